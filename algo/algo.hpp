@@ -11,12 +11,22 @@
 #include "include/algo_bit.hpp"
 #include "include/algo_data_mining.hpp"
 #include "include/algo_geometry.hpp"
+#include "include/algo_geometry_hull.hpp"
+#include "include/algo_geometry_index.hpp"
+#include "include/algo_geometry_kernel.hpp"
+#include "include/algo_geometry_mesh.hpp"
+#include "include/algo_geometry_pairs.hpp"
+#include "include/algo_geometry_polygon.hpp"
 #include "include/algo_graph.hpp"
 #include "include/algo_greedy.hpp"
 #include "include/algo_image_basic.hpp"
+#include "include/algo_image_color.hpp"
 #include "include/algo_image_feature.hpp"
 #include "include/algo_image_filter.hpp"
 #include "include/algo_image_object.hpp"
+#include "include/algo_image_pipeline.hpp"
+#include "include/algo_image_pyramid.hpp"
+#include "include/algo_image_tile.hpp"
 #include "include/algo_math.hpp"
 #include "include/algo_puzzle.hpp"
 #include "include/algo_sequence.hpp"
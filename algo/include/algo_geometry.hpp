@@ -12,6 +12,12 @@
 /// 2021-01-18 Minimum enclosing circle
 /// 2022-01-06 Object oriented design
 /// 2022-01-15 Delaunay triangulation
+/// 2026-10-19 Structure-of-arrays point cloud and batch kernels
+/// 2026-10-19 Robust orientation and in-circle predicates
+/// 2026-10-19 Adaptive precision predicates in the primitive tests
+/// 2026-10-19 Exact comparison of intersection points
+/// 2026-10-19 Monotone chain convex hull
+/// 2026-10-19 Iterative Welzl, batched minimum enclosing circles
 ///
 
 #pragma once
@@ -33,6 +39,63 @@ std::vector<Point> SortCounterClockWise(const std::vector<Point>& pts);
 
 }  // namespace helpers
 
+namespace predicates {
+
+/// \brief Orientation test, the sign of the result is exact.
+/// \details A floating-point filter decides the common case. Inputs that are
+/// too close to degenerate are refined in adaptive stages, and only the
+/// last stage evaluates the determinant exactly.
+/// \param a Point.
+/// \param b Point.
+/// \param c Point.
+/// \return Positive if a, b, c are counter clockwise, negative if clockwise
+/// and zero if collinear.
+double Orient2D(const Point& a, const Point& b, const Point& c);
+
+/// \brief Orientation test on raw coordinates, see Orient2D above.
+double Orient2D(double ax, double ay, double bx, double by, double cx,
+                double cy);
+
+/// \brief In-circle test, the sign of the result is exact.
+/// \param a Point.
+/// \param b Point.
+/// \param c Point.
+/// \param d Point.
+/// \return Positive if d is inside the circle through the counter clockwise
+/// points a, b, c, negative if outside and zero if on the circle.
+double InCircle(const Point& a, const Point& b, const Point& c, const Point& d);
+
+/// \brief In-circle test on raw coordinates, see InCircle above.
+double InCircle(double ax, double ay, double bx, double by, double cx,
+                double cy, double dx, double dy);
+
+/// \brief Compares the intersection point of the lines through a, b and
+/// c, d with a point in (x, y) order, exactly.
+/// \details The intersection point is usually not representable. It is
+/// located in floating point with error bounds first, and evaluated exactly
+/// only when that does not decide.
+/// \param a Point on the first line.
+/// \param b Point on the first line.
+/// \param c Point on the second line.
+/// \param d Point on the second line.
+/// \param pt The point.
+/// \return -1 if the intersection point comes first, 1 if pt comes first
+/// and 0 if they are equal.
+/// \throws std::invalid_argument if the lines are parallel.
+int CompareIntersection(const Point& a, const Point& b, const Point& c,
+                        const Point& d, const Point& pt);
+
+/// \brief Compares the intersection points of the lines through a, b and
+/// c, d and of the lines through e, f and g, h in (x, y) order, exactly.
+/// \return -1 if the first intersection point comes first, 1 if the second
+/// comes first and 0 if they are equal.
+/// \throws std::invalid_argument if either pair of lines is parallel.
+int CompareIntersections(const Point& a, const Point& b, const Point& c,
+                         const Point& d, const Point& e, const Point& f,
+                         const Point& g, const Point& h);
+
+}  // namespace predicates
+
 // /////////////////////////////
 // MARK: Point
 
@@ -93,6 +156,105 @@ class Point {
   double y_;
 };
 
+class Rectangle;
+
+// /////////////////////////////
+// MARK: PointCloud
+
+/// \brief Structure-of-arrays point storage. The x and y coordinates are kept
+/// in two separate contiguous arrays so that the batch kernels below can be
+/// vectorized by the compiler.
+class PointCloud {
+ public:
+  PointCloud() = default;
+  explicit PointCloud(const std::vector<Point>& points);
+  PointCloud(std::vector<double> xs, std::vector<double> ys);
+  PointCloud(const PointCloud& other) = default;
+  PointCloud(PointCloud&& other) noexcept = default;
+  PointCloud& operator=(const PointCloud& other) = default;
+  PointCloud& operator=(PointCloud&& other) noexcept = default;
+  ~PointCloud() = default;
+
+  /// \brief Returns the number of points.
+  /// \return Number of points.
+  size_t Size() const;
+
+  /// \brief Checks if there are no points.
+  /// \return true if empty.
+  bool Empty() const;
+
+  /// \brief Reserves storage for n points.
+  /// \param n Number of points.
+  void Reserve(size_t n);
+
+  /// \brief Appends a point.
+  /// \param x Coordinate.
+  /// \param y Coordinate.
+  void PushBack(double x, double y);
+
+  /// \brief Appends a point.
+  /// \param pt The point.
+  void PushBack(const Point& pt);
+
+  /// \brief Returns the x-coordinate of the i:th point.
+  /// \param i Index.
+  /// \return x.
+  double X(size_t i) const;
+
+  /// \brief Returns the y-coordinate of the i:th point.
+  /// \param i Index.
+  /// \return y.
+  double Y(size_t i) const;
+
+  /// \brief Returns the i:th point.
+  /// \param i Index.
+  /// \return The point.
+  Point At(size_t i) const;
+
+  /// \brief Returns the contiguous array of x-coordinates.
+  /// \return x-coordinates.
+  const std::vector<double>& Xs() const;
+
+  /// \brief Returns the contiguous array of y-coordinates.
+  /// \return y-coordinates.
+  const std::vector<double>& Ys() const;
+
+  /// \brief Converts to an array of points.
+  /// \return Points.
+  std::vector<Point> ToPoints() const;
+
+  /// \brief Returns the Euclidean distance from each point to pt.
+  /// \param pt The point.
+  /// \return Distances, one per point.
+  std::vector<double> Distances(const Point& pt) const;
+
+  /// \brief Determines on which side of the directed line a -> b each point is.
+  /// \details Exact, as predicates::Orient2D. The floating-point filter runs
+  /// over all points, the few it cannot decide go to Orient2D.
+  /// \param a Line start.
+  /// \param b Line end.
+  /// \return 1 if left (counter clockwise), -1 if right, 0 if collinear.
+  std::vector<int> Orientations(const Point& a, const Point& b) const;
+
+  /// \brief Returns the axis aligned bounding rectangle of the points.
+  /// \return Bounding rectangle.
+  Rectangle BoundingRectangle() const;
+
+  /// \brief Returns the mean of the points.
+  /// \return Centroid.
+  Point Centroid() const;
+
+  /// \brief Rotates the points with an angle around a point center.
+  /// \param angle The rotation angle.
+  /// \param center The point that the points will be rotated around.
+  /// \return A rotated copy of the points.
+  PointCloud Rotate(double angle, const Point& center) const;
+
+ private:
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+};
+
 // /////////////////////////////
 // MARK: Edge
 
@@ -113,7 +275,7 @@ class Edge {
 
   /// \brief Checks if this edge and edge intersect.
   /// \details Note that the edges are not treated as continuing beyond their
-  /// edge points.
+  /// edge points. Uses the robust orientation predicate.
   /// \param edge Other edge.
   /// \return true if there's an intersection.
   bool Intersect(const Edge& edge) const;
@@ -161,8 +323,10 @@ class Circle {
   double Area() const;
 
   /// \brief Checks if pt is inside this circle.
+  /// \details The comparison of the squared distance against the squared
+  /// radius is exact.
   /// \param pt The point.
-  /// \return true if inside.
+  /// \return true if inside or on the circle.
   bool IsInside(const Point& pt) const;
 
   /// \brief Returns an equal sided triangle that encloses the circle.
@@ -182,14 +346,13 @@ class Circle {
   const double radius_;
 };
 
-class Rectangle;
-
 // /////////////////////////////
 // MARK: Polygon
 
 class Polygon {
  public:
   explicit Polygon(const std::vector<Point>& points);
+  explicit Polygon(PointCloud points);
   Polygon() = delete;
   Polygon(const Polygon& other) = default;
   Polygon(Polygon&& other) noexcept = default;
@@ -235,8 +398,12 @@ class Polygon {
   /// \return Points.
   std::vector<Point> GetPoints() const;
 
+  /// \brief Returns the points of this polygon without copying them.
+  /// \return Points.
+  const PointCloud& GetCloud() const;
+
  protected:
-  std::vector<Point> points_;
+  PointCloud points_;
   Point center_;
 };
 
@@ -254,6 +421,8 @@ class Triangle : public Polygon {
   ~Triangle() override = default;
 
   /// \brief Checks if pt is inside this triangle.
+  /// \details Three robust orientation tests, points on the boundary count
+  /// as inside.
   /// \param[in] pt The point.
   /// \return true if inside.
   bool IsInside(const Point& pt) const;
@@ -320,12 +489,15 @@ class Rectangle : public Polygon {
   const double height_;
 };
 
+class TriangleMesh;
+
 // /////////////////////////////
 // MARK: Grid
 
 class Grid {
  public:
   explicit Grid(const std::vector<Point>& points);
+  explicit Grid(PointCloud points);
   Grid() = delete;
   Grid(const Grid& other) = default;
   Grid(Grid&& other) noexcept = default;
@@ -334,34 +506,70 @@ class Grid {
   ~Grid() = default;
 
   /// \brief Returns the two points that are closest in distance to each other.
-  /// \return Closest pair of points.
+  /// \details O(n log n), see ClosestPairs in algo_geometry_pairs.hpp.
+  /// \return Closest pair of points, in input order.
+  /// \throws std::invalid_argument if there are fewer than two points.
   std::pair<Point, Point> ClosestPairOfPoints() const;
 
   /// \brief Returns the convex hull of this grid.
-  /// \details Using quick hull algorithm.
-  /// \return The polygon than makes the convex hull.
-  Polygon ConvexHull() const;
+  /// \details Andrew's monotone chain, see algo_geometry_hull.hpp.
+  /// \param nbr_threads Number of threads, 0 means hardware concurrency.
+  /// \return The polygon than makes the convex hull, counter clockwise from
+  /// the lowest point.
+  /// \throws std::invalid_argument if the hull has less than three corners.
+  Polygon ConvexHull(size_t nbr_threads = 1) const;
 
   /// \brief Returns the minimum bounding box if this grid.
-  /// \return Minimum bounding box.
+  /// \details See RotatingCalipers in algo_geometry_hull.hpp.
+  /// \return Minimum area bounding box, counter clockwise.
+  /// \throws std::invalid_argument if the hull has less than three corners.
   Polygon MinBoundingBox() const;
 
   /// \brief Returns the minimum enclosing circle.
-  /// \return Minimum enclosing circle.
+  /// \details Welzl's algorithm, iterative with move-to-front on the points
+  /// in random order, expected O(n).
+  /// \return Minimum enclosing circle, radius 0 at the origin if empty.
   Circle MinEnclosingCircle() const;
 
   /// \brief Returns a triangulation of this grid.
-  /// \return A triangulation.
+  /// \details The sweep of BasicGrid<double>::Triangulation, O(n log n).
+  /// \return A triangulation, empty if there are fewer than two points.
   std::vector<Edge> Triangulation() const;
 
   /// \brief Returns the Delaunay triangulation of this grid.
   /// \return Thed edges that construct the triangulation.
   std::vector<Edge> DelaunayTriangulation() const;
 
+  /// \brief Returns the Delaunay triangulation of this grid as a triangle
+  /// mesh with adjacency, see algo_geometry_mesh.hpp.
+  /// \return Triangle mesh.
+  TriangleMesh DelaunayMesh() const;
+
+  /// \brief Returns the points of this grid without copying them.
+  /// \return Points.
+  const PointCloud& GetCloud() const;
+
  private:
-  const std::vector<Point> points_;
+  const PointCloud points_;
 };
 
 using Points = std::vector<Point>;
 
+// /////////////////////////////
+// MARK: MinEnclosingCircle
+
+/// \brief Returns the minimum enclosing circle of each group of points, as
+/// from a clustering.
+/// \details The points are sorted on the groups once, then each group is
+/// solved in place as in Grid::MinEnclosingCircle, without allocations.
+/// \param points The points.
+/// \param labels The group of each point, 0, 1, ... less than the number of
+/// points. Points with a negative label, such as noise, are left out.
+/// \return One circle per group up to the largest label. Empty groups get
+/// radius 0 at the origin.
+/// \throws std::invalid_argument if there is not one label per point, or if
+/// a label is not less than the number of points.
+std::vector<Circle> MinEnclosingCircles(const PointCloud& points,
+                                        const std::vector<int>& labels);
+
 }  // namespace algo::geometry
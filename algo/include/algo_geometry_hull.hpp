@@ -0,0 +1,114 @@
+///
+/// \brief Convex hull algorithms.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+/// Change list:
+/// 2026-10-19 Monotone chain, parallel and streaming convex hull
+/// 2026-10-19 Rotating calipers: minimum boxes, diameter and width
+///
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "algo_geometry.hpp"
+
+namespace algo::geometry {
+
+// /////////////////////////////
+// MARK: Convex hull
+
+/// \brief Returns the convex hull of points sorted on (x, y) with Andrew's
+/// monotone chain, O(n).
+/// \details The turns are decided with the robust orientation predicate.
+/// Duplicated points and points on the hull edges are left out.
+/// \param sorted Points sorted on x, then on y.
+/// \return The hull vertices counter clockwise, starting at the lowest point
+/// (the leftmost one if several). Fewer than three if all points are on a
+/// line.
+PointCloud MonotoneChain(const PointCloud& sorted);
+
+/// \brief Returns the convex hull of points in any order, O(n log n).
+/// \details The points are split in chunks, one per thread, that are sorted
+/// and reduced to their hulls in parallel. The chunk hulls, usually much
+/// smaller than the input, are merged with a final monotone chain.
+/// \param points The points.
+/// \param nbr_threads Number of threads, 0 means hardware concurrency.
+/// \return The hull vertices, see MonotoneChain.
+PointCloud ConvexHull(const PointCloud& points, size_t nbr_threads = 1);
+
+// /////////////////////////////
+// MARK: Rotating calipers
+
+/// \brief A rectangle at any angle.
+struct OrientedBox {
+  std::array<Point, 4> corners;  // Counter clockwise.
+  double length;                 // Side from the first to the second corner.
+  double height;                 // Side from the second to the third corner.
+};
+
+/// \brief Measures of a convex polygon.
+struct CaliperMetrics {
+  OrientedBox min_area_box;
+  OrientedBox min_perimeter_box;
+  double diameter;  // Largest distance between two vertices.
+  double width;     // Smallest distance between two parallel support lines.
+};
+
+/// \brief Measures a convex hull with rotating calipers in O(h).
+/// \details One pass over the hull edges. The extreme vertices in the edge
+/// direction, across it and against it are followed by three pointers that
+/// only move forward. An optimal box has a side on a hull edge, so the boxes
+/// are only compared by their sides and the corners of the two best are
+/// computed at the end. Nothing is allocated.
+/// \param hull Hull vertices counter clockwise, as from MonotoneChain or
+/// ConvexHull. One or two points give boxes with zero height.
+/// \return The measures.
+/// \throws std::invalid_argument if the hull is empty.
+CaliperMetrics RotatingCalipers(const PointCloud& hull);
+
+// /////////////////////////////
+// MARK: StreamingHull
+
+/// \brief Convex hull of a stream of points that arrive in chunks.
+/// \details Only the current hull vertices are kept, so the memory is O(h)
+/// whatever the length of the stream. Adding a chunk of m points is
+/// O(m log m + h).
+class StreamingHull {
+ public:
+  StreamingHull() = default;
+  StreamingHull(const StreamingHull& other) = default;
+  StreamingHull(StreamingHull&& other) noexcept = default;
+  StreamingHull& operator=(const StreamingHull& other) = default;
+  StreamingHull& operator=(StreamingHull&& other) noexcept = default;
+  ~StreamingHull() = default;
+
+  /// \brief Adds a chunk of points.
+  /// \param chunk The points, in any order.
+  void Add(const PointCloud& chunk);
+
+  /// \brief Adds a single point.
+  /// \param pt The point.
+  void Add(const Point& pt);
+
+  /// \brief Returns the hull of all points added so far.
+  /// \return The hull vertices, see MonotoneChain.
+  PointCloud Hull() const;
+
+  /// \brief Returns the number of points added so far.
+  /// \return Number of points.
+  size_t Count() const;
+
+ private:
+  // Hull vertices sorted on (x, y), so that a sorted chunk is merged in
+  // linear time.
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  size_t count_{0};
+};
+
+}  // namespace algo::geometry
@@ -0,0 +1,231 @@
+///
+/// \brief Spatial indexes for geometry algorithms.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+/// Change list:
+/// 2026-10-19 Static 2D k-d tree
+/// 2026-10-19 R-tree for polygons and edges
+///
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "algo_geometry.hpp"
+
+namespace algo::geometry {
+
+// /////////////////////////////
+// MARK: KdTree
+
+/// \brief Static 2D k-d tree over a point cloud.
+/// \details The tree is stored implicitly: the points are reordered so that
+/// the median of a range is the splitting node and the two halves on each
+/// side are its subtrees. The split axis alternates between x and y with the
+/// depth. There are no node pointers, the coordinates are kept as two
+/// contiguous arrays in tree order. All queries return indices into the
+/// point cloud the tree was built from.
+class KdTree {
+ public:
+  static constexpr size_t kNone{std::numeric_limits<size_t>::max()};
+
+  /// \brief Builds the tree in O(n log n).
+  /// \param points The points.
+  /// \param nbr_threads Number of threads for the build, 0 means hardware
+  /// concurrency.
+  explicit KdTree(PointCloud points, size_t nbr_threads = 0);
+  KdTree() = delete;
+  KdTree(const KdTree& other) = default;
+  KdTree(KdTree&& other) noexcept = default;
+  KdTree& operator=(const KdTree& other) = default;
+  KdTree& operator=(KdTree&& other) noexcept = default;
+  ~KdTree() = default;
+
+  /// \brief Returns the number of points.
+  /// \return Number of points.
+  size_t Size() const;
+
+  /// \brief Finds the point closest to pt.
+  /// \param pt Query point.
+  /// \return Index of the nearest point, kNone if the tree is empty.
+  size_t Nearest(const Point& pt) const;
+
+  /// \brief Finds the k points closest to pt.
+  /// \param pt Query point.
+  /// \param k Number of neighbours.
+  /// \return Indices, nearest first. Fewer than k if the tree is smaller.
+  std::vector<size_t> KNearest(const Point& pt, size_t k) const;
+
+  /// \brief Finds all points within a distance from pt.
+  /// \param pt Query point.
+  /// \param radius Maximum distance, inclusive.
+  /// \return Indices in no particular order.
+  std::vector<size_t> Radius(const Point& pt, double radius) const;
+
+  /// \brief Finds all points inside an axis-aligned rectangle.
+  /// \param rect The rectangle, points on the boundary are included.
+  /// \return Indices in no particular order.
+  std::vector<size_t> Range(const Rectangle& rect) const;
+
+  /// \brief Nearest point for each query point, the queries are spread over
+  /// threads.
+  /// \param queries Query points.
+  /// \param nbr_threads Number of threads, 0 means hardware concurrency.
+  /// \return Index of the nearest point for each query.
+  std::vector<size_t> Nearest(const PointCloud& queries,
+                              size_t nbr_threads = 0) const;
+
+  /// \brief k nearest points for each query point, see Nearest.
+  /// \param queries Query points.
+  /// \param k Number of neighbours.
+  /// \param nbr_threads Number of threads, 0 means hardware concurrency.
+  /// \return Indices for each query, nearest first.
+  std::vector<std::vector<size_t>> KNearest(const PointCloud& queries,
+                                            size_t k,
+                                            size_t nbr_threads = 0) const;
+
+  /// \brief Returns the points of this tree.
+  /// \return Points.
+  const PointCloud& GetCloud() const;
+
+ private:
+  PointCloud points_;
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  std::vector<size_t> ids_;
+};
+
+// /////////////////////////////
+// MARK: RTree
+
+/// \brief Dynamic R-tree over the bounding rectangles of polygons and edges.
+/// \details Objects are identified by a caller chosen id and keyed on their
+/// axis-aligned bounding rectangle, Polygon::BoundingRectangle for polygons.
+/// The tree can be bulk loaded with Sort-Tile-Recursive packing, and objects
+/// can be inserted (Guttman, quadratic split) and removed afterwards. The
+/// queries test bounding rectangles only, the caller refines the candidates
+/// with an exact test such as Triangle::IsInside or Edge::Intersect.
+class RTree {
+ public:
+  static constexpr size_t kNone{std::numeric_limits<size_t>::max()};
+  /// Maximum number of entries per node.
+  static constexpr size_t kMaxEntries{16UL};
+  /// Minimum number of entries per node, except for the root.
+  static constexpr size_t kMinEntries{6UL};
+
+  /// \brief Distance from the query point to the object with the given id.
+  using DistanceFunc = std::function<double(size_t id)>;
+
+  RTree();
+
+  /// \brief Bulk loads the polygons, the ids are the indices.
+  /// \param polygons The polygons.
+  explicit RTree(const std::vector<Polygon>& polygons);
+
+  /// \brief Bulk loads the edges, the ids are the indices.
+  /// \param edges The edges.
+  explicit RTree(const std::vector<Edge>& edges);
+
+  RTree(const RTree& other) = default;
+  RTree(RTree&& other) noexcept = default;
+  RTree& operator=(const RTree& other) = default;
+  RTree& operator=(RTree&& other) noexcept = default;
+  ~RTree() = default;
+
+  /// \brief Returns the number of objects.
+  /// \return Number of objects.
+  size_t Size() const;
+
+  /// \brief Returns the height, 1 when the root is a leaf.
+  /// \return Height.
+  size_t Height() const;
+
+  /// \brief Inserts a polygon.
+  /// \param id Object id.
+  /// \param polygon The polygon.
+  void Insert(size_t id, const Polygon& polygon);
+
+  /// \brief Inserts an edge.
+  /// \param id Object id.
+  /// \param edge The edge.
+  void Insert(size_t id, const Edge& edge);
+
+  /// \brief Removes a polygon, it must be the same as when inserted.
+  /// \param id Object id.
+  /// \param polygon The polygon.
+  /// \return true if the object was found.
+  bool Remove(size_t id, const Polygon& polygon);
+
+  /// \brief Removes an edge, it must be the same as when inserted.
+  /// \param id Object id.
+  /// \param edge The edge.
+  /// \return true if the object was found.
+  bool Remove(size_t id, const Edge& edge);
+
+  /// \brief Finds the objects whose bounding rectangles intersect a window.
+  /// \param window Axis-aligned window, touching counts as intersecting.
+  /// \return Ids in no particular order.
+  std::vector<size_t> Search(const Rectangle& window) const;
+
+  /// \brief Finds the objects whose bounding rectangles contain a point.
+  /// \param pt The point, the boundary counts as inside.
+  /// \return Ids in no particular order.
+  std::vector<size_t> Contains(const Point& pt) const;
+
+  /// \brief Finds the k objects nearest to a point, best first.
+  /// \details Without a distance function the objects are ordered by the
+  /// distance to their bounding rectangles. The distance function gives the
+  /// exact distance to an object and must never be smaller than the distance
+  /// to its bounding rectangle.
+  /// \param pt Query point.
+  /// \param k Number of objects.
+  /// \param distance Optional exact distance to an object.
+  /// \return Ids, nearest first.
+  std::vector<size_t> Nearest(const Point& pt, size_t k = 1,
+                              const DistanceFunc& distance = {}) const;
+
+ private:
+  struct Box {
+    double x_min;
+    double y_min;
+    double x_max;
+    double y_max;
+  };
+
+  struct Entry {
+    Box box;
+    size_t child;  // Object id in a leaf, node index otherwise.
+  };
+
+  struct Node {
+    std::array<Entry, kMaxEntries> entries;
+    size_t count;
+    bool leaf;
+  };
+
+  void BulkLoad(std::vector<Entry> entries);
+  std::vector<Entry> Pack(std::vector<Entry>& entries, bool leaf);
+  void InsertEntry(const Entry& entry);
+  size_t InsertInto(size_t node, const Entry& entry);
+  size_t AddEntry(size_t node, const Entry& entry);
+  bool RemoveEntry(const Entry& entry);
+  bool RemoveFrom(size_t node, const Entry& entry,
+                  std::vector<Entry>& orphans);
+  void Collect(size_t node, std::vector<Entry>& objects);
+  size_t NewNode(bool leaf);
+  Box NodeBox(size_t node) const;
+
+  std::vector<Node> nodes_;
+  std::vector<size_t> free_;
+  size_t root_;
+  size_t size_;
+  size_t height_;
+};
+
+}  // namespace algo::geometry
@@ -0,0 +1,155 @@
+///
+/// \brief Geometry kernels on float, double and 32-bit integer coordinates.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+/// Change list:
+/// 2026-10-19 Points, edges and grid algorithms templated on the coordinate
+/// type, exact integer predicates
+///
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "algo_geometry.hpp"
+
+namespace algo::geometry {
+
+// /////////////////////////////
+// MARK: BasicPoint
+
+/// \brief A point on coordinates of type T, 8 bytes for float and int32_t.
+/// \details Unlike Point it has no virtual functions, so a vector of them is
+/// two coordinates per point and nothing else. The templates are compiled
+/// into the library for float, double and int32_t.
+template <typename T>
+struct BasicPoint {
+  T x;
+  T y;
+
+  bool operator==(const BasicPoint& p) const { return x == p.x && y == p.y; }
+  bool operator!=(const BasicPoint& p) const { return !(*this == p); }
+};
+
+/// \brief A segment between two points on coordinates of type T.
+template <typename T>
+struct BasicEdge {
+  BasicPoint<T> first;
+  BasicPoint<T> second;
+};
+
+using PointF = BasicPoint<float>;
+using PointI = BasicPoint<int32_t>;
+using EdgeF = BasicEdge<float>;
+using EdgeI = BasicEdge<int32_t>;
+
+// /////////////////////////////
+// MARK: Exact predicates
+
+/// \brief Orientation test, exact for every coordinate type.
+/// \details Integer coordinates less than 2^30 apart are decided in 64-bit
+/// integer arithmetic. Larger ones, and float and double coordinates, which
+/// all convert to double exactly, use predicates::Orient2D.
+/// \param a Point.
+/// \param b Point.
+/// \param c Point.
+/// \return 1 if a, b, c are counter clockwise, -1 if clockwise and 0 if
+/// collinear.
+template <typename T>
+int Orientation(const BasicPoint<T>& a, const BasicPoint<T>& b,
+                const BasicPoint<T>& c);
+
+/// \brief In-circle test, exact for every coordinate type.
+/// \details Integer coordinates less than 2^14 apart are decided in 64-bit
+/// integer arithmetic, the rest with predicates::InCircle.
+/// \param a Point.
+/// \param b Point.
+/// \param c Point.
+/// \param d Point.
+/// \return 1 if d is inside the circle through the counter clockwise points
+/// a, b, c, -1 if outside and 0 if on the circle.
+template <typename T>
+int InCircle(const BasicPoint<T>& a, const BasicPoint<T>& b,
+             const BasicPoint<T>& c, const BasicPoint<T>& d);
+
+/// \brief Checks if two closed segments have a point in common, exactly.
+/// \param e Segment.
+/// \param f Segment.
+/// \return True if they intersect or touch.
+template <typename T>
+bool Intersect(const BasicEdge<T>& e, const BasicEdge<T>& f);
+
+// /////////////////////////////
+// MARK: BasicGrid
+
+/// \brief The Grid algorithms on points with coordinates of type T.
+/// \details The hull, the closest pair and the triangulation run on the
+/// points as they are, with the exact predicates above. The minimum
+/// enclosing circle, the minimum bounding box and the Delaunay triangulation
+/// have results that are not on the coordinate type in general; they work
+/// on double copies of the points, of the hull only for the box.
+template <typename T>
+class BasicGrid {
+ public:
+  explicit BasicGrid(std::vector<BasicPoint<T>> points);
+  BasicGrid() = delete;
+  BasicGrid(const BasicGrid& other) = default;
+  BasicGrid(BasicGrid&& other) noexcept = default;
+  BasicGrid& operator=(const BasicGrid& other) = delete;
+  BasicGrid& operator=(BasicGrid&& other) noexcept = delete;
+  ~BasicGrid() = default;
+
+  /// \brief Returns the two points that are closest to each other, with a
+  /// sweep along x in O(n log n). Integer coordinates are compared on their
+  /// exact squared distances, which need more than 64 bits.
+  /// \return Closest pair of points, in input order.
+  /// \throws std::invalid_argument if there are fewer than two points.
+  std::pair<BasicPoint<T>, BasicPoint<T>> ClosestPairOfPoints() const;
+
+  /// \brief Returns the convex hull with Andrew's monotone chain.
+  /// \return The hull vertices counter clockwise from the lowest point, the
+  /// leftmost one if several. Points on the hull edges are left out.
+  /// \throws std::invalid_argument if the hull has less than three corners.
+  std::vector<BasicPoint<T>> ConvexHull() const;
+
+  /// \brief Returns the minimum area bounding box, see Grid.
+  /// \return Minimum area bounding box, counter clockwise.
+  /// \throws std::invalid_argument if the hull has less than three corners.
+  Polygon MinBoundingBox() const;
+
+  /// \brief Returns the minimum enclosing circle, see Grid.
+  /// \return Minimum enclosing circle, radius 0 at the origin if empty.
+  Circle MinEnclosingCircle() const;
+
+  /// \brief Returns a triangulation with a sweep along x, O(n log n).
+  /// \details Each point in (x, y) order is joined to the corners of the
+  /// hull so far that it sees. Duplicated points are joined once.
+  /// \return The edges of the triangulation.
+  std::vector<BasicEdge<T>> Triangulation() const;
+
+  /// \brief Returns the Delaunay triangulation, see Grid.
+  /// \return The edges of the triangulation, empty if all points are on a
+  /// line.
+  std::vector<BasicEdge<T>> DelaunayTriangulation() const;
+
+  /// \brief Returns the points of this grid.
+  /// \return Points.
+  const std::vector<BasicPoint<T>>& GetPoints() const;
+
+ private:
+  const std::vector<BasicPoint<T>> points_;
+};
+
+using GridF = BasicGrid<float>;
+using GridI = BasicGrid<int32_t>;
+
+extern template class BasicGrid<float>;
+extern template class BasicGrid<double>;
+extern template class BasicGrid<int32_t>;
+
+}  // namespace algo::geometry
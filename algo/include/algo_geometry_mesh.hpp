@@ -0,0 +1,170 @@
+///
+/// \brief Triangle meshes for geometry algorithms.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+/// Change list:
+/// 2026-10-19 Half-edge triangle mesh, divide and conquer Delaunay
+/// 2026-10-19 Constrained Delaunay triangulation, Voronoi diagram
+///
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "algo_geometry.hpp"
+
+namespace algo::geometry {
+
+// /////////////////////////////
+// MARK: TriangleMesh
+
+/// \brief Triangle mesh over a point cloud, stored as half-edges.
+/// \details Half-edge e belongs to triangle e / 3 and starts at vertex
+/// Vertex(e). The three half-edges of a triangle are ordered counter
+/// clockwise, so Next(e) ends where e starts the next side. Twin(e) is the
+/// half-edge going the opposite way in the neighbouring triangle, or kNone if
+/// e is on the boundary.
+class TriangleMesh {
+ public:
+  static constexpr size_t kNone{std::numeric_limits<size_t>::max()};
+
+  TriangleMesh(PointCloud points, std::vector<size_t> vertices,
+               std::vector<size_t> twins);
+  TriangleMesh() = delete;
+  TriangleMesh(const TriangleMesh& other) = default;
+  TriangleMesh(TriangleMesh&& other) noexcept = default;
+  TriangleMesh& operator=(const TriangleMesh& other) = default;
+  TriangleMesh& operator=(TriangleMesh&& other) noexcept = default;
+  ~TriangleMesh() = default;
+
+  /// \brief Computes the Delaunay triangulation of the points.
+  /// \details Guibas-Stolfi divide and conquer on a quad-edge structure,
+  /// O(n log n), using the robust predicates. Duplicated points are only
+  /// triangulated once and collinear inputs give an empty mesh.
+  /// \param points The points, the mesh vertex indices refer to these.
+  /// \return Delaunay triangle mesh.
+  static TriangleMesh Delaunay(PointCloud points);
+
+  /// \brief Computes the constrained Delaunay triangulation of the points.
+  /// \details The constraints are inserted into the Delaunay triangulation
+  /// one at a time: the edges that cross a constraint are flipped until one
+  /// of them is the constraint, and the new edges are then flipped back to
+  /// Delaunay where no constraint is in the way (Sloan's algorithm). A
+  /// constraint through other points is split at them. O(n log n) plus
+  /// O(k^2) for a constraint that crosses k edges.
+  /// \param points The points, the mesh vertex indices refer to these.
+  /// \param constraints Required edges as pairs of point indices.
+  /// \return Constrained Delaunay triangle mesh, IsConstrained tells the
+  /// required edges.
+  /// \throws std::invalid_argument if an index is out of range or if two
+  /// constraints cross.
+  static TriangleMesh ConstrainedDelaunay(
+      PointCloud points,
+      const std::vector<std::pair<size_t, size_t>>& constraints);
+
+  /// \brief Returns the number of triangles.
+  /// \return Number of triangles.
+  size_t TriangleCount() const;
+
+  /// \brief Returns the number of half-edges, three per triangle.
+  /// \return Number of half-edges.
+  size_t HalfEdgeCount() const;
+
+  /// \brief Returns the start vertex of a half-edge.
+  /// \param e Half-edge.
+  /// \return Vertex index into the point cloud.
+  size_t Vertex(size_t e) const;
+
+  /// \brief Returns the opposite half-edge.
+  /// \param e Half-edge.
+  /// \return Twin half-edge, or kNone on the boundary.
+  size_t Twin(size_t e) const;
+
+  /// \brief Checks if a half-edge is a required edge of a constrained
+  /// Delaunay triangulation.
+  /// \param e Half-edge.
+  /// \return True if e is constrained.
+  bool IsConstrained(size_t e) const;
+
+  /// \brief Returns the next half-edge in the same triangle.
+  /// \param e Half-edge.
+  /// \return Next half-edge.
+  static size_t Next(size_t e);
+
+  /// \brief Returns the previous half-edge in the same triangle.
+  /// \param e Half-edge.
+  /// \return Previous half-edge.
+  static size_t Prev(size_t e);
+
+  /// \brief Returns the three vertices of triangle t, counter clockwise.
+  /// \param t Triangle.
+  /// \return Vertex indices.
+  std::array<size_t, 3> TriangleVertices(size_t t) const;
+
+  /// \brief Returns the neighbours of triangle t. The i:th neighbour is across
+  /// the half-edge from vertex i to vertex i + 1.
+  /// \param t Triangle.
+  /// \return Neighbouring triangles, kNone on the boundary.
+  std::array<size_t, 3> TriangleNeighbors(size_t t) const;
+
+  /// \brief Returns triangle t.
+  /// \param t Triangle.
+  /// \return Triangle.
+  Triangle GetTriangle(size_t t) const;
+
+  /// \brief Returns all triangles.
+  /// \return Triangles.
+  std::vector<Triangle> GetTriangles() const;
+
+  /// \brief Returns all edges, each edge once.
+  /// \return Edges.
+  std::vector<Edge> GetEdges() const;
+
+  /// \brief Returns the vertices of this mesh.
+  /// \return Points.
+  const PointCloud& GetCloud() const;
+
+  /// \brief Returns the start vertex of each half-edge.
+  /// \return Vertex indices.
+  const std::vector<size_t>& Vertices() const;
+
+  /// \brief Returns the twin of each half-edge.
+  /// \return Half-edges.
+  const std::vector<size_t>& Twins() const;
+
+ private:
+  PointCloud points_;
+  std::vector<size_t> vertices_;
+  std::vector<size_t> twins_;
+  std::vector<uint8_t> constrained_;  // Per half-edge, empty if none.
+};
+
+// /////////////////////////////
+// MARK: Voronoi
+
+/// \brief The Voronoi cell of a site.
+struct VoronoiCell {
+  size_t site;   // Index of the site.
+  Polygon cell;  // Counter clockwise.
+};
+
+/// \brief Computes the Voronoi diagram of the sites inside a rectangle.
+/// \details The diagram is the dual of the Delaunay triangulation, the
+/// corners of a cell are the circum centers of the triangles around its
+/// site. Four sites far outside are added so that every cell is bounded,
+/// they are nearer to no point of the rectangle. O(n log n).
+/// \param sites The sites.
+/// \param box The cells are clipped to this rectangle.
+/// \return The cells that overlap the rectangle, sorted on the sites.
+/// Duplicated sites share one cell, it is reported for one of them.
+std::vector<VoronoiCell> VoronoiDiagram(const PointCloud& sites,
+                                        const Rectangle& box);
+
+}  // namespace algo::geometry
@@ -0,0 +1,120 @@
+///
+/// \brief Closest pair algorithms.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+/// Change list:
+/// 2026-10-19 Closest pair by sweep and grid hashing, k closest pairs and
+/// pairs within a distance
+///
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "algo_geometry.hpp"
+
+namespace algo::geometry {
+
+// /////////////////////////////
+// MARK: ClosestPairs
+
+/// \brief Two points, as indices into a point cloud, and their distance.
+struct PointPair {
+  size_t first;  // The smaller index.
+  size_t second;
+  double dist;
+};
+
+/// \brief Closest pair queries over point clouds.
+/// \details The working memory is kept between the calls and only grows, so
+/// a ClosestPairs that is reused for clouds of similar sizes does not
+/// allocate. The results of KClosest and WithinDistance are held by the
+/// object and are valid until the next call. Duplicated points are pairs at
+/// distance zero.
+class ClosestPairs {
+ public:
+  ClosestPairs() = default;
+  ClosestPairs(const ClosestPairs& other) = default;
+  ClosestPairs(ClosestPairs&& other) noexcept = default;
+  ClosestPairs& operator=(const ClosestPairs& other) = default;
+  ClosestPairs& operator=(ClosestPairs&& other) noexcept = default;
+  ~ClosestPairs() = default;
+
+  /// \brief Finds the closest pair in O(n log n).
+  /// \details Divide and conquer on the points sorted on x once. The halves
+  /// are merged on y on the way back up, through one buffer, so that the
+  /// strip around each split is scanned in y order.
+  /// \param points The points, at least two.
+  /// \return The closest pair.
+  /// \throws std::invalid_argument if there are fewer than two points.
+  PointPair Closest(const PointCloud& points);
+
+  /// \brief Finds the closest pair in expected O(n) with a hashed grid.
+  /// \details The points are inserted in random order into a grid with cells
+  /// as large as the closest distance so far, a point is compared with the
+  /// points in the 3x3 cells around it only. The grid is rebuilt when the
+  /// distance shrinks, which happens O(log n) times in expectation.
+  /// \param points The points, at least two.
+  /// \param seed Seed for the insertion order.
+  /// \return The closest pair, the same distance as Closest.
+  /// \throws std::invalid_argument if there are fewer than two points.
+  PointPair ClosestHashed(const PointCloud& points, uint32_t seed = 0);
+
+  /// \brief Finds the k closest pairs with a sweep along the widest axis.
+  /// \param points The points.
+  /// \param k Number of pairs.
+  /// \return The pairs, closest first. Fewer than k if there are fewer pairs.
+  const std::vector<PointPair>& KClosest(const PointCloud& points, size_t k);
+
+  /// \brief Finds all pairs at most a distance apart with a hashed grid, in
+  /// expected O(n + m) for m pairs.
+  /// \param points The points.
+  /// \param dist Maximum distance, inclusive.
+  /// \return The pairs, sorted on the indices.
+  const std::vector<PointPair>& WithinDistance(const PointCloud& points,
+                                               double dist);
+
+ private:
+  struct Item {
+    double x;
+    double y;
+    size_t id;
+  };
+
+  struct Cell {
+    int64_t cx;
+    int64_t cy;
+    size_t head;  // First point in the cell, none if the slot is unused.
+  };
+
+  void Load(const PointCloud& points);
+  void Divide(size_t lo, size_t hi, PointPair& best);
+  void Sweep(double dist);
+  bool ResetGrid(double side);
+  std::pair<int64_t, int64_t> CellOf(const Item& p) const;
+  size_t Find(int64_t cx, int64_t cy) const;
+  void Insert(size_t i);
+
+  // Points of the current call.
+  std::vector<Item> items_;
+  std::vector<Item> buffer_;
+  // Hashed grid: open addressing on the cell coordinates, the points in a
+  // cell are linked through next_. Only the used slots are cleared.
+  std::vector<Cell> cells_;
+  std::vector<size_t> used_;
+  std::vector<size_t> next_;
+  std::vector<PointPair> pairs_;
+  size_t mask_{0};
+  double x_min_{0.0};
+  double y_min_{0.0};
+  double x_max_{0.0};
+  double y_max_{0.0};
+  double side_{0.0};
+};
+
+}  // namespace algo::geometry
@@ -0,0 +1,212 @@
+///
+/// \brief Polygon and segment algorithms.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+/// Change list:
+/// 2026-10-19 Bentley-Ottmann segment intersection, simple polygon test
+/// 2026-10-19 Boolean operations on polygons
+/// 2026-10-19 Point in polygon, winding number and slab index
+/// 2026-10-19 Polygon triangulation by ear clipping
+///
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "algo_geometry.hpp"
+
+namespace algo::geometry {
+
+// /////////////////////////////
+// MARK: Segment intersection
+
+/// \brief Two intersecting edges and a common point.
+struct Intersection {
+  size_t first;   // Index of the first edge, first < second.
+  size_t second;  // Index of the second edge.
+  Point point;    // Common point, rounded if it is not representable.
+};
+
+/// \brief Finds all pairs of intersecting edges with a Bentley-Ottmann
+/// sweep, O((n + k) log n) for k intersecting pairs.
+/// \details Edges intersect if they have a common point that is not an end
+/// point of both, so edges that only meet at a shared end point, as in a
+/// mesh, do not intersect. Touching an edge with an end point and collinear
+/// overlaps count. Whether two edges intersect is decided with the robust
+/// predicates, overlapping edges are reported once.
+/// \param edges The edges.
+/// \return Intersections, sorted on the edge indices.
+std::vector<Intersection> Intersections(const std::vector<Edge>& edges);
+
+/// \brief Checks if any two edges intersect, in the sense of Intersections.
+/// \details Stops at the first intersection, O(n log n).
+/// \param edges The edges.
+/// \return true if an intersection was found.
+bool AnyIntersection(const std::vector<Edge>& edges);
+
+/// \brief Checks if a polygon is simple, i.e. its boundary does not touch or
+/// cross itself. Only consecutive edges may share a point, their common
+/// corner.
+/// \param polygon The polygon.
+/// \return true if simple.
+bool IsSimple(const Polygon& polygon);
+
+// /////////////////////////////
+// MARK: Boolean operations
+
+/// \brief A polygon with holes.
+struct PolygonWithHoles {
+  Polygon outer;
+  std::vector<Polygon> holes;  // Inside outer, counter clockwise as well.
+};
+
+/// \brief Boolean operations on polygons.
+enum class BooleanOp { kIntersection, kUnion, kDifference, kXor };
+
+/// \brief Computes a Boolean operation on two polygons with the
+/// Martinez-Rueda sweep, O((n + k) log n) for k edge intersections.
+/// \details The polygons must be simple and may be concave. Edges that cross
+/// are split at the rounded crossing points, the decisions are made with the
+/// robust predicates. The intersection of two small convex polygons takes the
+/// fast path of ConvexClip. Collinear points are removed from the result, and
+/// rings that touch at a point are separate polygons or holes.
+/// \param subject The first polygon.
+/// \param clip The second polygon.
+/// \param op The operation, kDifference is subject minus clip.
+/// \return The polygons of the result, in sweep order.
+std::vector<PolygonWithHoles> Clip(const Polygon& subject, const Polygon& clip,
+                                   BooleanOp op);
+
+/// \brief Computes a Boolean operation on two sets of polygons with holes,
+/// see above. The polygons in a set must not overlap, such as a result of
+/// Clip.
+/// \param subject The first set.
+/// \param clip The second set.
+/// \param op The operation, kDifference is subject minus clip.
+/// \return The polygons of the result, in sweep order.
+std::vector<PolygonWithHoles> Clip(const std::vector<PolygonWithHoles>& subject,
+                                   const std::vector<PolygonWithHoles>& clip,
+                                   BooleanOp op);
+
+/// \brief Intersects two convex polygons with Sutherland-Hodgman, O(nm).
+/// \param subject A convex polygon.
+/// \param clip A convex polygon.
+/// \return The intersection counter clockwise, empty if it has no area.
+PointCloud ConvexClip(const Polygon& subject, const Polygon& clip);
+
+// /////////////////////////////
+// MARK: Point in polygon
+
+/// \brief Tests if a point is inside a polygon with the winding number, O(n).
+/// \details The polygon may be concave or self-intersecting, a point is
+/// inside if the polygon winds around it (nonzero rule). The decision is
+/// exact, made with Orient2D.
+/// \param polygon The polygon.
+/// \param pt The point.
+/// \return True if pt is inside or on the boundary.
+bool IsInside(const Polygon& polygon, const Point& pt);
+
+/// \brief Point in polygon queries in O(log n) on a slab decomposition.
+/// \details The plane is cut into horizontal slabs at the y coordinates of
+/// the corners. The edges that cross a slab do not cross each other inside
+/// it, so they are stored sorted left to right and a query is two binary
+/// searches: one for the slab and one for the number of edges to the left
+/// of the point. The decisions are exact. Polygons with at most
+/// kSmallPolygon corners are not indexed, they are tested with the winding
+/// number. The slabs take O(n) memory for convex polygons and O(n^2) in the
+/// worst case, a zigzag with many edges across many slabs.
+class PolygonIndex {
+ public:
+  /// Polygons with at most this many corners use the winding number.
+  static constexpr size_t kSmallPolygon{16};
+
+  /// \brief Builds the index in O(n log n + s) for s edges in slabs.
+  /// \param polygon A simple polygon.
+  explicit PolygonIndex(const Polygon& polygon);
+  PolygonIndex() = delete;
+  PolygonIndex(const PolygonIndex& other) = default;
+  PolygonIndex(PolygonIndex&& other) noexcept = default;
+  PolygonIndex& operator=(const PolygonIndex& other) = default;
+  PolygonIndex& operator=(PolygonIndex&& other) noexcept = default;
+  ~PolygonIndex() = default;
+
+  /// \brief Tests if a point is inside the polygon.
+  /// \param pt The point.
+  /// \return True if pt is inside or on the boundary.
+  bool IsInside(const Point& pt) const;
+
+  /// \brief Tests many points, such as positions against a fence.
+  /// \details The points are processed in blocks. Each step of the binary
+  /// searches runs over the whole block without branches and with a plain
+  /// determinant, which the compiler can vectorize. Only the points where a
+  /// determinant is too close to zero to trust are tested again exactly.
+  /// \param points The points.
+  /// \param nbr_threads Number of threads, 0 means hardware concurrency.
+  /// \return 1 for each point inside or on the boundary, 0 outside.
+  std::vector<int> IsInside(const PointCloud& points,
+                            size_t nbr_threads = 0) const;
+
+  /// \brief Returns the number of edges stored in the slabs, a measure of
+  /// the memory used.
+  /// \return Number of edges in slabs.
+  size_t SlabEdgeCount() const;
+
+ private:
+  /// Edge from the lower end a to the upper end b.
+  struct SlabEdge {
+    double ax;
+    double ay;
+    double bx;
+    double by;
+  };
+
+  void Locate(const double* xs, const double* ys, size_t n, int* out) const;
+  bool OnRow(size_t row, double x) const;
+
+  Polygon polygon_;
+  // Distinct corner y coordinates, slab i is [ys_[i], ys_[i + 1]).
+  std::vector<double> ys_;
+  // Edges of slab i are slab_edges_[offsets_[i], offsets_[i + 1]), left to
+  // right. There is one padding edge at the end.
+  std::vector<size_t> offsets_;
+  std::vector<SlabEdge> slab_edges_;
+  // Boundary on row i: disjoint x intervals of the corners and horizontal
+  // edges at ys_[i], as row_xs_[2k] and row_xs_[2k + 1] for k in
+  // [row_offsets_[i], row_offsets_[i + 1]).
+  std::vector<size_t> row_offsets_;
+  std::vector<double> row_xs_;
+  // Number of halvings that find the edge in the largest slab.
+  uint32_t steps_{0};
+};
+
+// /////////////////////////////
+// MARK: Triangulation
+
+/// \brief Triangulates a polygon with holes by ear clipping.
+/// \details The corners are kept in a linked list. Each hole is first joined
+/// to the outer ring by a bridge, found through the edges on rows of y,
+/// then ears, convex corners with no other corner inside their triangle,
+/// are cut off one at a time. For large polygons the corners are also
+/// linked in z-order (Morton order), so an ear is only tested against the
+/// corners that hash into the range of its bounding box. If no ear is left
+/// the ring is cleaned of self-touching corners and at last split along a
+/// diagonal. Close to O(n log n) for most polygons, O(n^2) in the worst
+/// case, such as long spikes. Plain floating point, as in mapbox earcut.
+/// \param polygon The polygon, the holes inside the outer ring and not
+/// overlapping each other.
+/// \return Triangles counter clockwise, as indices of the corners. The
+/// outer ring has the first indices, then the holes in order.
+std::vector<std::array<size_t, 3>> Triangulate(
+    const PolygonWithHoles& polygon);
+
+/// \brief Triangulates a polygon by ear clipping, see above.
+/// \param polygon A simple polygon.
+/// \return Triangles counter clockwise, as indices of the corners.
+std::vector<std::array<size_t, 3>> Triangulate(const Polygon& polygon);
+
+}  // namespace algo::geometry
@@ -17,6 +17,7 @@
 /// 2020-05-13 IsBipartite
 /// 2022-12-17 Refactor to classes.
 /// 2022-12-22 Remove nearest neighbour.
+/// 2026-10-19 Triangle counting and local clustering coefficient.
 ///
 
 #include <cstddef>
@@ -52,6 +53,15 @@ using Edges = std::vector<Edge>;
 using RawGraph = std::vector<std::vector<Connection>>;
 using NodeMat = std::vector<Nodes>;
 using WeightMat = std::vector<Weights>;
+using Counts = std::vector<size_t>;
+
+/// \brief Frozen, compressed adjacency of an undirected graph. The neighbours
+/// of node n are neighbors[offsets[n]] ... neighbors[offsets[n + 1] - 1],
+/// sorted in ascending order and without duplicates.
+struct SortedAdjacency {
+  std::vector<size_t> offsets;
+  Nodes neighbors;
+};
 
 // - MARK: Classes -
 
@@ -157,6 +167,21 @@ class UndirectedGraph : public Graph {
   /// where no edge is connected to a node in the same set.
   /// \return true if bipartite.
   bool IsBipartite() const;
+
+  /// \brief Returns a frozen, sorted snapshot of the adjacency lists. Later
+  /// edge insertions or removals are not reflected in the snapshot.
+  /// \return Sorted adjacency.
+  SortedAdjacency Freeze() const;
+
+  /// \brief Counts the number of triangles each node is part of.
+  /// \param nbr_threads Number of worker threads, 0 means one per core.
+  /// \return Triangle count per node.
+  Counts TriangleCount(size_t nbr_threads = 0) const;
+
+  /// \brief Computes the local clustering coefficient of each node.
+  /// \param nbr_threads Number of worker threads, 0 means one per core.
+  /// \return Clustering coefficient per node, 0.0 for nodes of degree < 2.
+  Weights ClusteringCoefficient(size_t nbr_threads = 0) const;
 };
 
 class DirectedGraph : public Graph {
@@ -305,6 +330,26 @@ class DirectedWeightedGraph : public Graph {
   double MaxFlowEdmondsKarp(size_t source, size_t dest);
 };
 
+// - MARK: Sorted adjacency -
+
+/// \brief Counts the number of triangles each node is part of.
+/// \details Edges are oriented from lower to higher (degree, id) rank and the
+/// triangles are found by merge-intersecting the oriented neighbour lists, so
+/// every triangle is visited exactly once. The total number of triangles in
+/// the graph is the sum of the counts divided by three.
+/// \param adj Sorted adjacency, see UndirectedGraph::Freeze.
+/// \param nbr_threads Number of worker threads, 0 means one per core.
+/// \return Triangle count per node.
+Counts TriangleCount(const SortedAdjacency &adj, size_t nbr_threads = 0);
+
+/// \brief Computes the local clustering coefficient of each node, that is the
+/// number of triangles through the node divided by the number of neighbour
+/// pairs, d(d - 1) / 2.
+/// \param adj Sorted adjacency, see UndirectedGraph::Freeze.
+/// \param nbr_threads Number of worker threads, 0 means one per core.
+/// \return Clustering coefficient per node, 0.0 for nodes of degree < 2.
+Weights ClusteringCoefficient(const SortedAdjacency &adj, size_t nbr_threads = 0);
+
 }// namespace algo::graph
 
 #endif//ALGO_ALGO_INCLUDE_ALGO_GRAPH_HPP_
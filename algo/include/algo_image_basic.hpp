@@ -7,9 +7,13 @@
 /// Change list:
 /// 2016-04-07 Thresholding
 /// 2020-05-21 Integral image.
+/// 2026-10-19 Image views.
+/// 2026-10-19 Instruction sets moved here from algo_image_filter.hpp.
 ///
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #ifndef ALGO_ALGO_INCLUDE_ALGO_IMAGE_BASIC_HPP_
@@ -133,6 +137,62 @@ struct IntegralImage {
   void Set(const int& x, const int& y, const uint32_t& value);
 };
 
+// ////////////////////////////////
+//  Image views
+// ////////////////////////////////
+
+/// \brief Pixels of an image in memory that the view does not own, e.g. a part of an Img or a camera buffer.
+/// \details Row y starts stride elements after row y - 1, so a view of a rectangle of a larger image shares its
+/// memory. A view is only valid as long as that memory is.
+template <typename T>
+struct View {
+  T* data{nullptr};
+  Size size{};
+  int stride{0};// Elements from the start of one row to the next.
+
+  /// \brief Returns the first pixel of row y.
+  [[nodiscard]] T* Row(const int& y) const { return data + static_cast<ptrdiff_t>(y) * stride; }
+
+  /// \brief Returns the value at x, y.
+  [[nodiscard]] T& At(const int& x, const int& y) const { return Row(y)[x]; }
+
+  [[nodiscard]] bool Empty() const { return data == nullptr || size.rows <= 0 || size.cols <= 0; }
+
+  /// \brief Returns the view of the rectangle rect of this view, without copying.
+  /// \return The sub-view, empty if rect is not inside of the view.
+  [[nodiscard]] View Roi(const Rectangle& rect) const
+  {
+    if (rect.x < 0 || rect.y < 0 || rect.width <= 0 || rect.height <= 0 || rect.x + rect.width > size.cols
+        || rect.y + rect.height > size.rows) {
+      return View{};
+    }
+    return View{Row(rect.y) + rect.x, Size{rect.height, rect.width}, stride};
+  }
+
+  /// A view can always be read only.
+  operator View<const T>() const { return View<const T>{data, size, stride}; }
+};
+
+using ImgView = View<uint8_t>;
+using ConstImgView = View<const uint8_t>;
+using ImgViewF = View<float>;
+using ConstImgViewF = View<const float>;
+
+// ////////////////////////////////
+//  Instruction sets
+// ////////////////////////////////
+
+/// \brief Instruction sets for the vectorized row kernels, narrowest first.
+enum class Simd {
+  SCALAR,/// One pixel at a time.
+  SSE2,  /// 128-bit vectors, e.g. 8 pixels in 16 bits.
+  AVX2,  /// 256-bit vectors, e.g. 16 pixels in 16 bits.
+};
+
+/// \brief Returns the widest instruction set this CPU supports, detected at the first call.
+/// \return SCALAR on other CPUs than x86.
+Simd DetectedSimd();
+
 // //////////////////////////////////////////
 //  Fundamental functions
 // //////////////////////////////////////////
@@ -144,7 +204,7 @@ struct IntegralImage {
 Img NewImgGray(const int& rows, const int& cols);
 
 /// \brief Converts a color image to a gray scale image.
-/// \details `gray = 0.3 * red + 0.59 * green + 0.11 * blue`.
+/// \details `gray = 0.3 * red + 0.59 * green + 0.11 * blue`, in fixed point, see ToGray in algo_image_color.hpp.
 /// \param img3 Values to convert.
 /// \return A new gray scale image.
 Img ToGray(const Img3& img3);
@@ -179,6 +239,18 @@ Img MaxOf(const Img& im1, const Img& im2);
 /// \return The subtracted result.
 Img Subtract(const Img& im1, const Img& im2);
 
+/// \brief Returns a view of all of im.
+ImgView ViewOf(Img& im);
+ConstImgView ViewOf(const Img& im);
+ImgViewF ViewOf(ImgF& im);
+ConstImgViewF ViewOf(const ImgF& im);
+
+/// \brief Copies the pixels of a view into a new image with packed rows.
+/// \param view The view.
+/// \return A new image, empty if the view is empty.
+Img FromView(const ConstImgView& view);
+ImgF FromViewF(const ConstImgViewF& view);
+
 // //////////////////////////////////////////
 //  Integral image
 // //////////////////////////////////////////
@@ -189,6 +261,9 @@ Img Subtract(const Img& im1, const Img& im2);
 /// \link <a href="https://en.wikipedia.org/wiki/Summed-area_table">Summed-area-table, Wikipedia.</a>
 IntegralImage ImgToIntegralImage(const Img& im);
 
+/// \brief Computes the integral image of the view im, e.g. a region of an image.
+IntegralImage ImgToIntegralImage(const ConstImgView& im);
+
 /// \brief Computes the sum of the rectangular patch.
 /// \param img The input integral image.
 /// \param pt_tl Point 1, top left.
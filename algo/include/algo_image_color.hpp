@@ -0,0 +1,151 @@
+///
+/// \brief Header for color image layouts and color conversions.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+/// Change list:
+/// 2026-10-19 Interleaved images, planar and interleaved views, gray and YUV conversions.
+///
+
+#ifndef ALGO_ALGO_INCLUDE_ALGO_IMAGE_COLOR_HPP_
+#define ALGO_ALGO_INCLUDE_ALGO_IMAGE_COLOR_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "algo_image_basic.hpp"
+
+namespace algo::image {
+
+// //////////////////////////////////////////
+//  Interleaved images
+// //////////////////////////////////////////
+
+/// \brief The order of the channels of an interleaved pixel.
+enum class PixelFormat {
+  RGB, /// 3 bytes per pixel.
+  BGR, /// 3 bytes per pixel.
+  RGBA,/// 4 bytes per pixel, the alpha is ignored when read and 255 when written.
+  BGRA,/// 4 bytes per pixel.
+};
+
+/// \brief Returns the number of bytes of a pixel in format.
+int BytesPerPixel(const PixelFormat& format);
+
+/// \brief A color image with the channels of a pixel next to each other, as from most cameras and decoders.
+struct ImgInterleaved {
+  Data8 data;
+  Size size{};
+  PixelFormat format{PixelFormat::RGB};
+};
+
+// //////////////////////////////////////////
+//  Color views
+// //////////////////////////////////////////
+
+/// \brief Color pixels that the view does not own, in three planes as Img3 or interleaved.
+/// \details The channel c of the pixel x, y is data[c][y * stride + x * step]. Planes have step 1, interleaved
+/// pixels step 3 or 4 with the three channels pointing into the same pixel.
+struct Img3View {
+  std::array<const uint8_t*, 3> data{};// Red, Green and Blue.
+  Size size{};
+  int stride{0};// Bytes from the start of one row to the next.
+  int step{1};  // Bytes from one pixel to the next.
+
+  /// \brief Returns the first value of channel c in row y.
+  [[nodiscard]] const uint8_t* Row(const int& c, const int& y) const
+  {
+    return data[c] + static_cast<ptrdiff_t>(y) * stride;
+  }
+
+  /// \brief Returns the value of channel c at x, y.
+  [[nodiscard]] uint8_t At(const int& c, const int& x, const int& y) const { return Row(c, y)[x * step]; }
+
+  [[nodiscard]] bool Empty() const;
+
+  /// \brief Returns the view of the rectangle rect of this view, without copying.
+  /// \return The sub-view, empty if rect is not inside of the view.
+  [[nodiscard]] Img3View Roi(const Rectangle& rect) const;
+};
+
+/// \brief Returns a view of all of im.
+/// \return An empty view if a plane is smaller than the image.
+Img3View ViewOf(const Img3& im);
+Img3View ViewOf(const ImgInterleaved& im);
+
+/// \brief Returns a view of interleaved pixels in memory owned by someone else, e.g. a camera frame.
+/// \param data The first pixel.
+/// \param size The size of the image.
+/// \param format The order of the channels.
+/// \param stride Bytes from the start of one row to the next, 0 for rows without padding.
+Img3View InterleavedView(const uint8_t* data, const Size& size, const PixelFormat& format, const int& stride = 0);
+
+// //////////////////////////////////////////
+//  Layout conversions
+// //////////////////////////////////////////
+
+/// \brief Copies a color view into the three planes of an Img3.
+/// \return A new image, empty if im is empty.
+Img3 ToPlanar(const Img3View& im, Simd simd = DetectedSimd());
+
+/// \brief Copies a color view into an interleaved image.
+/// \return A new image, empty if im is empty.
+ImgInterleaved ToInterleaved(const Img3View& im, const PixelFormat& format, Simd simd = DetectedSimd());
+
+/// \brief Converts a color view of either layout to gray, without making planes of it first.
+/// \details `gray = (4915 * red + 9667 * green + 1802 * blue) >> 14`, the weights 0.3, 0.59 and 0.11 in 14 bits.
+/// Planes and interleaved pixels of 3 and 4 bytes run 16 pixels per AVX2 vector and 8 per SSE2 vector, except
+/// 3 byte pixels which need AVX2. All instruction sets give the same image.
+/// \return A new image, empty if im is empty.
+Img ToGray(const Img3View& im, Simd simd = DetectedSimd());
+
+/// \brief Converts im to gray into the view out, as ToGray.
+/// \return False, and nothing written, if im is empty or out has another size.
+bool ToGray(const Img3View& im, const ImgView& out, Simd simd = DetectedSimd());
+
+// //////////////////////////////////////////
+//  YUV
+// //////////////////////////////////////////
+
+/// \brief The range of the values of YUV pixels, both with the BT.601 colors.
+enum class YuvRange {
+  VIDEO,/// Y in 16-235 and U, V in 16-240, as from most video decoders.
+  FULL, /// All in 0-255, as JPEG and many cameras.
+};
+
+/// \brief YUV 4:2:0 pixels that the view does not own, one U and V value for each 2x2 pixels.
+/// \details The chroma value of the pixel x, y is u[(y / 2) * uv_stride + (x / 2) * uv_step], the same for v. I420
+/// has separate U and V planes, uv_step 1. NV12 has one plane with U and V after each other, uv_step 2, and NV21 is
+/// NV12 with u and v swapped.
+struct YuvView {
+  const uint8_t* y{nullptr};
+  const uint8_t* u{nullptr};
+  const uint8_t* v{nullptr};
+  Size size{};
+  int y_stride{0};
+  int uv_stride{0};
+  int uv_step{1};
+  YuvRange range{YuvRange::VIDEO};
+};
+
+/// \brief Returns a view of an I420 buffer, the Y plane followed by the U and the V planes, without padding.
+YuvView I420View(const uint8_t* data, const Size& size, const YuvRange& range = YuvRange::VIDEO);
+
+/// \brief Returns a view of an NV12 buffer, the Y plane followed by the interleaved U and V plane, without padding.
+YuvView Nv12View(const uint8_t* data, const Size& size, const YuvRange& range = YuvRange::VIDEO);
+
+/// \brief Converts YUV 4:2:0 pixels to RGB, with the BT.601 weights in 14-bit fixed point.
+/// \details 16 pixels per AVX2 vector and 8 per SSE2 vector, all instruction sets give the same image.
+/// \return A new image, empty if im is empty.
+/// \link <a href="https://en.wikipedia.org/wiki/YCbCr#ITU-R_BT.601_conversion">YCbCr, Wikipedia.</a>
+Img3 YuvToRgb(const YuvView& im, Simd simd = DetectedSimd());
+
+/// \brief Returns the luma of YUV pixels as a gray image, stretched to 0-255 for YuvRange::VIDEO.
+/// \return A new image, empty if im is empty.
+Img YuvToGray(const YuvView& im, Simd simd = DetectedSimd());
+
+}// namespace algo::image
+
+#endif//ALGO_ALGO_INCLUDE_ALGO_IMAGE_COLOR_HPP_
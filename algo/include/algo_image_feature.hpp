@@ -7,12 +7,15 @@
 /// Change list:
 /// 2020-05-19 Hough lines transform
 /// 2020-05-26 Hough circles transform
+/// 2026-10-19 FAST corners, corners and SIFT keypoints on image views
+/// 2026-10-19 SIFT keypoints and corners on a shared Pyramid
 ///
 
 #ifndef ALGO_ALGO_INCLUDE_ALGO_IMAGE_FEATURE_HPP_
 #define ALGO_ALGO_INCLUDE_ALGO_IMAGE_FEATURE_HPP_
 
 #include "algo_image_basic.hpp"
+#include "algo_image_pyramid.hpp"
 
 namespace algo::image::feature {
 
@@ -50,6 +53,17 @@ Points Corners(const Img& im, const int& threshold, const CornerDetType& det_typ
                const int& n_best = 0, const int& min_dist = 0,
                const GaussWindowSettings& g_win_set = {Size{7, 7}, 1.0});
 
+/// \brief Finds the corners of the view im, e.g. a region of an image, as Corners, in the coordinates of the view.
+Points Corners(const ConstImgView& im, const int& threshold, const CornerDetType& det_type = CornerDetType::kHarris,
+               const int& n_best = 0, const int& min_dist = 0,
+               const GaussWindowSettings& g_win_set = {Size{7, 7}, 1.0});
+
+/// \brief Finds the corners of octave of the pyramid pyr, as Corners, with the first Gaussian level of the octave
+/// instead of the Gaussian window.
+/// \return Corners, in the pixels of the input image. min_dist is in the pixels of the octave.
+Points Corners(const Pyramid& pyr, const int& octave, const int& threshold,
+               const CornerDetType& det_type = CornerDetType::kHarris, const int& n_best = 0, const int& min_dist = 0);
+
 // //////////////////////////////////////////
 //  FAST Corner
 // //////////////////////////////////////////
@@ -62,6 +76,9 @@ Points Corners(const Img& im, const int& threshold, const CornerDetType& det_typ
 /// \link <a href="https://en.wikipedia.org/wiki/Features_from_accelerated_segment_test">FAST, Wikipedia.</a>
 Points FASTCorners(const Img& im, const int& intensity_threshold, const int& corner_threshold = 11);
 
+/// \brief Returns the FAST corners of the view im, e.g. a region of an image, in the coordinates of the view.
+Points FASTCorners(const ConstImgView& im, const int& intensity_threshold, const int& corner_threshold = 11);
+
 // //////////////////////////////////////////
 //  SIFT Keypoints
 // //////////////////////////////////////////
@@ -78,9 +95,10 @@ struct Keypoint {
 using Keypoints = std::vector<Keypoint>;
 
 /// \brief Retuns a list of SIFT keypoints, where each keypoint has a (x,y)-coordinate, radius and angle.
+/// \details Builds a Pyramid of img with nbr_gaussians - 3 scales and finds the keypoints in it.
 /// \param img Input image.
 /// \param nbr_gaussians The number of gaussians in each octave-layer, 5 recommended.
-/// \param nbr_octaves The number of octaves in DoG-pyramid, |DoG| = nbr_octaves * nbr_gaussians - 1, 5 recommended.
+/// \param nbr_octaves The number of octaves in DoG-pyramid, each half the size of the one before, 5 recommended.
 /// \param contrast_offset The contrast threshold that will discard keypoints at locations with lower value.
 /// \param edge_threshold The edge threshold that will discard keypoints at edges with lower value.
 /// \return The SIFT-keypoints [{x, y, radius, angle},...].
@@ -89,9 +107,17 @@ using Keypoints = std::vector<Keypoint>;
 /// \link <a href="https://en.wikipedia.org/wiki/Scale-invariant_feature_transform">SIFT, Wikipedia.</a>
 /// \link <a href="https://www.cs.ubc.ca/~lowe/papers/iccv99.pdf">Lowe 1999.</a>
 /// \todo Add code for computing the descriptors.
-/// \todo Unit test.
 Keypoints SiftKeypoints(const Img& img, const int& nbr_gaussians = 5, const int& nbr_octaves = 5, const float& contrast_offset = 1.7, const float& edge_threshold = 20.0);
 
+/// \brief Returns the SIFT keypoints of the view im, e.g. a region of an image, as SiftKeypoints, in the coordinates of
+/// the view.
+Keypoints SiftKeypoints(const ConstImgView& im, const int& nbr_gaussians = 5, const int& nbr_octaves = 5,
+                        const float& contrast_offset = 1.7, const float& edge_threshold = 20.0);
+
+/// \brief Returns the SIFT keypoints of the Laplacian levels of pyr, in the pixels of the input image.
+/// \details The extrema are searched in the Laplacian levels 1 to Scales() of every octave.
+Keypoints SiftKeypoints(const Pyramid& pyr, const float& contrast_offset = 1.7, const float& edge_threshold = 20.0);
+
 }// namespace algo::image::feature
 
 #endif//ALGO_ALGO_INCLUDE_ALGO_IMAGE_FEATURE_HPP_
@@ -7,12 +7,19 @@
 /// Change list:
 /// 2016-04-04 Convolve
 /// 2016-04-08 Median filter
+/// 2026-10-19 SSE2 and AVX2 row kernels for Convolve and Convolve3
+/// 2026-10-19 Separable filters and a recursive Gaussian blur
+/// 2026-10-19 Constant time median filter
+/// 2026-10-19 Filters on image views
+/// 2026-10-19 Convolve3 and MedianFilter3 on interleaved color views
+/// 2026-10-19 Recursive Gaussian blur in place on a view
 ///
 
 #ifndef ALGO_ALGO_INCLUDE_ALGO_IMAGE_FILTER_HPP_
 #define ALGO_ALGO_INCLUDE_ALGO_IMAGE_FILTER_HPP_
 
 #include "algo_image_basic.hpp"
+#include "algo_image_color.hpp"
 
 namespace algo::image::filter {
 
@@ -42,54 +49,138 @@ enum class KernelType {
 //  Convolutions
 // //////////////////////////////////////////
 
+// The instruction sets are shared with the color conversions, see algo_image_basic.hpp.
+using image::DetectedSimd;
+using image::Simd;
+
 /// \brief Performs the mathematical convolve operation with a chosen filter.
+/// \details The kernels with weights k / 2^s, for integers k and s <= 4, run in 16-bit integer arithmetic, the others
+/// in float. All instruction sets give the same result. The border pixels are 0.
 /// \param im Image to convolve.
 /// \param filter_type The filter to use, see FilterType.
+/// \param simd The widest instruction set to use, at most DetectedSimd().
 /// \return A grayscale image.
-Img Convolve(const Img& im, KernelType filter_type);
+Img Convolve(const Img& im, KernelType filter_type, Simd simd = DetectedSimd());
+
+/// \brief Convolves the view im into the view out, as Convolve. No image is allocated.
+/// \param im The pixels to convolve, e.g. a region of an image.
+/// \param out Where the result is written, of the same size as im and not overlapping it.
+/// \return False, and nothing written, if im is empty or out has another size.
+bool Convolve(const ConstImgView& im, const ImgView& out, KernelType filter_type, Simd simd = DetectedSimd());
 
 /// \brief Performs convolution of color images.
 /// \param im The image.
 /// \param filter_type The filter to use, see Filtertype.
+/// \param simd The widest instruction set to use, at most DetectedSimd().
 /// \return A new color image.
-Img3 Convolve3(const Img3& im, KernelType filter_type);
+Img3 Convolve3(const Img3& im, KernelType filter_type, Simd simd = DetectedSimd());
+
+/// \brief Convolves the channels of a color view of either layout, as Convolve3.
+/// \details Planes are read where they are, interleaved rows are gathered three at a time as the kernel reaches them.
+/// \return A new color image, empty if im is empty.
+Img3 Convolve3(const Img3View& im, KernelType filter_type, Simd simd = DetectedSimd());
+
+// //////////////////////////////////////////
+//  Separable filters
+// //////////////////////////////////////////
+
+/// \brief Convolves im with the kernel that is the outer product of kernel_y and kernel_x.
+/// \details The rows are convolved with kernel_x into a float image, and its columns with kernel_y. That is
+/// w + h multiplications per pixel instead of w * h. The pixels closer to the border than half a kernel are 0.
+/// \param im Input image.
+/// \param kernel_x Weights along x, an odd number less than the image width.
+/// \param kernel_y Weights along y, an odd number less than the image height.
+/// \return The filtered image, rounded to the nearest value for Img. Empty if a kernel has the wrong size.
+Img SeparableFilter(const Img& im, const Dataf& kernel_x, const Dataf& kernel_y);
+
+ImgF SeparableFilter(const ImgF& im, const Dataf& kernel_x, const Dataf& kernel_y);
+
+/// \brief Filters the view im into the view out, of the same size and not overlapping im, as SeparableFilter.
+/// \return False, and nothing written, if im is empty, out has another size or a kernel has the wrong size.
+bool SeparableFilter(const ConstImgView& im, const ImgView& out, const Dataf& kernel_x, const Dataf& kernel_y);
+
+bool SeparableFilter(const ConstImgViewF& im, const ImgViewF& out, const Dataf& kernel_x, const Dataf& kernel_y);
+
+/// \brief Returns the mean over a window around each pixel, see SeparableFilter.
+/// \param im Input image.
+/// \param size The window size, odd and smaller than the image.
+/// \return Box blurred im, empty if the size is wrong.
+Img BoxBlur(const Img& im, const Size& size);
+
+bool BoxBlur(const ConstImgView& im, const ImgView& out, const Size& size);
 
 // //////////////////////////////////////////
 //  Gaussian blur
 // //////////////////////////////////////////
 
 /// \brief Returns the Gaussian blurred image of im.
+/// \details Runs as a SeparableFilter, with a Gaussian along x and along y.
 /// \param im Input image.
-/// \param size The size of the Gaussian kernel.
+/// \param size The size of the Gaussian kernel, odd and smaller than the image.
 /// \param sigma The standard deviation of the Gaussian kernel.
-/// \return Gaussian blurred im.
+/// \return Gaussian blurred im, empty if the size is wrong.
 /// \link <a href="https://en.wikipedia.org/wiki/Gaussian_blur">Gaussian blur, Wikipedia.</a>
 Img GaussianBlur(const Img& im, const Size& size, const float& sigma);
 
 ImgF GaussianBlurF(const ImgF& im, const Size& size, const float& sigma);
 
+/// \brief Blurs the view im into the view out, of the same size and not overlapping im, as GaussianBlur.
+/// \return False, and nothing written, if im is empty, out has another size or the size is wrong.
+bool GaussianBlur(const ConstImgView& im, const ImgView& out, const Size& size, const float& sigma);
+
+bool GaussianBlurF(const ConstImgViewF& im, const ImgViewF& out, const Size& size, const float& sigma);
+
 Img GaussBlur(const Img& im, const Size& size, const float& sigma);
 
+/// \brief Returns the Gaussian blurred image of im, with the recursive filter of Young, van Vliet and van Ginkel.
+/// \details A third order filter runs forward and backward along the rows and then the columns. The cost per pixel is
+/// the same for every sigma, and there is no window. The pixels outside of the image are taken to be the nearest
+/// border pixel, so the borders are blurred too. The response has the right sigma, its shape is within a few percent
+/// of a Gaussian.
+/// \param im Input image.
+/// \param sigma The standard deviation, at least 0.5.
+/// \return Gaussian blurred im, empty if sigma is too small.
+/// \link <a href="https://doi.org/10.1109/TSP.2002.804095">Young, van Vliet, van Ginkel. Recursive Gabor filtering,
+/// 2002.</a>
+Img RecursiveGaussianBlur(const Img& im, const float& sigma);
+
+ImgF RecursiveGaussianBlurF(const ImgF& im, const float& sigma);
+
+/// \brief Blurs the view im in place, as RecursiveGaussianBlurF.
+/// \return False, and nothing written, if im is empty or sigma is too small.
+bool RecursiveGaussianBlurF(const ImgViewF& im, const float& sigma);
+
 // //////////////////////////////////////////
 //  Median filters
 // //////////////////////////////////////////
 
 /// \brief Filters the input image with a median filter.
-/// \details This filter will remove noise.
+/// \details This filter will remove noise. 3x3 and 5x5 windows run through sorting networks, other sizes through
+/// histograms in constant time per pixel. The pixels closer to the border than the window reaches are 0. For an even
+/// number of pixels in the window, the larger of the two middle values is taken.
 /// \param im The input image.
 /// \param w_size The window size of the filter.
 /// \return New median filtered image of im.
 /// \link <a href="https://en.wikipedia.org/wiki/Median_filter">Median filter, Wikipedia.</a>
 Img MedianFilter(const Img& im, const Size& w_size);
 
+/// \brief Filters the view im into the view out, of the same size and not overlapping im, as MedianFilter.
+/// \return False, and nothing written, if im is empty, out has another size or the window does not fit.
+bool MedianFilter(const ConstImgView& im, const ImgView& out, const Size& w_size);
+
 /// \brief Filters a color image with a median filter.
 /// \note The result will become blurry for too large windows. Very noisy images will look better.
+/// \details The three channels are filtered in parallel, each as in MedianFilter.
 /// \param im Input color image.
 /// \param The window size of the filter.
 /// \return A new median filtered image of im.
 /// \link <a href="https://en.wikipedia.org/wiki/Median_filter">Median filter, Wikipedia.</a>
 Img3 MedianFilter3(const Img3& im, const Size& w_size);
 
+/// \brief Filters the channels of a color view of either layout, as MedianFilter3.
+/// \details Both layouts are read where they are, the pixels of a channel step apart.
+Img3 MedianFilter3(const Img3View& im, const Size& w_size);
+
 // //////////////////////////////////////////
 //  Thresholding
 // //////////////////////////////////////////
@@ -103,6 +194,10 @@ namespace threshold {
 /// \return A new image.
 Img Fixed(const Img& im, const uint8_t& threshold, const bool& cut_white);
 
+/// \brief Thresholds the view im into the view out, as Fixed. out may be im, to threshold in place.
+/// \return False, and nothing written, if out has another size than im.
+bool Fixed(const ConstImgView& im, const ImgView& out, const uint8_t& threshold, const bool& cut_white);
+
 /// \brief Computes the adaptive threshold of the input image. The thresholding decision is based on the mean value of the
 /// chose region size, e.g. 10x10 pixels (region_size^2).
 /// \param im Input image.
@@ -111,6 +206,10 @@ Img Fixed(const Img& im, const uint8_t& threshold, const bool& cut_white);
 /// \return A new image.
 Img Adaptive(const Img& im, const int& region_size, const bool& cut_white);
 
+/// \brief Thresholds the view im into the view out, as Adaptive. out may be im, to threshold in place.
+/// \return False, and nothing written, if im is empty, out has another size or the region does not fit in im.
+bool Adaptive(const ConstImgView& im, const ImgView& out, const int& region_size, const bool& cut_white);
+
 }// namespace threshold
 
 }// namespace algo::image::filter
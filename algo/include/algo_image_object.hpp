@@ -8,12 +8,15 @@
 /// 2020-05-23 Canny edge
 /// 2020-05-24 Hough line
 /// 2020-05-27 Corners.
+/// 2026-10-19 Canny edges on image views
+/// 2026-10-19 Canny edges on a shared Pyramid
 ///
 
 #ifndef ALGO_ALGO_INCLUDE_ALGO_IMAGE_OBJECT_HPP_
 #define ALGO_ALGO_INCLUDE_ALGO_IMAGE_OBJECT_HPP_
 
 #include "algo_image_basic.hpp"
+#include "algo_image_pyramid.hpp"
 
 namespace algo::image::object {
 
@@ -27,6 +30,17 @@ namespace algo::image::object {
 /// \link <a href="https://en.wikipedia.org/wiki/Canny_edge_detector">Canny edge detector, Wikipedia.</a>
 Img ExtractCannyEdges(const Img& im, const int& threshold_min = 31, const int& threshold_max = 91);
 
+/// \brief Detects the edges of the view im, e.g. a region of an image, into the view out, as ExtractCannyEdges.
+/// out may be im.
+/// \return False, and nothing written, if im is empty or out has another size.
+bool ExtractCannyEdges(const ConstImgView& im, const ImgView& out, const int& threshold_min = 31,
+                       const int& threshold_max = 91);
+
+/// \brief Detects the edges of octave of the pyramid pyr, with its first Gaussian level instead of the 3x3 blur.
+/// \return Detected edges in a new image of the size of the octave, empty if there is no such octave.
+Img ExtractCannyEdges(const Pyramid& pyr, const int& octave, const int& threshold_min = 31,
+                      const int& threshold_max = 91);
+
 // //////////////////////////////////////////
 //  Hough lines
 // //////////////////////////////////////////
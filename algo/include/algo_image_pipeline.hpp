@@ -0,0 +1,104 @@
+///
+/// \brief Header for chains of image operations run band by band.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#ifndef ALGO_ALGO_INCLUDE_ALGO_IMAGE_PIPELINE_HPP_
+#define ALGO_ALGO_INCLUDE_ALGO_IMAGE_PIPELINE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "algo_image_basic.hpp"
+#include "algo_image_color.hpp"
+#include "algo_image_filter.hpp"
+#include "algo_image_tile.hpp"
+
+namespace algo::image {
+
+// //////////////////////////////////////////
+//  Pipeline
+// //////////////////////////////////////////
+
+/// A point-wise operation, the new value of every pixel value.
+using Lut = std::array<uint8_t, 256>;
+
+/// \brief A chain of image operations that is recorded first and run later, band by band.
+/// \details Run does not make an image for every operation. It takes a band of rows small enough to stay in the
+/// cache, together with the rows around it that the operations read, runs the whole chain on it and keeps the rows
+/// of the band. Point-wise operations that follow each other are made into one table, and the ones before the first
+/// window operation are applied while the band is read from the input. Only the output is a full image. It is the
+/// same image as running the operations one at a time on the whole input.
+///
+/// Pipeline p;
+/// p.GaussianBlur(Size{5, 5}, 1.0F).Convolve(filter::KernelType::SOBEL_X).Fixed(40, true);
+/// Img edges{p.Run(im3)};
+class Pipeline {
+ public:
+  /// \brief Adds filter::Convolve.
+  Pipeline& Convolve(const filter::KernelType& kernel_type);
+
+  /// \brief Adds filter::GaussianBlur.
+  Pipeline& GaussianBlur(const Size& size, const float& sigma);
+
+  /// \brief Adds filter::MedianFilter.
+  Pipeline& MedianFilter(const Size& w_size);
+
+  /// \brief Adds filter::threshold::Adaptive.
+  Pipeline& Adaptive(const int& region_size, const bool& cut_white);
+
+  /// \brief Adds filter::threshold::Fixed.
+  Pipeline& Fixed(const uint8_t& threshold, const bool& cut_white);
+
+  /// \brief Adds InvertPixels.
+  Pipeline& Invert();
+
+  /// \brief Adds a point-wise operation, pixel value v becomes lut[v].
+  Pipeline& Map(const Lut& lut);
+
+  /// \brief Adds an operation on the whole image, where an output pixel depends on the input at most halo rows away.
+  /// \see tile::Run
+  Pipeline& Window(const tile::Operation& op, const int& halo);
+
+  /// \brief The number of rows above and below a band that the operations read together.
+  [[nodiscard]] int Halo() const;
+
+  /// \brief Runs the operations on im.
+  /// \param im The input image.
+  /// \param nbr_threads The number of threads, 0 for one per core.
+  /// \param band_rows The number of rows of a band, 0 to fit a band in the cache.
+  /// \return The output image, empty if im is empty or an operation returns an empty image.
+  [[nodiscard]] Img Run(const Img& im, const size_t& nbr_threads = 0, const int& band_rows = 0) const;
+
+  /// \brief Converts im as ToGray and runs the operations on it, without making the gray image.
+  [[nodiscard]] Img Run(const Img3& im, const size_t& nbr_threads = 0, const int& band_rows = 0) const;
+
+  /// \brief Converts a color view of either layout, e.g. an interleaved camera frame, as ToGray band by band and runs
+  /// the operations on it.
+  [[nodiscard]] Img Run(const Img3View& im, const size_t& nbr_threads = 0, const int& band_rows = 0) const;
+
+ private:
+  /// Writes the gray rows [top, bottom) of the input to dst.
+  using Reader = std::function<void(const int& top, const int& bottom, uint8_t* dst)>;
+
+  struct Stage {
+    tile::Operation op;// Empty for a point-wise stage.
+    int halo;
+    Lut lut;
+  };
+
+  /// \brief Runs the stages on bands read from an input of size.
+  [[nodiscard]] Img RunBands(const Size& size, const Reader& read, const size_t& nbr_threads,
+                             const int& band_rows) const;
+
+  std::vector<Stage> stages_;
+};
+
+}// namespace algo::image
+
+#endif//ALGO_ALGO_INCLUDE_ALGO_IMAGE_PIPELINE_HPP_
@@ -0,0 +1,101 @@
+///
+/// \brief Header for Gaussian and Laplacian image pyramids.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#ifndef ALGO_ALGO_INCLUDE_ALGO_IMAGE_PYRAMID_HPP_
+#define ALGO_ALGO_INCLUDE_ALGO_IMAGE_PYRAMID_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "algo_image_basic.hpp"
+
+namespace algo::image {
+
+// //////////////////////////////////////////
+//  Pyramid
+// //////////////////////////////////////////
+
+/// \brief The Gaussian scale space of an image, in octaves of half the size of the one before.
+/// \details An octave has nbr_scales + 3 Gaussian levels, level l blurred with sigma * 2^(l / nbr_scales) in the
+/// pixels of the octave, and nbr_scales + 2 Laplacian levels, Laplacian(o, l) = Gaussian(o, l + 1) - Gaussian(o, l).
+/// Every level is blurred from the one before with the small sigma that is missing, and the first level of an octave
+/// is every second pixel of level nbr_scales of the octave before, which has twice the sigma. All levels are floats in
+/// one buffer, made once in the constructor, so that SIFT, Canny and corner detection on the same frame share them.
+///
+/// const Pyramid pyr{frame, 4};
+/// Keypoints keypoints{feature::SiftKeypoints(pyr)};
+/// Img edges{object::ExtractCannyEdges(pyr, 1)};
+/// \link <a href="https://www.cs.ubc.ca/~lowe/papers/ijcv04.pdf">Lowe, Distinctive image features from
+/// scale-invariant keypoints, 2004.</a>
+class Pyramid {
+ public:
+  Pyramid() = default;
+
+  /// \brief Builds the pyramid of im.
+  /// \param im The input image.
+  /// \param nbr_octaves The number of octaves, fewer if the smallest side would be below kMinSide.
+  /// \param nbr_scales The number of levels per doubling of sigma. The smallest blur from one level to the next,
+  /// sigma * sqrt(2^(2 / nbr_scales) - 1), must be at least 0.5, which is at most 14 scales for sigma 1.6.
+  /// \param sigma The sigma of the first level of every octave.
+  /// \param input_sigma The blur that im already has, e.g. 0.5 from the camera.
+  /// The pyramid is empty if im is empty or smaller than kMinSide, or if a parameter is out of range, also when
+  /// nbr_scales is too large for sigma.
+  Pyramid(const Img& im, const int& nbr_octaves, const int& nbr_scales = 3, const float& sigma = 1.6F,
+          const float& input_sigma = 0.5F);
+
+  /// \brief Builds the pyramid of the view im, e.g. a region of an image, as the constructor above.
+  Pyramid(const ConstImgView& im, const int& nbr_octaves, const int& nbr_scales = 3, const float& sigma = 1.6F,
+          const float& input_sigma = 0.5F);
+
+  /// The smallest side of an octave.
+  static constexpr int kMinSide{16};
+
+  [[nodiscard]] bool Empty() const { return octaves_.empty(); }
+
+  [[nodiscard]] int Octaves() const { return static_cast<int>(octaves_.size()); }
+
+  /// \brief The number of Gaussian levels of an octave, nbr_scales + 3.
+  [[nodiscard]] int Levels() const { return nbr_scales_ + 3; }
+
+  [[nodiscard]] int Scales() const { return nbr_scales_; }
+
+  /// \brief The size of the levels of octave o.
+  [[nodiscard]] Size SizeOf(const int& o) const;
+
+  /// \brief The sigma of level l of octave o, in the pixels of the input image.
+  [[nodiscard]] float Sigma(const int& o, const int& l) const;
+
+  /// \brief Returns level l of octave o, with the values of the input image, 0-255.
+  /// \return The level, an empty view if there is no such level. The same goes for Laplacian.
+  [[nodiscard]] ConstImgViewF Gaussian(const int& o, const int& l) const;
+
+  /// \brief Returns the difference of the Gaussian levels l + 1 and l of octave o.
+  [[nodiscard]] ConstImgViewF Laplacian(const int& o, const int& l) const;
+
+  /// \brief Returns the first Gaussian level of octave o rounded to 8 bits, for the filters that take an Img.
+  [[nodiscard]] const Img& Smoothed(const int& o) const;
+
+ private:
+  struct Octave {
+    Size size;
+    size_t offset;// Of the first Gaussian level in data_.
+  };
+
+  /// \brief The level l of octave o, Gaussian levels first and then the Laplacian levels.
+  [[nodiscard]] float* LevelData(const int& o, const int& l);
+  [[nodiscard]] const float* LevelData(const int& o, const int& l) const;
+
+  int nbr_scales_{0};
+  float sigma_{0.0F};
+  std::vector<Octave> octaves_;
+  Dataf data_;
+  std::vector<Img> smoothed_;
+};
+
+}// namespace algo::image
+
+#endif//ALGO_ALGO_INCLUDE_ALGO_IMAGE_PYRAMID_HPP_
@@ -0,0 +1,68 @@
+///
+/// \brief Header for running image operations on row bands in parallel.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#ifndef ALGO_ALGO_INCLUDE_ALGO_IMAGE_TILE_HPP_
+#define ALGO_ALGO_INCLUDE_ALGO_IMAGE_TILE_HPP_
+
+#include <cstddef>
+#include <functional>
+
+#include "algo_image_basic.hpp"
+
+namespace algo::image::tile {
+
+// //////////////////////////////////////////
+//  Band execution
+// //////////////////////////////////////////
+
+/// \brief A band of rows of an image, the rows [first, first + rows) with the rows [top, bottom) around them that are
+/// read to compute them.
+struct Band {
+  int first;
+  int rows;
+  int top;
+  int bottom;
+};
+
+/// \brief Calls func for each band of rows of an image with rows rows, on several threads.
+/// \details The bands are taken by the threads as they become free. An exception thrown by func stops the threads
+/// from taking more bands and is thrown again when they are done.
+/// \param rows The number of rows of the image.
+/// \param halo The number of rows above and below a band that are read with it.
+/// \param func Called once for every band.
+/// \param nbr_threads The number of threads, 0 for one per core.
+/// \param band_rows The number of rows of a band, 0 to pick it from rows and the number of threads. Bands have at
+/// least 2 * halo + 1 rows.
+void ForEachBand(const int& rows, const int& halo, const std::function<void(const Band&)>& func,
+                 const size_t& nbr_threads = 0, const int& band_rows = 0);
+
+/// An operation on a whole image that returns an image of the same size, e.g. a filter.
+using Operation = std::function<Img(const Img&)>;
+using OperationF = std::function<ImgF(const ImgF&)>;
+
+/// \brief Runs op on bands of rows of im on several threads and stitches the results into one image.
+/// \details Each band is given halo rows of the image above and below it as context, op is run on the band and its
+/// halo, and only the rows of the band are kept. The result equals op(im) for any op where an output pixel depends
+/// on the input pixels at most halo rows away, and which treats the first and last rows of its input as the border
+/// of the image. That covers the filters, Convolve with halo 1, GaussianBlur and MedianFilter with half the window
+/// height, threshold::Adaptive with half the region size, and object::ExtractCannyEdges with 4. The bands are taken
+/// by the threads as they become free.
+/// \param im The input image.
+/// \param op The operation.
+/// \param halo The number of rows above and below a band that op reads.
+/// \param nbr_threads The number of threads, 0 for one per core.
+/// \param band_rows The number of rows of a band, 0 to pick it from the image and the number of threads. Bands have
+/// at least 2 * halo + 1 rows.
+/// \return The stitched image, empty if im is empty, halo is negative or op returns an image of another size.
+Img Run(const Img& im, const Operation& op, const int& halo, const size_t& nbr_threads = 0, const int& band_rows = 0);
+
+ImgF RunF(const ImgF& im, const OperationF& op, const int& halo, const size_t& nbr_threads = 0,
+          const int& band_rows = 0);
+
+}// namespace algo::image::tile
+
+#endif//ALGO_ALGO_INCLUDE_ALGO_IMAGE_TILE_HPP_
@@ -7,15 +7,22 @@
 #include "algo_geometry.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <iterator>
 #include <limits>
+#include <random>
 #include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "algo_geometry_hull.hpp"
+#include "algo_geometry_kernel.hpp"
+#include "algo_geometry_mesh.hpp"
+#include "algo_geometry_pairs.hpp"
+
 namespace {
 constexpr double kPi{3.14159265358979323846264338327950288};
 
@@ -23,10 +30,6 @@ constexpr size_t kMinPolygonPoints{3UL};
 constexpr size_t kMinBoundingBoxPoints{3UL};
 constexpr size_t kMinDelaunayTriangulationPoints{3UL};
 constexpr size_t kMinConvexHullPoints{3UL};
-constexpr size_t kMinClosestPairPoints{3UL};
-
-constexpr auto kXComp = [](auto p1, auto p2) { return p1.X() < p2.X(); };
-constexpr auto kYComp = [](auto p1, auto p2) { return p1.Y() < p2.Y(); };
 
 }  // namespace
 
@@ -59,6 +62,588 @@ std::vector<Point> helpers::SortCounterClockWise(
   return points;
 }
 
+// /////////////////////////////
+// MARK: Predicates
+
+// Robust predicates following J. R. Shewchuk, "Adaptive Precision
+// Floating-Point Arithmetic and Fast Robust Geometric Predicates".
+// https://www.cs.cmu.edu/~quake/robust.html
+//
+// Each predicate first evaluates the determinant in plain floating point and
+// returns it when it is safely away from zero (stage A). Otherwise it refines
+// the result in stages of increasing cost (B, C) on stack arrays, and only
+// the last resort computes the exact determinant (stage D).
+
+namespace {
+
+/// Non-overlapping floating-point expansion, components in increasing order
+/// of magnitude. The exact value is the sum of all components.
+using Expansion = std::vector<double>;
+
+constexpr double kEpsilon{std::numeric_limits<double>::epsilon() / 2.0};
+constexpr double kResultErrBound{(3.0 + 8.0 * kEpsilon) * kEpsilon};
+constexpr double kCcwErrBoundA{(3.0 + 16.0 * kEpsilon) * kEpsilon};
+constexpr double kCcwErrBoundB{(2.0 + 12.0 * kEpsilon) * kEpsilon};
+constexpr double kCcwErrBoundC{(9.0 + 64.0 * kEpsilon) * kEpsilon * kEpsilon};
+constexpr double kIccErrBoundA{(10.0 + 96.0 * kEpsilon) * kEpsilon};
+constexpr double kIccErrBoundB{(4.0 + 48.0 * kEpsilon) * kEpsilon};
+constexpr double kIccErrBoundC{(44.0 + 576.0 * kEpsilon) * kEpsilon *
+                               kEpsilon};
+constexpr double kDistErrBoundA{(6.0 + 64.0 * kEpsilon) * kEpsilon};
+
+/// \brief x + y == a + b exactly, where x = fl(a + b).
+inline void TwoSum(double a, double b, double& x, double& y) {
+  x = a + b;
+  const double b_virtual{x - a};
+  const double a_virtual{x - b_virtual};
+  y = (a - a_virtual) + (b - b_virtual);
+}
+
+/// \brief x + y == a * b exactly, where x = fl(a * b).
+inline void TwoProduct(double a, double b, double& x, double& y) {
+  x = a * b;
+  y = std::fma(a, b, -x);
+}
+
+/// \brief Returns the roundoff of x = fl(a - b), so that a - b == x + tail.
+inline double TwoDiffTail(double a, double b, double x) {
+  const double b_virtual{a - x};
+  const double a_virtual{x + b_virtual};
+  return (a - a_virtual) + (b_virtual - b);
+}
+
+/// \brief h = (a1 + a0) - (b1 + b0) as a four component expansion.
+inline void TwoTwoDiff(double a1, double a0, double b1, double b0, double* h) {
+  double i{0.0};
+  double j{0.0};
+  double k{0.0};
+  TwoSum(a0, -b0, i, h[0]);
+  TwoSum(a1, i, j, k);
+  TwoSum(k, -b1, i, h[1]);
+  TwoSum(j, i, h[3], h[2]);
+}
+
+/// \brief h = e + f, zero components are dropped. h must have room for
+/// elen + flen components and must not alias e or f.
+/// \return The number of components in h, at least one.
+size_t Sum(const double* e, size_t elen, const double* f, size_t flen,
+           double* h) {
+  size_t ei{0};
+  size_t fi{0};
+  size_t hi{0};
+  // Merges the components of e and f by increasing magnitude.
+  const auto next = [&]() {
+    if (fi == flen || (ei < elen && std::abs(e[ei]) <= std::abs(f[fi]))) {
+      return e[ei++];
+    }
+    return f[fi++];
+  };
+
+  double q{next()};
+  while (ei < elen || fi < flen) {
+    double sum{0.0};
+    double err{0.0};
+    TwoSum(q, next(), sum, err);
+    q = sum;
+    if (err != 0.0) {
+      h[hi++] = err;
+    }
+  }
+  if (q != 0.0 || hi == 0) {
+    h[hi++] = q;
+  }
+  return hi;
+}
+
+/// \brief h = e * b, zero components are dropped. h must have room for
+/// 2 * elen components and must not alias e.
+/// \return The number of components in h, at least one.
+size_t Scale(const double* e, size_t elen, double b, double* h) {
+  size_t hi{0};
+  double q{0.0};
+  double err{0.0};
+  TwoProduct(e[0], b, q, err);
+  if (err != 0.0) {
+    h[hi++] = err;
+  }
+
+  for (size_t i = 1; i < elen; i++) {
+    double product{0.0};
+    double product_err{0.0};
+    TwoProduct(e[i], b, product, product_err);
+    double sum{0.0};
+    TwoSum(q, product_err, sum, err);
+    if (err != 0.0) {
+      h[hi++] = err;
+    }
+    TwoSum(product, sum, q, err);
+    if (err != 0.0) {
+      h[hi++] = err;
+    }
+  }
+  if (q != 0.0 || hi == 0) {
+    h[hi++] = q;
+  }
+  return hi;
+}
+
+/// \brief Returns an approximation of the value of e.
+inline double Estimate(const double* e, size_t elen) {
+  double q{0.0};
+  for (size_t i = 0; i < elen; i++) {
+    q += e[i];
+  }
+  return q;
+}
+
+/// \brief Returns e + f.
+Expansion Add(const Expansion& e, const Expansion& f) {
+  if (e.empty()) {
+    return f;
+  }
+  if (f.empty()) {
+    return e;
+  }
+  Expansion h(e.size() + f.size());
+  h.resize(Sum(e.data(), e.size(), f.data(), f.size(), h.data()));
+  return h;
+}
+
+/// \brief Returns -e.
+Expansion Negate(Expansion e) {
+  for (auto& c : e) {
+    c = -c;
+  }
+  return e;
+}
+
+/// \brief Returns e * f.
+Expansion Multiply(const Expansion& e, const Expansion& f) {
+  Expansion h;
+  Expansion scaled(2 * e.size());
+  for (const double b : f) {
+    scaled.resize(2 * e.size());
+    scaled.resize(Scale(e.data(), e.size(), b, scaled.data()));
+    h = Add(h, scaled);
+  }
+  return h;
+}
+
+/// \brief Returns a - b as an exact expansion.
+inline Expansion Diff(double a, double b) {
+  const double x{a - b};
+  return {TwoDiffTail(a, b, x), x};
+}
+
+/// \brief Returns the most significant component, which has the sign of the
+/// exact value.
+inline double MostSignificant(const Expansion& e) {
+  return e.empty() ? 0.0 : e.back();
+}
+
+double Orient2DAdapt(double ax, double ay, double bx, double by, double cx,
+                     double cy, double det_sum) {
+  const double acx{ax - cx};
+  const double bcx{bx - cx};
+  const double acy{ay - cy};
+  const double bcy{by - cy};
+
+  // Stage B, the determinant of the rounded differences, exactly.
+  double det_left{0.0};
+  double det_left_tail{0.0};
+  double det_right{0.0};
+  double det_right_tail{0.0};
+  TwoProduct(acx, bcy, det_left, det_left_tail);
+  TwoProduct(acy, bcx, det_right, det_right_tail);
+  std::array<double, 4> b{};
+  TwoTwoDiff(det_left, det_left_tail, det_right, det_right_tail, b.data());
+
+  double det{Estimate(b.data(), b.size())};
+  double err_bound{kCcwErrBoundB * det_sum};
+  if (det >= err_bound || -det >= err_bound) {
+    return det;
+  }
+
+  const double acx_tail{TwoDiffTail(ax, cx, acx)};
+  const double bcx_tail{TwoDiffTail(bx, cx, bcx)};
+  const double acy_tail{TwoDiffTail(ay, cy, acy)};
+  const double bcy_tail{TwoDiffTail(by, cy, bcy)};
+  if (acx_tail == 0.0 && acy_tail == 0.0 && bcx_tail == 0.0 &&
+      bcy_tail == 0.0) {
+    // The differences were exact, so is stage B.
+    return det;
+  }
+
+  // Stage C, first order correction for the roundoff in the differences.
+  err_bound = kCcwErrBoundC * det_sum + kResultErrBound * std::abs(det);
+  det += (acx * bcy_tail + bcy * acx_tail) - (acy * bcx_tail + bcx * acy_tail);
+  if (det >= err_bound || -det >= err_bound) {
+    return det;
+  }
+
+  // Stage D, adds the remaining terms exactly.
+  std::array<double, 4> u{};
+  std::array<double, 8> c1{};
+  std::array<double, 12> c2{};
+  std::array<double, 16> d{};
+  double s1{0.0};
+  double s0{0.0};
+  double t1{0.0};
+  double t0{0.0};
+
+  TwoProduct(acx_tail, bcy, s1, s0);
+  TwoProduct(acy_tail, bcx, t1, t0);
+  TwoTwoDiff(s1, s0, t1, t0, u.data());
+  const size_t c1_len{Sum(b.data(), b.size(), u.data(), u.size(), c1.data())};
+
+  TwoProduct(acx, bcy_tail, s1, s0);
+  TwoProduct(acy, bcx_tail, t1, t0);
+  TwoTwoDiff(s1, s0, t1, t0, u.data());
+  const size_t c2_len{Sum(c1.data(), c1_len, u.data(), u.size(), c2.data())};
+
+  TwoProduct(acx_tail, bcy_tail, s1, s0);
+  TwoProduct(acy_tail, bcx_tail, t1, t0);
+  TwoTwoDiff(s1, s0, t1, t0, u.data());
+  const size_t d_len{Sum(c2.data(), c2_len, u.data(), u.size(), d.data())};
+  return d[d_len - 1];
+}
+
+/// \brief Exact incircle determinant, the last resort of InCircle.
+double InCircleExact(double ax, double ay, double bx, double by, double cx,
+                     double cy, double dx, double dy) {
+  const Expansion adx{Diff(ax, dx)};
+  const Expansion ady{Diff(ay, dy)};
+  const Expansion bdx{Diff(bx, dx)};
+  const Expansion bdy{Diff(by, dy)};
+  const Expansion cdx{Diff(cx, dx)};
+  const Expansion cdy{Diff(cy, dy)};
+
+  const auto lift = [](const Expansion& x, const Expansion& y) {
+    return Add(Multiply(x, x), Multiply(y, y));
+  };
+  const auto cross = [](const Expansion& x1, const Expansion& y1,
+                        const Expansion& x2, const Expansion& y2) {
+    return Add(Multiply(x1, y2), Negate(Multiply(y1, x2)));
+  };
+
+  const Expansion a_term{Multiply(lift(adx, ady), cross(bdx, bdy, cdx, cdy))};
+  const Expansion b_term{Multiply(lift(bdx, bdy), cross(cdx, cdy, adx, ady))};
+  const Expansion c_term{Multiply(lift(cdx, cdy), cross(adx, ady, bdx, bdy))};
+  return MostSignificant(Add(Add(a_term, b_term), c_term));
+}
+
+/// \brief Stage B lifted cross term, h = (x^2 + y^2) * cross where cross is
+/// a four component expansion.
+/// \return The number of components in h.
+size_t LiftedTerm(const std::array<double, 4>& cross, double x, double y,
+                  double* h) {
+  std::array<double, 8> x1{};
+  std::array<double, 16> x2{};
+  std::array<double, 8> y1{};
+  std::array<double, 16> y2{};
+  const size_t x1_len{Scale(cross.data(), cross.size(), x, x1.data())};
+  const size_t x2_len{Scale(x1.data(), x1_len, x, x2.data())};
+  const size_t y1_len{Scale(cross.data(), cross.size(), y, y1.data())};
+  const size_t y2_len{Scale(y1.data(), y1_len, y, y2.data())};
+  return Sum(x2.data(), x2_len, y2.data(), y2_len, h);
+}
+
+/// \brief Stage B cross term, h = x1 * y2 - x2 * y1 exactly.
+void CrossTerm(double x1, double y1, double x2, double y2,
+               std::array<double, 4>& h) {
+  double s1{0.0};
+  double s0{0.0};
+  double t1{0.0};
+  double t0{0.0};
+  TwoProduct(x1, y2, s1, s0);
+  TwoProduct(x2, y1, t1, t0);
+  TwoTwoDiff(s1, s0, t1, t0, h.data());
+}
+
+double InCircleAdapt(double ax, double ay, double bx, double by, double cx,
+                     double cy, double dx, double dy, double permanent) {
+  const double adx{ax - dx};
+  const double bdx{bx - dx};
+  const double cdx{cx - dx};
+  const double ady{ay - dy};
+  const double bdy{by - dy};
+  const double cdy{cy - dy};
+
+  // Stage B, the determinant of the rounded differences, exactly.
+  std::array<double, 4> bc{};
+  std::array<double, 4> ca{};
+  std::array<double, 4> ab{};
+  CrossTerm(bdx, bdy, cdx, cdy, bc);
+  CrossTerm(cdx, cdy, adx, ady, ca);
+  CrossTerm(adx, ady, bdx, bdy, ab);
+
+  std::array<double, 32> a_det{};
+  std::array<double, 32> b_det{};
+  std::array<double, 32> c_det{};
+  std::array<double, 64> ab_det{};
+  std::array<double, 96> fin{};
+  const size_t a_len{LiftedTerm(bc, adx, ady, a_det.data())};
+  const size_t b_len{LiftedTerm(ca, bdx, bdy, b_det.data())};
+  const size_t c_len{LiftedTerm(ab, cdx, cdy, c_det.data())};
+  const size_t ab_len{
+      Sum(a_det.data(), a_len, b_det.data(), b_len, ab_det.data())};
+  const size_t fin_len{
+      Sum(ab_det.data(), ab_len, c_det.data(), c_len, fin.data())};
+
+  double det{Estimate(fin.data(), fin_len)};
+  double err_bound{kIccErrBoundB * permanent};
+  if (det >= err_bound || -det >= err_bound) {
+    return det;
+  }
+
+  const double adx_tail{TwoDiffTail(ax, dx, adx)};
+  const double ady_tail{TwoDiffTail(ay, dy, ady)};
+  const double bdx_tail{TwoDiffTail(bx, dx, bdx)};
+  const double bdy_tail{TwoDiffTail(by, dy, bdy)};
+  const double cdx_tail{TwoDiffTail(cx, dx, cdx)};
+  const double cdy_tail{TwoDiffTail(cy, dy, cdy)};
+  if (adx_tail == 0.0 && bdx_tail == 0.0 && cdx_tail == 0.0 &&
+      ady_tail == 0.0 && bdy_tail == 0.0 && cdy_tail == 0.0) {
+    // The differences were exact, so is stage B.
+    return det;
+  }
+
+  // Stage C, first order correction for the roundoff in the differences.
+  err_bound = kIccErrBoundC * permanent + kResultErrBound * std::abs(det);
+  det += ((adx * adx + ady * ady) * ((bdx * cdy_tail + cdy * bdx_tail) -
+                                     (bdy * cdx_tail + cdx * bdy_tail)) +
+          2.0 * (adx * adx_tail + ady * ady_tail) * (bdx * cdy - bdy * cdx)) +
+         ((bdx * bdx + bdy * bdy) * ((cdx * ady_tail + ady * cdx_tail) -
+                                     (cdy * adx_tail + adx * cdy_tail)) +
+          2.0 * (bdx * bdx_tail + bdy * bdy_tail) * (cdx * ady - cdy * adx)) +
+         ((cdx * cdx + cdy * cdy) * ((adx * bdy_tail + bdy * adx_tail) -
+                                     (ady * bdx_tail + bdx * ady_tail)) +
+          2.0 * (cdx * cdx_tail + cdy * cdy_tail) * (adx * bdy - ady * bdx));
+  if (det >= err_bound || -det >= err_bound) {
+    return det;
+  }
+
+  // Stage D.
+  return InCircleExact(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+/// \brief Returns a value with the sign of |pt - origin|^2 - radius^2.
+double CompareDistance(const Point& origin, double radius, const Point& pt) {
+  const double dx{pt.X() - origin.X()};
+  const double dy{pt.Y() - origin.Y()};
+  const double dist{dx * dx + dy * dy};
+  const double radius2{radius * radius};
+  const double det{dist - radius2};
+
+  const double err_bound{kDistErrBoundA * (dist + radius2)};
+  if (det > err_bound || -det > err_bound) {
+    return det;
+  }
+
+  const Expansion ex{Diff(pt.X(), origin.X())};
+  const Expansion ey{Diff(pt.Y(), origin.Y())};
+  double r1{0.0};
+  double r0{0.0};
+  TwoProduct(radius, radius, r1, r0);
+  return MostSignificant(
+      Add(Add(Multiply(ex, ex), Multiply(ey, ey)), Expansion{-r0, -r1}));
+}
+
+/// \brief Point in homogeneous form (x / w, y / w), exact.
+struct ExactPoint {
+  Expansion x;
+  Expansion y;
+  Expansion w;
+};
+
+inline int Sign(double v) {
+  return (v > 0.0) - (v < 0.0);
+}
+
+/// \brief Exact intersection of the lines through a, b and c, d. With
+/// n = orient(c, d, a) and m = orient(c, d, b) it is a + n / (n - m) (b - a).
+ExactPoint ExactIntersection(const Point& a, const Point& b, const Point& c,
+                             const Point& d) {
+  const Expansion dcx{Diff(d.X(), c.X())};
+  const Expansion dcy{Diff(d.Y(), c.Y())};
+  const auto orient = [&](const Point& pt) {
+    return Add(Multiply(dcx, Diff(pt.Y(), c.Y())),
+               Negate(Multiply(dcy, Diff(pt.X(), c.X()))));
+  };
+  const Expansion n{orient(a)};
+  const Expansion w{Add(n, Negate(orient(b)))};
+  if (MostSignificant(w) == 0.0) {
+    throw std::invalid_argument("Parallel lines");
+  }
+  return {Add(Multiply(Expansion{a.X()}, w), Multiply(n, Diff(b.X(), a.X()))),
+          Add(Multiply(Expansion{a.Y()}, w), Multiply(n, Diff(b.Y(), a.Y()))),
+          w};
+}
+
+/// \brief Compares two exact points in (x, y) order.
+int CompareExact(const ExactPoint& p, const ExactPoint& q) {
+  const int w_sign{Sign(MostSignificant(p.w)) * Sign(MostSignificant(q.w))};
+  const auto compare = [&](const Expansion& pc, const Expansion& qc) {
+    return w_sign * Sign(MostSignificant(
+                        Add(Multiply(pc, q.w), Negate(Multiply(qc, p.w)))));
+  };
+  const int x{compare(p.x, q.x)};
+  return x != 0 ? x : compare(p.y, q.y);
+}
+
+/// \brief Floating-point intersection of the lines through a, b and c, d
+/// with bounds on the errors of x and y.
+/// \return false if the lines are too close to parallel for the bounds.
+bool ApproxIntersection(const Point& a, const Point& b, const Point& c,
+                        const Point& d, Point& pt, double& err_x,
+                        double& err_y) {
+  const double dcx{d.X() - c.X()};
+  const double dcy{d.Y() - c.Y()};
+  const auto orient = [&](const Point& p, double& err) {
+    const double left{dcx * (p.Y() - c.Y())};
+    const double right{dcy * (p.X() - c.X())};
+    err = kCcwErrBoundA * (std::abs(left) + std::abs(right));
+    return left - right;
+  };
+  double err_n{0.0};
+  double err_m{0.0};
+  const double n{orient(a, err_n)};
+  const double m{orient(b, err_m)};
+  const double w{n - m};
+  const double err_w{2.0 * (err_n + err_m) + 4.0 * kEpsilon * std::abs(w)};
+  if (std::abs(w) <= 2.0 * err_w) {
+    return false;
+  }
+  const double u{n / w};
+  const double err_u{(err_n + std::abs(u) * err_w) / (std::abs(w) - err_w) +
+                     4.0 * kEpsilon * std::abs(u)};
+  const double bax{b.X() - a.X()};
+  const double bay{b.Y() - a.Y()};
+  pt = Point{a.X() + u * bax, a.Y() + u * bay};
+  err_x = 2.0 * (std::abs(bax) * err_u +
+                 8.0 * kEpsilon * (std::abs(a.X()) + std::abs(u * bax)));
+  err_y = 2.0 * (std::abs(bay) * err_u +
+                 8.0 * kEpsilon * (std::abs(a.Y()) + std::abs(u * bay)));
+  return true;
+}
+
+/// \brief Decides the comparison of two approximate points in (x, y) order
+/// if the errors allow, 0 is returned otherwise.
+int CompareApprox(const Point& p, double err_px, double err_py, const Point& q,
+                  double err_qx, double err_qy) {
+  const double dx{p.X() - q.X()};
+  if (std::abs(dx) > (err_px + err_qx) * (1.0 + 4.0 * kEpsilon)) {
+    return Sign(dx);
+  }
+  // The y coordinates decide only if the x coordinates are exactly equal.
+  if (err_px == 0.0 && err_qx == 0.0 && dx == 0.0) {
+    const double dy{p.Y() - q.Y()};
+    if (std::abs(dy) > (err_py + err_qy) * (1.0 + 4.0 * kEpsilon)) {
+      return Sign(dy);
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+double predicates::Orient2D(const Point& a, const Point& b, const Point& c) {
+  return Orient2D(a.X(), a.Y(), b.X(), b.Y(), c.X(), c.Y());
+}
+
+double predicates::Orient2D(double ax, double ay, double bx, double by,
+                            double cx, double cy) {
+  const double det_left{(ax - cx) * (by - cy)};
+  const double det_right{(ay - cy) * (bx - cx)};
+  const double det{det_left - det_right};
+  // Without branching on the signs of the products, which are random in the
+  // common case. When they differ the bound always holds.
+  const double det_sum{std::abs(det_left) + std::abs(det_right)};
+
+  const double err_bound{kCcwErrBoundA * det_sum};
+  if (std::abs(det) >= err_bound) {
+    return det;
+  }
+  return Orient2DAdapt(ax, ay, bx, by, cx, cy, det_sum);
+}
+
+double predicates::InCircle(const Point& a, const Point& b, const Point& c,
+                            const Point& d) {
+  return InCircle(a.X(), a.Y(), b.X(), b.Y(), c.X(), c.Y(), d.X(), d.Y());
+}
+
+double predicates::InCircle(double ax, double ay, double bx, double by,
+                            double cx, double cy, double dx, double dy) {
+  const double adx{ax - dx};
+  const double bdx{bx - dx};
+  const double cdx{cx - dx};
+  const double ady{ay - dy};
+  const double bdy{by - dy};
+  const double cdy{cy - dy};
+
+  const double bdxcdy{bdx * cdy};
+  const double cdxbdy{cdx * bdy};
+  const double a_lift{adx * adx + ady * ady};
+
+  const double cdxady{cdx * ady};
+  const double adxcdy{adx * cdy};
+  const double b_lift{bdx * bdx + bdy * bdy};
+
+  const double adxbdy{adx * bdy};
+  const double bdxady{bdx * ady};
+  const double c_lift{cdx * cdx + cdy * cdy};
+
+  const double det{a_lift * (bdxcdy - cdxbdy) + b_lift * (cdxady - adxcdy) +
+                   c_lift * (adxbdy - bdxady)};
+  const double permanent{
+      (std::abs(bdxcdy) + std::abs(cdxbdy)) * a_lift +
+      (std::abs(cdxady) + std::abs(adxcdy)) * b_lift +
+      (std::abs(adxbdy) + std::abs(bdxady)) * c_lift};
+
+  const double err_bound{kIccErrBoundA * permanent};
+  if (std::abs(det) > err_bound) {
+    return det;
+  }
+  return InCircleAdapt(ax, ay, bx, by, cx, cy, dx, dy, permanent);
+}
+
+int predicates::CompareIntersection(const Point& a, const Point& b,
+                                    const Point& c, const Point& d,
+                                    const Point& pt) {
+  Point approx{0.0, 0.0};
+  double err_x{0.0};
+  double err_y{0.0};
+  if (ApproxIntersection(a, b, c, d, approx, err_x, err_y)) {
+    const int result{CompareApprox(approx, err_x, err_y, pt, 0.0, 0.0)};
+    if (result != 0) {
+      return result;
+    }
+  }
+  return CompareExact(ExactIntersection(a, b, c, d),
+                      {{pt.X()}, {pt.Y()}, {1.0}});
+}
+
+int predicates::CompareIntersections(const Point& a, const Point& b,
+                                     const Point& c, const Point& d,
+                                     const Point& e, const Point& f,
+                                     const Point& g, const Point& h) {
+  Point p{0.0, 0.0};
+  Point q{0.0, 0.0};
+  double err_px{0.0};
+  double err_py{0.0};
+  double err_qx{0.0};
+  double err_qy{0.0};
+  if (ApproxIntersection(a, b, c, d, p, err_px, err_py) &&
+      ApproxIntersection(e, f, g, h, q, err_qx, err_qy)) {
+    const int result{CompareApprox(p, err_px, err_py, q, err_qx, err_qy)};
+    if (result != 0) {
+      return result;
+    }
+  }
+  return CompareExact(ExactIntersection(a, b, c, d),
+                      ExactIntersection(e, f, g, h));
+}
+
 // /////////////////////////////
 // MARK: Point
 
@@ -104,6 +689,197 @@ double Point::Y() const {
   return y_;
 }
 
+// /////////////////////////////
+// MARK: PointCloud
+
+PointCloud::PointCloud(const std::vector<Point>& points) {
+  Reserve(points.size());
+  for (const auto& pt : points) {
+    PushBack(pt);
+  }
+}
+
+PointCloud::PointCloud(std::vector<double> xs, std::vector<double> ys)
+    : xs_{std::move(xs)}, ys_{std::move(ys)} {
+  if (xs_.size() != ys_.size()) {
+    throw std::invalid_argument("Coordinate arrays differ in size.");
+  }
+}
+
+size_t PointCloud::Size() const {
+  return xs_.size();
+}
+
+bool PointCloud::Empty() const {
+  return xs_.empty();
+}
+
+void PointCloud::Reserve(size_t n) {
+  xs_.reserve(n);
+  ys_.reserve(n);
+}
+
+void PointCloud::PushBack(double x, double y) {
+  xs_.push_back(x);
+  ys_.push_back(y);
+}
+
+void PointCloud::PushBack(const Point& pt) {
+  PushBack(pt.X(), pt.Y());
+}
+
+double PointCloud::X(size_t i) const {
+  return xs_[i];
+}
+
+double PointCloud::Y(size_t i) const {
+  return ys_[i];
+}
+
+Point PointCloud::At(size_t i) const {
+  return Point{xs_.at(i), ys_.at(i)};
+}
+
+const std::vector<double>& PointCloud::Xs() const {
+  return xs_;
+}
+
+const std::vector<double>& PointCloud::Ys() const {
+  return ys_;
+}
+
+std::vector<Point> PointCloud::ToPoints() const {
+  std::vector<Point> points;
+  points.reserve(Size());
+  for (size_t i = 0; i < Size(); i++) {
+    points.emplace_back(xs_[i], ys_[i]);
+  }
+  return points;
+}
+
+// The kernels below work on raw pointers over the two coordinate arrays and
+// keep the loop bodies branch free so that they vectorize.
+
+std::vector<double> PointCloud::Distances(const Point& pt) const {
+  const size_t n{Size()};
+  const double* xs{xs_.data()};
+  const double* ys{ys_.data()};
+  const double px{pt.X()};
+  const double py{pt.Y()};
+  std::vector<double> dists(n);
+  double* out{dists.data()};
+
+  for (size_t i = 0; i < n; i++) {
+    const double dx{xs[i] - px};
+    const double dy{ys[i] - py};
+    out[i] = std::sqrt(dx * dx + dy * dy);
+  }
+  return dists;
+}
+
+std::vector<int> PointCloud::Orientations(const Point& a,
+                                          const Point& b) const {
+  const size_t n{Size()};
+  const double* xs{xs_.data()};
+  const double* ys{ys_.data()};
+  const double ax{a.X()};
+  const double ay{a.Y()};
+  const double abx{b.X() - a.X()};
+  const double aby{b.Y() - a.Y()};
+  std::vector<int> sides(n);
+  int* out{sides.data()};
+
+  // The filter of predicates::Orient2D, with a as the pivot. The points it
+  // cannot decide are left at 0 and done exactly after the loop.
+  bool undecided{false};
+  for (size_t i = 0; i < n; i++) {
+    const double det_left{abx * (ys[i] - ay)};
+    const double det_right{aby * (xs[i] - ax)};
+    const double det{det_left - det_right};
+    const double err_bound{kCcwErrBoundA *
+                           (std::abs(det_left) + std::abs(det_right))};
+    const bool sure{det > err_bound || -det > err_bound};
+    out[i] = sure ? static_cast<int>(det > 0.0) - static_cast<int>(det < 0.0)
+                  : 0;
+    undecided = undecided || !sure;
+  }
+  if (undecided) {
+    for (size_t i = 0; i < n; i++) {
+      if (out[i] == 0) {
+        const double det{
+            predicates::Orient2D(ax, ay, b.X(), b.Y(), xs[i], ys[i])};
+        out[i] = static_cast<int>(det > 0.0) - static_cast<int>(det < 0.0);
+      }
+    }
+  }
+  return sides;
+}
+
+Rectangle PointCloud::BoundingRectangle() const {
+  if (Empty()) {
+    throw std::invalid_argument("No points.");
+  }
+
+  const size_t n{Size()};
+  const double* xs{xs_.data()};
+  const double* ys{ys_.data()};
+  double x_min{xs[0]};
+  double x_max{xs[0]};
+  double y_min{ys[0]};
+  double y_max{ys[0]};
+
+  for (size_t i = 1; i < n; i++) {
+    x_min = xs[i] < x_min ? xs[i] : x_min;
+    x_max = xs[i] > x_max ? xs[i] : x_max;
+    y_min = ys[i] < y_min ? ys[i] : y_min;
+    y_max = ys[i] > y_max ? ys[i] : y_max;
+  }
+
+  return Rectangle{{x_min, y_min}, x_max - x_min, y_max - y_min};
+}
+
+Point PointCloud::Centroid() const {
+  if (Empty()) {
+    throw std::invalid_argument("Division by zero.");
+  }
+
+  const size_t n{Size()};
+  const double* xs{xs_.data()};
+  const double* ys{ys_.data()};
+  double x_sum{0.0};
+  double y_sum{0.0};
+
+  for (size_t i = 0; i < n; i++) {
+    x_sum += xs[i];
+    y_sum += ys[i];
+  }
+
+  const auto size = static_cast<double>(n);
+  return Point{x_sum / size, y_sum / size};
+}
+
+PointCloud PointCloud::Rotate(const double angle, const Point& center) const {
+  const size_t n{Size()};
+  const double* xs{xs_.data()};
+  const double* ys{ys_.data()};
+  const double cx{center.X()};
+  const double cy{center.Y()};
+  const double cos_a{std::cos(angle)};
+  const double sin_a{std::sin(angle)};
+  std::vector<double> rx(n);
+  std::vector<double> ry(n);
+  double* out_x{rx.data()};
+  double* out_y{ry.data()};
+
+  for (size_t i = 0; i < n; i++) {
+    const double x{xs[i] - cx};
+    const double y{ys[i] - cy};
+    out_x[i] = x * cos_a - y * sin_a + cx;
+    out_y[i] = x * sin_a + y * cos_a + cy;
+  }
+  return PointCloud{std::move(rx), std::move(ry)};
+}
+
 // /////////////////////////////
 // MARK: Edge
 
@@ -132,8 +908,7 @@ bool Edge::Intersect(const Edge& edge) const {
   const Point& p4{edge.pt2_};
 
   const auto ccw = [](const Point& p1, const Point& p2, const Point& p3) {
-    return ((p3.Y() - p1.Y()) * (p2.X() - p1.X())) >=
-           ((p2.Y() - p1.Y()) * (p3.X() - p1.X()));
+    return predicates::Orient2D(p1, p2, p3) >= 0.0;
   };
 
   const bool is_ccw{(ccw(p1, p3, p4) != ccw(p2, p3, p4)) &&
@@ -191,9 +966,7 @@ Point Edge::GetEnd() const {
 }
 
 int Edge::Location(const Point& pt) const {
-  const double temp{(pt2_.X() - pt1_.X()) * (pt.Y() - pt1_.Y()) -
-                    (pt2_.Y() - pt1_.Y()) * (pt.X() - pt1_.X())};
-  return temp > 0.0 ? 1 : -1;
+  return predicates::Orient2D(pt1_, pt2_, pt) > 0.0 ? 1 : -1;
 }
 
 // /////////////////////////////
@@ -207,7 +980,7 @@ double Circle::Area() const {
 }
 
 bool Circle::IsInside(const Point& pt) const {
-  return origin_.Dist(pt) <= radius_;
+  return CompareDistance(origin_, radius_, pt) <= 0.0;
 }
 
 Triangle Circle::EnclosingTriangle() const {
@@ -238,110 +1011,82 @@ double Circle::Radius() const {
 
 namespace {
 
-inline Point CenterOfPoints(const std::vector<Point>& pts) {
-  double x_sum{0.0};
-  double y_sum{0.0};
-
-  if (pts.empty()) {
-    throw std::invalid_argument("Division by zero.");
-  }
-
-  auto n = static_cast<double>(pts.size());
-  for (const auto& pt : pts) {
-    x_sum += pt.X();
-    y_sum += pt.Y();
-  }
-  return Point{x_sum / n, y_sum / n};
-}
-
-inline bool IsSortedCounterClockwise(const std::vector<Point>& pts) {
+inline bool IsSortedCounterClockwise(const PointCloud& pts) {
   // Skipping checks since that was done in constructor.
   // Get any three points.
-  const Point& pt1{pts.at(0)};
-  const Point& pt2{pts.at(1)};
-  const Point& pt3{pts.at(2)};
+  const Point pt1{pts.At(0)};
+  const Point pt2{pts.At(1)};
+  const Point pt3{pts.At(2)};
 
-  const double cross_product{(pt2.X() - pt1.X()) * (pt3.Y() - pt1.Y()) -
-                             (pt3.X() - pt1.X()) * (pt2.Y() - pt1.Y())};
-
-  return cross_product > 0.0;
+  return predicates::Orient2D(pt1, pt2, pt3) > 0.0;
 }
 
-inline bool AnyPointPairEqual(const std::vector<Point>& pts) {
-  for (size_t i = 0; i < pts.size() - 1; i++) {
-    if (pts.at(i) == pts.at(i + 1)) {
+inline bool AnyPointPairEqual(const PointCloud& pts) {
+  const size_t n{pts.Size()};
+  for (size_t i = 0; i < n - 1; i++) {
+    if (pts.X(i) == pts.X(i + 1) && pts.Y(i) == pts.Y(i + 1)) {
       return true;
     }
   }
-  return pts.back() == pts.front();
+  return pts.X(n - 1) == pts.X(0) && pts.Y(n - 1) == pts.Y(0);
 }
 
 }  // namespace
 
 Polygon::Polygon(const std::vector<Point>& points)
-    : points_{points}, center_{CenterOfPoints(points)} {
-  if (points.size() < kMinPolygonPoints) {
+    : Polygon(PointCloud{points}) {}
+
+Polygon::Polygon(PointCloud points)
+    : points_{std::move(points)}, center_{points_.Centroid()} {
+  if (points_.Size() < kMinPolygonPoints) {
     throw std::invalid_argument("Less than three points");
   }
-  if (AnyPointPairEqual(points)) {
+  if (AnyPointPairEqual(points_)) {
     throw ::std::invalid_argument("Contains equal point pairs.");
   }
-  if (not IsSortedCounterClockwise(points)) {
+  if (not IsSortedCounterClockwise(points_)) {
     throw std::invalid_argument("Not sorted counter clockwise");
   }
 };
 
 size_t Polygon::EdgeCount() const {
-  return points_.size() <= 2 ? (points_.size() - 1) : points_.size();
+  return points_.Size() <= 2 ? (points_.Size() - 1) : points_.Size();
 }
 
 Point Polygon::GetEdge(const size_t i) const {
-  const size_t index_next{(i + 1) % points_.size()};
-  const Point pt1{points_.at(i)};
-  const Point pt2{points_.at(index_next)};
+  const size_t index_next{(i + 1) % points_.Size()};
+  const Point pt1{points_.At(i)};
+  const Point pt2{points_.At(index_next)};
   return pt2 - pt1;
 }
 
 std::vector<Edge> Polygon::GetEdges() const {
   std::vector<Edge> edges;
-  for (size_t i = 0; i < points_.size() - 1; i++) {
-    edges.emplace_back(points_.at(i), points_.at(i + 1));
+  edges.reserve(points_.Size());
+  for (size_t i = 0; i < points_.Size() - 1; i++) {
+    edges.emplace_back(points_.At(i), points_.At(i + 1));
   }
-  edges.emplace_back(points_.back(), points_.front());
+  edges.emplace_back(points_.At(points_.Size() - 1), points_.At(0));
   return edges;
 }
 
 double Polygon::Area() const {
+  const size_t n{points_.Size()};
+  const double* xs{points_.Xs().data()};
+  const double* ys{points_.Ys().data()};
   double area{0.0};
 
-  const auto det = [](const Point& p1, const Point& p2) {
-    return p1.X() * p2.Y() - p1.Y() * p2.X();
-  };
-
-  for (size_t i = 0; i < points_.size() - 1; i++) {
-    area += det(points_.at(i), points_.at(i + 1));
+  for (size_t i = 0; i < n - 1; i++) {
+    area += xs[i] * ys[i + 1] - ys[i] * xs[i + 1];
   }
   // Includes last point to first point, closed loop.
-  area += det(points_.back(), points_.front());
+  area += xs[n - 1] * ys[0] - ys[n - 1] * xs[0];
 
   return area / 2.0;
 }
 
 Polygon Polygon::Rotate(const double angle, const Point& center) const {
-  auto points = points_;
-
-  for (auto& pt : points) {
-    double x{pt.X() - center.X()};
-    double y{pt.Y() - center.Y()};
-    const double tx{x};
-
-    x = tx * std::cos(angle) - y * std::sin(angle);
-    y = tx * std::sin(angle) + y * std::cos(angle);
-    x += center.X();
-    y += center.Y();
-    pt.Set(x, y);
-  }
-  return Polygon{points};
+  return Polygon{points_.Rotate(angle, center)};
 }
 
 Polygon Polygon::Rotate(const double angle) const {
@@ -353,23 +1098,14 @@ Point Polygon::GetCenter() const {
 }
 
 Rectangle Polygon::BoundingRectangle() const {
-  auto x_min = std::numeric_limits<double>::max();
-  auto y_min = std::numeric_limits<double>::max();
-  double x_max{0.0};
-  double y_max{0.0};
-
-  // Find minimum a maximum values of coordinates.
-  for (const Point& pt : points_) {
-    x_max = std::max(pt.X(), x_max);
-    y_max = std::max(pt.Y(), y_max);
-    x_min = std::min(pt.X(), x_min);
-    y_min = std::min(pt.Y(), y_min);
-  }
-
-  return Rectangle{{x_min, y_min}, x_max - x_min, y_max - y_min};
+  return points_.BoundingRectangle();
 }
 
 std::vector<Point> Polygon::GetPoints() const {
+  return points_.ToPoints();
+}
+
+const PointCloud& Polygon::GetCloud() const {
   return points_;
 }
 
@@ -380,24 +1116,14 @@ Triangle::Triangle(const Point& pt1, const Point& pt2, const Point& pt3)
     : Polygon({pt1, pt2, pt3}), pt1_{pt1}, pt2_{pt2}, pt3_{pt3} {}
 
 bool Triangle::IsInside(const Point& pt) const {
-  if ((pt == pt1_) || (pt == pt2_) || (pt == pt3_)) {
-    // pt is a corner point -> "inside" ?
-    return true;
-  }
-
-  const auto area_of_triangle = [](const Point& pt1, const Point& pt2,
-                                   const Point& pt3) {
-    return std::abs((pt1.X() * (pt2.Y() - pt3.Y()) +
-                     pt2.X() * (pt3.Y() - pt1.Y()) +
-                     pt3.X() * (pt1.Y() - pt2.Y())) /
-                    2.0);
-  };
-
-  const double area0{Area()};
-  const double area1{area_of_triangle(pt, pt2_, pt3_)};
-  const double area2{area_of_triangle(pt1_, pt, pt3_)};
-  const double area3{area_of_triangle(pt1_, pt2_, pt)};
-  return area0 == (area1 + area2 + area3);
+  // Inside or on the boundary when pt is not strictly on opposite sides of
+  // two of the edges.
+  const double o1{predicates::Orient2D(pt1_, pt2_, pt)};
+  const double o2{predicates::Orient2D(pt2_, pt3_, pt)};
+  const double o3{predicates::Orient2D(pt3_, pt1_, pt)};
+  const bool has_neg{o1 < 0.0 || o2 < 0.0 || o3 < 0.0};
+  const bool has_pos{o1 > 0.0 || o2 > 0.0 || o3 > 0.0};
+  return !(has_neg && has_pos);
 }
 
 bool Triangle::HasEdge(const Edge& edge) const {
@@ -491,7 +1217,7 @@ Rectangle::Rectangle(const Point& pt1, double width, double height)
       height_{height} {}
 
 Point Rectangle::GetPoint() const {
-  return points_.front();
+  return points_.At(0);
 }
 
 double Rectangle::GetWidth() const {
@@ -507,272 +1233,42 @@ double Rectangle::GetHeight() const {
 
 Grid::Grid(const std::vector<Point>& points) : points_{points} {}
 
-// /////////////////////////////
-// MARK: Closest pair of points
+Grid::Grid(PointCloud points) : points_{std::move(points)} {}
 
-namespace {
-
-/// \brief Returns the closes pair of points, brute force. Only to be used on a
-/// very small set of points.
-/// \param xp Input points.
-/// \param yp Input points.
-/// \return Closest pair of points.
-std::pair<double, std::vector<Point>> ClosestPairBF(
-    const std::vector<Point>& xp, const std::vector<Point>& yp) {
-  auto min_dist = std::numeric_limits<double>::max();
-  Point xp_min{0.0, 0.0};
-  Point yp_min{0.0, 0.0};
-
-  for (const auto& px : xp) {
-    for (const auto& py : yp) {
-      if (px.X() != py.X() || px.Y() != py.Y()) {
-        if (px.Dist(py) < min_dist) {
-          min_dist = px.Dist(py);
-          xp_min = px;
-          yp_min = py;
-        }
-      }
-    }
-  }
-
-  return std::make_pair(min_dist, std::vector<Point>{xp_min, yp_min});
-}
-
-/// \brief Divide and conquer algorithm to find the closest pair of points.
-/// \param xp Set of points.
-/// \param yp Set of points.
-/// \return The min distance and the two closest points.
-// NOLINTNEXTLINE
-std::pair<double, std::vector<Point>> ClosestPair(
-    const std::vector<Point>& xp, const std::vector<Point>& yp) {
-  // Brute force if size <= 3
-  if (xp.size() <= kMinClosestPairPoints) {
-    return ClosestPairBF(xp, yp);
-  }
-  auto n = static_cast<int>(xp.size());
-
-  std::vector<Point> x_left;
-  std::vector<Point> x_right;
-  std::vector<Point> y_left;
-  std::vector<Point> y_right;
-
-  std::copy(xp.begin(), xp.begin() + (n / 2), std::back_inserter(x_left));
-  std::copy(xp.begin() + (n / 2), xp.end(), std::back_inserter(x_right));
-  // Mid point on x-axis
-  const Point& mid_x_pt{xp.at(n / 2)};
-
-  std::copy_if(yp.begin(), yp.end(), std::back_inserter(y_left),
-               [&mid_x_pt](auto pt) { return pt.X() <= mid_x_pt.X(); });
-
-  std::copy_if(yp.begin(), yp.end(), std::back_inserter(y_right),
-               [&mid_x_pt](auto pt) { return pt.X() > mid_x_pt.X(); });
-
-  // Recursive calls
-  auto c_l = ClosestPair(x_left, y_left);
-  auto c_r = ClosestPair(x_right, y_right);
-
-  auto p_min = c_l.first < c_r.first ? c_l.second : c_r.second;
-  const double dist_min{c_l.first < c_r.first ? c_l.first : c_r.first};
-
-  std::vector<Point> ys;
-  std::copy_if(xp.begin(), xp.end(), std::back_inserter(ys),
-               [&dist_min, &mid_x_pt](auto pt) {
-                 return std::abs(mid_x_pt.X() - pt.X()) < dist_min;
-               });
-
-  double closest_dist{dist_min};
-  auto closest_pair = p_min;
-
-  for (size_t i = 0; i < ys.size(); ++i) {
-    size_t k{i + 1};
-
-    while (k < ys.size() && ((ys.at(k).Y() - ys.at(i).Y()) < dist_min)) {
-      if (ys.at(k).Dist(ys.at(i)) < closest_dist) {
-        closest_dist = ys.at(k).Dist(ys.at(i));
-        closest_pair = {ys[k], ys[i]};
-      }
-      k++;
-    }
-  }
-
-  return std::make_pair(closest_dist, closest_pair);
+const PointCloud& Grid::GetCloud() const {
+  return points_;
 }
 
-}  // namespace
+// /////////////////////////////
+// MARK: Closest pair of points
 
 std::pair<Point, Point> Grid::ClosestPairOfPoints() const {
-  auto ptsx = points_;
-  auto ptsy = points_;
-  std::sort(ptsx.begin(), ptsx.end(), kXComp);
-  std::sort(ptsy.begin(), ptsy.end(), kYComp);
-
-  const auto closest = ClosestPair(ptsx, ptsy);
-  // Closest points in input:
-  const Point& p1{closest.second.front()};
-  const Point& p2{closest.second.back()};
-  return std::make_pair(p1, p2);
+  const auto closest = ClosestPairs{}.Closest(points_);
+  return std::make_pair(points_.At(closest.first), points_.At(closest.second));
 }
 
 // /////////////////////////////
 // MARK: ConvexHull
 
-namespace {
-
-/// \brief Determines the distance between a point p and the line ln.
-/// \param p The point.
-/// \param ln The line.
-/// \return Distance.
-inline double DistanceToLine(const Point& p, const Edge& ln) {
-  const double abx{ln.GetEnd().X() - ln.GetStart().X()};
-  const double aby{ln.GetEnd().Y() - ln.GetStart().Y()};
-  const double dist{abx * (ln.GetStart().Y() - p.Y()) -
-                    aby * (ln.GetStart().X() - p.X())};
-  return dist < 0 ? -1.0 * dist : dist;
-}
-
-inline int MaxEdgeDistanceIndex(const std::vector<Point>& pts,
-                                const Edge& edge) {
-  int ci{0};
-  int k{0};
-  double max_dist{0.0};
-
-  for (const auto& p : pts) {
-    const double curr_dist{DistanceToLine(p, edge)};
-    if (curr_dist > max_dist) {
-      max_dist = curr_dist;
-      ci = k;
-    }
-    ++k;
-  }
-  return ci;
-}
-
-/// \brief Subroutine of Quickhull. Not to be accessible from outside of this
-/// file. Use ConvexHull.
-// NOLINTNEXTLINE
-void QuickHull(const Point& a, const Point& b, std::vector<Point>& pts,
-               std::vector<Point>& conv_hull_pts) {
-  if (pts.empty()) {
-    return;
-  }
-
-  if (pts.size() == 1) {
-    conv_hull_pts.emplace_back(pts.front());
-    pts.erase(pts.begin());
-    return;
-  }
-
-  const int max_edge_index{MaxEdgeDistanceIndex(pts, Edge{a, b})};
-  const Point point_at_max_index{pts.at(max_edge_index)};
-
-  conv_hull_pts.push_back(point_at_max_index);
-  pts.erase(pts.begin() + max_edge_index);
-
-  std::vector<Point> pts_a;
-  std::vector<Point> pts_b;
-
-  const Edge edge1{a, point_at_max_index};
-  const Edge edge2{point_at_max_index, b};
-
-  for (const auto& p : pts) {
-    // Checking which side of edge p is.
-    if (edge1.Location(p) == 1) {
-      pts_a.emplace_back(p);
-    }
-    if (edge2.Location(p) == 1) {
-      pts_b.emplace_back(p);
-    }
-  }
-
-  // Recursive calls
-  QuickHull(a, point_at_max_index, pts_a, conv_hull_pts);
-  QuickHull(point_at_max_index, b, pts_b, conv_hull_pts);
-}
-
-}  // namespace
-
-Polygon Grid::ConvexHull() const {
-  if (points_.size() < kMinConvexHullPoints) {
+Polygon Grid::ConvexHull(size_t nbr_threads) const {
+  if (points_.Size() < kMinConvexHullPoints) {
     throw std::invalid_argument("To few points in input.");
   }
-
-  auto pts = points_;
-  std::sort(pts.begin(), pts.end(), kXComp);
-
-  // b and a with min and max x-coordinates respectively
-  const Point b{pts.front()};
-  const Point a{pts.back()};
-  std::vector<Point> pts_ch{a, b};
-  pts.erase(pts.begin());
-  pts.erase(pts.end() - 1);
-
-  std::vector<Point> left;
-  std::vector<Point> right;
-
-  const Edge edge{a, b};
-  // Determine which side of line (a,b)
-  for (const auto& pt : pts) {
-    edge.Location(pt) == -1 ? left.emplace_back(pt) : right.emplace_back(pt);
-  }
-
-  // Call qhull with two sets
-  QuickHull(a, b, right, pts_ch);  // NOLINT
-  QuickHull(b, a, left, pts_ch);   // NOLINT
-
-  pts_ch = helpers::SortCounterClockWise(pts_ch);
-  return Polygon{pts_ch};
+  return Polygon{geometry::ConvexHull(points_, nbr_threads)};
 }
 
 // /////////////////////////////
 // MARK: MinBoundingBox
 
-namespace {
-
-/// Minimum bounding box, rotating calipers
-/// https://github.com/Glissando/Rotating-Calipers
-
-std::vector<Polygon> RotatingCalipers(const Polygon& convex_hull_pts) {
-  std::vector<Polygon> polygons;
-
-  for (size_t i = 0; i < convex_hull_pts.EdgeCount(); i++) {
-    const Point edge{convex_hull_pts.GetEdge(i)};
-    const double angle1{std::acos(edge.Normalize().Y())};
-    auto polygon1 = convex_hull_pts.Rotate(angle1);
-    const auto box = polygon1.BoundingRectangle();
-    polygon1 = polygon1.Rotate(-angle1);
-    const Point center{polygon1.GetCenter()};
-    const Polygon pg{box.GetPoints()};
-    polygons.emplace_back(pg.Rotate(-angle1, center));
-  }
-
-  return polygons;
-}
-
-Polygon GetMinBox(const std::vector<Polygon>& polygons) {
-  auto iter = std::min_element(
-      polygons.begin(), polygons.end(),
-      [](const auto& polygon1, const auto& polygon2) {
-        const auto pts1 = polygon1.GetPoints();
-        const Rhombus rhombus1{pts1.at(0), pts1.at(1), pts1.at(2), pts1.at(3)};
-        const auto pts2 = polygon2.GetPoints();
-        const Rhombus rhombus2{pts2.at(0), pts2.at(1), pts2.at(2), pts2.at(3)};
-        return rhombus1.Area() < rhombus2.Area();
-      });
-  return *iter;
-}
-
-}  // namespace
-
 Polygon Grid::MinBoundingBox() const {
   // The only other constraint is if all points are on the same line.
-  if (points_.size() < kMinBoundingBoxPoints) {
+  if (points_.Size() < kMinBoundingBoxPoints) {
     throw std::invalid_argument("Too few points in input.");
   }
 
-  auto convex_hull_pts = ConvexHull();
-  auto polygons = RotatingCalipers(convex_hull_pts);
-
-  return GetMinBox(polygons);
+  const auto convex_hull = ConvexHull();
+  const auto box = RotatingCalipers(convex_hull.GetCloud()).min_area_box;
+  return Polygon{std::vector<Point>{box.corners.begin(), box.corners.end()}};
 }
 
 // /////////////////////////////
@@ -780,289 +1276,192 @@ Polygon Grid::MinBoundingBox() const {
 
 namespace {
 
-/// \brief Makes a circle out of the the given points located on the radius.
-/// \param p1 Point 1.
-/// \param p2 Point 2.
-/// \param p3 Point 3.
-/// \return A circle of p1, p2, p3.
-inline Circle CircleOf3(const Point& p1, const Point& p2, const Point& p3) {
-  const double bx{p2.X() - p1.X()};
-  const double by{p2.Y() - p1.Y()};
-  const double cx{p3.X() - p1.X()};
-  const double cy{p3.Y() - p1.Y()};
-  const double b{bx * bx + by * by};
-  const double c{cx * cx + cy * cy};
-  const double d{bx * cy - by * cx};
+// Relative slack on the squared radius in the containment test, so that the
+// points defining a circle are inside of it despite the rounded center.
+constexpr double kDiscSlack{1e-12};
 
-  const double mid_x{p1.X() + (cy * b - by * c) / (2.0 * d)};
-  const double mid_y{p1.Y() + (bx * c - cx * b) / (2.0 * d)};
-  const Point center{mid_x, mid_y};
-  const double radius{center.Dist(p1)};
+/// \brief A circle with its squared radius.
+struct Disc {
+  double x;
+  double y;
+  double r2;
+};
+
+inline bool InDisc(const Disc& d, double x, double y) {
+  const double dx{x - d.x};
+  const double dy{y - d.y};
+  return dx * dx + dy * dy <= d.r2 * (1.0 + kDiscSlack);
+}
 
-  return {center, radius};
+/// \brief Returns the circle with p and q on opposite sides.
+inline Disc DiscOf2(double px, double py, double qx, double qy) {
+  const double dx{qx - px};
+  const double dy{qy - py};
+  return {(px + qx) / 2.0, (py + qy) / 2.0, (dx * dx + dy * dy) / 4.0};
 }
 
-/// \brief Returns a circle out of either 1, 2 or 3 points.
-/// \param pts Given points, |points| ≤ 3.
-/// \return A circle.
-inline Circle TrivialCircumcircle(std::vector<Point> pts) {
-  if (pts.empty() || pts.size() > 3) {
-    return Circle{{0, 0}, 0};
+/// \brief Returns the circle through p, q and r.
+inline Disc DiscOf3(double px, double py, double qx, double qy, double rx,
+                    double ry) {
+  const double bx{qx - px};
+  const double by{qy - py};
+  const double cx{rx - px};
+  const double cy{ry - py};
+  const double b{bx * bx + by * by};
+  const double c{cx * cx + cy * cy};
+  const double d{bx * cy - by * cx};
+  if (d == 0.0) {
+    // Collinear, which only happens through rounding. The circle over the
+    // two points furthest apart contains the third.
+    const Disc pq{DiscOf2(px, py, qx, qy)};
+    const Disc pr{DiscOf2(px, py, rx, ry)};
+    const Disc qr{DiscOf2(qx, qy, rx, ry)};
+    return pq.r2 >= pr.r2 ? (pq.r2 >= qr.r2 ? pq : qr)
+                          : (pr.r2 >= qr.r2 ? pr : qr);
   }
-  // Single point given
-  if (pts.size() == 1) {
-    return Circle{pts.front(), 0};
+
+  const double x{px + (cy * b - by * c) / (2.0 * d)};
+  const double y{py + (bx * c - cx * b) / (2.0 * d)};
+  return {x, y, (x - px) * (x - px) + (y - py) * (y - py)};
+}
+
+/// \brief Welzl's algorithm in the iterative form with move-to-front, the
+/// points in [first, last) are reordered.
+/// \details Expected O(n) for points in random order. A point outside the
+/// current circle is on the boundary of the circle of the points before it,
+/// the inner loops find it with one or two boundary points fixed. Points
+/// that grew the circle are moved to the front, where the inner loops find
+/// them early.
+Disc MinDisc(double* xs, double* ys, size_t n) {
+  if (n == 0) {
+    return {0.0, 0.0, 0.0};
   }
-  // Two points on the circle
-  if (pts.size() == 2) {
-    const Point p1 = pts.at(0);
-    const Point p2 = pts.at(1);
-    const Point mid{(p1.X() + p2.X()) / 2.0, (p1.Y() + p2.Y()) / 2.0};
-    const double diameter{p1.Dist(p2)};
-    return Circle{mid, diameter / 2.0};
+  Disc disc{xs[0], ys[0], 0.0};
+  for (size_t i = 1; i < n; i++) {
+    if (InDisc(disc, xs[i], ys[i])) {
+      continue;
+    }
+    disc = {xs[i], ys[i], 0.0};
+    for (size_t j = 0; j < i; j++) {
+      if (InDisc(disc, xs[j], ys[j])) {
+        continue;
+      }
+      disc = DiscOf2(xs[i], ys[i], xs[j], ys[j]);
+      for (size_t k = 0; k < j; k++) {
+        if (!InDisc(disc, xs[k], ys[k])) {
+          disc = DiscOf3(xs[i], ys[i], xs[j], ys[j], xs[k], ys[k]);
+        }
+      }
+    }
+    std::rotate(xs, xs + i, xs + i + 1);
+    std::rotate(ys, ys + i, ys + i + 1);
   }
-  // Last case, three points are on the circle
-  return CircleOf3(pts.at(0), pts.at(1), pts.at(2));
+  return disc;
 }
 
-/// \brief Runs the Welzl step of the minimum enclosing circle step.
-/// \param pts Points to construct a circle around.
-/// \param r Input plane.
-/// \return A circle around the points in pts.
-// NOLINTNEXTLINE
-inline Circle Welzl(std::vector<Point> pts, std::vector<Point> r) {
-  if (pts.empty() || r.size() == 3) {
-    return TrivialCircumcircle(r);
-  }
-  auto index = std::rand() % pts.size();
-  auto p = pts.at(index);
-  pts.erase(pts.begin() + static_cast<long>(index));
-  auto circle = Welzl(pts, r);
-
-  if (circle.IsInside(p)) {
-    return circle;
+/// \brief Fisher-Yates shuffle of the points in both arrays.
+void Shuffle(double* xs, double* ys, size_t n, std::mt19937& gen) {
+  for (size_t i = n; i > 1; i--) {
+    const size_t j{std::uniform_int_distribution<size_t>{0, i - 1}(gen)};
+    std::swap(xs[i - 1], xs[j]);
+    std::swap(ys[i - 1], ys[j]);
   }
+}
 
-  r.emplace_back(p);
-  return Welzl(pts, r);
+inline Circle ToCircle(const Disc& disc) {
+  return Circle{{disc.x, disc.y}, std::sqrt(disc.r2)};
 }
 
 }  // namespace
 
 Circle Grid::MinEnclosingCircle() const {
-  const std::vector<Point> r;
-  return Welzl(points_, r);
+  std::vector<double> xs{points_.Xs()};
+  std::vector<double> ys{points_.Ys()};
+  std::mt19937 gen{xs.size()};
+  Shuffle(xs.data(), ys.data(), xs.size(), gen);
+  return ToCircle(MinDisc(xs.data(), ys.data(), xs.size()));
 }
 
-// /////////////////////////////
-// MARK: Triangulate
-
-namespace {
-
-/// \brief Sorts the input points lexicographically,
-/// \param pts The input points.
-inline void LexSortPoints(std::vector<Point>& pts) {
-  auto x = pts.front().X();
-  std::vector<Point> pts2;
-  std::vector<Point> pts_res;
-
-  for (auto& pt : pts) {
-    if (pt.X() != x) {
-      std::sort(pts2.begin(), pts2.end(), kXComp);
-      std::copy(pts2.begin(), pts2.end(), std::back_inserter(pts_res));
-      pts2.clear();
-      x = pt.X();
-    }
-
-    pts2.emplace_back(pt);
+std::vector<Circle> MinEnclosingCircles(const PointCloud& points,
+                                        const std::vector<int>& labels) {
+  if (labels.size() != points.Size()) {
+    throw std::invalid_argument("One label per point is required.");
   }
-
-  if (!pts2.empty()) {
-    std::copy(pts2.begin(), pts2.end(), std::back_inserter(pts_res));
+  const int max_label{labels.empty()
+                          ? -1
+                          : *std::max_element(labels.begin(), labels.end())};
+  // A label is at most the number of points, so that the groups below are
+  // not sized by one large label.
+  if (max_label >= 0 && static_cast<size_t>(max_label) >= labels.size()) {
+    throw std::invalid_argument("A label is not less than the point count.");
   }
-
-  pts = pts_res;
-}
-
-}  // namespace
-
-std::vector<Edge> Grid::Triangulation() const {
-  auto pts = points_;
-  LexSortPoints(pts);
-
-  std::vector<Point> visited{pts.at(0), pts.at(1), pts.at(2)};
-  bool intersection{false};
-
-  // The three first points constructs a triangle.
-  const Edge l0{pts.at(0), pts.at(1)};
-  const Edge l1{pts.at(0), pts.at(2)};
-  const Edge l2{pts.at(1), pts.at(2)};
-  std::vector<Edge> lines{l0, l1, l2};
-
-  // From this point add points to the only triangulate incrementally.
-  for (size_t i = 3; i < pts.size(); ++i) {
-    auto& pt0 = pts.at(i);
-
-    // Target point pi
-    for (auto pi = visited.rbegin(); pi != visited.rend(); ++pi) {
-      const Edge edge1{pt0, *pi};
-
-      // Verify that the segment p0-pi doesn't intersect e
-      for (auto e = lines.rbegin(); e != lines.rend(); ++e) {
-        if (edge1.Intersect(*e)) {
-          intersection = true;
-          break;  // when something intersects
-        }
-      }
-
-      if (!intersection) {
-        const Edge line{pt0, *pi};
-        lines.emplace_back(line);
-      }
-      intersection = false;
+  const size_t groups{max_label < 0 ? 0 : static_cast<size_t>(max_label) + 1};
+
+  // Counting sort of the points on the labels, then each group is a range
+  // of the same two arrays.
+  std::vector<size_t> offsets(groups + 1, 0);
+  for (const int label : labels) {
+    if (label >= 0) {
+      offsets[static_cast<size_t>(label) + 1]++;
     }
-    visited.emplace_back(pt0);
   }
-
-  return lines;
-}
-
-// /////////////////////////////
-// MARK: DelaunayTriangulation
-
-namespace {
-
-/// \brief Returns all the edges from the triangles.
-/// \param triangles Triangles.
-/// \return All edges.
-std::vector<Edge> TrianglesToEdges(const std::vector<Triangle>& triangles) {
-  std::vector<Edge> all_edges;
-  for (const auto& triangle : triangles) {
-    auto edges = triangle.GetEdges();
-    all_edges.emplace_back(edges.at(0));
-    all_edges.emplace_back(edges.at(1));
-    all_edges.emplace_back(edges.at(2));
-  }
-  return all_edges;
-}
-
-/// \brief Returns all edges that are not shared with no other triangle.
-/// \param[in] triangles Triangles.
-/// \return Edges.
-std::vector<Edge> GetNonSharingEdges(const std::vector<Triangle>& triangles) {
-  std::vector<Edge> polygon;
-  for (const auto& triangle_i : triangles) {
-    for (const auto& edge : triangle_i.GetEdges()) {
-      bool sharing_edge{false};
-      for (const auto& triangle_j : triangles) {
-        if (triangle_i == triangle_j) {
-          continue;
-        }
-        if (triangle_j.HasEdge(edge)) {
-          sharing_edge = true;
-          break;
-        }
-      }
-      if (not sharing_edge) {
-        polygon.emplace_back(edge);
-      }
-    }
+  for (size_t g = 0; g < groups; g++) {
+    offsets[g + 1] += offsets[g];
   }
-  return polygon;
-}
-
-/// \brief Removes triangles that are equal in triangulation and bad_triangles.
-/// \param[in,out] triangulation Triangles.
-/// \param[in] bad_triangles Triangles.
-inline void RemoveEqualTriangles(std::vector<Triangle>& triangulation,
-                                 const std::vector<Triangle>& bad_triangles) {
-  auto iter = triangulation.begin();
-
-  while (iter != triangulation.end()) {
-    for (const auto& bt : bad_triangles) {
-      iter = std::find_if(triangulation.begin(), triangulation.end(),
-                          [bt](const Triangle& tri) { return tri == bt; });
-
-      if (iter != triangulation.end()) {
-        triangulation.erase(iter);
-      }
+  std::vector<double> xs(offsets.back());
+  std::vector<double> ys(offsets.back());
+  std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < labels.size(); i++) {
+    if (labels[i] >= 0) {
+      const size_t at{next[static_cast<size_t>(labels[i])]++};
+      xs[at] = points.X(i);
+      ys[at] = points.Y(i);
     }
   }
-}
 
-/// \brief Removes the edges in the Delaunay triangulation that share a point
-/// with the super triangle.
-/// \param[in] del_edges Delaunay triangulation with super triangle around it.
-/// \param[in] super_triangle Known super triangle.
-inline void RemoveSuperVertices(std::vector<Edge>& del_edges,
-                                const Triangle& super_triangle) {
-  const auto st_vertices = super_triangle.GetPoints();
-  auto iter = del_edges.begin();
-  while (iter != del_edges.end()) {
-    iter = std::find_if(
-        del_edges.begin(), del_edges.end(), [st_vertices](const Edge& edge) {
-          const auto get_start = edge.GetStart();
-          const auto get_end = edge.GetEnd();
-          return get_start == st_vertices.at(0) or
-                 get_end == st_vertices.at(0) or
-                 get_start == st_vertices.at(1) or
-                 get_end == st_vertices.at(1) or
-                 get_start == st_vertices.at(2) or get_end == st_vertices.at(2);
-        });
-    if (iter != del_edges.end()) {
-      del_edges.erase(iter);
-    }
+  std::mt19937 gen{labels.size()};
+  std::vector<Circle> circles;
+  circles.reserve(groups);
+  for (size_t g = 0; g < groups; g++) {
+    const size_t n{offsets[g + 1] - offsets[g]};
+    Shuffle(xs.data() + offsets[g], ys.data() + offsets[g], n, gen);
+    circles.emplace_back(
+        ToCircle(MinDisc(xs.data() + offsets[g], ys.data() + offsets[g], n)));
   }
+  return circles;
 }
 
-/// \brief Removes the duplicated edges.
-/// \param edges Edges.
-/// \return What's left.
-inline std::vector<Edge> GetNonDuplicates(const std::vector<Edge>& edges) {
-  std::vector<Edge> non_duplicates;
+// /////////////////////////////
+// MARK: Triangulate
 
-  for (const auto& e1 : edges) {
-    auto iter = std::find_if(non_duplicates.begin(), non_duplicates.end(),
-                             [e1](const Edge& e2) { return e1 == e2; });
-    if (iter == non_duplicates.end()) {
-      non_duplicates.emplace_back(e1);
-    }
+std::vector<Edge> Grid::Triangulation() const {
+  // One triangulation for double points, the sweep of BasicGrid.
+  std::vector<BasicPoint<double>> pts;
+  pts.reserve(points_.Size());
+  for (size_t i = 0; i < points_.Size(); i++) {
+    const Point p{points_.At(i)};
+    pts.push_back({p.X(), p.Y()});
   }
-  return non_duplicates;
+  std::vector<Edge> lines;
+  for (const auto& e : BasicGrid<double>{std::move(pts)}.Triangulation()) {
+    lines.emplace_back(Point{e.first.x, e.first.y},
+                       Point{e.second.x, e.second.y});
+  }
+  return lines;
 }
 
-}  // namespace
-
-// Delaunay triangulation using the Bowyer–Watson algorithm
-// https://en.wikipedia.org/wiki/Bowyer–Watson_algorithm
+// /////////////////////////////
+// MARK: DelaunayTriangulation
 
 std::vector<Edge> Grid::DelaunayTriangulation() const {
-  if (points_.size() < kMinDelaunayTriangulationPoints) {
+  if (points_.Size() < kMinDelaunayTriangulationPoints) {
     return {};
   }
-  const auto super_triangle = MinEnclosingCircle().EnclosingTriangle();
-  std::vector<Triangle> triangulation{super_triangle};
-
-  for (const auto& pt : points_) {
-    std::vector<Triangle> bad_triangles;
+  return DelaunayMesh().GetEdges();
+}
 
-    for (const auto& triangle : triangulation) {
-      if (triangle.CircumCircle().IsInside(pt)) {
-        bad_triangles.emplace_back(triangle);
-      }
-    }
-    // Get only edges that are not shared with any other bad triangle.
-    const auto polygon = GetNonSharingEdges(bad_triangles);
-    // Remove triangles in bad_triangles from triangulation
-    RemoveEqualTriangles(triangulation, bad_triangles);
-    // Make an ew triangle of edge and pt and put in triangulation.
-    for (const auto& edge : polygon) {
-      triangulation.emplace_back(pt, edge.GetStart(), edge.GetEnd());
-    }
-  }
-  auto del_edges = TrianglesToEdges(triangulation);
-  RemoveSuperVertices(del_edges, super_triangle);
-  return GetNonDuplicates(del_edges);
+TriangleMesh Grid::DelaunayMesh() const {
+  return TriangleMesh::Delaunay(points_);
 }
 
 }  // namespace algo::geometry
@@ -0,0 +1,337 @@
+///
+/// \brief Source file for convex hull algorithms.
+/// \author alex011235
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_geometry_hull.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace algo::geometry {
+
+namespace {
+
+// Inputs smaller than this per thread are not split.
+constexpr size_t kParallelHullSize{1UL << 15};
+
+struct XY {
+  double x;
+  double y;
+};
+
+inline bool operator==(const XY& p, const XY& q) {
+  return p.x == q.x && p.y == q.y;
+}
+
+/// \brief (x, y) order.
+inline bool operator<(const XY& p, const XY& q) {
+  return p.x < q.x || (p.x == q.x && p.y < q.y);
+}
+
+inline bool LeftTurn(const XY& a, const XY& b, const XY& c) {
+  return predicates::Orient2D(a.x, a.y, b.x, b.y, c.x, c.y) > 0.0;
+}
+
+/// \brief Andrew's monotone chain over n points sorted on (x, y), at(i) is
+/// the i:th point.
+/// \return Hull vertices counter clockwise from the leftmost point.
+template <typename At>
+std::vector<XY> Chain(size_t n, const At& at) {
+  std::vector<XY> hull;
+  // Lower hull, left to right.
+  for (size_t i = 0; i < n; i++) {
+    const XY p{at(i)};
+    if (i > 0 && p == at(i - 1)) {
+      continue;
+    }
+    while (hull.size() >= 2 &&
+           !LeftTurn(hull[hull.size() - 2], hull.back(), p)) {
+      hull.pop_back();
+    }
+    hull.emplace_back(p);
+  }
+  if (hull.size() < 2) {
+    return hull;
+  }
+
+  // Upper hull, right to left, ending at the first point again.
+  const size_t lower{hull.size() + 1};
+  for (size_t i = n - 1; i-- > 0;) {
+    const XY p{at(i)};
+    if (p == at(i + 1)) {
+      continue;
+    }
+    while (hull.size() >= lower &&
+           !LeftTurn(hull[hull.size() - 2], hull.back(), p)) {
+      hull.pop_back();
+    }
+    hull.emplace_back(p);
+  }
+  hull.pop_back();
+  return hull;
+}
+
+std::vector<XY> SortedChain(std::vector<XY>& pts) {
+  std::sort(pts.begin(), pts.end());
+  return Chain(pts.size(), [&pts](size_t i) { return pts[i]; });
+}
+
+/// \brief Converts a chain to a point cloud, starting at the lowest point.
+PointCloud ToCloud(std::vector<XY> hull) {
+  const auto lowest = std::min_element(
+      hull.begin(), hull.end(), [](const XY& p, const XY& q) {
+        return p.y < q.y || (p.y == q.y && p.x < q.x);
+      });
+  std::rotate(hull.begin(), lowest, hull.end());
+
+  PointCloud cloud;
+  cloud.Reserve(hull.size());
+  for (const auto& p : hull) {
+    cloud.PushBack(p.x, p.y);
+  }
+  return cloud;
+}
+
+/// \brief A box with a side on the line through p in the unit direction u,
+/// from lo to hi along u and height to the left of it.
+OrientedBox MakeBox(const XY& p, const XY& u, double lo, double hi,
+                    double height) {
+  const auto at = [&p, &u](double s, double t) {
+    return Point{p.x + s * u.x - t * u.y, p.y + s * u.y + t * u.x};
+  };
+  return {{at(lo, 0.0), at(hi, 0.0), at(hi, height), at(lo, height)},
+          hi - lo,
+          height};
+}
+
+size_t NumberOfThreads(size_t nbr_threads, size_t n) {
+  if (nbr_threads == 0) {
+    nbr_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(1, std::min(nbr_threads, n / kParallelHullSize));
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: Convex hull
+
+PointCloud MonotoneChain(const PointCloud& sorted) {
+  const auto& xs = sorted.Xs();
+  const auto& ys = sorted.Ys();
+  const auto at = [&xs, &ys](size_t i) { return XY{xs[i], ys[i]}; };
+  for (size_t i = 1; i < sorted.Size(); i++) {
+    if (at(i) < at(i - 1)) {
+      throw std::invalid_argument("Points are not sorted.");
+    }
+  }
+  return ToCloud(Chain(sorted.Size(), at));
+}
+
+PointCloud ConvexHull(const PointCloud& points, size_t nbr_threads) {
+  const size_t n{points.Size()};
+  const size_t threads{NumberOfThreads(nbr_threads, n)};
+
+  // Each thread reduces a chunk of the points to its hull.
+  std::vector<std::vector<XY>> hulls(threads);
+  const auto reduce = [&points, &hulls, n, threads](size_t t) {
+    const size_t first{n * t / threads};
+    const size_t last{n * (t + 1) / threads};
+    std::vector<XY> pts;
+    pts.reserve(last - first);
+    for (size_t i = first; i < last; i++) {
+      pts.push_back({points.X(i), points.Y(i)});
+    }
+    hulls[t] = SortedChain(pts);
+  };
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threads; t++) {
+    workers.emplace_back(reduce, t);
+  }
+  reduce(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  if (threads == 1) {
+    return ToCloud(std::move(hulls.front()));
+  }
+
+  std::vector<XY> merged;
+  for (const auto& hull : hulls) {
+    merged.insert(merged.end(), hull.begin(), hull.end());
+  }
+  return ToCloud(SortedChain(merged));
+}
+
+// /////////////////////////////
+// MARK: Rotating calipers
+
+CaliperMetrics RotatingCalipers(const PointCloud& hull) {
+  const size_t h{hull.Size()};
+  if (h == 0) {
+    throw std::invalid_argument("No points.");
+  }
+  const auto& xs = hull.Xs();
+  const auto& ys = hull.Ys();
+  // The pointers only grow, the vertices are taken modulo h.
+  const auto at = [&xs, &ys, h](size_t i) { return XY{xs[i % h], ys[i % h]}; };
+
+  if (h <= 2) {
+    const XY p{at(0)};
+    const XY q{at(h - 1)};
+    const double len{std::hypot(q.x - p.x, q.y - p.y)};
+    const XY u{len > 0.0 ? XY{(q.x - p.x) / len, (q.y - p.y) / len}
+                         : XY{1.0, 0.0}};
+    const OrientedBox box{MakeBox(p, u, 0.0, len, 0.0)};
+    return {box, box, len, 0.0};
+  }
+
+  // The best box so far of each kind, as the edge it rests on.
+  struct Candidate {
+    size_t edge;
+    XY u;
+    double lo;
+    double hi;
+    double height;
+  };
+  constexpr double kInf{std::numeric_limits<double>::infinity()};
+  Candidate min_area{0, {1.0, 0.0}, 0.0, 0.0, 0.0};
+  Candidate min_perimeter{min_area};
+  double best_area{kInf};
+  double best_perimeter{kInf};
+  double diameter2{0.0};
+  double width{kInf};
+
+  size_t right{1};
+  size_t top{1};
+  size_t left{1};
+  for (size_t i = 0; i < h; i++) {
+    const XY p{at(i)};
+    const XY q{at(i + 1)};
+    const XY e{q.x - p.x, q.y - p.y};
+    const auto dot = [&e, &at](size_t j) {
+      const XY a{at(j)};
+      const XY b{at(j + 1)};
+      return e.x * (b.x - a.x) + e.y * (b.y - a.y);
+    };
+    const auto cross = [&e, &at](size_t j) {
+      const XY a{at(j)};
+      const XY b{at(j + 1)};
+      return e.x * (b.y - a.y) - e.y * (b.x - a.x);
+    };
+
+    // Farthest along the edge, then across it, then back against it.
+    right = std::max(right, i + 1);
+    while (dot(right) > 0.0) {
+      right++;
+    }
+    top = std::max(top, right);
+    while (cross(top) > 0.0) {
+      top++;
+    }
+    left = std::max(left, top);
+    while (dot(left) < 0.0) {
+      left++;
+    }
+
+    const double len{std::hypot(e.x, e.y)};
+    const XY u{e.x / len, e.y / len};
+    const auto along = [&p, &u](const XY& a) {
+      return (a.x - p.x) * u.x + (a.y - p.y) * u.y;
+    };
+    const XY t{at(top)};
+    const double height{u.x * (t.y - p.y) - u.y * (t.x - p.x)};
+    const double lo{along(at(left))};
+    const double hi{along(at(right))};
+
+    const double area{(hi - lo) * height};
+    if (area < best_area) {
+      best_area = area;
+      min_area = {i, u, lo, hi, height};
+    }
+    const double perimeter{2.0 * (hi - lo + height)};
+    if (perimeter < best_perimeter) {
+      best_perimeter = perimeter;
+      min_perimeter = {i, u, lo, hi, height};
+    }
+    width = std::min(width, height);
+
+    // The top vertex is antipodal to both ends of the edge.
+    for (const XY& a : {p, q}) {
+      diameter2 = std::max(diameter2, (t.x - a.x) * (t.x - a.x) +
+                                          (t.y - a.y) * (t.y - a.y));
+    }
+  }
+
+  const auto box = [&at](const Candidate& c) {
+    return MakeBox(at(c.edge), c.u, c.lo, c.hi, c.height);
+  };
+  return {box(min_area), box(min_perimeter), std::sqrt(diameter2), width};
+}
+
+// /////////////////////////////
+// MARK: StreamingHull
+
+void StreamingHull::Add(const PointCloud& chunk) {
+  if (chunk.Empty()) {
+    return;
+  }
+  count_ += chunk.Size();
+
+  std::vector<XY> pts;
+  pts.reserve(chunk.Size());
+  for (size_t i = 0; i < chunk.Size(); i++) {
+    pts.push_back({chunk.X(i), chunk.Y(i)});
+  }
+  std::sort(pts.begin(), pts.end());
+
+  // The kept vertices are sorted, a merge keeps the input to the chain
+  // sorted.
+  std::vector<XY> merged;
+  merged.reserve(xs_.size() + pts.size());
+  size_t j{0};
+  for (const auto& p : pts) {
+    for (; j < xs_.size() && XY{xs_[j], ys_[j]} < p; j++) {
+      merged.push_back({xs_[j], ys_[j]});
+    }
+    merged.push_back(p);
+  }
+  for (; j < xs_.size(); j++) {
+    merged.push_back({xs_[j], ys_[j]});
+  }
+
+  std::vector<XY> hull{
+      Chain(merged.size(), [&merged](size_t i) { return merged[i]; })};
+  std::sort(hull.begin(), hull.end());
+  xs_.resize(hull.size());
+  ys_.resize(hull.size());
+  for (size_t i = 0; i < hull.size(); i++) {
+    xs_[i] = hull[i].x;
+    ys_[i] = hull[i].y;
+  }
+}
+
+void StreamingHull::Add(const Point& pt) {
+  PointCloud chunk;
+  chunk.PushBack(pt);
+  Add(chunk);
+}
+
+PointCloud StreamingHull::Hull() const {
+  return ToCloud(
+      Chain(xs_.size(), [this](size_t i) { return XY{xs_[i], ys_[i]}; }));
+}
+
+size_t StreamingHull::Count() const {
+  return count_;
+}
+
+}  // namespace algo::geometry
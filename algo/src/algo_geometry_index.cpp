@@ -0,0 +1,836 @@
+///
+/// \brief Source file for spatial indexes.
+/// \author alex011235
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_geometry_index.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace algo::geometry {
+
+namespace {
+
+// Ranges of at most this many points are leaves, they are scanned linearly.
+constexpr size_t kLeafSize{8UL};
+// Subtrees smaller than this are built by the calling thread.
+constexpr size_t kParallelBuildSize{1UL << 14};
+// Queries handed to a thread at a time in the batched queries.
+constexpr size_t kQueryChunk{256UL};
+// The tree depth is at most log2(n) < 64, the traversal stack holds at most
+// one frame per level plus one.
+constexpr size_t kMaxStack{128UL};
+
+constexpr double kInf{std::numeric_limits<double>::infinity()};
+
+struct Entry {
+  double x;
+  double y;
+  size_t id;
+};
+
+/// \brief A subtree [lo, hi) at depth with a lower bound on the squared
+/// distance from the query to its region.
+struct Frame {
+  size_t lo;
+  size_t hi;
+  size_t depth;
+  double bound;
+};
+
+size_t NumberOfThreads(size_t nbr_threads, size_t n, size_t chunk) {
+  if (nbr_threads == 0) {
+    nbr_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(1, std::min(nbr_threads, n / chunk + 1));
+}
+
+void Build(Entry* first, size_t n, size_t depth, size_t nbr_threads) {
+  if (n <= kLeafSize) {
+    return;
+  }
+  const size_t mid{n / 2};
+  if (depth % 2 == 0) {
+    std::nth_element(first, first + mid, first + n,
+                     [](const Entry& a, const Entry& b) { return a.x < b.x; });
+  } else {
+    std::nth_element(first, first + mid, first + n,
+                     [](const Entry& a, const Entry& b) { return a.y < b.y; });
+  }
+
+  if (nbr_threads > 1 && n > kParallelBuildSize) {
+    std::thread left{Build, first, mid, depth + 1, nbr_threads / 2};
+    Build(first + mid + 1, n - mid - 1, depth + 1,
+          nbr_threads - nbr_threads / 2);
+    left.join();
+  } else {
+    Build(first, mid, depth + 1, 1);
+    Build(first + mid + 1, n - mid - 1, depth + 1, 1);
+  }
+}
+
+/// \brief Runs query(i) for i in [0, n) on a number of threads.
+void ParallelFor(size_t n, size_t nbr_threads,
+                 const std::function<void(size_t)>& query) {
+  const size_t threads{NumberOfThreads(nbr_threads, n, kQueryChunk)};
+  std::atomic<size_t> next{0};
+
+  const auto worker = [&]() {
+    for (size_t begin = next.fetch_add(kQueryChunk); begin < n;
+         begin = next.fetch_add(kQueryChunk)) {
+      const size_t end{std::min(begin + kQueryChunk, n)};
+      for (size_t i = begin; i < end; i++) {
+        query(i);
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threads; t++) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: KdTree
+
+KdTree::KdTree(PointCloud points, size_t nbr_threads)
+    : points_{std::move(points)} {
+  const size_t n{points_.Size()};
+  std::vector<Entry> entries(n);
+  for (size_t i = 0; i < n; i++) {
+    entries[i] = {points_.X(i), points_.Y(i), i};
+  }
+  Build(entries.data(), n, 0,
+        NumberOfThreads(nbr_threads, n, kParallelBuildSize));
+
+  xs_.resize(n);
+  ys_.resize(n);
+  ids_.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    xs_[i] = entries[i].x;
+    ys_[i] = entries[i].y;
+    ids_[i] = entries[i].id;
+  }
+}
+
+size_t KdTree::Size() const {
+  return ids_.size();
+}
+
+size_t KdTree::Nearest(const Point& pt) const {
+  const double qx{pt.X()};
+  const double qy{pt.Y()};
+  double best_dist{kInf};
+  size_t best{kNone};
+
+  const auto visit = [&](size_t i) {
+    const double dx{xs_[i] - qx};
+    const double dy{ys_[i] - qy};
+    const double dist{dx * dx + dy * dy};
+    if (dist < best_dist) {
+      best_dist = dist;
+      best = i;
+    }
+  };
+
+  std::array<Frame, kMaxStack> stack{};
+  size_t top{0};
+  stack[top++] = {0, Size(), 0, 0.0};
+
+  while (top > 0) {
+    const Frame f{stack[--top]};
+    if (f.bound >= best_dist) {
+      continue;
+    }
+    if (f.hi - f.lo <= kLeafSize) {
+      for (size_t i = f.lo; i < f.hi; i++) {
+        visit(i);
+      }
+      continue;
+    }
+
+    const size_t mid{f.lo + (f.hi - f.lo) / 2};
+    visit(mid);
+    const double diff{f.depth % 2 == 0 ? qx - xs_[mid] : qy - ys_[mid]};
+    Frame near{f.lo, mid, f.depth + 1, f.bound};
+    Frame far{mid + 1, f.hi, f.depth + 1, f.bound};
+    if (diff >= 0.0) {
+      std::swap(near, far);
+    }
+    // The far side is pushed first, so that the near side is searched first.
+    far.bound = std::max(f.bound, diff * diff);
+    stack[top++] = far;
+    stack[top++] = near;
+  }
+  return best == kNone ? kNone : ids_[best];
+}
+
+std::vector<size_t> KdTree::KNearest(const Point& pt, size_t k) const {
+  k = std::min(k, Size());
+  if (k == 0) {
+    return {};
+  }
+  const double qx{pt.X()};
+  const double qy{pt.Y()};
+
+  // Max-heap of the k best so far, on squared distance.
+  std::vector<std::pair<double, size_t>> heap;
+  heap.reserve(k);
+  const auto bound = [&]() {
+    return heap.size() < k ? kInf : heap.front().first;
+  };
+  const auto visit = [&](size_t i) {
+    const double dx{xs_[i] - qx};
+    const double dy{ys_[i] - qy};
+    const double dist{dx * dx + dy * dy};
+    if (heap.size() < k) {
+      heap.emplace_back(dist, i);
+      std::push_heap(heap.begin(), heap.end());
+    } else if (dist < heap.front().first) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = {dist, i};
+      std::push_heap(heap.begin(), heap.end());
+    }
+  };
+
+  std::array<Frame, kMaxStack> stack{};
+  size_t top{0};
+  stack[top++] = {0, Size(), 0, 0.0};
+
+  while (top > 0) {
+    const Frame f{stack[--top]};
+    if (f.bound >= bound()) {
+      continue;
+    }
+    if (f.hi - f.lo <= kLeafSize) {
+      for (size_t i = f.lo; i < f.hi; i++) {
+        visit(i);
+      }
+      continue;
+    }
+
+    const size_t mid{f.lo + (f.hi - f.lo) / 2};
+    visit(mid);
+    const double diff{f.depth % 2 == 0 ? qx - xs_[mid] : qy - ys_[mid]};
+    Frame near{f.lo, mid, f.depth + 1, f.bound};
+    Frame far{mid + 1, f.hi, f.depth + 1, f.bound};
+    if (diff >= 0.0) {
+      std::swap(near, far);
+    }
+    far.bound = std::max(f.bound, diff * diff);
+    stack[top++] = far;
+    stack[top++] = near;
+  }
+
+  std::sort_heap(heap.begin(), heap.end());
+  std::vector<size_t> result;
+  result.reserve(heap.size());
+  for (const auto& entry : heap) {
+    result.emplace_back(ids_[entry.second]);
+  }
+  return result;
+}
+
+std::vector<size_t> KdTree::Radius(const Point& pt, double radius) const {
+  std::vector<size_t> result;
+  if (Size() == 0 || radius < 0.0) {
+    return result;
+  }
+  const double qx{pt.X()};
+  const double qy{pt.Y()};
+  const double radius2{radius * radius};
+
+  const auto visit = [&](size_t i) {
+    const double dx{xs_[i] - qx};
+    const double dy{ys_[i] - qy};
+    if (dx * dx + dy * dy <= radius2) {
+      result.emplace_back(ids_[i]);
+    }
+  };
+
+  std::array<Frame, kMaxStack> stack{};
+  size_t top{0};
+  stack[top++] = {0, Size(), 0, 0.0};
+
+  while (top > 0) {
+    const Frame f{stack[--top]};
+    if (f.hi - f.lo <= kLeafSize) {
+      for (size_t i = f.lo; i < f.hi; i++) {
+        visit(i);
+      }
+      continue;
+    }
+
+    const size_t mid{f.lo + (f.hi - f.lo) / 2};
+    visit(mid);
+    const double diff{f.depth % 2 == 0 ? qx - xs_[mid] : qy - ys_[mid]};
+    const bool far_ok{diff * diff <= radius2};
+    if (diff < 0.0 || far_ok) {
+      stack[top++] = {f.lo, mid, f.depth + 1, 0.0};
+    }
+    if (diff >= 0.0 || far_ok) {
+      stack[top++] = {mid + 1, f.hi, f.depth + 1, 0.0};
+    }
+  }
+  return result;
+}
+
+std::vector<size_t> KdTree::Range(const Rectangle& rect) const {
+  std::vector<size_t> result;
+  const Point corner{rect.GetPoint()};
+  const double x_min{std::min(corner.X(), corner.X() + rect.GetWidth())};
+  const double x_max{std::max(corner.X(), corner.X() + rect.GetWidth())};
+  const double y_min{std::min(corner.Y(), corner.Y() + rect.GetHeight())};
+  const double y_max{std::max(corner.Y(), corner.Y() + rect.GetHeight())};
+
+  const auto visit = [&](size_t i) {
+    if (xs_[i] >= x_min && xs_[i] <= x_max && ys_[i] >= y_min &&
+        ys_[i] <= y_max) {
+      result.emplace_back(ids_[i]);
+    }
+  };
+
+  if (Size() == 0) {
+    return result;
+  }
+  std::array<Frame, kMaxStack> stack{};
+  size_t top{0};
+  stack[top++] = {0, Size(), 0, 0.0};
+
+  while (top > 0) {
+    const Frame f{stack[--top]};
+    if (f.hi - f.lo <= kLeafSize) {
+      for (size_t i = f.lo; i < f.hi; i++) {
+        visit(i);
+      }
+      continue;
+    }
+
+    const size_t mid{f.lo + (f.hi - f.lo) / 2};
+    visit(mid);
+    const bool x_axis{f.depth % 2 == 0};
+    const double split{x_axis ? xs_[mid] : ys_[mid]};
+    // The left subtree has coordinates <= split, the right >= split.
+    if ((x_axis ? x_min : y_min) <= split) {
+      stack[top++] = {f.lo, mid, f.depth + 1, 0.0};
+    }
+    if ((x_axis ? x_max : y_max) >= split) {
+      stack[top++] = {mid + 1, f.hi, f.depth + 1, 0.0};
+    }
+  }
+  return result;
+}
+
+std::vector<size_t> KdTree::Nearest(const PointCloud& queries,
+                                    size_t nbr_threads) const {
+  std::vector<size_t> result(queries.Size(), kNone);
+  ParallelFor(queries.Size(), nbr_threads,
+              [&](size_t i) { result[i] = Nearest(queries.At(i)); });
+  return result;
+}
+
+std::vector<std::vector<size_t>> KdTree::KNearest(const PointCloud& queries,
+                                                  size_t k,
+                                                  size_t nbr_threads) const {
+  std::vector<std::vector<size_t>> result(queries.Size());
+  ParallelFor(queries.Size(), nbr_threads,
+              [&](size_t i) { result[i] = KNearest(queries.At(i), k); });
+  return result;
+}
+
+const PointCloud& KdTree::GetCloud() const {
+  return points_;
+}
+
+// /////////////////////////////
+// MARK: RTree
+
+namespace {
+
+// The box helpers are templates, so they can take RTree's private node types.
+
+template <typename Box>
+double Area(const Box& b) {
+  return (b.x_max - b.x_min) * (b.y_max - b.y_min);
+}
+
+template <typename Box>
+Box Union(const Box& a, const Box& b) {
+  return {std::min(a.x_min, b.x_min), std::min(a.y_min, b.y_min),
+          std::max(a.x_max, b.x_max), std::max(a.y_max, b.y_max)};
+}
+
+template <typename Box>
+double Enlargement(const Box& a, const Box& b) {
+  return Area(Union(a, b)) - Area(a);
+}
+
+template <typename Box>
+bool Overlaps(const Box& a, const Box& b) {
+  return a.x_min <= b.x_max && b.x_min <= a.x_max && a.y_min <= b.y_max &&
+         b.y_min <= a.y_max;
+}
+
+template <typename Box>
+bool Encloses(const Box& outer, const Box& inner) {
+  return outer.x_min <= inner.x_min && outer.y_min <= inner.y_min &&
+         outer.x_max >= inner.x_max && outer.y_max >= inner.y_max;
+}
+
+template <typename Box>
+bool SameBox(const Box& a, const Box& b) {
+  return a.x_min == b.x_min && a.y_min == b.y_min && a.x_max == b.x_max &&
+         a.y_max == b.y_max;
+}
+
+/// \brief Squared distance from (x, y) to the box, 0 inside.
+template <typename Box>
+double SquaredDist(const Box& b, double x, double y) {
+  const double dx{std::max({b.x_min - x, 0.0, x - b.x_max})};
+  const double dy{std::max({b.y_min - y, 0.0, y - b.y_max})};
+  return dx * dx + dy * dy;
+}
+
+template <typename Box>
+Box MakeBox(const Rectangle& rect) {
+  const Point corner{rect.GetPoint()};
+  const double x2{corner.X() + rect.GetWidth()};
+  const double y2{corner.Y() + rect.GetHeight()};
+  return {std::min(corner.X(), x2), std::min(corner.Y(), y2),
+          std::max(corner.X(), x2), std::max(corner.Y(), y2)};
+}
+
+template <typename Box>
+Box MakeBox(const Edge& edge) {
+  const Point a{edge.GetStart()};
+  const Point b{edge.GetEnd()};
+  return {std::min(a.X(), b.X()), std::min(a.Y(), b.Y()),
+          std::max(a.X(), b.X()), std::max(a.Y(), b.Y())};
+}
+
+template <typename Entry>
+double CenterX(const Entry& e) {
+  return e.box.x_min + e.box.x_max;
+}
+
+template <typename Entry>
+double CenterY(const Entry& e) {
+  return e.box.y_min + e.box.y_max;
+}
+
+}  // namespace
+
+RTree::RTree() : root_{0}, size_{0}, height_{1} {
+  root_ = NewNode(true);
+}
+
+RTree::RTree(const std::vector<Polygon>& polygons) : RTree() {
+  std::vector<Entry> entries;
+  entries.reserve(polygons.size());
+  for (size_t i = 0; i < polygons.size(); i++) {
+    entries.push_back({MakeBox<Box>(polygons[i].BoundingRectangle()), i});
+  }
+  BulkLoad(std::move(entries));
+}
+
+RTree::RTree(const std::vector<Edge>& edges) : RTree() {
+  std::vector<Entry> entries;
+  entries.reserve(edges.size());
+  for (size_t i = 0; i < edges.size(); i++) {
+    entries.push_back({MakeBox<Box>(edges[i]), i});
+  }
+  BulkLoad(std::move(entries));
+}
+
+size_t RTree::Size() const {
+  return size_;
+}
+
+size_t RTree::Height() const {
+  return height_;
+}
+
+void RTree::Insert(size_t id, const Polygon& polygon) {
+  InsertEntry({MakeBox<Box>(polygon.BoundingRectangle()), id});
+  size_++;
+}
+
+void RTree::Insert(size_t id, const Edge& edge) {
+  InsertEntry({MakeBox<Box>(edge), id});
+  size_++;
+}
+
+bool RTree::Remove(size_t id, const Polygon& polygon) {
+  return RemoveEntry({MakeBox<Box>(polygon.BoundingRectangle()), id});
+}
+
+bool RTree::Remove(size_t id, const Edge& edge) {
+  return RemoveEntry({MakeBox<Box>(edge), id});
+}
+
+std::vector<size_t> RTree::Search(const Rectangle& window) const {
+  const Box box{MakeBox<Box>(window)};
+  std::vector<size_t> result;
+  std::vector<size_t> stack{root_};
+
+  while (!stack.empty()) {
+    const Node& node{nodes_[stack.back()]};
+    stack.pop_back();
+    for (size_t i = 0; i < node.count; i++) {
+      if (Overlaps(node.entries[i].box, box)) {
+        (node.leaf ? result : stack).emplace_back(node.entries[i].child);
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<size_t> RTree::Contains(const Point& pt) const {
+  const Box box{pt.X(), pt.Y(), pt.X(), pt.Y()};
+  std::vector<size_t> result;
+  std::vector<size_t> stack{root_};
+
+  while (!stack.empty()) {
+    const Node& node{nodes_[stack.back()]};
+    stack.pop_back();
+    for (size_t i = 0; i < node.count; i++) {
+      if (Encloses(node.entries[i].box, box)) {
+        (node.leaf ? result : stack).emplace_back(node.entries[i].child);
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<size_t> RTree::Nearest(const Point& pt, size_t k,
+                                   const DistanceFunc& distance) const {
+  // Best first search. Objects are first queued with the distance to their
+  // bounding rectangle and queued again with the exact distance.
+  enum class Kind { kNode, kBox, kObject };
+  struct Candidate {
+    double dist;
+    size_t index;
+    Kind kind;
+    bool operator>(const Candidate& other) const { return dist > other.dist; }
+  };
+  std::priority_queue<Candidate, std::vector<Candidate>,
+                      std::greater<Candidate>>
+      queue;
+  queue.push({0.0, root_, Kind::kNode});
+
+  std::vector<size_t> result;
+  while (!queue.empty() && result.size() < k) {
+    const Candidate c{queue.top()};
+    queue.pop();
+
+    if (c.kind == Kind::kObject) {
+      result.emplace_back(c.index);
+    } else if (c.kind == Kind::kBox) {
+      queue.push({distance(c.index), c.index, Kind::kObject});
+    } else {
+      const Node& node{nodes_[c.index]};
+      const Kind kind{!node.leaf ? Kind::kNode
+                                 : (distance ? Kind::kBox : Kind::kObject)};
+      for (size_t i = 0; i < node.count; i++) {
+        const Entry& e{node.entries[i]};
+        queue.push({std::sqrt(SquaredDist(e.box, pt.X(), pt.Y())), e.child,
+                    kind});
+      }
+    }
+  }
+  return result;
+}
+
+void RTree::BulkLoad(std::vector<Entry> entries) {
+  if (entries.empty()) {
+    return;
+  }
+  nodes_.clear();
+  free_.clear();
+  size_ = entries.size();
+  height_ = 0;
+
+  bool leaf{true};
+  while (true) {
+    height_++;
+    entries = Pack(entries, leaf);
+    leaf = false;
+    if (entries.size() == 1) {
+      root_ = entries.front().child;
+      return;
+    }
+  }
+}
+
+std::vector<RTree::Entry> RTree::Pack(std::vector<Entry>& entries, bool leaf) {
+  // Sort-Tile-Recursive: sorts on x, cuts into vertical slices of
+  // slice_count nodes and packs each slice sorted on y.
+  const size_t n{entries.size()};
+  const size_t node_count{(n + kMaxEntries - 1) / kMaxEntries};
+  const auto slice_count = static_cast<size_t>(
+      std::ceil(std::sqrt(static_cast<double>(node_count))));
+  const size_t slice_size{slice_count * kMaxEntries};
+
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return CenterX(a) < CenterX(b);
+  });
+
+  std::vector<Entry> parents;
+  parents.reserve(node_count);
+  for (size_t begin = 0; begin < n; begin += slice_size) {
+    const size_t end{std::min(begin + slice_size, n)};
+    std::sort(entries.begin() + begin, entries.begin() + end,
+              [](const auto& a, const auto& b) {
+                return CenterY(a) < CenterY(b);
+              });
+
+    for (size_t i = begin; i < end; i += kMaxEntries) {
+      const size_t node{NewNode(leaf)};
+      Node& packed{nodes_[node]};
+      packed.count = std::min(kMaxEntries, end - i);
+      std::copy_n(entries.begin() + i, packed.count, packed.entries.begin());
+      parents.push_back({NodeBox(node), node});
+    }
+  }
+  return parents;
+}
+
+void RTree::InsertEntry(const Entry& entry) {
+  const size_t sibling{InsertInto(root_, entry)};
+  if (sibling == kNone) {
+    return;
+  }
+  // The root was split, the tree grows one level.
+  const size_t root{NewNode(false)};
+  Node& node{nodes_[root]};
+  node.entries[0] = {NodeBox(root_), root_};
+  node.entries[1] = {NodeBox(sibling), sibling};
+  node.count = 2;
+  root_ = root;
+  height_++;
+}
+
+size_t RTree::InsertInto(size_t node, const Entry& entry) {
+  if (nodes_[node].leaf) {
+    return AddEntry(node, entry);
+  }
+
+  // The child that needs the least enlargement, then the smallest.
+  size_t best{0};
+  double best_enlargement{std::numeric_limits<double>::max()};
+  double best_area{std::numeric_limits<double>::max()};
+  for (size_t i = 0; i < nodes_[node].count; i++) {
+    const Box& box{nodes_[node].entries[i].box};
+    const double enlargement{Enlargement(box, entry.box)};
+    const double area{Area(box)};
+    if (enlargement < best_enlargement ||
+        (enlargement == best_enlargement && area < best_area)) {
+      best = i;
+      best_enlargement = enlargement;
+      best_area = area;
+    }
+  }
+
+  // No references into nodes_ are kept over the calls, they may add nodes.
+  const size_t child{nodes_[node].entries[best].child};
+  const size_t sibling{InsertInto(child, entry)};
+  nodes_[node].entries[best].box = NodeBox(child);
+  if (sibling == kNone) {
+    return kNone;
+  }
+  return AddEntry(node, {NodeBox(sibling), sibling});
+}
+
+size_t RTree::AddEntry(size_t node, const Entry& entry) {
+  if (nodes_[node].count < kMaxEntries) {
+    nodes_[node].entries[nodes_[node].count++] = entry;
+    return kNone;
+  }
+
+  // Quadratic split of the full node and the new entry.
+  std::vector<Entry> all(nodes_[node].entries.begin(),
+                         nodes_[node].entries.end());
+  all.emplace_back(entry);
+
+  size_t seed_a{0};
+  size_t seed_b{1};
+  double worst{std::numeric_limits<double>::lowest()};
+  for (size_t i = 0; i < all.size(); i++) {
+    for (size_t j = i + 1; j < all.size(); j++) {
+      const double waste{Area(Union(all[i].box, all[j].box)) -
+                         Area(all[i].box) - Area(all[j].box)};
+      if (waste > worst) {
+        worst = waste;
+        seed_a = i;
+        seed_b = j;
+      }
+    }
+  }
+
+  const size_t sibling{NewNode(nodes_[node].leaf)};
+  Node& a{nodes_[node]};
+  Node& b{nodes_[sibling]};
+  a.count = 0;
+  a.entries[a.count++] = all[seed_a];
+  b.entries[b.count++] = all[seed_b];
+  Box box_a{all[seed_a].box};
+  Box box_b{all[seed_b].box};
+
+  std::vector<Entry> rest;
+  for (size_t i = 0; i < all.size(); i++) {
+    if (i != seed_a && i != seed_b) {
+      rest.emplace_back(all[i]);
+    }
+  }
+
+  while (!rest.empty()) {
+    // Fills up a group that would otherwise end up too small.
+    if (a.count + rest.size() == kMinEntries ||
+        b.count + rest.size() == kMinEntries) {
+      Node& small{a.count + rest.size() == kMinEntries ? a : b};
+      for (const auto& e : rest) {
+        small.entries[small.count++] = e;
+      }
+      break;
+    }
+
+    // The entry with the strongest preference for one of the groups.
+    size_t pick{0};
+    double max_diff{-1.0};
+    for (size_t i = 0; i < rest.size(); i++) {
+      const double diff{std::abs(Enlargement(box_a, rest[i].box) -
+                                 Enlargement(box_b, rest[i].box))};
+      if (diff > max_diff) {
+        max_diff = diff;
+        pick = i;
+      }
+    }
+    const Entry e{rest[pick]};
+    rest[pick] = rest.back();
+    rest.pop_back();
+
+    const double grow_a{Enlargement(box_a, e.box)};
+    const double grow_b{Enlargement(box_b, e.box)};
+    bool to_a{grow_a < grow_b};
+    if (grow_a == grow_b) {
+      to_a = Area(box_a) < Area(box_b) ||
+             (Area(box_a) == Area(box_b) && a.count <= b.count);
+    }
+    if (to_a) {
+      a.entries[a.count++] = e;
+      box_a = Union(box_a, e.box);
+    } else {
+      b.entries[b.count++] = e;
+      box_b = Union(box_b, e.box);
+    }
+  }
+  return sibling;
+}
+
+bool RTree::RemoveEntry(const Entry& entry) {
+  std::vector<Entry> orphans;
+  if (!RemoveFrom(root_, entry, orphans)) {
+    return false;
+  }
+  size_--;
+
+  // A root with a single child is replaced by the child.
+  while (!nodes_[root_].leaf && nodes_[root_].count == 1) {
+    free_.emplace_back(root_);
+    root_ = nodes_[root_].entries[0].child;
+    height_--;
+  }
+  for (const auto& orphan : orphans) {
+    InsertEntry(orphan);
+  }
+  return true;
+}
+
+bool RTree::RemoveFrom(size_t node, const Entry& entry,
+                       std::vector<Entry>& orphans) {
+  Node& current{nodes_[node]};
+  if (current.leaf) {
+    for (size_t i = 0; i < current.count; i++) {
+      if (current.entries[i].child == entry.child &&
+          SameBox(current.entries[i].box, entry.box)) {
+        current.entries[i] = current.entries[--current.count];
+        return true;
+      }
+    }
+    return false;
+  }
+
+  for (size_t i = 0; i < current.count; i++) {
+    const size_t child{current.entries[i].child};
+    if (!Encloses(current.entries[i].box, entry.box) ||
+        !RemoveFrom(child, entry, orphans)) {
+      continue;
+    }
+    if (nodes_[child].count < kMinEntries) {
+      // Condenses the tree, the objects below child are inserted again.
+      Collect(child, orphans);
+      current.entries[i] = current.entries[--current.count];
+    } else {
+      current.entries[i].box = NodeBox(child);
+    }
+    return true;
+  }
+  return false;
+}
+
+void RTree::Collect(size_t node, std::vector<Entry>& objects) {
+  const Node& current{nodes_[node]};
+  for (size_t i = 0; i < current.count; i++) {
+    if (current.leaf) {
+      objects.emplace_back(current.entries[i]);
+    } else {
+      Collect(current.entries[i].child, objects);
+    }
+  }
+  free_.emplace_back(node);
+}
+
+size_t RTree::NewNode(bool leaf) {
+  size_t node{nodes_.size()};
+  if (free_.empty()) {
+    nodes_.emplace_back();
+  } else {
+    node = free_.back();
+    free_.pop_back();
+  }
+  nodes_[node].count = 0;
+  nodes_[node].leaf = leaf;
+  return node;
+}
+
+RTree::Box RTree::NodeBox(size_t node) const {
+  const Node& current{nodes_[node]};
+  Box box{std::numeric_limits<double>::max(),
+          std::numeric_limits<double>::max(),
+          std::numeric_limits<double>::lowest(),
+          std::numeric_limits<double>::lowest()};
+  for (size_t i = 0; i < current.count; i++) {
+    box = Union(box, current.entries[i].box);
+  }
+  return box;
+}
+
+}  // namespace algo::geometry
@@ -0,0 +1,378 @@
+///
+/// \brief Source file for geometry kernels on templated coordinates.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_geometry_kernel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "algo_geometry_hull.hpp"
+#include "algo_geometry_mesh.hpp"
+
+namespace algo::geometry {
+
+namespace {
+
+// Integer differences below these fit the determinants in 64 bits.
+constexpr int64_t kOrientLimit{int64_t{1} << 30};
+constexpr int64_t kInCircleLimit{int64_t{1} << 14};
+
+constexpr size_t kMinClosestPairPoints{2UL};
+constexpr size_t kMinHullCorners{3UL};
+
+inline int Sign(double v) {
+  return (v > 0.0) - (v < 0.0);
+}
+
+inline int Sign(int64_t v) {
+  return (v > 0) - (v < 0);
+}
+
+inline bool Small(int64_t v, int64_t limit) {
+  return v > -limit && v < limit;
+}
+
+template <typename T>
+int64_t Diff(T a, T b) {
+  return static_cast<int64_t>(a) - static_cast<int64_t>(b);
+}
+
+template <typename T>
+double D(T v) {
+  return static_cast<double>(v);
+}
+
+/// \brief Checks if q is within the bounding box of p and r, the three
+/// collinear.
+template <typename T>
+bool OnSegment(const BasicPoint<T>& p, const BasicPoint<T>& q,
+               const BasicPoint<T>& r) {
+  return q.x <= std::max(p.x, r.x) && q.x >= std::min(p.x, r.x) &&
+         q.y <= std::max(p.y, r.y) && q.y >= std::min(p.y, r.y);
+}
+
+template <typename T>
+bool LessXY(const BasicPoint<T>& p, const BasicPoint<T>& q) {
+  return p.x < q.x || (p.x == q.x && p.y < q.y);
+}
+
+/// \brief dx^2 + dy^2 of integer differences less than 2^32, exactly. The
+/// squares fit in 64 bits unsigned, hi is the carry of their sum.
+struct SquaredDistance {
+  uint64_t hi;
+  uint64_t lo;
+
+  bool operator<(const SquaredDistance& other) const {
+    return hi < other.hi || (hi == other.hi && lo < other.lo);
+  }
+};
+
+SquaredDistance Squared(int64_t dx, int64_t dy) {
+  const uint64_t ux{static_cast<uint64_t>(dx < 0 ? -dx : dx)};
+  const uint64_t uy{static_cast<uint64_t>(dy < 0 ? -dy : dy)};
+  const uint64_t lo{ux * ux + uy * uy};
+  return SquaredDistance{lo < ux * ux ? 1UL : 0UL, lo};
+}
+
+/// \brief A d with d^2 > dist, at most 2 more than the square root. Only
+/// bounds the search, the distances are compared exactly.
+int64_t SqrtBound(const SquaredDistance& dist) {
+  return static_cast<int64_t>(
+             std::sqrt(std::ldexp(D(dist.hi), 64) + D(dist.lo))) +
+         1;
+}
+
+/// \brief The closest pair sweep of BasicGrid on integer coordinates, with
+/// the distances compared exactly.
+template <typename T>
+std::pair<size_t, size_t> ClosestPairExact(
+    const std::vector<BasicPoint<T>>& points,
+    const std::vector<size_t>& order) {
+  // The points less than the closest distance behind the sweep, on y.
+  std::set<std::pair<int64_t, size_t>> active;
+  SquaredDistance best{};
+  bool found{false};
+  size_t first{order[0]};
+  size_t second{order[1]};
+  size_t left{0};
+  for (const size_t i : order) {
+    const int64_t x{points[i].x};
+    const int64_t y{points[i].y};
+    int64_t dist{0};
+    if (found) {
+      for (; best < Squared(x - points[order[left]].x, 0); left++) {
+        active.erase({points[order[left]].y, order[left]});
+      }
+      dist = SqrtBound(best);
+    }
+    auto it = found ? active.lower_bound({y - dist, 0}) : active.begin();
+    for (; it != active.end() && (!found || it->first <= y + dist); ++it) {
+      const SquaredDistance d{
+          Squared(x - points[it->second].x, y - it->first)};
+      if (!found || d < best) {
+        best = d;
+        found = true;
+        first = std::min(i, it->second);
+        second = std::max(i, it->second);
+        dist = SqrtBound(best);
+      }
+    }
+    active.emplace(y, i);
+  }
+  return {first, second};
+}
+
+template <typename T>
+PointCloud ToCloud(const std::vector<BasicPoint<T>>& points) {
+  PointCloud cloud;
+  cloud.Reserve(points.size());
+  for (const auto& p : points) {
+    cloud.PushBack(D(p.x), D(p.y));
+  }
+  return cloud;
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: Exact predicates
+
+template <typename T>
+int Orientation(const BasicPoint<T>& a, const BasicPoint<T>& b,
+                const BasicPoint<T>& c) {
+  if constexpr (std::is_integral_v<T>) {
+    const int64_t abx{Diff(b.x, a.x)};
+    const int64_t aby{Diff(b.y, a.y)};
+    const int64_t acx{Diff(c.x, a.x)};
+    const int64_t acy{Diff(c.y, a.y)};
+    if (Small(abx, kOrientLimit) && Small(aby, kOrientLimit) &&
+        Small(acx, kOrientLimit) && Small(acy, kOrientLimit)) {
+      return Sign(abx * acy - aby * acx);
+    }
+  }
+  return Sign(predicates::Orient2D(D(a.x), D(a.y), D(b.x), D(b.y), D(c.x),
+                                   D(c.y)));
+}
+
+template <typename T>
+int InCircle(const BasicPoint<T>& a, const BasicPoint<T>& b,
+             const BasicPoint<T>& c, const BasicPoint<T>& d) {
+  if constexpr (std::is_integral_v<T>) {
+    const int64_t adx{Diff(a.x, d.x)};
+    const int64_t ady{Diff(a.y, d.y)};
+    const int64_t bdx{Diff(b.x, d.x)};
+    const int64_t bdy{Diff(b.y, d.y)};
+    const int64_t cdx{Diff(c.x, d.x)};
+    const int64_t cdy{Diff(c.y, d.y)};
+    if (Small(adx, kInCircleLimit) && Small(ady, kInCircleLimit) &&
+        Small(bdx, kInCircleLimit) && Small(bdy, kInCircleLimit) &&
+        Small(cdx, kInCircleLimit) && Small(cdy, kInCircleLimit)) {
+      return Sign((adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) +
+                  (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy) +
+                  (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady));
+    }
+  }
+  return Sign(predicates::InCircle(D(a.x), D(a.y), D(b.x), D(b.y), D(c.x),
+                                   D(c.y), D(d.x), D(d.y)));
+}
+
+template <typename T>
+bool Intersect(const BasicEdge<T>& e, const BasicEdge<T>& f) {
+  const int o1{Orientation(e.first, e.second, f.first)};
+  const int o2{Orientation(e.first, e.second, f.second)};
+  const int o3{Orientation(f.first, f.second, e.first)};
+  const int o4{Orientation(f.first, f.second, e.second)};
+  return (o1 != o2 && o3 != o4) ||
+         (o1 == 0 && OnSegment(e.first, f.first, e.second)) ||
+         (o2 == 0 && OnSegment(e.first, f.second, e.second)) ||
+         (o3 == 0 && OnSegment(f.first, e.first, f.second)) ||
+         (o4 == 0 && OnSegment(f.first, e.second, f.second));
+}
+
+// /////////////////////////////
+// MARK: BasicGrid
+
+template <typename T>
+BasicGrid<T>::BasicGrid(std::vector<BasicPoint<T>> points)
+    : points_{std::move(points)} {}
+
+template <typename T>
+const std::vector<BasicPoint<T>>& BasicGrid<T>::GetPoints() const {
+  return points_;
+}
+
+template <typename T>
+std::pair<BasicPoint<T>, BasicPoint<T>> BasicGrid<T>::ClosestPairOfPoints()
+    const {
+  const size_t n{points_.size()};
+  if (n < kMinClosestPairPoints) {
+    throw std::invalid_argument("Too few points in input.");
+  }
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+    return points_[i].x < points_[j].x;
+  });
+  if constexpr (std::is_integral_v<T>) {
+    const auto [first, second] = ClosestPairExact(points_, order);
+    return {points_[first], points_[second]};
+  }
+
+  // The points less than the closest distance behind the sweep, on y.
+  std::set<std::pair<double, size_t>> active;
+  double best{std::numeric_limits<double>::infinity()};
+  size_t first{order[0]};
+  size_t second{order[1]};
+  size_t left{0};
+  for (const size_t i : order) {
+    const double x{D(points_[i].x)};
+    const double y{D(points_[i].y)};
+    const double dist{std::sqrt(best)};
+    for (; x - D(points_[order[left]].x) > dist; left++) {
+      active.erase({D(points_[order[left]].y), order[left]});
+    }
+    for (auto it = active.lower_bound({y - dist, 0});
+         it != active.end() && it->first <= y + dist; ++it) {
+      const double dx{x - D(points_[it->second].x)};
+      const double dy{y - it->first};
+      if (dx * dx + dy * dy < best) {
+        best = dx * dx + dy * dy;
+        first = std::min(i, it->second);
+        second = std::max(i, it->second);
+      }
+    }
+    active.emplace(y, i);
+  }
+  return {points_[first], points_[second]};
+}
+
+template <typename T>
+std::vector<BasicPoint<T>> BasicGrid<T>::ConvexHull() const {
+  std::vector<BasicPoint<T>> sorted{points_};
+  std::sort(sorted.begin(), sorted.end(), LessXY<T>);
+
+  // Lower hull left to right, then upper hull right to left.
+  std::vector<BasicPoint<T>> hull;
+  for (const auto& p : sorted) {
+    while (hull.size() >= 2 &&
+           Orientation(hull[hull.size() - 2], hull.back(), p) <= 0) {
+      hull.pop_back();
+    }
+    hull.push_back(p);
+  }
+  const size_t lower{hull.size() + 1};
+  for (auto it = sorted.rbegin(); it != sorted.rend(); ++it) {
+    while (hull.size() >= lower &&
+           Orientation(hull[hull.size() - 2], hull.back(), *it) <= 0) {
+      hull.pop_back();
+    }
+    hull.push_back(*it);
+  }
+  hull.pop_back();
+  if (hull.size() < kMinHullCorners) {
+    throw std::invalid_argument("The hull has less than three corners.");
+  }
+
+  const auto lowest = std::min_element(
+      hull.begin(), hull.end(), [](const auto& p, const auto& q) {
+        return p.y < q.y || (p.y == q.y && p.x < q.x);
+      });
+  std::rotate(hull.begin(), lowest, hull.end());
+  return hull;
+}
+
+template <typename T>
+Polygon BasicGrid<T>::MinBoundingBox() const {
+  const auto box = RotatingCalipers(ToCloud(ConvexHull())).min_area_box;
+  return Polygon{std::vector<Point>{box.corners.begin(), box.corners.end()}};
+}
+
+template <typename T>
+Circle BasicGrid<T>::MinEnclosingCircle() const {
+  return Grid{ToCloud(points_)}.MinEnclosingCircle();
+}
+
+template <typename T>
+std::vector<BasicEdge<T>> BasicGrid<T>::Triangulation() const {
+  std::vector<BasicPoint<T>> sorted{points_};
+  std::sort(sorted.begin(), sorted.end(), LessXY<T>);
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+  // The hull so far as a lower and an upper chain, both ending at the last
+  // point. A chain edge is seen from p if p is strictly outside of it.
+  std::vector<BasicEdge<T>> edges;
+  std::vector<BasicPoint<T>> lower;
+  std::vector<BasicPoint<T>> upper;
+  for (const auto& p : sorted) {
+    if (!lower.empty()) {
+      edges.push_back({lower.back(), p});
+    }
+    while (lower.size() >= 2 &&
+           Orientation(lower[lower.size() - 2], lower.back(), p) < 0) {
+      lower.pop_back();
+      edges.push_back({lower.back(), p});
+    }
+    while (upper.size() >= 2 &&
+           Orientation(upper[upper.size() - 2], upper.back(), p) > 0) {
+      upper.pop_back();
+      edges.push_back({upper.back(), p});
+    }
+    lower.push_back(p);
+    upper.push_back(p);
+  }
+  return edges;
+}
+
+template <typename T>
+std::vector<BasicEdge<T>> BasicGrid<T>::DelaunayTriangulation() const {
+  const auto mesh = TriangleMesh::Delaunay(ToCloud(points_));
+  const auto& vertices = mesh.Vertices();
+  const auto& twins = mesh.Twins();
+  std::vector<BasicEdge<T>> edges;
+  for (size_t e = 0; e < vertices.size(); e++) {
+    // Interior edges are visited from both sides, keep one of them.
+    if (twins[e] == TriangleMesh::kNone || e < twins[e]) {
+      edges.push_back({points_[vertices[e]],
+                       points_[vertices[TriangleMesh::Next(e)]]});
+    }
+  }
+  return edges;
+}
+
+// /////////////////////////////
+// MARK: Instantiations
+
+template int Orientation(const PointF&, const PointF&, const PointF&);
+template int Orientation(const BasicPoint<double>&, const BasicPoint<double>&,
+                         const BasicPoint<double>&);
+template int Orientation(const PointI&, const PointI&, const PointI&);
+
+template int InCircle(const PointF&, const PointF&, const PointF&,
+                      const PointF&);
+template int InCircle(const BasicPoint<double>&, const BasicPoint<double>&,
+                      const BasicPoint<double>&, const BasicPoint<double>&);
+template int InCircle(const PointI&, const PointI&, const PointI&,
+                      const PointI&);
+
+template bool Intersect(const EdgeF&, const EdgeF&);
+template bool Intersect(const BasicEdge<double>&, const BasicEdge<double>&);
+template bool Intersect(const EdgeI&, const EdgeI&);
+
+template class BasicGrid<float>;
+template class BasicGrid<double>;
+template class BasicGrid<int32_t>;
+
+}  // namespace algo::geometry
@@ -0,0 +1,801 @@
+///
+/// \brief Source file for triangle meshes.
+/// \author alex011235
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_geometry_mesh.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algo_geometry_hull.hpp"
+
+namespace algo::geometry {
+
+// /////////////////////////////
+// MARK: TriangleMesh
+
+TriangleMesh::TriangleMesh(PointCloud points, std::vector<size_t> vertices,
+                           std::vector<size_t> twins)
+    : points_{std::move(points)},
+      vertices_{std::move(vertices)},
+      twins_{std::move(twins)} {
+  if (vertices_.size() % 3 != 0 || vertices_.size() != twins_.size()) {
+    throw std::invalid_argument("Not three half-edges per triangle.");
+  }
+}
+
+size_t TriangleMesh::TriangleCount() const {
+  return vertices_.size() / 3;
+}
+
+size_t TriangleMesh::HalfEdgeCount() const {
+  return vertices_.size();
+}
+
+size_t TriangleMesh::Vertex(size_t e) const {
+  return vertices_.at(e);
+}
+
+size_t TriangleMesh::Twin(size_t e) const {
+  return twins_.at(e);
+}
+
+bool TriangleMesh::IsConstrained(size_t e) const {
+  if (e >= vertices_.size()) {
+    throw std::out_of_range("No such half-edge.");
+  }
+  return !constrained_.empty() && constrained_[e] != 0;
+}
+
+size_t TriangleMesh::Next(size_t e) {
+  return (e % 3 == 2) ? e - 2 : e + 1;
+}
+
+size_t TriangleMesh::Prev(size_t e) {
+  return (e % 3 == 0) ? e + 2 : e - 1;
+}
+
+std::array<size_t, 3> TriangleMesh::TriangleVertices(size_t t) const {
+  return {vertices_.at(3 * t), vertices_.at(3 * t + 1),
+          vertices_.at(3 * t + 2)};
+}
+
+std::array<size_t, 3> TriangleMesh::TriangleNeighbors(size_t t) const {
+  std::array<size_t, 3> neighbors{};
+  for (size_t i = 0; i < 3; i++) {
+    const size_t twin{twins_.at(3 * t + i)};
+    neighbors.at(i) = twin == kNone ? kNone : twin / 3;
+  }
+  return neighbors;
+}
+
+Triangle TriangleMesh::GetTriangle(size_t t) const {
+  const auto v = TriangleVertices(t);
+  return Triangle{points_.At(v[0]), points_.At(v[1]), points_.At(v[2])};
+}
+
+std::vector<Triangle> TriangleMesh::GetTriangles() const {
+  std::vector<Triangle> triangles;
+  triangles.reserve(TriangleCount());
+  for (size_t t = 0; t < TriangleCount(); t++) {
+    triangles.emplace_back(GetTriangle(t));
+  }
+  return triangles;
+}
+
+std::vector<Edge> TriangleMesh::GetEdges() const {
+  std::vector<Edge> edges;
+  for (size_t e = 0; e < HalfEdgeCount(); e++) {
+    // Interior edges are visited from both sides, keep one of them.
+    if (twins_[e] == kNone || e < twins_[e]) {
+      edges.emplace_back(points_.At(vertices_[e]),
+                         points_.At(vertices_[Next(e)]));
+    }
+  }
+  return edges;
+}
+
+const PointCloud& TriangleMesh::GetCloud() const {
+  return points_;
+}
+
+const std::vector<size_t>& TriangleMesh::Vertices() const {
+  return vertices_;
+}
+
+const std::vector<size_t>& TriangleMesh::Twins() const {
+  return twins_;
+}
+
+// /////////////////////////////
+// MARK: Delaunay
+
+// Divide and conquer Delaunay triangulation on a quad-edge structure.
+// L. Guibas and J. Stolfi, "Primitives for the Manipulation of General
+// Subdivisions and the Computation of Voronoi Diagrams", 1985.
+
+namespace {
+
+using QuadIndex = uint32_t;
+
+/// \brief Quad-edge store. Directed edge e = 4q + r is rotation r of quad-edge
+/// q, r = 0 and r = 2 are the primal edges and r = 1, 3 their duals. The
+/// points must be sorted lexicographically and free from duplicates.
+class QuadEdgeDelaunay {
+ public:
+  explicit QuadEdgeDelaunay(const PointCloud& sorted)
+      : xs_{sorted.Xs().data()}, ys_{sorted.Ys().data()}, size_{sorted.Size()} {
+    const size_t max_edges{3 * size_};
+    next_.reserve(4 * max_edges);
+    org_.reserve(2 * max_edges);
+    alive_.reserve(max_edges);
+  }
+
+  /// \brief Triangulates and returns the mesh half-edge arrays.
+  std::pair<std::vector<size_t>, std::vector<size_t>> Run() {
+    Divide(0, size_);
+    return Extract();
+  }
+
+ private:
+  static QuadIndex Rot(QuadIndex e) { return (e & ~3U) | ((e + 1U) & 3U); }
+  static QuadIndex RotInv(QuadIndex e) { return (e & ~3U) | ((e + 3U) & 3U); }
+  static QuadIndex Sym(QuadIndex e) { return e ^ 2U; }
+
+  QuadIndex Onext(QuadIndex e) const { return next_[e]; }
+  QuadIndex Oprev(QuadIndex e) const { return Rot(Onext(Rot(e))); }
+  QuadIndex Lnext(QuadIndex e) const { return Rot(Onext(RotInv(e))); }
+  QuadIndex Rprev(QuadIndex e) const { return Onext(Sym(e)); }
+  size_t Org(QuadIndex e) const { return org_[e >> 1U]; }
+  size_t Dest(QuadIndex e) const { return org_[Sym(e) >> 1U]; }
+
+  bool Ccw(size_t a, size_t b, size_t c) const {
+    return predicates::Orient2D(xs_[a], ys_[a], xs_[b], ys_[b], xs_[c],
+                                ys_[c]) > 0.0;
+  }
+
+  bool InCircle(size_t a, size_t b, size_t c, size_t d) const {
+    return predicates::InCircle(xs_[a], ys_[a], xs_[b], ys_[b], xs_[c], ys_[c],
+                                xs_[d], ys_[d]) > 0.0;
+  }
+
+  bool RightOf(size_t x, QuadIndex e) const { return Ccw(x, Dest(e), Org(e)); }
+  bool LeftOf(size_t x, QuadIndex e) const { return Ccw(x, Org(e), Dest(e)); }
+
+  QuadIndex MakeEdge(size_t org, size_t dest) {
+    QuadIndex e{0};
+    if (free_.empty()) {
+      e = static_cast<QuadIndex>(next_.size());
+      next_.insert(next_.end(), {e, e + 3, e + 2, e + 1});
+      org_.insert(org_.end(), {0, 0});
+      alive_.push_back(1);
+    } else {
+      e = free_.back();
+      free_.pop_back();
+      alive_[e >> 2U] = 1;
+    }
+    next_[e] = e;
+    next_[e + 1] = e + 3;
+    next_[e + 2] = e + 2;
+    next_[e + 3] = e + 1;
+    org_[e >> 1U] = static_cast<QuadIndex>(org);
+    org_[(e + 2) >> 1U] = static_cast<QuadIndex>(dest);
+    return e;
+  }
+
+  void Splice(QuadIndex a, QuadIndex b) {
+    const QuadIndex alpha{Rot(Onext(a))};
+    const QuadIndex beta{Rot(Onext(b))};
+    std::swap(next_[a], next_[b]);
+    std::swap(next_[alpha], next_[beta]);
+  }
+
+  QuadIndex Connect(QuadIndex a, QuadIndex b) {
+    const QuadIndex e{MakeEdge(Dest(a), Org(b))};
+    Splice(e, Lnext(a));
+    Splice(Sym(e), b);
+    return e;
+  }
+
+  void DeleteEdge(QuadIndex e) {
+    Splice(e, Oprev(e));
+    Splice(Sym(e), Oprev(Sym(e)));
+    alive_[e >> 2U] = 0;
+    free_.push_back(e & ~3U);
+  }
+
+  /// \brief Triangulates the points [lo, hi), returns the counter clockwise convex
+  /// hull edge out of the leftmost vertex and the clockwise convex hull edge
+  /// out of the rightmost vertex.
+  // NOLINTNEXTLINE
+  std::pair<QuadIndex, QuadIndex> Divide(size_t lo, size_t hi) {
+    const size_t n{hi - lo};
+
+    if (n == 2) {
+      const QuadIndex a{MakeEdge(lo, lo + 1)};
+      return {a, Sym(a)};
+    }
+
+    if (n == 3) {
+      const size_t s1{lo};
+      const size_t s2{lo + 1};
+      const size_t s3{lo + 2};
+      const QuadIndex a{MakeEdge(s1, s2)};
+      const QuadIndex b{MakeEdge(s2, s3)};
+      Splice(Sym(a), b);
+
+      if (Ccw(s1, s2, s3)) {
+        Connect(b, a);
+        return {a, Sym(b)};
+      }
+      if (Ccw(s1, s3, s2)) {
+        const QuadIndex c{Connect(b, a)};
+        return {Sym(c), c};
+      }
+      // Collinear.
+      return {a, Sym(b)};
+    }
+
+    const size_t mid{lo + n / 2};
+    auto [ldo, ldi] = Divide(lo, mid);
+    auto [rdi, rdo] = Divide(mid, hi);
+
+    // Find the lower common tangent of the two halves.
+    while (true) {
+      if (LeftOf(Org(rdi), ldi)) {
+        ldi = Lnext(ldi);
+      } else if (RightOf(Org(ldi), rdi)) {
+        rdi = Rprev(rdi);
+      } else {
+        break;
+      }
+    }
+
+    QuadIndex basel{Connect(Sym(rdi), ldi)};
+    if (Org(ldi) == Org(ldo)) {
+      ldo = Sym(basel);
+    }
+    if (Org(rdi) == Org(rdo)) {
+      rdo = basel;
+    }
+
+    const auto valid = [this, &basel](QuadIndex e) {
+      return RightOf(Dest(e), basel);
+    };
+
+    // Merge, zip the two halves together bottom up.
+    while (true) {
+      QuadIndex lcand{Onext(Sym(basel))};
+      if (valid(lcand)) {
+        while (InCircle(Dest(basel), Org(basel), Dest(lcand),
+                        Dest(Onext(lcand)))) {
+          const QuadIndex t{Onext(lcand)};
+          DeleteEdge(lcand);
+          lcand = t;
+        }
+      }
+
+      QuadIndex rcand{Oprev(basel)};
+      if (valid(rcand)) {
+        while (InCircle(Dest(basel), Org(basel), Dest(rcand),
+                        Dest(Oprev(rcand)))) {
+          const QuadIndex t{Oprev(rcand)};
+          DeleteEdge(rcand);
+          rcand = t;
+        }
+      }
+
+      const bool lvalid{valid(lcand)};
+      const bool rvalid{valid(rcand)};
+      if (!lvalid && !rvalid) {
+        break;
+      }
+
+      if (!lvalid || (rvalid && InCircle(Dest(lcand), Org(lcand), Org(rcand),
+                                         Dest(rcand)))) {
+        basel = Connect(rcand, Sym(basel));
+      } else {
+        basel = Connect(Sym(basel), Sym(lcand));
+      }
+    }
+    return {ldo, rdo};
+  }
+
+  /// \brief Collects the bounded triangular faces into half-edge arrays.
+  std::pair<std::vector<size_t>, std::vector<size_t>> Extract() const {
+    constexpr size_t kUnset{TriangleMesh::kNone};
+    // Half-edge slot of each primal directed edge, indexed by e >> 1.
+    std::vector<size_t> slot(org_.size(), kUnset);
+    std::vector<QuadIndex> edge_of_slot;
+    std::vector<size_t> vertices;
+    edge_of_slot.reserve(org_.size());
+    vertices.reserve(org_.size());
+
+    for (QuadIndex q = 0; q < alive_.size(); q++) {
+      if (!alive_[q]) {
+        continue;
+      }
+      for (const QuadIndex e : {4 * q, 4 * q + 2}) {
+        if (slot[e >> 1U] != kUnset) {
+          continue;
+        }
+        const QuadIndex b{Lnext(e)};
+        const QuadIndex c{Lnext(b)};
+        if (Lnext(c) != e || !Ccw(Org(e), Org(b), Org(c))) {
+          continue;  // Outer face.
+        }
+        for (const QuadIndex side : {e, b, c}) {
+          slot[side >> 1U] = vertices.size();
+          edge_of_slot.push_back(side);
+          vertices.push_back(Org(side));
+        }
+      }
+    }
+
+    std::vector<size_t> twins(vertices.size(), TriangleMesh::kNone);
+    for (size_t h = 0; h < vertices.size(); h++) {
+      twins[h] = slot[Sym(edge_of_slot[h]) >> 1U];
+    }
+    return {std::move(vertices), std::move(twins)};
+  }
+
+  const double* xs_;
+  const double* ys_;
+  std::vector<QuadIndex> next_;
+  std::vector<QuadIndex> org_;
+  std::vector<uint8_t> alive_;
+  std::vector<QuadIndex> free_;
+  size_t size_;
+};
+
+}  // namespace
+
+TriangleMesh TriangleMesh::Delaunay(PointCloud points) {
+  const auto& xs = points.Xs();
+  const auto& ys = points.Ys();
+
+  // Sort lexicographically and drop duplicated points.
+  std::vector<size_t> order(points.Size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&xs, &ys](size_t a, size_t b) {
+    return xs[a] < xs[b] || (xs[a] == xs[b] && ys[a] < ys[b]);
+  });
+  order.erase(std::unique(order.begin(), order.end(),
+                          [&xs, &ys](size_t a, size_t b) {
+                            return xs[a] == xs[b] && ys[a] == ys[b];
+                          }),
+              order.end());
+
+  if (order.size() < 3) {
+    return TriangleMesh{std::move(points), {}, {}};
+  }
+
+  // The quad-edge origins refer to positions in the sorted order.
+  std::vector<double> sorted_xs(order.size());
+  std::vector<double> sorted_ys(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    sorted_xs[i] = xs[order[i]];
+    sorted_ys[i] = ys[order[i]];
+  }
+  const PointCloud sorted{std::move(sorted_xs), std::move(sorted_ys)};
+
+  QuadEdgeDelaunay delaunay{sorted};
+  auto [vertices, twins] = delaunay.Run();
+  for (auto& v : vertices) {
+    v = order[v];
+  }
+  return TriangleMesh{std::move(points), std::move(vertices), std::move(twins)};
+}
+
+// /////////////////////////////
+// MARK: Constrained Delaunay
+
+// S. W. Sloan, "A fast algorithm for generating constrained Delaunay
+// triangulations", 1993. The edges that cross a constraint are flipped until
+// none is left, then the new edges are legalized with Lawson's flips, which
+// stop at constrained edges.
+
+namespace {
+
+/// \brief Inserts constraints into a Delaunay triangulation, flipping edges
+/// in the half-edge arrays of a mesh.
+class ConstraintInserter {
+ public:
+  ConstraintInserter(const PointCloud& points, std::vector<size_t>& vertices,
+                     std::vector<size_t>& twins,
+                     std::vector<uint8_t>& constrained)
+      : xs_{points.Xs().data()},
+        ys_{points.Ys().data()},
+        vertices_{vertices},
+        twins_{twins},
+        constrained_{constrained},
+        out_(points.Size(), kNone) {
+    for (size_t e = 0; e < vertices_.size(); e++) {
+      out_[vertices_[e]] = e;
+    }
+  }
+
+  /// \brief Checks if a point is a vertex of the mesh.
+  bool InMesh(size_t v) const { return out_[v] != kNone; }
+
+  /// \brief Makes the segment ab edges of the mesh.
+  void Insert(size_t a, size_t b) {
+    while (a != b) {
+      const auto [first, end] = Leave(a, b);
+      if (first != kNone) {
+        // Flips away the edges between a and end, the next point on ab.
+        std::deque<std::pair<size_t, size_t>> crossed;
+        for (size_t h = first;;) {
+          if (constrained_[h] != 0) {
+            throw std::invalid_argument("Constraints cross.");
+          }
+          crossed.emplace_back(vertices_[h], vertices_[TriangleMesh::Next(h)]);
+          const size_t t{twins_[h]};
+          const size_t w{vertices_[TriangleMesh::Prev(t)]};
+          if (w == end) {
+            break;
+          }
+          h = Orient(a, end, w) > 0 ? TriangleMesh::Next(t)
+                                    : TriangleMesh::Prev(t);
+        }
+        FlipCrossed(crossed, a, end);
+      }
+      Mark(a, end);
+      a = end;
+    }
+  }
+
+ private:
+  static constexpr size_t kNone{TriangleMesh::kNone};
+
+  int Orient(size_t a, size_t b, size_t c) const {
+    const double det{predicates::Orient2D(xs_[a], ys_[a], xs_[b], ys_[b],
+                                          xs_[c], ys_[c])};
+    return (det > 0.0) - (det < 0.0);
+  }
+
+  /// \brief Returns the most clockwise outgoing half-edge of v, the one on
+  /// the boundary if v is on it. With NextAround, the outgoing half-edges are
+  /// walked counter clockwise in place:
+  ///
+  /// for (size_t e = start; e != kNone; e = NextAround(e, start))
+  size_t FirstAround(size_t v) const {
+    size_t start{out_[v]};
+    for (size_t e = start; twins_[e] != kNone;) {
+      e = TriangleMesh::Next(twins_[e]);
+      if (e == out_[v]) {
+        break;
+      }
+      start = e;
+    }
+    return start;
+  }
+
+  /// \brief Returns the outgoing half-edge after e counter clockwise, kNone
+  /// after the last one or back at start.
+  size_t NextAround(size_t e, size_t start) const {
+    const size_t next{twins_[TriangleMesh::Prev(e)]};
+    return next == start ? kNone : next;
+  }
+
+  /// \brief Returns the half-edge from u to v, kNone if there is none.
+  size_t Find(size_t u, size_t v) const {
+    const size_t start{FirstAround(u)};
+    for (size_t e = start; e != kNone; e = NextAround(e, start)) {
+      if (vertices_[TriangleMesh::Next(e)] == v) {
+        return e;
+      }
+    }
+    return kNone;
+  }
+
+  /// \brief Marks the edge between u and v as constrained.
+  void Mark(size_t u, size_t v) {
+    size_t e{Find(u, v)};
+    e = e == kNone ? Find(v, u) : e;
+    constrained_[e] = 1;
+    if (twins_[e] != kNone) {
+      constrained_[twins_[e]] = 1;
+    }
+  }
+
+  /// \brief Finds where ab leaves a. Returns the first edge that ab
+  /// crosses and the next point on ab, or kNone and the point if there is an
+  /// edge along ab.
+  std::pair<size_t, size_t> Leave(size_t a, size_t b) const {
+    const auto along = [&](size_t v) {
+      return v == b ||
+             (Orient(a, b, v) == 0 && (xs_[v] - xs_[a]) * (xs_[b] - xs_[a]) +
+                                              (ys_[v] - ys_[a]) *
+                                                  (ys_[b] - ys_[a]) >
+                                          0.0);
+    };
+    const size_t start{FirstAround(a)};
+    for (size_t e = start; e != kNone; e = NextAround(e, start)) {
+      const size_t v1{vertices_[TriangleMesh::Next(e)]};
+      const size_t v2{vertices_[TriangleMesh::Prev(e)]};
+      // On the boundary the last edge only goes from v2 to a.
+      for (const size_t v : {v1, v2}) {
+        if (along(v)) {
+          return {kNone, v};
+        }
+      }
+      if (Orient(a, b, v1) < 0 && Orient(a, b, v2) > 0) {
+        // Through the triangle, crosses the opposite edge.
+        const size_t first{TriangleMesh::Next(e)};
+        // The next point on ab is where the walk stops.
+        for (size_t h = first;;) {
+          const size_t t{twins_[h]};
+          const size_t w{vertices_[TriangleMesh::Prev(t)]};
+          const int o{Orient(a, b, w)};
+          if (w == b || o == 0) {
+            return {first, w};
+          }
+          h = o > 0 ? TriangleMesh::Next(t) : TriangleMesh::Prev(t);
+        }
+      }
+    }
+    throw std::invalid_argument("Constraint outside the triangulation.");
+  }
+
+  void Set(size_t h, size_t v, size_t twin, uint8_t flag) {
+    vertices_[h] = v;
+    twins_[h] = twin;
+    if (twin != kNone) {
+      twins_[twin] = h;
+    }
+    constrained_[h] = flag;
+    out_[v] = h;
+  }
+
+  /// \brief Flips the diagonal e of the two triangles (a, b, c) and
+  /// (b, a, d) to the triangles (a, d, c) and (b, c, d).
+  void Flip(size_t e) {
+    const size_t f{twins_[e]};
+    const size_t t1{e - e % 3};
+    const size_t t2{f - f % 3};
+    const size_t a{vertices_[e]};
+    const size_t b{vertices_[TriangleMesh::Next(e)]};
+    const size_t c{vertices_[TriangleMesh::Prev(e)]};
+    const size_t d{vertices_[TriangleMesh::Prev(f)]};
+    const size_t bc{TriangleMesh::Next(e)};
+    const size_t ca{TriangleMesh::Prev(e)};
+    const size_t ad{TriangleMesh::Next(f)};
+    const size_t db{TriangleMesh::Prev(f)};
+    const size_t bc_twin{twins_[bc]};
+    const size_t ca_twin{twins_[ca]};
+    const size_t ad_twin{twins_[ad]};
+    const size_t db_twin{twins_[db]};
+    const uint8_t bc_flag{constrained_[bc]};
+    const uint8_t ca_flag{constrained_[ca]};
+    const uint8_t ad_flag{constrained_[ad]};
+    const uint8_t db_flag{constrained_[db]};
+
+    Set(t1, a, ad_twin, ad_flag);
+    Set(t1 + 1, d, t2 + 1, 0);
+    Set(t1 + 2, c, ca_twin, ca_flag);
+    Set(t2, b, bc_twin, bc_flag);
+    Set(t2 + 1, c, t1 + 1, 0);
+    Set(t2 + 2, d, db_twin, db_flag);
+  }
+
+  /// \brief Flips the edges that cross ab, then legalizes the new edges.
+  void FlipCrossed(std::deque<std::pair<size_t, size_t>>& crossed, size_t a,
+                   size_t b) {
+    std::vector<std::pair<size_t, size_t>> created;
+    while (!crossed.empty()) {
+      const auto [u, v] = crossed.front();
+      crossed.pop_front();
+      const size_t e{Find(u, v)};
+      const size_t c{vertices_[TriangleMesh::Prev(e)]};
+      const size_t d{vertices_[TriangleMesh::Prev(twins_[e])]};
+      // Only the diagonal of a convex quadrilateral can be flipped.
+      if (Orient(c, d, u) * Orient(c, d, v) >= 0) {
+        crossed.emplace_back(u, v);
+        continue;
+      }
+      Flip(e);
+      if (Orient(a, b, c) * Orient(a, b, d) < 0) {
+        crossed.emplace_back(c, d);
+      } else {
+        created.emplace_back(c, d);
+      }
+    }
+
+    // Lawson's flips, from the new edges outwards.
+    while (!created.empty()) {
+      const auto [u, v] = created.back();
+      created.pop_back();
+      const size_t e{Find(u, v)};
+      if (e == kNone || twins_[e] == kNone || constrained_[e] != 0 ||
+          (u == a && v == b) || (u == b && v == a)) {
+        continue;
+      }
+      const size_t c{vertices_[TriangleMesh::Prev(e)]};
+      const size_t d{vertices_[TriangleMesh::Prev(twins_[e])]};
+      if (predicates::InCircle(xs_[u], ys_[u], xs_[v], ys_[v], xs_[c], ys_[c],
+                               xs_[d], ys_[d]) > 0.0) {
+        Flip(e);
+        created.insert(created.end(), {{u, c}, {c, v}, {v, d}, {d, u}});
+      }
+    }
+  }
+
+  const double* xs_;
+  const double* ys_;
+  std::vector<size_t>& vertices_;
+  std::vector<size_t>& twins_;
+  std::vector<uint8_t>& constrained_;
+  std::vector<size_t> out_;  // An outgoing half-edge of each vertex.
+};
+
+}  // namespace
+
+TriangleMesh TriangleMesh::ConstrainedDelaunay(
+    PointCloud points,
+    const std::vector<std::pair<size_t, size_t>>& constraints) {
+  for (const auto& [a, b] : constraints) {
+    if (a >= points.Size() || b >= points.Size()) {
+      throw std::invalid_argument("Constraint index out of range.");
+    }
+  }
+  TriangleMesh mesh{Delaunay(std::move(points))};
+  mesh.constrained_.assign(mesh.vertices_.size(), 0);
+  if (mesh.vertices_.empty()) {
+    return mesh;
+  }
+
+  ConstraintInserter inserter{mesh.points_, mesh.vertices_, mesh.twins_,
+                              mesh.constrained_};
+
+  // Duplicated points are triangulated once, the constraints use that one.
+  const auto& xs = mesh.points_.Xs();
+  const auto& ys = mesh.points_.Ys();
+  std::vector<size_t> order(mesh.points_.Size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&xs, &ys](size_t a, size_t b) {
+    return xs[a] < xs[b] || (xs[a] == xs[b] && ys[a] < ys[b]);
+  });
+  std::vector<size_t> same(mesh.points_.Size());
+  for (size_t i = 0, j = 0; i < order.size(); i = j) {
+    size_t kept{order[i]};
+    for (j = i; j < order.size() && xs[order[j]] == xs[order[i]] &&
+                ys[order[j]] == ys[order[i]];
+         j++) {
+      kept = inserter.InMesh(order[j]) ? order[j] : kept;
+    }
+    for (size_t k = i; k < j; k++) {
+      same[order[k]] = kept;
+    }
+  }
+
+  for (const auto& [a, b] : constraints) {
+    inserter.Insert(same[a], same[b]);
+  }
+  return mesh;
+}
+
+// /////////////////////////////
+// MARK: Voronoi
+
+std::vector<VoronoiCell> VoronoiDiagram(const PointCloud& sites,
+                                        const Rectangle& box) {
+  const size_t n{sites.Size()};
+  if (n == 0) {
+    return {};
+  }
+
+  // Four sites around everything, far enough to be nearer to no point in
+  // the box than any of the sites.
+  const Point corner{box.GetPoint()};
+  const auto [xs_min, xs_max] =
+      std::minmax_element(sites.Xs().begin(), sites.Xs().end());
+  const auto [ys_min, ys_max] =
+      std::minmax_element(sites.Ys().begin(), sites.Ys().end());
+  const double x_min{std::min(corner.X(), *xs_min)};
+  const double y_min{std::min(corner.Y(), *ys_min)};
+  const double x_max{std::max(corner.X() + box.GetWidth(), *xs_max)};
+  const double y_max{std::max(corner.Y() + box.GetHeight(), *ys_max)};
+  const double cx{(x_min + x_max) / 2.0};
+  const double cy{(y_min + y_max) / 2.0};
+  const double far{10.0 * std::max(x_max - x_min, y_max - y_min)};
+  PointCloud all{sites};
+  all.PushBack(cx - far, cy - far);
+  all.PushBack(cx + far, cy - far);
+  all.PushBack(cx + far, cy + far);
+  all.PushBack(cx - far, cy + far);
+  const TriangleMesh mesh{TriangleMesh::Delaunay(std::move(all))};
+  const PointCloud& points{mesh.GetCloud()};
+
+  // Circum center of each triangle.
+  std::vector<double> centers_x(mesh.TriangleCount());
+  std::vector<double> centers_y(mesh.TriangleCount());
+  for (size_t t = 0; t < mesh.TriangleCount(); t++) {
+    const auto v = mesh.TriangleVertices(t);
+    const double ax{points.X(v[0])};
+    const double ay{points.Y(v[0])};
+    const double bx{points.X(v[1]) - ax};
+    const double by{points.Y(v[1]) - ay};
+    const double qx{points.X(v[2]) - ax};
+    const double qy{points.Y(v[2]) - ay};
+    const double d{2.0 * (bx * qy - by * qx)};
+    const double b2{bx * bx + by * by};
+    const double q2{qx * qx + qy * qy};
+    centers_x[t] = ax + (qy * b2 - by * q2) / d;
+    centers_y[t] = ay + (bx * q2 - qx * b2) / d;
+  }
+
+  std::vector<size_t> out(n, TriangleMesh::kNone);
+  for (size_t e = 0; e < mesh.HalfEdgeCount(); e++) {
+    if (mesh.Vertex(e) < n) {
+      out[mesh.Vertex(e)] = e;
+    }
+  }
+
+  const double box_x[2]{corner.X(), corner.X() + box.GetWidth()};
+  const double box_y[2]{corner.Y(), corner.Y() + box.GetHeight()};
+  std::vector<VoronoiCell> cells;
+  std::vector<double> ring_x;
+  std::vector<double> ring_y;
+  std::vector<double> kept_x;
+  std::vector<double> kept_y;
+  for (size_t v = 0; v < n; v++) {
+    if (out[v] == TriangleMesh::kNone) {
+      continue;  // A duplicate.
+    }
+    // The sites are inside the far ones, so the triangles close around v.
+    ring_x.clear();
+    ring_y.clear();
+    size_t e{out[v]};
+    do {
+      ring_x.push_back(centers_x[e / 3]);
+      ring_y.push_back(centers_y[e / 3]);
+      e = mesh.Twin(TriangleMesh::Prev(e));
+    } while (e != out[v]);
+
+    // Sutherland-Hodgman on the four sides of the box.
+    for (size_t side = 0; side < 4 && !ring_x.empty(); side++) {
+      const bool on_x{side % 2 == 0};
+      const double limit{on_x ? box_x[side / 2] : box_y[side / 2]};
+      const double sign{side < 2 ? 1.0 : -1.0};
+      const auto& coord = on_x ? ring_x : ring_y;
+      kept_x.clear();
+      kept_y.clear();
+      for (size_t i = 0; i < ring_x.size(); i++) {
+        const size_t j{i + 1 == ring_x.size() ? 0 : i + 1};
+        const double di{sign * (coord[i] - limit)};
+        const double dj{sign * (coord[j] - limit)};
+        if (di >= 0.0) {
+          kept_x.push_back(ring_x[i]);
+          kept_y.push_back(ring_y[i]);
+        }
+        if ((di > 0.0 && dj < 0.0) || (di < 0.0 && dj > 0.0)) {
+          const double u{di / (di - dj)};
+          kept_x.push_back(on_x ? limit
+                                : ring_x[i] + u * (ring_x[j] - ring_x[i]));
+          kept_y.push_back(on_x ? ring_y[i] + u * (ring_y[j] - ring_y[i])
+                                : limit);
+        }
+      }
+      std::swap(ring_x, kept_x);
+      std::swap(ring_y, kept_y);
+    }
+
+    // Drops the repeated and collinear corners that clipping leaves.
+    PointCloud cell{ConvexHull(PointCloud{ring_x, ring_y})};
+    if (cell.Size() >= 3) {
+      cells.push_back({v, Polygon{std::move(cell)}});
+    }
+  }
+  return cells;
+}
+
+}  // namespace algo::geometry
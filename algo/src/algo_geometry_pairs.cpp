@@ -0,0 +1,369 @@
+///
+/// \brief Source file for closest pair algorithms.
+/// \author alex011235
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_geometry_pairs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace algo::geometry {
+
+namespace {
+
+// Ranges of at most this many points are solved by brute force.
+constexpr size_t kBruteForceSize{3UL};
+// Grids with more cells than this along an axis are not used, the cell
+// coordinates would be too coarse to find the neighbouring cells.
+constexpr double kMaxCells{2147483648.0};
+// The cells are made slightly larger than the distance so that rounding
+// never puts two points within the distance more than one cell apart.
+constexpr double kCellSlack{1e-6};
+constexpr size_t kEmpty{std::numeric_limits<size_t>::max()};
+constexpr double kInf{std::numeric_limits<double>::infinity()};
+
+inline double SquaredDist(double x1, double y1, double x2, double y2) {
+  const double dx{x1 - x2};
+  const double dy{y1 - y2};
+  return dx * dx + dy * dy;
+}
+
+/// \brief A pair with the smaller index first, dist is squared until the
+/// result is returned.
+inline PointPair MakePair(size_t a, size_t b, double dist2) {
+  return a < b ? PointPair{a, b, dist2} : PointPair{b, a, dist2};
+}
+
+/// \brief (distance, first, second) order, the top of a heap is the farthest
+/// pair.
+inline bool Closer(const PointPair& p, const PointPair& q) {
+  if (p.dist != q.dist) {
+    return p.dist < q.dist;
+  }
+  return p.first < q.first || (p.first == q.first && p.second < q.second);
+}
+
+inline bool IndexLess(const PointPair& p, const PointPair& q) {
+  return p.first < q.first || (p.first == q.first && p.second < q.second);
+}
+
+PointPair Root(PointPair pair) {
+  pair.dist = std::sqrt(pair.dist);
+  return pair;
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: ClosestPairs
+
+void ClosestPairs::Load(const PointCloud& points) {
+  const size_t n{points.Size()};
+  items_.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    items_[i] = {points.X(i), points.Y(i), i};
+  }
+  if (n > 0) {
+    const auto [x_lo, x_hi] =
+        std::minmax_element(points.Xs().begin(), points.Xs().end());
+    const auto [y_lo, y_hi] =
+        std::minmax_element(points.Ys().begin(), points.Ys().end());
+    x_min_ = *x_lo;
+    x_max_ = *x_hi;
+    y_min_ = *y_lo;
+    y_max_ = *y_hi;
+  }
+}
+
+// NOLINTNEXTLINE
+void ClosestPairs::Divide(size_t lo, size_t hi, PointPair& best) {
+  if (hi - lo <= kBruteForceSize) {
+    for (size_t i = lo; i < hi; i++) {
+      for (size_t j = i + 1; j < hi; j++) {
+        const double d2{SquaredDist(items_[i].x, items_[i].y, items_[j].x,
+                                    items_[j].y)};
+        if (d2 < best.dist) {
+          best = MakePair(items_[i].id, items_[j].id, d2);
+        }
+      }
+    }
+    std::sort(items_.begin() + lo, items_.begin() + hi,
+              [](const Item& p, const Item& q) { return p.y < q.y; });
+    return;
+  }
+
+  const size_t mid{lo + (hi - lo) / 2};
+  const double mid_x{items_[mid].x};
+  Divide(lo, mid, best);
+  Divide(mid, hi, best);
+
+  // Both halves are sorted on y, merge them through the buffer.
+  std::merge(items_.begin() + lo, items_.begin() + mid, items_.begin() + mid,
+             items_.begin() + hi, buffer_.begin() + lo,
+             [](const Item& p, const Item& q) { return p.y < q.y; });
+  std::copy(buffer_.begin() + lo, buffer_.begin() + hi, items_.begin() + lo);
+
+  // Points closer to the split than the best distance, in y order. A closer
+  // pair in the strip is at most a few places apart.
+  size_t strip{lo};
+  for (size_t i = lo; i < hi; i++) {
+    const double dx{items_[i].x - mid_x};
+    if (dx * dx < best.dist) {
+      buffer_[strip++] = items_[i];
+    }
+  }
+  for (size_t i = lo; i < strip; i++) {
+    for (size_t j = i + 1; j < strip; j++) {
+      const double dy{buffer_[j].y - buffer_[i].y};
+      if (dy * dy >= best.dist) {
+        break;
+      }
+      const double d2{SquaredDist(buffer_[i].x, buffer_[i].y, buffer_[j].x,
+                                  buffer_[j].y)};
+      if (d2 < best.dist) {
+        best = MakePair(buffer_[i].id, buffer_[j].id, d2);
+      }
+    }
+  }
+}
+
+PointPair ClosestPairs::Closest(const PointCloud& points) {
+  if (points.Size() < 2) {
+    throw std::invalid_argument("Too few points in input.");
+  }
+  Load(points);
+  std::sort(items_.begin(), items_.end(), [](const Item& p, const Item& q) {
+    return p.x < q.x || (p.x == q.x && p.y < q.y);
+  });
+  buffer_.resize(items_.size());
+
+  PointPair best{0, 0, kInf};
+  Divide(0, items_.size(), best);
+  return Root(best);
+}
+
+void ClosestPairs::Sweep(double dist) {
+  std::sort(items_.begin(), items_.end(),
+            [](const Item& p, const Item& q) { return p.x < q.x; });
+  const double dist2{dist * dist};
+  for (size_t i = 0; i < items_.size(); i++) {
+    for (size_t j = i + 1;
+         j < items_.size() && items_[j].x - items_[i].x <= dist; j++) {
+      const double d2{SquaredDist(items_[i].x, items_[i].y, items_[j].x,
+                                  items_[j].y)};
+      if (d2 <= dist2) {
+        pairs_.push_back(MakePair(items_[i].id, items_[j].id, d2));
+      }
+    }
+  }
+}
+
+bool ClosestPairs::ResetGrid(double side) {
+  side_ = side * (1.0 + kCellSlack);
+  if (!((x_max_ - x_min_) / side_ < kMaxCells &&
+        (y_max_ - y_min_) / side_ < kMaxCells)) {
+    return false;
+  }
+
+  // At least twice as many slots as points, the probe sequences stay short.
+  const size_t n{items_.size()};
+  size_t slots{16};
+  while (slots < 2 * n) {
+    slots *= 2;
+  }
+  if (cells_.size() < slots) {
+    cells_.assign(slots, Cell{0, 0, kEmpty});
+    mask_ = slots - 1;
+  } else {
+    for (const size_t slot : used_) {
+      cells_[slot].head = kEmpty;
+    }
+  }
+  used_.clear();
+  next_.resize(n);
+  return true;
+}
+
+std::pair<int64_t, int64_t> ClosestPairs::CellOf(const Item& p) const {
+  return {static_cast<int64_t>(std::floor((p.x - x_min_) / side_)),
+          static_cast<int64_t>(std::floor((p.y - y_min_) / side_))};
+}
+
+size_t ClosestPairs::Find(int64_t cx, int64_t cy) const {
+  auto slot = static_cast<size_t>(
+      (static_cast<uint64_t>(cx) * 0x9E3779B97F4A7C15ULL) ^
+      (static_cast<uint64_t>(cy) * 0xC2B2AE3D27D4EB4FULL));
+  for (slot = (slot ^ (slot >> 29)) & mask_; cells_[slot].head != kEmpty;
+       slot = (slot + 1) & mask_) {
+    if (cells_[slot].cx == cx && cells_[slot].cy == cy) {
+      return slot;
+    }
+  }
+  return slot;
+}
+
+void ClosestPairs::Insert(size_t i) {
+  const auto [cx, cy] = CellOf(items_[i]);
+  Cell& cell{cells_[Find(cx, cy)]};
+  if (cell.head == kEmpty) {
+    cell.cx = cx;
+    cell.cy = cy;
+    used_.push_back(static_cast<size_t>(&cell - cells_.data()));
+  }
+  next_[i] = cell.head;
+  cell.head = i;
+}
+
+PointPair ClosestPairs::ClosestHashed(const PointCloud& points,
+                                      uint32_t seed) {
+  const size_t n{points.Size()};
+  if (n < 2) {
+    throw std::invalid_argument("Too few points in input.");
+  }
+  Load(points);
+  std::mt19937 gen{seed};
+  std::shuffle(items_.begin(), items_.end(), gen);
+
+  PointPair best{MakePair(
+      items_[0].id, items_[1].id,
+      SquaredDist(items_[0].x, items_[0].y, items_[1].x, items_[1].y))};
+  if (best.dist == 0.0) {
+    return best;
+  }
+  if (!ResetGrid(std::sqrt(best.dist))) {
+    return Closest(points);
+  }
+  Insert(0);
+  Insert(1);
+
+  for (size_t i = 2; i < n; i++) {
+    const Item& p{items_[i]};
+    const auto [cx, cy] = CellOf(p);
+    bool closer{false};
+    for (int64_t gx = cx - 1; gx <= cx + 1; gx++) {
+      for (int64_t gy = cy - 1; gy <= cy + 1; gy++) {
+        for (size_t j = cells_[Find(gx, gy)].head; j != kEmpty; j = next_[j]) {
+          const double d2{SquaredDist(p.x, p.y, items_[j].x, items_[j].y)};
+          if (d2 < best.dist) {
+            best = MakePair(p.id, items_[j].id, d2);
+            closer = true;
+          }
+        }
+      }
+    }
+    if (!closer) {
+      Insert(i);
+      continue;
+    }
+    // The cells are too large now, rebuild the grid for the points so far.
+    if (best.dist == 0.0) {
+      return best;
+    }
+    if (!ResetGrid(std::sqrt(best.dist))) {
+      return Closest(points);
+    }
+    for (size_t j = 0; j <= i; j++) {
+      Insert(j);
+    }
+  }
+  return Root(best);
+}
+
+const std::vector<PointPair>& ClosestPairs::KClosest(
+    const PointCloud& points, size_t k) {
+  pairs_.clear();
+  const size_t n{points.Size()};
+  if (k == 0 || n < 2) {
+    return pairs_;
+  }
+  Load(points);
+
+  // Sweep along the axis where the points are most spread out.
+  if (y_max_ - y_min_ > x_max_ - x_min_) {
+    for (auto& item : items_) {
+      std::swap(item.x, item.y);
+    }
+  }
+  std::sort(items_.begin(), items_.end(),
+            [](const Item& p, const Item& q) { return p.x < q.x; });
+
+  // Max-heap of the k closest pairs so far, a point is compared with the
+  // points behind it while they are closer along the axis than the farthest.
+  for (size_t i = 1; i < n; i++) {
+    for (size_t j = i; j-- > 0;) {
+      const double dx{items_[i].x - items_[j].x};
+      if (pairs_.size() == k && dx * dx >= pairs_.front().dist) {
+        break;
+      }
+      const PointPair pair{MakePair(
+          items_[i].id, items_[j].id,
+          SquaredDist(items_[i].x, items_[i].y, items_[j].x, items_[j].y))};
+      if (pairs_.size() < k) {
+        pairs_.push_back(pair);
+        std::push_heap(pairs_.begin(), pairs_.end(), Closer);
+      } else if (Closer(pair, pairs_.front())) {
+        std::pop_heap(pairs_.begin(), pairs_.end(), Closer);
+        pairs_.back() = pair;
+        std::push_heap(pairs_.begin(), pairs_.end(), Closer);
+      }
+    }
+  }
+  std::sort_heap(pairs_.begin(), pairs_.end(), Closer);
+  for (auto& pair : pairs_) {
+    pair.dist = std::sqrt(pair.dist);
+  }
+  return pairs_;
+}
+
+const std::vector<PointPair>& ClosestPairs::WithinDistance(
+    const PointCloud& points, double dist) {
+  pairs_.clear();
+  const size_t n{points.Size()};
+  if (n < 2 || !(dist >= 0.0)) {
+    return pairs_;
+  }
+  Load(points);
+
+  if (dist == 0.0 || !ResetGrid(dist)) {
+    Sweep(dist);
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      Insert(i);
+    }
+    // The items are in input order, each pair is reported by its smaller
+    // index.
+    const double dist2{dist * dist};
+    for (size_t i = 0; i < n; i++) {
+      const Item& p{items_[i]};
+      const auto [cx, cy] = CellOf(p);
+      for (int64_t gx = cx - 1; gx <= cx + 1; gx++) {
+        for (int64_t gy = cy - 1; gy <= cy + 1; gy++) {
+          for (size_t j = cells_[Find(gx, gy)].head; j != kEmpty;
+               j = next_[j]) {
+            const double d2{SquaredDist(p.x, p.y, items_[j].x, items_[j].y)};
+            if (j > i && d2 <= dist2) {
+              pairs_.push_back({i, j, d2});
+            }
+          }
+        }
+      }
+    }
+  }
+
+  std::sort(pairs_.begin(), pairs_.end(), IndexLess);
+  for (auto& pair : pairs_) {
+    pair.dist = std::sqrt(pair.dist);
+  }
+  return pairs_;
+}
+
+}  // namespace algo::geometry
@@ -0,0 +1,2446 @@
+///
+/// \brief Source file for polygon and segment algorithms.
+/// \author alex011235
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_geometry_polygon.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace algo::geometry {
+
+namespace {
+
+// /////////////////////////////
+// MARK: Sweep
+
+// Bentley-Ottmann as in de Berg et al., "Computational Geometry", chapter 2.
+// The sweep line moves left to right, events are ordered on (x, y). All
+// decisions are exact: segments are compared with Orient2D, and crossing
+// points, which are usually not representable, are ordered with
+// CompareIntersection(s). Their rounded coordinates are only reported.
+
+constexpr size_t kNoSegment{std::numeric_limits<size_t>::max()};
+
+/// \brief Segment with a < b in (x, y) order.
+struct Segment {
+  double ax;
+  double ay;
+  double bx;
+  double by;
+};
+
+/// \brief (x1, y1) < (x2, y2) in sweep order.
+inline bool Before(double x1, double y1, double x2, double y2) {
+  return x1 < x2 || (x1 == x2 && y1 < y2);
+}
+
+inline int Sign(double v) {
+  return (v > 0.0) - (v < 0.0);
+}
+
+inline int Orient(const Segment& s, double x, double y) {
+  return Sign(predicates::Orient2D(s.ax, s.ay, s.bx, s.by, x, y));
+}
+
+inline bool IsEndPoint(const Segment& s, double x, double y) {
+  return (s.ax == x && s.ay == y) || (s.bx == x && s.by == y);
+}
+
+/// \brief Checks if (x, y) is on the closed segment.
+inline bool Contains(const Segment& s, double x, double y) {
+  return Orient(s, x, y) == 0 && !Before(x, y, s.ax, s.ay) &&
+         !Before(s.bx, s.by, x, y);
+}
+
+enum class ContactKind { kNone, kEndPoints, kIntersect };
+
+/// \brief How two segments meet, and a common point. The point is exact
+/// unless the segments cross properly.
+struct Contact {
+  ContactKind kind;
+  double x;
+  double y;
+  bool exact;
+};
+
+/// \brief Classifies the common point of two segments that meet in exactly
+/// one representable point.
+inline Contact AtPoint(const Segment& s, const Segment& t, double x,
+                       double y) {
+  const bool shared{IsEndPoint(s, x, y) && IsEndPoint(t, x, y)};
+  return {shared ? ContactKind::kEndPoints : ContactKind::kIntersect, x, y,
+          true};
+}
+
+Contact FindContact(const Segment& first, const Segment& second) {
+  // The same rounding whatever the order of the arguments.
+  const bool swap{std::tie(second.ax, second.ay, second.bx, second.by) <
+                  std::tie(first.ax, first.ay, first.bx, first.by)};
+  const Segment& s{swap ? second : first};
+  const Segment& t{swap ? first : second};
+
+  const int o1{Orient(s, t.ax, t.ay)};
+  const int o2{Orient(s, t.bx, t.by)};
+  if (o1 == 0 && o2 == 0) {
+    // Collinear, the overlap is [lo, hi] in sweep order.
+    const bool s_first{Before(t.ax, t.ay, s.ax, s.ay)};
+    const double lo_x{s_first ? s.ax : t.ax};
+    const double lo_y{s_first ? s.ay : t.ay};
+    const bool s_last{Before(s.bx, s.by, t.bx, t.by)};
+    const double hi_x{s_last ? s.bx : t.bx};
+    const double hi_y{s_last ? s.by : t.by};
+    if (Before(hi_x, hi_y, lo_x, lo_y)) {
+      return {ContactKind::kNone, 0.0, 0.0, true};
+    }
+    if (lo_x == hi_x && lo_y == hi_y) {
+      return AtPoint(s, t, lo_x, lo_y);
+    }
+    return {ContactKind::kIntersect, lo_x, lo_y, true};
+  }
+
+  const double d3{predicates::Orient2D(t.ax, t.ay, t.bx, t.by, s.ax, s.ay)};
+  const double d4{predicates::Orient2D(t.ax, t.ay, t.bx, t.by, s.bx, s.by)};
+  const int o3{Sign(d3)};
+  const int o4{Sign(d4)};
+  if (o1 * o2 > 0 || o3 * o4 > 0) {
+    return {ContactKind::kNone, 0.0, 0.0, true};
+  }
+  // An end point on the other segment, the common point is exact.
+  if (o1 == 0) {
+    return AtPoint(s, t, t.ax, t.ay);
+  }
+  if (o2 == 0) {
+    return AtPoint(s, t, t.bx, t.by);
+  }
+  if (o3 == 0) {
+    return AtPoint(s, t, s.ax, s.ay);
+  }
+  if (o4 == 0) {
+    return AtPoint(s, t, s.bx, s.by);
+  }
+
+  // Proper crossing, the rounded point is clamped to both bounding boxes.
+  const double u{d3 / (d3 - d4)};
+  const double x_min{std::max(s.ax, t.ax)};
+  const double x_max{std::min(s.bx, t.bx)};
+  const double y_min{std::max(std::min(s.ay, s.by), std::min(t.ay, t.by))};
+  const double y_max{std::min(std::max(s.ay, s.by), std::max(t.ay, t.by))};
+  return {ContactKind::kIntersect,
+          std::clamp(s.ax + u * (s.bx - s.ax), x_min, x_max),
+          std::clamp(s.ay + u * (s.by - s.ay), y_min, y_max), false};
+}
+
+class Sweep {
+ public:
+  /// \param edges The segments.
+  /// \param first_only Stops at the first intersection.
+  /// \param ring The edges are the closed boundary of a polygon, only
+  /// consecutive edges may share an end point.
+  Sweep(const std::vector<Edge>& edges, bool first_only, bool ring);
+
+  std::vector<Intersection> Run();
+
+ private:
+  /// \brief An end point, or the crossing point of segments s and t with
+  /// rounded coordinates.
+  struct EventPoint {
+    double x;
+    double y;
+    size_t s;
+    size_t t;
+  };
+
+  struct EventLess {
+    const Sweep* sweep;
+    bool operator()(const EventPoint& p, const EventPoint& q) const {
+      return sweep->Compare(p, q) < 0;
+    }
+  };
+
+  struct Event {
+    std::vector<size_t> upper;    // Segments starting here.
+    std::vector<size_t> lower;    // Segments ending here.
+    std::vector<size_t> through;  // Pairs of segments crossing here.
+  };
+
+  /// \brief A place in the status. The segments in places are swapped when
+  /// they cross, which does not change the order of the places.
+  struct Slot {
+    mutable size_t id;
+  };
+
+  /// \brief Orders the status bottom to top. Segments are only compared when
+  /// one is inserted at its first end point, or against an end point.
+  struct StatusLess {
+    using is_transparent = void;
+    struct Probe {};
+
+    const Sweep* sweep;
+    bool operator()(const Slot& s, const Slot& t) const {
+      return sweep->InsertBelow(s.id, t.id);
+    }
+    bool operator()(const Slot& s, Probe /*p*/) const {
+      return Orient(sweep->segments_[s.id], sweep->px_, sweep->py_) > 0;
+    }
+    bool operator()(Probe /*p*/, const Slot& s) const {
+      return Orient(sweep->segments_[s.id], sweep->px_, sweep->py_) < 0;
+    }
+  };
+  using Status = std::set<Slot, StatusLess>;
+
+  int Compare(const EventPoint& p, const EventPoint& q) const;
+  bool InsertBelow(size_t s, size_t t) const;
+  bool AfterBelow(size_t s, size_t t) const;
+  bool MaySharePoint(size_t s, size_t t) const;
+  bool OnPoint(size_t s) const;
+  void Collect(const Event& event, std::vector<size_t>& members);
+  void Reorder(size_t s);
+  void Handle(const EventPoint& point, const Event& event);
+  void ReportPair(size_t s, size_t t);
+  void Check(size_t below, size_t above);
+  void Report(size_t s, size_t t, double x, double y);
+
+  std::vector<Segment> segments_;
+  bool first_only_;
+  bool ring_;
+  bool done_;
+
+  std::map<EventPoint, Event, EventLess> events_;
+  Status status_;
+  std::vector<Status::iterator> where_;
+  std::vector<uint8_t> active_;
+  std::vector<uint8_t> at_event_;
+  size_t inserting_;
+  EventPoint point_;
+  double px_;
+  double py_;
+
+  std::unordered_set<size_t> reported_;
+  std::vector<Intersection> result_;
+};
+
+Sweep::Sweep(const std::vector<Edge>& edges, bool first_only, bool ring)
+    : first_only_{first_only},
+      ring_{ring},
+      done_{false},
+      events_{EventLess{this}},
+      status_{StatusLess{this}},
+      where_(edges.size()),
+      active_(edges.size(), 0),
+      at_event_(edges.size(), 0),
+      inserting_{0},
+      point_{0.0, 0.0, kNoSegment, kNoSegment},
+      px_{0.0},
+      py_{0.0} {
+  segments_.reserve(edges.size());
+  for (const auto& edge : edges) {
+    Point a{edge.GetStart()};
+    Point b{edge.GetEnd()};
+    if (Before(b.X(), b.Y(), a.X(), a.Y())) {
+      std::swap(a, b);
+    }
+    segments_.push_back({a.X(), a.Y(), b.X(), b.Y()});
+  }
+}
+
+std::vector<Intersection> Sweep::Run() {
+  // The end points go in first, so that a crossing at an end point is merged
+  // into the end point event.
+  for (size_t i = 0; i < segments_.size(); i++) {
+    const Segment& s{segments_[i]};
+    events_[{s.ax, s.ay, kNoSegment, kNoSegment}].upper.emplace_back(i);
+    events_[{s.bx, s.by, kNoSegment, kNoSegment}].lower.emplace_back(i);
+  }
+
+  while (!events_.empty() && !done_) {
+    const auto node = events_.extract(events_.begin());
+    Handle(node.key(), node.mapped());
+  }
+
+  std::sort(result_.begin(), result_.end(),
+            [](const Intersection& a, const Intersection& b) {
+              return std::make_pair(a.first, a.second) <
+                     std::make_pair(b.first, b.second);
+            });
+  return result_;
+}
+
+int Sweep::Compare(const EventPoint& p, const EventPoint& q) const {
+  if (p.s == kNoSegment && q.s == kNoSegment) {
+    return Before(p.x, p.y, q.x, q.y) ? -1 : Before(q.x, q.y, p.x, p.y);
+  }
+  if (p.s == q.s && p.t == q.t) {
+    return 0;
+  }
+  const auto start = [this](size_t s) {
+    return Point{segments_[s].ax, segments_[s].ay};
+  };
+  const auto end = [this](size_t s) {
+    return Point{segments_[s].bx, segments_[s].by};
+  };
+  if (q.s == kNoSegment) {
+    return predicates::CompareIntersection(start(p.s), end(p.s), start(p.t),
+                                           end(p.t), Point{q.x, q.y});
+  }
+  if (p.s == kNoSegment) {
+    return -predicates::CompareIntersection(start(q.s), end(q.s), start(q.t),
+                                            end(q.t), Point{p.x, p.y});
+  }
+  return predicates::CompareIntersections(start(p.s), end(p.s), start(p.t),
+                                          end(p.t), start(q.s), end(q.s),
+                                          start(q.t), end(q.t));
+}
+
+bool Sweep::InsertBelow(size_t s, size_t t) const {
+  if (s == t) {
+    return false;
+  }
+  if (t == inserting_) {
+    return !InsertBelow(t, s);
+  }
+  // s starts at the event point, which t contains or passes.
+  const Segment& seg{segments_[s]};
+  const int o{Orient(segments_[t], seg.ax, seg.ay)};
+  if (o != 0) {
+    return o < 0;
+  }
+  return AfterBelow(s, t);
+}
+
+bool Sweep::AfterBelow(size_t s, size_t t) const {
+  // For segments through a common point, the order right after it. The end
+  // point that comes first is compared, both segments are there.
+  const Segment& first{segments_[s]};
+  const Segment& second{segments_[t]};
+  const int o{Before(second.bx, second.by, first.bx, first.by)
+                  ? -Orient(first, second.bx, second.by)
+                  : Orient(second, first.bx, first.by)};
+  if (o != 0) {
+    return o < 0;
+  }
+  return s < t;
+}
+
+bool Sweep::MaySharePoint(size_t s, size_t t) const {
+  if (!ring_) {
+    return true;
+  }
+  const size_t n{segments_.size()};
+  const size_t lo{std::min(s, t)};
+  const size_t hi{std::max(s, t)};
+  return hi - lo == 1 || (lo == 0 && hi == n - 1);
+}
+
+void Sweep::Report(size_t s, size_t t, double x, double y) {
+  const size_t lo{std::min(s, t)};
+  const size_t hi{std::max(s, t)};
+  if (!done_ && reported_.insert(lo * segments_.size() + hi).second) {
+    result_.push_back({lo, hi, Point{x, y}});
+    done_ = first_only_;
+  }
+}
+
+void Sweep::ReportPair(size_t s, size_t t) {
+  const Contact c{FindContact(segments_[s], segments_[t])};
+  if (c.kind == ContactKind::kIntersect ||
+      (c.kind == ContactKind::kEndPoints && !MaySharePoint(s, t))) {
+    Report(s, t, c.x, c.y);
+  }
+}
+
+void Sweep::Check(size_t below, size_t above) {
+  const Contact c{FindContact(segments_[below], segments_[above])};
+  if (c.kind == ContactKind::kNone ||
+      (c.kind == ContactKind::kEndPoints && MaySharePoint(below, above))) {
+    return;
+  }
+  if (!first_only_) {
+    const EventPoint point{c.x, c.y, c.exact ? kNoSegment : below,
+                           c.exact ? kNoSegment : above};
+    if (Compare(point_, point) < 0) {
+      Event& event{events_[point]};
+      event.through.emplace_back(below);
+      event.through.emplace_back(above);
+      return;
+    }
+  }
+  Report(below, above, c.x, c.y);
+}
+
+bool Sweep::OnPoint(size_t s) const {
+  const Segment& seg{segments_[s]};
+  if (point_.s == kNoSegment) {
+    return Contains(seg, px_, py_);
+  }
+  // The crossing point of the event is on the line through s if s is
+  // collinear with the first segment of the pair, or crosses its line there.
+  // Then it is on s if it is between the end points.
+  const Point a{seg.ax, seg.ay};
+  const Point b{seg.bx, seg.by};
+  const auto start = [this](size_t t) {
+    return Point{segments_[t].ax, segments_[t].ay};
+  };
+  const auto end = [this](size_t t) {
+    return Point{segments_[t].bx, segments_[t].by};
+  };
+  const Point p0{start(point_.s)};
+  const Point p1{end(point_.s)};
+  const Point q0{start(point_.t)};
+  const Point q1{end(point_.t)};
+  const int o1{Sign(predicates::Orient2D(p0, p1, a))};
+  const int o2{Sign(predicates::Orient2D(p0, p1, b))};
+  if (o1 == o2 && o1 != 0) {
+    return false;
+  }
+  if (o1 != 0 || o2 != 0) {
+    if (predicates::CompareIntersections(a, b, p0, p1, p0, p1, q0, q1) != 0) {
+      return false;
+    }
+  }
+  return predicates::CompareIntersection(p0, p1, q0, q1, a) >= 0 &&
+         predicates::CompareIntersection(p0, p1, q0, q1, b) <= 0;
+}
+
+void Sweep::Collect(const Event& event, std::vector<size_t>& members) {
+  const auto add = [&](size_t s) {
+    if (at_event_[s] == 0) {
+      at_event_[s] = 1;
+      members.emplace_back(s);
+    }
+  };
+
+  if (point_.s == kNoSegment) {
+    const auto above = status_.lower_bound(StatusLess::Probe{});
+    if (above != status_.end() && OnPoint(above->id)) {
+      add(above->id);
+    }
+  }
+  for (const size_t s : event.through) {
+    if (active_[s] != 0) {
+      add(s);
+    }
+  }
+
+  // The segments through the event point are next to each other in the
+  // status.
+  for (size_t i = 0; i < members.size(); i++) {
+    const auto it = where_[members[i]];
+    if (it != status_.begin() && at_event_[std::prev(it)->id] == 0 &&
+        OnPoint(std::prev(it)->id)) {
+      add(std::prev(it)->id);
+    }
+    if (std::next(it) != status_.end() &&
+        at_event_[std::next(it)->id] == 0 && OnPoint(std::next(it)->id)) {
+      add(std::next(it)->id);
+    }
+  }
+}
+
+void Sweep::Reorder(size_t s) {
+  // Sorts the run of members around s on the order after the event point.
+  auto first = where_[s];
+  while (first != status_.begin() && at_event_[std::prev(first)->id] != 0) {
+    --first;
+  }
+  std::vector<Status::iterator> run;
+  for (auto it = first; it != status_.end() && at_event_[it->id] != 0; ++it) {
+    run.emplace_back(it);
+  }
+  std::vector<size_t> ids;
+  for (const auto& it : run) {
+    // Insertion sort, the runs are short.
+    const size_t id{it->id};
+    auto pos = ids.end();
+    while (pos != ids.begin() && AfterBelow(id, *std::prev(pos))) {
+      --pos;
+    }
+    ids.insert(pos, id);
+  }
+  for (size_t i = 0; i < run.size(); i++) {
+    run[i]->id = ids[i];
+    where_[ids[i]] = run[i];
+    at_event_[ids[i]] = 2;
+  }
+}
+
+void Sweep::Handle(const EventPoint& point, const Event& event) {
+  point_ = point;
+  px_ = point.x;
+  py_ = point.y;
+
+  std::vector<size_t> members;
+  Collect(event, members);
+
+  // Reports the pairs meeting here.
+  std::vector<size_t> all{members};
+  all.insert(all.end(), event.upper.begin(), event.upper.end());
+  for (size_t i = 0; i < all.size(); i++) {
+    for (size_t j = i + 1; j < all.size(); j++) {
+      ReportPair(all[i], all[j]);
+    }
+  }
+
+  // Removes the segments ending here, the others through the point are
+  // reversed. Then the segments starting here are inserted.
+  for (const size_t s : event.lower) {
+    status_.erase(where_[s]);
+    active_[s] = 0;
+  }
+  for (const size_t s : members) {
+    if (active_[s] != 0 && at_event_[s] == 1) {
+      Reorder(s);
+    }
+  }
+  for (const size_t s : event.upper) {
+    inserting_ = s;
+    where_[s] = status_.insert(Slot{s}).first;
+    active_[s] = 1;
+    at_event_[s] = 2;
+    members.emplace_back(s);
+  }
+
+  // Checks the new neighbours.
+  bool any{false};
+  for (const size_t s : members) {
+    if (active_[s] == 0 || done_) {
+      continue;
+    }
+    any = true;
+    const auto it = where_[s];
+    if (it != status_.begin() && at_event_[std::prev(it)->id] == 0) {
+      Check(std::prev(it)->id, s);
+    }
+    if (std::next(it) != status_.end() && at_event_[std::next(it)->id] == 0 &&
+        !done_) {
+      Check(s, std::next(it)->id);
+    }
+  }
+  if (!any && !done_ && point_.s == kNoSegment) {
+    const auto above = status_.lower_bound(StatusLess::Probe{});
+    if (above != status_.end() && above != status_.begin()) {
+      Check(std::prev(above)->id, above->id);
+    }
+  }
+
+  for (const size_t s : members) {
+    at_event_[s] = 0;
+  }
+}
+
+// /////////////////////////////
+// MARK: Clipper
+
+// Martinez, Rueda and Feito, "A new algorithm for computing Boolean
+// operations on polygons", 2009. The edges of both operands are swept left
+// to right and split where they meet, until every piece is either inside or
+// outside of the other operand. A piece takes its flags from the piece right
+// below it in the status. The pieces of the result are linked into rings
+// afterwards, directed so that the result is on their left.
+
+constexpr size_t kNoEvent{std::numeric_limits<size_t>::max()};
+constexpr double kTwoPi{6.283185307179586476925286766559};
+// Crossing points this close to an end, relative to the coordinates, are
+// taken as the end.
+constexpr double kSnap{16.0 * std::numeric_limits<double>::epsilon()};
+// Sutherland-Hodgman is O(nm), above this product of the corner counts the
+// sweep is faster.
+constexpr size_t kMaxConvexClip{1UL << 15};
+
+struct XY {
+  double x;
+  double y;
+};
+
+enum class PieceType {
+  kNormal,
+  kNonContributing,     // Overlaps a piece of the other operand, left out.
+  kSameTransition,      // Overlaps, both operands on the same side.
+  kDifferentTransition  // Overlaps, the operands on opposite sides.
+};
+
+/// \brief Checks if two points are a few ulps apart.
+bool IsNear(double x1, double y1, double x2, double y2) {
+  const double scale{
+      std::max({1.0, std::abs(x1), std::abs(y1), std::abs(x2), std::abs(y2)})};
+  return std::abs(x1 - x2) <= kSnap * scale &&
+         std::abs(y1 - y2) <= kSnap * scale;
+}
+
+/// \brief Removes repeated and collinear points from a ring.
+std::vector<XY> CleanRing(const std::vector<XY>& ring) {
+  const auto collinear = [](const XY& a, const XY& b, const XY& c) {
+    return predicates::Orient2D(a.x, a.y, b.x, b.y, c.x, c.y) == 0.0;
+  };
+  std::vector<XY> clean;
+  for (const XY& p : ring) {
+    while (clean.size() >= 2 &&
+           collinear(clean[clean.size() - 2], clean.back(), p)) {
+      clean.pop_back();
+    }
+    if (clean.empty() || clean.back().x != p.x || clean.back().y != p.y) {
+      clean.push_back(p);
+    }
+  }
+  // Around the closing corner.
+  size_t first{0};
+  while (clean.size() - first >= 3) {
+    const size_t n{clean.size()};
+    if (collinear(clean[n - 2], clean[n - 1], clean[first])) {
+      clean.pop_back();
+    } else if (collinear(clean[n - 1], clean[first], clean[first + 1])) {
+      first++;
+    } else {
+      break;
+    }
+  }
+  clean.erase(clean.begin(), clean.begin() + first);
+  if (clean.size() < 3) {
+    clean.clear();
+  }
+  return clean;
+}
+
+double SignedArea(const std::vector<XY>& ring) {
+  double area{0.0};
+  for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+    area += (ring[j].x - ring[i].x) * (ring[j].y + ring[i].y);
+  }
+  return area / 2.0;
+}
+
+/// \brief A ring as a counter clockwise point cloud. Polygon checks the
+/// turn at the second point, the lowest point is put there since it is a
+/// convex corner.
+PointCloud ToCloud(std::vector<XY> ring) {
+  if (SignedArea(ring) < 0.0) {
+    std::reverse(ring.begin(), ring.end());
+  }
+  const auto lowest = std::min_element(
+      ring.begin(), ring.end(), [](const XY& p, const XY& q) {
+        return p.y < q.y || (p.y == q.y && p.x < q.x);
+      });
+  std::rotate(ring.begin(), lowest, ring.end());
+  std::rotate(ring.rbegin(), ring.rbegin() + 1, ring.rend());
+  PointCloud cloud;
+  cloud.Reserve(ring.size());
+  for (const XY& p : ring) {
+    cloud.PushBack(p.x, p.y);
+  }
+  return cloud;
+}
+
+/// \brief Checks if the point is inside the ring, even-odd rule.
+bool InRing(const std::vector<XY>& ring, const XY& p) {
+  bool inside{false};
+  for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+    if ((ring[i].y > p.y) != (ring[j].y > p.y) &&
+        p.x < ring[j].x + (p.y - ring[j].y) * (ring[i].x - ring[j].x) /
+                              (ring[i].y - ring[j].y)) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+/// \brief Checks if all corners turn left and the boundary winds once.
+bool IsConvex(const PointCloud& ring) {
+  const size_t n{ring.Size()};
+  int x_turns{0};
+  int y_turns{0};
+  double dx_prev{ring.X(0) - ring.X(n - 1)};
+  double dy_prev{ring.Y(0) - ring.Y(n - 1)};
+  for (size_t i = 0; i < n; i++) {
+    const size_t j{(i + 1) % n};
+    const size_t k{(i + 2) % n};
+    if (predicates::Orient2D(ring.X(i), ring.Y(i), ring.X(j), ring.Y(j),
+                             ring.X(k), ring.Y(k)) < 0.0) {
+      return false;
+    }
+    const double dx{ring.X(j) - ring.X(i)};
+    const double dy{ring.Y(j) - ring.Y(i)};
+    x_turns += (dx != 0.0 && dx_prev != 0.0 && (dx > 0.0) != (dx_prev > 0.0));
+    y_turns += (dy != 0.0 && dy_prev != 0.0 && (dy > 0.0) != (dy_prev > 0.0));
+    dx_prev = dx != 0.0 ? dx : dx_prev;
+    dy_prev = dy != 0.0 ? dy : dy_prev;
+  }
+  return x_turns <= 2 && y_turns <= 2;
+}
+
+class Clipper {
+ public:
+  explicit Clipper(BooleanOp op);
+
+  /// \param ring A ring of the subject or of the clip, any orientation.
+  void AddRing(const PointCloud& ring, bool subject);
+
+  std::vector<PolygonWithHoles> Run();
+
+ private:
+  struct EventGreater {
+    const Clipper* clipper;
+    bool operator()(size_t e1, size_t e2) const {
+      return clipper->CompareEvents(e1, e2) > 0;
+    }
+  };
+
+  /// \brief Orders the pieces in the status bottom to top.
+  struct StatusLess {
+    const Clipper* clipper;
+    bool operator()(size_t e1, size_t e2) const {
+      return clipper->CompareSegments(e1, e2) < 0;
+    }
+  };
+  using Status = std::set<size_t, StatusLess>;
+
+  /// \brief An end point of a piece of an edge.
+  struct Event {
+    double x;
+    double y;
+    size_t other;  // The other end of the piece.
+    bool left;     // The first end in (x, y) order.
+    bool subject;  // A piece of the subject, otherwise of the clip.
+    size_t contour;
+    size_t edge;  // The input edge the piece is a part of.
+    PieceType type;
+    bool in_out;        // Its own operand is not right above the piece.
+    bool other_in_out;  // The other operand is not right above the piece.
+    int transition;     // 1 if the result is above, -1 below, 0 if the
+                        // piece is not in the result.
+    size_t below;       // The closest result piece below, not vertical.
+    size_t order;       // When the left end was handled.
+    size_t ring;        // The result ring of the piece.
+    bool active;        // In the status.
+    Status::iterator where;
+  };
+
+  size_t NewEvent(double x, double y, bool left, bool subject,
+                  size_t contour, size_t edge);
+  bool IsCollinear(size_t e1, size_t e2) const;
+  bool IsOnPiece(size_t e, double x, double y) const;
+  bool IsBelow(size_t e, double x, double y) const;
+  bool IsVertical(size_t e) const;
+  bool IsInside(size_t e, double x, double y) const;
+  int CompareEvents(size_t e1, size_t e2) const;
+  int CompareSegments(size_t e1, size_t e2) const;
+  bool InResult(const Event& e) const;
+  int ResultTransition(const Event& e) const;
+  void ComputeFields(size_t e, size_t prev);
+  void Overlap(size_t kept, size_t dropped);
+  void Divide(size_t e, double x, double y);
+  int PossibleIntersection(size_t e1, size_t e2);
+  void Insert(size_t e);
+  void Remove(size_t e);
+  size_t NextPiece(size_t piece, const std::vector<size_t>& from,
+                   const std::vector<size_t>& to) const;
+  std::vector<PolygonWithHoles> Connect();
+
+  BooleanOp op_;
+  std::deque<Event> events_;
+  std::priority_queue<size_t, std::vector<size_t>, EventGreater> queue_;
+  Status status_;
+  std::vector<size_t> handled_;  // Left ends in the order they were handled.
+  std::vector<Segment> edges_;
+  size_t contours_;
+  double subject_x_max_;
+  double clip_x_max_;
+
+  // Linking of the result pieces.
+  std::vector<XY> vertices_;
+  std::vector<size_t> out_first_;  // Pieces leaving a vertex, as ranges.
+  std::vector<size_t> out_;
+  std::vector<uint8_t> used_;
+};
+
+Clipper::Clipper(BooleanOp op)
+    : op_{op},
+      queue_{EventGreater{this}},
+      status_{StatusLess{this}},
+      contours_{0},
+      subject_x_max_{-std::numeric_limits<double>::infinity()},
+      clip_x_max_{-std::numeric_limits<double>::infinity()} {}
+
+size_t Clipper::NewEvent(double x, double y, bool left, bool subject,
+                         size_t contour, size_t edge) {
+  events_.push_back({x, y, kNoEvent, left, subject, contour, edge,
+                     PieceType::kNormal, false, false, 0, kNoEvent, 0,
+                     kNoEvent, false, status_.end()});
+  return events_.size() - 1;
+}
+
+void Clipper::AddRing(const PointCloud& ring, bool subject) {
+  const size_t n{ring.Size()};
+  for (size_t i = 0; i < n; i++) {
+    const size_t j{(i + 1) % n};
+    const double ax{ring.X(i)};
+    const double ay{ring.Y(i)};
+    const double bx{ring.X(j)};
+    const double by{ring.Y(j)};
+    if (ax == bx && ay == by) {
+      continue;
+    }
+    const bool a_first{Before(ax, ay, bx, by)};
+    const size_t a{
+        NewEvent(ax, ay, a_first, subject, contours_, edges_.size())};
+    const size_t b{
+        NewEvent(bx, by, !a_first, subject, contours_, edges_.size())};
+    edges_.push_back({ax, ay, bx, by});
+    events_[a].other = b;
+    events_[b].other = a;
+    queue_.push(a);
+    queue_.push(b);
+    double& x_max{subject ? subject_x_max_ : clip_x_max_};
+    x_max = std::max({x_max, ax, bx});
+  }
+  contours_++;
+}
+
+bool Clipper::IsCollinear(size_t e1, size_t e2) const {
+  // The input edges are compared as well, the ends of the pieces may be
+  // rounded.
+  const Event& p{events_[e1]};
+  const Event& q{events_[e2]};
+  const Event& p_other{events_[p.other]};
+  const Event& q_other{events_[q.other]};
+  const Segment& s{edges_[p.edge]};
+  const Segment& t{edges_[q.edge]};
+  const Segment piece{p.x, p.y, p_other.x, p_other.y};
+  return p.edge == q.edge ||
+         (Orient(s, t.ax, t.ay) == 0 && Orient(s, t.bx, t.by) == 0) ||
+         (Orient(piece, q.x, q.y) == 0 &&
+          Orient(piece, q_other.x, q_other.y) == 0);
+}
+
+bool Clipper::IsOnPiece(size_t e, double x, double y) const {
+  if (!IsInside(e, x, y)) {
+    return false;
+  }
+  if (Orient(edges_[events_[e].edge], x, y) == 0) {
+    return true;
+  }
+  // A few ulps from the line through the piece.
+  const Event& a{events_[e]};
+  const Event& b{events_[a.other]};
+  const double scale{std::max({1.0, std::abs(a.x), std::abs(a.y),
+                               std::abs(b.x), std::abs(b.y)})};
+  return std::abs(predicates::Orient2D(a.x, a.y, b.x, b.y, x, y)) <=
+         kSnap * scale * std::hypot(b.x - a.x, b.y - a.y);
+}
+
+bool Clipper::IsBelow(size_t e, double x, double y) const {
+  const Event& ev{events_[e]};
+  const Event& other{events_[ev.other]};
+  return ev.left
+             ? predicates::Orient2D(ev.x, ev.y, other.x, other.y, x, y) > 0.0
+             : predicates::Orient2D(other.x, other.y, ev.x, ev.y, x, y) > 0.0;
+}
+
+bool Clipper::IsVertical(size_t e) const {
+  return events_[e].x == events_[events_[e].other].x;
+}
+
+bool Clipper::IsInside(size_t e, double x, double y) const {
+  const Event& a{events_[e]};
+  const Event& b{events_[a.other]};
+  return Before(a.x, a.y, x, y) && Before(x, y, b.x, b.y);
+}
+
+int Clipper::CompareEvents(size_t e1, size_t e2) const {
+  const Event& p{events_[e1]};
+  const Event& q{events_[e2]};
+  if (p.x != q.x) {
+    return p.x < q.x ? -1 : 1;
+  }
+  if (p.y != q.y) {
+    return p.y < q.y ? -1 : 1;
+  }
+  // Right ends first.
+  if (p.left != q.left) {
+    return p.left ? 1 : -1;
+  }
+  // The lower piece first.
+  if (!IsCollinear(e1, e2)) {
+    const Event& q_other{events_[q.other]};
+    return IsBelow(e1, q_other.x, q_other.y) ? -1 : 1;
+  }
+  if (p.subject != q.subject) {
+    return p.subject ? -1 : 1;
+  }
+  return e1 < e2 ? -1 : static_cast<int>(e1 > e2);
+}
+
+int Clipper::CompareSegments(size_t e1, size_t e2) const {
+  if (e1 == e2) {
+    return 0;
+  }
+  const Event& p{events_[e1]};
+  const Event& q{events_[e2]};
+  const Event& q_other{events_[q.other]};
+  if (!IsCollinear(e1, e2)) {
+    if (p.x == q.x && p.y == q.y) {
+      return IsBelow(e1, q_other.x, q_other.y) ? -1 : 1;
+    }
+    if (p.x == q.x) {
+      return p.y < q.y ? -1 : 1;
+    }
+    // Compared where the later of the two was inserted.
+    if (CompareEvents(e1, e2) > 0) {
+      return IsBelow(e2, p.x, p.y) ? 1 : -1;
+    }
+    return IsBelow(e1, q.x, q.y) ? -1 : 1;
+  }
+  // Collinear.
+  if (p.subject != q.subject) {
+    return p.subject ? -1 : 1;
+  }
+  if (p.x == q.x && p.y == q.y) {
+    if (p.contour != q.contour) {
+      return p.contour < q.contour ? -1 : 1;
+    }
+    return e1 < e2 ? -1 : 1;
+  }
+  return CompareEvents(e1, e2) > 0 ? 1 : -1;
+}
+
+bool Clipper::InResult(const Event& e) const {
+  switch (e.type) {
+    case PieceType::kNormal:
+      switch (op_) {
+        case BooleanOp::kIntersection:
+          return !e.other_in_out;
+        case BooleanOp::kUnion:
+          return e.other_in_out;
+        case BooleanOp::kDifference:
+          return e.subject == e.other_in_out;
+        case BooleanOp::kXor:
+          return true;
+      }
+      break;
+    case PieceType::kSameTransition:
+      return op_ == BooleanOp::kIntersection || op_ == BooleanOp::kUnion;
+    case PieceType::kDifferentTransition:
+      return op_ == BooleanOp::kDifference;
+    case PieceType::kNonContributing:
+      return false;
+  }
+  return false;
+}
+
+int Clipper::ResultTransition(const Event& e) const {
+  // Above an overlap the other operand is inside as this one is for the same
+  // transition, otherwise the opposite.
+  const bool this_in{!e.in_out};
+  bool that_in{!e.other_in_out};
+  if (e.type == PieceType::kSameTransition) {
+    that_in = this_in;
+  } else if (e.type == PieceType::kDifferentTransition) {
+    that_in = !this_in;
+  }
+  bool in{false};
+  switch (op_) {
+    case BooleanOp::kIntersection:
+      in = this_in && that_in;
+      break;
+    case BooleanOp::kUnion:
+      in = this_in || that_in;
+      break;
+    case BooleanOp::kDifference:
+      in = e.subject ? this_in && !that_in : that_in && !this_in;
+      break;
+    case BooleanOp::kXor:
+      in = this_in != that_in;
+      break;
+  }
+  return in ? 1 : -1;
+}
+
+void Clipper::ComputeFields(size_t e, size_t prev) {
+  Event& ev{events_[e]};
+  if (prev == kNoEvent) {
+    ev.in_out = false;
+    ev.other_in_out = true;
+    ev.below = kNoEvent;
+  } else {
+    const Event& pv{events_[prev]};
+    if (ev.subject == pv.subject) {
+      ev.in_out = !pv.in_out;
+      ev.other_in_out = pv.other_in_out;
+    } else {
+      ev.in_out = !pv.other_in_out;
+      ev.other_in_out = IsVertical(prev) ? !pv.in_out : pv.in_out;
+    }
+    ev.below = !InResult(pv) || IsVertical(prev) ? pv.below : prev;
+  }
+  ev.transition = InResult(ev) ? ResultTransition(ev) : 0;
+}
+
+void Clipper::Overlap(size_t kept, size_t dropped) {
+  Event& ev{events_[kept]};
+  events_[dropped].type = PieceType::kNonContributing;
+  events_[dropped].transition = 0;
+  ev.type = ev.in_out == events_[dropped].in_out
+                ? PieceType::kSameTransition
+                : PieceType::kDifferentTransition;
+  ev.transition = InResult(ev) ? ResultTransition(ev) : 0;
+  if (ev.transition == 0 && events_[dropped].below == kept) {
+    events_[dropped].below = ev.below;
+  }
+}
+
+void Clipper::Divide(size_t e, double x, double y) {
+  const size_t right{events_[e].other};
+  const Event& ev{events_[e]};
+  const size_t r{NewEvent(x, y, false, ev.subject, ev.contour, ev.edge)};
+  const size_t l{NewEvent(x, y, true, ev.subject, ev.contour, ev.edge)};
+  events_[r].other = e;
+  events_[l].other = right;
+  events_[right].other = l;
+  events_[e].other = r;
+  queue_.push(l);
+  queue_.push(r);
+}
+
+int Clipper::PossibleIntersection(size_t e1, size_t e2) {
+  const Event& p{events_[e1]};
+  const Event& p_other{events_[p.other]};
+  const Event& q{events_[e2]};
+  const Event& q_other{events_[q.other]};
+  const Segment s{p.x, p.y, p_other.x, p_other.y};
+  const Segment t{q.x, q.y, q_other.x, q_other.y};
+  const bool overlap{IsCollinear(e1, e2) && Before(t.ax, t.ay, s.bx, s.by) &&
+                     Before(s.ax, s.ay, t.bx, t.by)};
+
+  if (!overlap) {
+    // An end on the other piece is the contact, the rounded ends of the
+    // pieces may have moved them slightly apart.
+    bool touch{false};
+    for (const auto& [a, b] : {std::pair{e1, e2}, std::pair{e2, e1}}) {
+      for (const size_t end : {a, events_[a].other}) {
+        const double x{events_[end].x};
+        const double y{events_[end].y};
+        if (IsOnPiece(b, x, y)) {
+          Divide(b, x, y);
+          touch = true;
+        }
+      }
+    }
+    if (touch) {
+      return 1;
+    }
+    const Contact contact{FindContact(s, t)};
+    if (contact.kind == ContactKind::kNone ||
+        (p.x == q.x && p.y == q.y) ||
+        (p_other.x == q_other.x && p_other.y == q_other.y)) {
+      return 0;
+    }
+    // A rounded crossing point that is not strictly inside a piece, in sweep
+    // order, or a few ulps from an end, is moved to that end.
+    double x{contact.x};
+    double y{contact.y};
+    for (const Segment& seg : {s, t}) {
+      if (IsNear(seg.ax, seg.ay, x, y) || !Before(seg.ax, seg.ay, x, y)) {
+        x = seg.ax;
+        y = seg.ay;
+      } else if (IsNear(seg.bx, seg.by, x, y) ||
+                 !Before(x, y, seg.bx, seg.by)) {
+        x = seg.bx;
+        y = seg.by;
+      }
+    }
+    if (IsInside(e1, x, y)) {
+      Divide(e1, x, y);
+    }
+    if (IsInside(e2, x, y)) {
+      Divide(e2, x, y);
+    }
+    return 1;
+  }
+  if (p.subject == q.subject) {
+    // Overlapping edges of one operand are left as they are.
+    return 0;
+  }
+
+  // The ends that differ, in sweep order.
+  std::array<size_t, 4> ends{};
+  size_t count{0};
+  const bool left_coincide{p.x == q.x && p.y == q.y};
+  const bool right_coincide{p_other.x == q_other.x && p_other.y == q_other.y};
+  if (!left_coincide) {
+    const bool swap{CompareEvents(e1, e2) > 0};
+    ends[count++] = swap ? e2 : e1;
+    ends[count++] = swap ? e1 : e2;
+  }
+  if (!right_coincide) {
+    const bool swap{CompareEvents(p.other, q.other) > 0};
+    ends[count++] = swap ? q.other : p.other;
+    ends[count++] = swap ? p.other : q.other;
+  }
+
+  if (left_coincide) {
+    // Only one of the two pieces from the common left end is kept, see
+    // Overlap.
+    if (!right_coincide) {
+      Divide(events_[ends[1]].other, events_[ends[0]].x, events_[ends[0]].y);
+    }
+    return 2;
+  }
+  if (right_coincide) {
+    Divide(ends[0], events_[ends[1]].x, events_[ends[1]].y);
+    return 3;
+  }
+  if (ends[0] != events_[ends[3]].other) {
+    // Neither piece contains the other.
+    Divide(ends[0], events_[ends[1]].x, events_[ends[1]].y);
+    Divide(ends[1], events_[ends[2]].x, events_[ends[2]].y);
+    return 3;
+  }
+  // One piece contains the other.
+  Divide(ends[0], events_[ends[1]].x, events_[ends[1]].y);
+  Divide(events_[ends[3]].other, events_[ends[2]].x, events_[ends[2]].y);
+  return 3;
+}
+
+void Clipper::Insert(size_t e) {
+  Event& ev{events_[e]};
+  ev.order = handled_.size();
+  handled_.push_back(e);
+  ev.where = status_.insert(e).first;
+  ev.active = true;
+
+  const size_t prev{ev.where == status_.begin() ? kNoEvent
+                                                 : *std::prev(ev.where)};
+  const auto after = std::next(ev.where);
+  const size_t next{after == status_.end() ? kNoEvent : *after};
+  ComputeFields(e, prev);
+  if (next != kNoEvent && PossibleIntersection(e, next) == 2) {
+    ComputeFields(next, e);
+    Overlap(e, next);
+  }
+  if (prev != kNoEvent && PossibleIntersection(prev, e) == 2) {
+    ComputeFields(e, prev);
+    Overlap(prev, e);
+  }
+  // A neighbour that was divided at the left end of e must leave the status
+  // before e is placed, e is handled again after the new right end.
+  for (const size_t n : {prev, next}) {
+    if (n == kNoEvent) {
+      continue;
+    }
+    const Event& end{events_[events_[n].other]};
+    if (end.x == events_[e].x && end.y == events_[e].y) {
+      status_.erase(events_[e].where);
+      events_[e].active = false;
+      handled_.pop_back();
+      queue_.push(e);
+      return;
+    }
+  }
+}
+
+void Clipper::Remove(size_t e) {
+  Event& left{events_[events_[e].other]};
+  if (!left.active) {
+    return;
+  }
+  const size_t prev{left.where == status_.begin() ? kNoEvent
+                                                   : *std::prev(left.where)};
+  const auto after = std::next(left.where);
+  const size_t next{after == status_.end() ? kNoEvent : *after};
+  status_.erase(left.where);
+  left.active = false;
+  if (prev != kNoEvent && next != kNoEvent) {
+    PossibleIntersection(prev, next);
+  }
+}
+
+size_t Clipper::NextPiece(size_t piece, const std::vector<size_t>& from,
+                          const std::vector<size_t>& to) const {
+  // The first unused piece clockwise from the way back keeps the result on
+  // the left.
+  const XY& v{vertices_[to[piece]]};
+  const XY& back{vertices_[from[piece]]};
+  const double back_angle{std::atan2(back.y - v.y, back.x - v.x)};
+  size_t best{kNoEvent};
+  double best_angle{0.0};
+  for (size_t i = out_first_[to[piece]]; i < out_first_[to[piece] + 1]; i++) {
+    const size_t next{out_[i]};
+    if (used_[next] != 0) {
+      continue;
+    }
+    const XY& w{vertices_[to[next]]};
+    double angle{back_angle - std::atan2(w.y - v.y, w.x - v.x)};
+    while (angle <= 0.0) {
+      angle += kTwoPi;
+    }
+    while (angle > kTwoPi) {
+      angle -= kTwoPi;
+    }
+    if (best == kNoEvent || angle < best_angle) {
+      best = next;
+      best_angle = angle;
+    }
+  }
+  return best;
+}
+
+std::vector<PolygonWithHoles> Clipper::Run() {
+  const double inf{std::numeric_limits<double>::infinity()};
+  // Nothing to the right of these is in the result.
+  const double x_limit{op_ == BooleanOp::kIntersection
+                           ? std::min(subject_x_max_, clip_x_max_)
+                       : op_ == BooleanOp::kDifference ? subject_x_max_
+                                                        : inf};
+  while (!queue_.empty()) {
+    const size_t e{queue_.top()};
+    queue_.pop();
+    if (events_[e].x > x_limit) {
+      break;
+    }
+    if (events_[e].left) {
+      Insert(e);
+    } else {
+      Remove(e);
+    }
+  }
+  return Connect();
+}
+
+std::vector<PolygonWithHoles> Clipper::Connect() {
+  // The result pieces, directed so that the result is on their left.
+  std::vector<size_t> pieces;
+  for (const size_t e : handled_) {
+    if (events_[e].transition != 0) {
+      pieces.push_back(e);
+    }
+  }
+  const size_t m{pieces.size()};
+  const auto less = [](const XY& p, const XY& q) {
+    return Before(p.x, p.y, q.x, q.y);
+  };
+  vertices_.clear();
+  for (const size_t e : pieces) {
+    const Event& other{events_[events_[e].other]};
+    vertices_.push_back({events_[e].x, events_[e].y});
+    vertices_.push_back({other.x, other.y});
+  }
+  std::sort(vertices_.begin(), vertices_.end(), less);
+  vertices_.erase(std::unique(vertices_.begin(), vertices_.end(),
+                              [](const XY& p, const XY& q) {
+                                return p.x == q.x && p.y == q.y;
+                              }),
+                  vertices_.end());
+  const auto vertex = [this, &less](double x, double y) {
+    return static_cast<size_t>(
+        std::lower_bound(vertices_.begin(), vertices_.end(), XY{x, y}, less) -
+        vertices_.begin());
+  };
+
+  std::vector<size_t> from(m);
+  std::vector<size_t> to(m);
+  out_first_.assign(vertices_.size() + 1, 0);
+  for (size_t i = 0; i < m; i++) {
+    const Event& ev{events_[pieces[i]]};
+    const Event& other{events_[ev.other]};
+    const size_t a{vertex(ev.x, ev.y)};
+    const size_t b{vertex(other.x, other.y)};
+    from[i] = ev.transition > 0 ? a : b;
+    to[i] = ev.transition > 0 ? b : a;
+    out_first_[from[i] + 1]++;
+  }
+  for (size_t v = 0; v < vertices_.size(); v++) {
+    out_first_[v + 1] += out_first_[v];
+  }
+  out_.resize(m);
+  std::vector<size_t> fill(out_first_.begin(), out_first_.end() - 1);
+  for (size_t i = 0; i < m; i++) {
+    out_[fill[from[i]]++] = i;
+  }
+
+  // Walk the pieces. A walk that comes back to a vertex on its path closes a
+  // ring there, so rings that touch at a point are kept apart.
+  used_.assign(m, 0);
+  std::vector<size_t> on_path(vertices_.size(), kNoEvent);
+  std::vector<size_t> path_vertices;
+  std::vector<size_t> path_pieces;
+  std::vector<std::vector<size_t>> rings;
+  for (size_t start = 0; start < m; start++) {
+    if (used_[start] != 0) {
+      continue;
+    }
+    path_vertices.assign(1, from[start]);
+    path_pieces.clear();
+    on_path[from[start]] = 0;
+    size_t piece{start};
+    while (piece != kNoEvent) {
+      used_[piece] = 1;
+      const size_t v{to[piece]};
+      if (on_path[v] == kNoEvent) {
+        on_path[v] = path_vertices.size();
+        path_vertices.push_back(v);
+        path_pieces.push_back(piece);
+      } else {
+        const size_t k{on_path[v]};
+        rings.emplace_back(path_pieces.begin() + static_cast<ptrdiff_t>(k),
+                           path_pieces.end());
+        rings.back().push_back(piece);
+        for (size_t i = k + 1; i < path_vertices.size(); i++) {
+          on_path[path_vertices[i]] = kNoEvent;
+        }
+        path_vertices.resize(k + 1);
+        path_pieces.resize(k);
+        if (path_pieces.empty()) {
+          break;
+        }
+      }
+      piece = NextPiece(piece, from, to);
+    }
+    // Either closed, or stuck on pieces that do not close.
+    for (const size_t v : path_vertices) {
+      on_path[v] = kNoEvent;
+    }
+  }
+
+  // Outer rings are counter clockwise, holes clockwise.
+  struct Ring {
+    std::vector<XY> points;
+    double area;
+    size_t first;  // The piece handled first.
+    size_t parent;
+  };
+  std::vector<Ring> result(rings.size());
+  for (size_t r = 0; r < rings.size(); r++) {
+    std::vector<XY> points;
+    size_t first{kNoEvent};
+    for (const size_t i : rings[r]) {
+      points.push_back(vertices_[from[i]]);
+      events_[pieces[i]].ring = r;
+      if (first == kNoEvent ||
+          events_[pieces[i]].order < events_[first].order) {
+        first = pieces[i];
+      }
+    }
+    points = CleanRing(points);
+    const double area{points.empty() ? 0.0 : SignedArea(points)};
+    result[r] = {std::move(points), area, first, kNoEvent};
+  }
+
+  // A hole is in the ring of the result piece right below its first piece,
+  // or in the parent of that ring if it is another hole. The rings are found
+  // in sweep order, so that parent is known.
+  std::vector<size_t> order(rings.size());
+  for (size_t r = 0; r < order.size(); r++) {
+    order[r] = r;
+  }
+  std::sort(order.begin(), order.end(), [this, &result](size_t a, size_t b) {
+    return events_[result[a].first].order < events_[result[b].first].order;
+  });
+  for (const size_t r : order) {
+    Ring& ring{result[r]};
+    if (ring.area >= 0.0) {
+      continue;
+    }
+    // Pieces that left the result after an overlap are skipped.
+    size_t below{events_[ring.first].below};
+    while (below != kNoEvent && events_[below].ring == kNoEvent) {
+      below = events_[below].below;
+    }
+    const size_t r_below{below == kNoEvent ? kNoEvent : events_[below].ring};
+    if (r_below != kNoEvent && result[r_below].area != 0.0) {
+      ring.parent =
+          result[r_below].area > 0.0 ? r_below : result[r_below].parent;
+    }
+    if (ring.parent == kNoEvent && !ring.points.empty()) {
+      // Not expected, search the smallest ring around it.
+      for (size_t o = 0; o < result.size(); o++) {
+        if (result[o].area > 0.0 && InRing(result[o].points, ring.points[0]) &&
+            (ring.parent == kNoEvent ||
+             result[o].area < result[ring.parent].area)) {
+          ring.parent = o;
+        }
+      }
+    }
+  }
+
+  std::vector<PolygonWithHoles> polygons;
+  std::vector<size_t> index(rings.size(), kNoEvent);
+  for (const size_t r : order) {
+    if (result[r].area > 0.0) {
+      index[r] = polygons.size();
+      polygons.push_back({Polygon{ToCloud(result[r].points)}, {}});
+    }
+  }
+  for (const size_t r : order) {
+    if (result[r].area < 0.0 && result[r].parent != kNoEvent) {
+      polygons[index[result[r].parent]].holes.emplace_back(
+          ToCloud(result[r].points));
+    }
+  }
+  return polygons;
+}
+
+// /////////////////////////////
+// MARK: Slabs
+
+constexpr double kEpsilon{std::numeric_limits<double>::epsilon() / 2.0};
+// Error bound of the plain orientation determinant, as in Orient2D.
+constexpr double kOrientBound{(3.0 + 16.0 * kEpsilon) * kEpsilon};
+// Points per block of the batch queries.
+constexpr size_t kBlock{256};
+// Inputs smaller than this per thread are not split.
+constexpr size_t kParallelQuerySize{kBlock * 64};
+
+size_t NumberOfThreads(size_t nbr_threads, size_t n) {
+  if (nbr_threads == 0) {
+    nbr_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(1, std::min(nbr_threads, n / kParallelQuerySize));
+}
+
+// The slab helpers are templates, so they can take PolygonIndex's private
+// edge type.
+
+/// \brief Side of a point relative to an upward edge, 1 on its left.
+template <typename E>
+int Side(const E& e, double x, double y) {
+  return Sign(predicates::Orient2D(e.ax, e.ay, e.bx, e.by, x, y));
+}
+
+/// \brief Checks if e is left of f inside a slab that both cross.
+/// \details The higher of the lower ends is within the y range of the other
+/// edge, and so is the lower of the upper ends. The edges do not cross in
+/// the slab, so they are ordered by the side of one of these ends.
+template <typename E>
+bool LeftOf(const E& e, const E& f) {
+  int side{e.ay >= f.ay ? Side(f, e.ax, e.ay) : -Side(e, f.ax, f.ay)};
+  if (side == 0) {
+    // The lower ends touch, the upper ends differ.
+    side = e.by <= f.by ? Side(f, e.bx, e.by) : -Side(e, f.bx, f.by);
+  }
+  return side > 0;
+}
+
+/// \brief Orientation determinant of (a, b, p) in floating point and its
+/// error bound, the sign is exact if |det| > bound.
+struct FastOrient {
+  double det;
+  double bound;
+};
+
+inline FastOrient Orient(double ax, double ay, double bx, double by,
+                         double px, double py) {
+  const double left{(ax - px) * (by - py)};
+  const double right{(ay - py) * (bx - px)};
+  return {left - right, kOrientBound * (std::abs(left) + std::abs(right))};
+}
+
+// /////////////////////////////
+// MARK: Ear clipping
+
+/// \brief Ear clipping over a linked ring of corners, as in mapbox earcut.
+/// \details The nodes live in one vector and refer to each other by index.
+/// Bridges and splits copy corners, so a corner may appear in more than one
+/// node. Turns are positive to the left, the outer ring is linked counter
+/// clockwise and the holes clockwise.
+class EarClipper {
+ public:
+  explicit EarClipper(const PolygonWithHoles& polygon) {
+    size_t n{polygon.outer.GetCloud().Size()};
+    for (const auto& hole : polygon.holes) {
+      n += hole.GetCloud().Size();
+    }
+    nodes_.reserve(n + 2 * polygon.holes.size() + 16);
+    triangles_.reserve(n + 2 * polygon.holes.size());
+
+    size_t outer{Link(polygon.outer.GetCloud(), 0, true)};
+    if (!polygon.holes.empty()) {
+      outer = EliminateHoles(polygon, outer);
+    }
+    // Hashing only pays off for larger polygons.
+    if (n > kHashedSize) {
+      double x_max{nodes_[0].x};
+      double y_max{nodes_[0].y};
+      x_min_ = x_max;
+      y_min_ = y_max;
+      for (const auto& node : nodes_) {
+        x_min_ = std::min(x_min_, node.x);
+        y_min_ = std::min(y_min_, node.y);
+        x_max = std::max(x_max, node.x);
+        y_max = std::max(y_max, node.y);
+      }
+      const double size{std::max(x_max - x_min_, y_max - y_min_)};
+      inv_size_ = size > 0.0 ? kZRange / size : 0.0;
+    }
+    Clip(outer, 0);
+  }
+
+  std::vector<std::array<size_t, 3>> Triangles() {
+    return std::move(triangles_);
+  }
+
+ private:
+  struct Node {
+    double x;
+    double y;
+    size_t i;  // Index of the corner.
+    size_t prev;
+    size_t next;
+    size_t prev_z{kNone};  // Neighbors in z-order.
+    size_t next_z{kNone};
+    uint32_t z{0};
+  };
+
+  static constexpr size_t kNone{std::numeric_limits<size_t>::max()};
+  static constexpr size_t kHashedSize{80};
+  static constexpr double kZRange{65535.0};
+
+  /// \brief Turn of (p, q, r), positive to the left.
+  double Turn(size_t p, size_t q, size_t r) const {
+    const Node& a{nodes_[p]};
+    const Node& b{nodes_[q]};
+    const Node& c{nodes_[r]};
+    return (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+  }
+
+  bool Equals(size_t p, size_t q) const {
+    return nodes_[p].x == nodes_[q].x && nodes_[p].y == nodes_[q].y;
+  }
+
+  /// \brief Inserts a node after last, a ring of its own if there is none.
+  size_t Insert(size_t i, double x, double y, size_t last) {
+    const size_t p{nodes_.size()};
+    nodes_.push_back({x, y, i, p, p});
+    if (last != kNone) {
+      nodes_[p].next = nodes_[last].next;
+      nodes_[p].prev = last;
+      nodes_[nodes_[last].next].prev = p;
+      nodes_[last].next = p;
+    }
+    return p;
+  }
+
+  void Remove(size_t p) {
+    const Node& node{nodes_[p]};
+    nodes_[node.next].prev = node.prev;
+    nodes_[node.prev].next = node.next;
+    if (node.prev_z != kNone) {
+      nodes_[node.prev_z].next_z = node.next_z;
+    }
+    if (node.next_z != kNone) {
+      nodes_[node.next_z].prev_z = node.prev_z;
+    }
+  }
+
+  /// \brief Links a ring, counter clockwise or clockwise.
+  /// \return The last node.
+  size_t Link(const PointCloud& ring, size_t first, bool ccw) {
+    const size_t n{ring.Size()};
+    double area{0.0};
+    for (size_t i = 0, j = n - 1; i < n; j = i++) {
+      area += (ring.X(j) - ring.X(i)) * (ring.Y(i) + ring.Y(j));
+    }
+    size_t last{kNone};
+    if (ccw == (area > 0.0)) {
+      for (size_t i = 0; i < n; i++) {
+        last = Insert(first + i, ring.X(i), ring.Y(i), last);
+      }
+    } else {
+      for (size_t i = n; i-- > 0;) {
+        last = Insert(first + i, ring.X(i), ring.Y(i), last);
+      }
+    }
+    if (Equals(last, nodes_[last].next)) {
+      Remove(last);
+      last = nodes_[last].next;
+    }
+    return last;
+  }
+
+  /// \brief Removes duplicated and collinear corners between start and end.
+  size_t Filter(size_t start, size_t end = kNone) {
+    if (end == kNone) {
+      end = start;
+    }
+    size_t p{start};
+    bool again{false};
+    do {
+      again = false;
+      const Node& node{nodes_[p]};
+      if (Equals(p, node.next) || Turn(node.prev, p, node.next) == 0.0) {
+        Remove(p);
+        p = end = node.prev;
+        if (p == nodes_[p].next) {
+          break;
+        }
+        again = true;
+      } else {
+        p = node.next;
+      }
+    } while (again || p != end);
+    return end;
+  }
+
+  /// \brief Cuts ears off the ring, with more costly fallbacks in later
+  /// passes when no ear is found.
+  void Clip(size_t ear, int pass) {
+    if (pass == 0 && inv_size_ > 0.0) {
+      IndexCurve(ear);
+    }
+    size_t stop{ear};
+    while (nodes_[ear].prev != nodes_[ear].next) {
+      const size_t prev{nodes_[ear].prev};
+      const size_t next{nodes_[ear].next};
+      if (inv_size_ > 0.0 ? IsEarHashed(ear) : IsEar(ear)) {
+        triangles_.push_back({nodes_[prev].i, nodes_[ear].i, nodes_[next].i});
+        const bool reflex{Turn(ear, next, nodes_[next].next) <= 0.0};
+        Remove(ear);
+        // Skipping the next corner leaves fewer sliver triangles, as in
+        // earcut. A reflex corner may have turned into an ear though, which
+        // is tried at once, or concave stretches would only lose a corner
+        // per round.
+        ear = reflex ? next : nodes_[next].next;
+        stop = ear;
+        continue;
+      }
+      ear = next;
+      if (ear == stop) {
+        if (pass == 0) {
+          Clip(Filter(ear), 1);
+        } else if (pass == 1) {
+          Clip(CureLocalIntersections(Filter(ear)), 2);
+        } else {
+          Split(ear);
+        }
+        return;
+      }
+    }
+  }
+
+  /// \brief Checks if (px, py) is inside the counter clockwise triangle
+  /// (a, b, c), boundary included.
+  static bool InTriangle(double ax, double ay, double bx, double by,
+                         double cx, double cy, double px, double py) {
+    return (cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+           (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+           (bx - px) * (cy - py) >= (cx - px) * (by - py);
+  }
+
+  /// \brief Checks if a node blocks the ear (a, b, c): a reflex corner in
+  /// the triangle, other than a copy of a.
+  bool Blocks(size_t p, const Node& a, const Node& b, const Node& c) const {
+    const Node& node{nodes_[p]};
+    return !(a.x == node.x && a.y == node.y) &&
+           InTriangle(a.x, a.y, b.x, b.y, c.x, c.y, node.x, node.y) &&
+           Turn(node.prev, p, node.next) <= 0.0;
+  }
+
+  bool IsEar(size_t ear) const {
+    const size_t a{nodes_[ear].prev};
+    const size_t c{nodes_[ear].next};
+    if (Turn(a, ear, c) <= 0.0) {
+      return false;
+    }
+    const Node& na{nodes_[a]};
+    const Node& nb{nodes_[ear]};
+    const Node& nc{nodes_[c]};
+    const double x0{std::min({na.x, nb.x, nc.x})};
+    const double y0{std::min({na.y, nb.y, nc.y})};
+    const double x1{std::max({na.x, nb.x, nc.x})};
+    const double y1{std::max({na.y, nb.y, nc.y})};
+    for (size_t p = nc.next; p != a; p = nodes_[p].next) {
+      const Node& node{nodes_[p]};
+      if (node.x >= x0 && node.x <= x1 && node.y >= y0 && node.y <= y1 &&
+          Blocks(p, na, nb, nc)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief As IsEar, but only the nodes with z-order in the range of the
+  /// bounding box of the ear are tested.
+  bool IsEarHashed(size_t ear) const {
+    const size_t a{nodes_[ear].prev};
+    const size_t c{nodes_[ear].next};
+    if (Turn(a, ear, c) <= 0.0) {
+      return false;
+    }
+    const Node& na{nodes_[a]};
+    const Node& nb{nodes_[ear]};
+    const Node& nc{nodes_[c]};
+    const double x0{std::min({na.x, nb.x, nc.x})};
+    const double y0{std::min({na.y, nb.y, nc.y})};
+    const double x1{std::max({na.x, nb.x, nc.x})};
+    const double y1{std::max({na.y, nb.y, nc.y})};
+    const uint32_t z_min{ZOrder(x0, y0)};
+    const uint32_t z_max{ZOrder(x1, y1)};
+
+    const auto blocks = [&](size_t p) {
+      const Node& node{nodes_[p]};
+      return node.x >= x0 && node.x <= x1 && node.y >= y0 && node.y <= y1 &&
+             p != a && p != c && Blocks(p, na, nb, nc);
+    };
+    // Both directions at once, the closest nodes first.
+    size_t p{nb.prev_z};
+    size_t n{nb.next_z};
+    while (p != kNone && nodes_[p].z >= z_min && n != kNone &&
+           nodes_[n].z <= z_max) {
+      if (blocks(p) || blocks(n)) {
+        return false;
+      }
+      p = nodes_[p].prev_z;
+      n = nodes_[n].next_z;
+    }
+    for (; p != kNone && nodes_[p].z >= z_min; p = nodes_[p].prev_z) {
+      if (blocks(p)) {
+        return false;
+      }
+    }
+    for (; n != kNone && nodes_[n].z <= z_max; n = nodes_[n].next_z) {
+      if (blocks(n)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Interleaves the bits of the scaled coordinates, 16 bits each.
+  uint32_t ZOrder(double x, double y) const {
+    const auto spread = [](uint32_t v) {
+      v = (v | (v << 8U)) & 0x00FF00FFU;
+      v = (v | (v << 4U)) & 0x0F0F0F0FU;
+      v = (v | (v << 2U)) & 0x33333333U;
+      return (v | (v << 1U)) & 0x55555555U;
+    };
+    const auto ix = static_cast<uint32_t>((x - x_min_) * inv_size_);
+    const auto iy = static_cast<uint32_t>((y - y_min_) * inv_size_);
+    return spread(ix) | (spread(iy) << 1U);
+  }
+
+  /// \brief Links the nodes of a ring in z-order.
+  void IndexCurve(size_t start) {
+    order_.clear();
+    size_t p{start};
+    do {
+      Node& node{nodes_[p]};
+      if (node.z == 0) {
+        node.z = ZOrder(node.x, node.y);
+      }
+      order_.emplace_back(node.z, p);
+      p = node.next;
+    } while (p != start);
+
+    // On the pairs rather than through the nodes, to stay in the cache.
+    std::sort(order_.begin(), order_.end());
+    size_t prev{kNone};
+    for (const auto& [z, q] : order_) {
+      nodes_[q].prev_z = prev;
+      nodes_[q].next_z = kNone;
+      if (prev != kNone) {
+        nodes_[prev].next_z = q;
+      }
+      prev = q;
+    }
+  }
+
+  static int TurnSign(double turn) { return (turn > 0.0) - (turn < 0.0); }
+
+  /// \brief Checks if q is within the bounding box of p and r, the three
+  /// collinear.
+  bool OnSegment(size_t p, size_t q, size_t r) const {
+    const Node& a{nodes_[p]};
+    const Node& b{nodes_[q]};
+    const Node& c{nodes_[r]};
+    return b.x <= std::max(a.x, c.x) && b.x >= std::min(a.x, c.x) &&
+           b.y <= std::max(a.y, c.y) && b.y >= std::min(a.y, c.y);
+  }
+
+  bool Intersects(size_t p1, size_t q1, size_t p2, size_t q2) const {
+    const int o1{TurnSign(Turn(p1, q1, p2))};
+    const int o2{TurnSign(Turn(p1, q1, q2))};
+    const int o3{TurnSign(Turn(p2, q2, p1))};
+    const int o4{TurnSign(Turn(p2, q2, q1))};
+    return (o1 != o2 && o3 != o4) || (o1 == 0 && OnSegment(p1, p2, q1)) ||
+           (o2 == 0 && OnSegment(p1, q2, q1)) ||
+           (o3 == 0 && OnSegment(p2, p1, q2)) ||
+           (o4 == 0 && OnSegment(p2, q1, q2));
+  }
+
+  /// \brief Checks if the diagonal (a, b) crosses an edge of the ring.
+  bool IntersectsRing(size_t a, size_t b) const {
+    const size_t ia{nodes_[a].i};
+    const size_t ib{nodes_[b].i};
+    size_t p{a};
+    do {
+      const size_t q{nodes_[p].next};
+      if (nodes_[p].i != ia && nodes_[q].i != ia && nodes_[p].i != ib &&
+          nodes_[q].i != ib && Intersects(p, q, a, b)) {
+        return true;
+      }
+      p = q;
+    } while (p != a);
+    return false;
+  }
+
+  /// \brief Checks if the diagonal (a, b) starts into the inside at a.
+  bool LocallyInside(size_t a, size_t b) const {
+    const size_t prev{nodes_[a].prev};
+    const size_t next{nodes_[a].next};
+    return Turn(prev, a, next) > 0.0
+               ? Turn(a, b, next) <= 0.0 && Turn(a, prev, b) <= 0.0
+               : Turn(a, b, prev) > 0.0 || Turn(a, next, b) > 0.0;
+  }
+
+  /// \brief Checks if the middle of the diagonal (a, b) is inside the ring.
+  bool MiddleInside(size_t a, size_t b) const {
+    const double x{(nodes_[a].x + nodes_[b].x) / 2.0};
+    const double y{(nodes_[a].y + nodes_[b].y) / 2.0};
+    bool inside{false};
+    size_t p{a};
+    do {
+      const Node& u{nodes_[p]};
+      const Node& v{nodes_[u.next]};
+      if ((u.y > y) != (v.y > y) && v.y != u.y &&
+          x < (v.x - u.x) * (y - u.y) / (v.y - u.y) + u.x) {
+        inside = !inside;
+      }
+      p = u.next;
+    } while (p != a);
+    return inside;
+  }
+
+  bool IsValidDiagonal(size_t a, size_t b) const {
+    const Node& na{nodes_[a]};
+    const Node& nb{nodes_[b]};
+    if (nodes_[na.next].i == nb.i || nodes_[na.prev].i == nb.i ||
+        IntersectsRing(a, b)) {
+      return false;
+    }
+    // Visible, and does not leave sectors facing each other.
+    if (LocallyInside(a, b) && LocallyInside(b, a) && MiddleInside(a, b) &&
+        (Turn(na.prev, a, nb.prev) != 0.0 || Turn(a, nb.prev, b) != 0.0)) {
+      return true;
+    }
+    // A diagonal of zero length between two convex corners.
+    return Equals(a, b) && Turn(na.prev, a, na.next) < 0.0 &&
+           Turn(nb.prev, b, nb.next) < 0.0;
+  }
+
+  /// \brief Cuts off the corners where the ring crosses itself by one edge.
+  size_t CureLocalIntersections(size_t start) {
+    size_t p{start};
+    do {
+      const size_t a{nodes_[p].prev};
+      const size_t b{nodes_[nodes_[p].next].next};
+      if (!Equals(a, b) && Intersects(a, p, nodes_[p].next, b) &&
+          LocallyInside(a, b) && LocallyInside(b, a)) {
+        triangles_.push_back({nodes_[a].i, nodes_[p].i, nodes_[b].i});
+        Remove(nodes_[p].next);
+        Remove(p);
+        p = start = b;
+      }
+      p = nodes_[p].next;
+    } while (p != start);
+    return Filter(p);
+  }
+
+  /// \brief Links a and b with a diagonal, the ring is split in two.
+  /// \return The copy of b, on the ring that does not hold a.
+  size_t SplitRing(size_t a, size_t b) {
+    const size_t a2{nodes_.size()};
+    const size_t b2{a2 + 1};
+    const size_t an{nodes_[a].next};
+    const size_t bp{nodes_[b].prev};
+    nodes_.push_back({nodes_[a].x, nodes_[a].y, nodes_[a].i, b2, an});
+    nodes_.push_back({nodes_[b].x, nodes_[b].y, nodes_[b].i, bp, a2});
+    nodes_[a].next = b;
+    nodes_[b].prev = a;
+    nodes_[an].prev = a2;
+    nodes_[bp].next = b2;
+    return b2;
+  }
+
+  /// \brief Splits the ring along some valid diagonal and clips both sides.
+  void Split(size_t start) {
+    size_t a{start};
+    do {
+      for (size_t b = nodes_[nodes_[a].next].next; b != nodes_[a].prev;
+           b = nodes_[b].next) {
+        if (nodes_[a].i != nodes_[b].i && IsValidDiagonal(a, b)) {
+          size_t c{SplitRing(a, b)};
+          a = Filter(a, nodes_[a].next);
+          c = Filter(c, nodes_[c].next);
+          Clip(a, 0);
+          Clip(c, 0);
+          return;
+        }
+      }
+      a = nodes_[a].next;
+    } while (a != start);
+  }
+
+  /// \brief Joins the holes to the outer ring, leftmost hole first.
+  size_t EliminateHoles(const PolygonWithHoles& polygon, size_t outer) {
+    std::vector<size_t> queue;
+    size_t first{polygon.outer.GetCloud().Size()};
+    for (const auto& hole : polygon.holes) {
+      queue.push_back(Leftmost(Link(hole.GetCloud(), first, false)));
+      first += hole.GetCloud().Size();
+    }
+    std::sort(queue.begin(), queue.end(), [&](size_t u, size_t v) {
+      return nodes_[u].x < nodes_[v].x ||
+             (nodes_[u].x == nodes_[v].x && nodes_[u].y < nodes_[v].y);
+    });
+
+    // Rows of about eight corners each.
+    double y_max{nodes_[0].y};
+    row_y_ = y_max;
+    for (const auto& node : nodes_) {
+      row_y_ = std::min(row_y_, node.y);
+      y_max = std::max(y_max, node.y);
+    }
+    rows_.resize(nodes_.size() / 8 + 1);
+    row_scale_ = y_max > row_y_
+                     ? static_cast<double>(rows_.size()) / (y_max - row_y_)
+                     : 0.0;
+    size_t p{outer};
+    do {
+      AddEdge(p);
+      p = nodes_[p].next;
+    } while (p != outer);
+
+    for (const size_t hole : queue) {
+      EliminateHole(hole);
+    }
+    // Removes collinear corners around the cuts.
+    return Filter(outer);
+  }
+
+  size_t Row(double y) const {
+    return std::min(rows_.size() - 1,
+                    static_cast<size_t>((y - row_y_) * row_scale_));
+  }
+
+  /// \brief Adds the edge from p to the rows it spans.
+  void AddEdge(size_t p) {
+    const double y0{nodes_[p].y};
+    const double y1{nodes_[nodes_[p].next].y};
+    for (size_t r = Row(std::min(y0, y1)); r <= Row(std::max(y0, y1)); r++) {
+      rows_[r].push_back(p);
+    }
+  }
+
+  size_t Leftmost(size_t start) const {
+    size_t p{start};
+    size_t leftmost{start};
+    do {
+      const Node& node{nodes_[p]};
+      if (node.x < nodes_[leftmost].x ||
+          (node.x == nodes_[leftmost].x && node.y < nodes_[leftmost].y)) {
+        leftmost = p;
+      }
+      p = node.next;
+    } while (p != start);
+    return leftmost;
+  }
+
+  /// \brief Joins a hole to the outer ring and adds the new edges to the
+  /// rows. The bridge corner keeps its old rows, as the edges are read
+  /// through the nodes that is only a few extra tests.
+  void EliminateHole(size_t hole) {
+    const size_t bridge{HoleBridge(hole)};
+    if (bridge == kNone) {
+      return;
+    }
+    const size_t reverse{SplitRing(bridge, hole)};
+    AddEdge(bridge);
+    AddEdge(nodes_[reverse].next);
+    for (size_t p = hole; p != nodes_[reverse].next; p = nodes_[p].next) {
+      AddEdge(p);
+    }
+  }
+
+  /// \brief Checks if the sector of p is inside the sector of m.
+  bool SectorContainsSector(size_t m, size_t p) const {
+    return Turn(nodes_[m].prev, m, nodes_[p].prev) > 0.0 &&
+           Turn(nodes_[p].next, m, nodes_[m].next) > 0.0;
+  }
+
+  /// \brief Finds a corner of the outer ring that the leftmost corner of a
+  /// hole can be joined to, only the edges on the rows of the hole corner
+  /// and the candidate are visited.
+  size_t HoleBridge(size_t hole) const {
+    const double hx{nodes_[hole].x};
+    const double hy{nodes_[hole].y};
+    // The closest edge crossed by a ray to the left of the hole, its end
+    // with the smaller x is a candidate.
+    double qx{-std::numeric_limits<double>::infinity()};
+    size_t m{kNone};
+    for (const size_t p : rows_[Row(hy)]) {
+      const Node& u{nodes_[p]};
+      const Node& v{nodes_[u.next]};
+      if (Equals(hole, p)) {
+        return p;
+      }
+      if (hy <= u.y && hy >= v.y && v.y != u.y) {
+        const double x{u.x + (hy - u.y) * (v.x - u.x) / (v.y - u.y)};
+        if (x <= hx && x > qx) {
+          qx = x;
+          m = u.x < v.x ? p : u.next;
+          if (x == hx) {
+            // The hole touches the edge.
+            return m;
+          }
+        }
+      }
+    }
+    if (m == kNone) {
+      return kNone;
+    }
+
+    // A corner inside the triangle of the hole corner, the crossing and the
+    // candidate blocks the view, then the corner with the smallest angle to
+    // the ray is taken instead.
+    const double mx{nodes_[m].x};
+    const double my{nodes_[m].y};
+    double tan_min{std::numeric_limits<double>::infinity()};
+    for (size_t r = Row(std::min(hy, my)); r <= Row(std::max(hy, my)); r++) {
+      for (const size_t p : rows_[r]) {
+        const Node& node{nodes_[p]};
+        if (hx >= node.x && node.x >= mx && hx != node.x &&
+            InTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy,
+                       node.x, node.y)) {
+          const double tan{std::abs(hy - node.y) / (hx - node.x)};
+          if (LocallyInside(p, hole) &&
+              (tan < tan_min ||
+               (tan == tan_min &&
+                (node.x > nodes_[m].x ||
+                 (node.x == nodes_[m].x && SectorContainsSector(m, p)))))) {
+            m = p;
+            tan_min = tan;
+          }
+        }
+      }
+    }
+    return m;
+  }
+
+  std::vector<Node> nodes_;
+  std::vector<std::pair<uint32_t, size_t>> order_;
+  std::vector<std::array<size_t, 3>> triangles_;
+  // Edges by the node they start from, on rows of y.
+  std::vector<std::vector<size_t>> rows_;
+  double row_y_{0.0};
+  double row_scale_{0.0};
+  double x_min_{0.0};
+  double y_min_{0.0};
+  double inv_size_{0.0};
+};
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: Segment intersection
+
+std::vector<Intersection> Intersections(const std::vector<Edge>& edges) {
+  return Sweep{edges, false, false}.Run();
+}
+
+bool AnyIntersection(const std::vector<Edge>& edges) {
+  return !Sweep{edges, true, false}.Run().empty();
+}
+
+bool IsSimple(const Polygon& polygon) {
+  return Sweep{polygon.GetEdges(), true, true}.Run().empty();
+}
+
+// /////////////////////////////
+// MARK: Boolean operations
+
+std::vector<PolygonWithHoles> Clip(const Polygon& subject, const Polygon& clip,
+                                   BooleanOp op) {
+  if (op == BooleanOp::kIntersection &&
+      subject.GetCloud().Size() * clip.GetCloud().Size() <= kMaxConvexClip &&
+      IsConvex(subject.GetCloud()) && IsConvex(clip.GetCloud())) {
+    auto ring = ConvexClip(subject, clip);
+    if (ring.Empty()) {
+      return {};
+    }
+    return {PolygonWithHoles{Polygon{std::move(ring)}, {}}};
+  }
+  Clipper clipper{op};
+  clipper.AddRing(subject.GetCloud(), true);
+  clipper.AddRing(clip.GetCloud(), false);
+  return clipper.Run();
+}
+
+std::vector<PolygonWithHoles> Clip(const std::vector<PolygonWithHoles>& subject,
+                                   const std::vector<PolygonWithHoles>& clip,
+                                   BooleanOp op) {
+  Clipper clipper{op};
+  for (const bool is_subject : {true, false}) {
+    for (const auto& polygon : is_subject ? subject : clip) {
+      clipper.AddRing(polygon.outer.GetCloud(), is_subject);
+      for (const auto& hole : polygon.holes) {
+        clipper.AddRing(hole.GetCloud(), is_subject);
+      }
+    }
+  }
+  return clipper.Run();
+}
+
+PointCloud ConvexClip(const Polygon& subject, const Polygon& clip) {
+  const PointCloud& window{clip.GetCloud()};
+  std::vector<XY> ring;
+  for (size_t i = 0; i < subject.GetCloud().Size(); i++) {
+    ring.push_back({subject.GetCloud().X(i), subject.GetCloud().Y(i)});
+  }
+
+  // Keeps the part on the left of each clip edge in turn.
+  std::vector<XY> kept;
+  for (size_t i = 0; i < window.Size() && !ring.empty(); i++) {
+    const size_t j{(i + 1) % window.Size()};
+    const double ax{window.X(i)};
+    const double ay{window.Y(i)};
+    const double bx{window.X(j)};
+    const double by{window.Y(j)};
+    kept.clear();
+    for (size_t k = 0; k < ring.size(); k++) {
+      const XY& p{ring[k]};
+      const XY& q{ring[(k + 1) % ring.size()]};
+      const double op{predicates::Orient2D(ax, ay, bx, by, p.x, p.y)};
+      const double oq{predicates::Orient2D(ax, ay, bx, by, q.x, q.y)};
+      if (op >= 0.0) {
+        kept.push_back(p);
+      }
+      if ((op > 0.0 && oq < 0.0) || (op < 0.0 && oq > 0.0)) {
+        const double u{op / (op - oq)};
+        kept.push_back({p.x + u * (q.x - p.x), p.y + u * (q.y - p.y)});
+      }
+    }
+    std::swap(ring, kept);
+  }
+
+  ring = CleanRing(ring);
+  if (ring.empty() || SignedArea(ring) <= 0.0) {
+    return PointCloud{};
+  }
+  return ToCloud(std::move(ring));
+}
+
+// /////////////////////////////
+// MARK: Point in polygon
+
+bool IsInside(const Polygon& polygon, const Point& pt) {
+  const PointCloud& ring{polygon.GetCloud()};
+  const size_t n{ring.Size()};
+  const double x{pt.X()};
+  const double y{pt.Y()};
+  int winding{0};
+
+  for (size_t i = 0; i < n; i++) {
+    const size_t j{i + 1 == n ? 0 : i + 1};
+    const double ax{ring.X(i)};
+    const double ay{ring.Y(i)};
+    const double bx{ring.X(j)};
+    const double by{ring.Y(j)};
+    if (std::min(ay, by) > y || std::max(ay, by) < y || std::max(ax, bx) < x) {
+      continue;
+    }
+    const int side{Sign(predicates::Orient2D(ax, ay, bx, by, x, y))};
+    if (side == 0 && std::min(ax, bx) <= x) {
+      return true;
+    }
+    // Upward edges count with the point on their left, downward edges with
+    // the point on their right, half open in y.
+    if (ay <= y && by > y && side > 0) {
+      winding++;
+    } else if (ay > y && by <= y && side < 0) {
+      winding--;
+    }
+  }
+  return winding != 0;
+}
+
+PolygonIndex::PolygonIndex(const Polygon& polygon) : polygon_{polygon} {
+  const PointCloud& ring{polygon_.GetCloud()};
+  const size_t n{ring.Size()};
+  if (n <= kSmallPolygon) {
+    return;
+  }
+
+  ys_ = ring.Ys();
+  std::sort(ys_.begin(), ys_.end());
+  ys_.erase(std::unique(ys_.begin(), ys_.end()), ys_.end());
+  const auto row_of = [&](double y) {
+    return static_cast<size_t>(
+        std::lower_bound(ys_.begin(), ys_.end(), y) - ys_.begin());
+  };
+
+  // The corners and the horizontal edges are the boundary on the rows, the
+  // other edges go into every slab between their ends.
+  struct Interval {
+    size_t row;
+    double lo;
+    double hi;
+  };
+  std::vector<Interval> intervals;
+  std::vector<SlabEdge> edges;
+  std::vector<size_t> counts(ys_.size() + 1, 0);
+  for (size_t i = 0; i < n; i++) {
+    const size_t j{i + 1 == n ? 0 : i + 1};
+    const double ax{ring.X(i)};
+    const double ay{ring.Y(i)};
+    const double bx{ring.X(j)};
+    const double by{ring.Y(j)};
+    intervals.push_back({row_of(ay), ax, ax});
+    if (ay == by) {
+      intervals.push_back({row_of(ay), std::min(ax, bx), std::max(ax, bx)});
+      continue;
+    }
+    const SlabEdge e{ay < by ? SlabEdge{ax, ay, bx, by}
+                             : SlabEdge{bx, by, ax, ay}};
+    for (size_t row = row_of(e.ay), top = row_of(e.by); row < top; row++) {
+      counts[row]++;
+    }
+    edges.push_back(e);
+  }
+
+  offsets_.assign(ys_.size() + 1, 0);
+  for (size_t row = 0; row < ys_.size(); row++) {
+    offsets_[row + 1] = offsets_[row] + counts[row];
+  }
+  slab_edges_.resize(offsets_.back() + 1, SlabEdge{0.0, 0.0, 0.0, 0.0});
+  std::vector<size_t> next(offsets_.begin(), offsets_.end() - 1);
+  for (const SlabEdge& e : edges) {
+    for (size_t row = row_of(e.ay), top = row_of(e.by); row < top; row++) {
+      slab_edges_[next[row]++] = e;
+    }
+  }
+  size_t widest{0};
+  for (size_t row = 0; row < ys_.size(); row++) {
+    std::sort(slab_edges_.begin() + offsets_[row],
+              slab_edges_.begin() + offsets_[row + 1],
+              LeftOf<SlabEdge>);
+    widest = std::max(widest, counts[row]);
+  }
+  for (; widest > 0; widest /= 2) {
+    steps_++;
+  }
+
+  // Merges the intervals on each row into disjoint ones.
+  std::sort(intervals.begin(), intervals.end(),
+            [](const Interval& a, const Interval& b) {
+              return a.row < b.row || (a.row == b.row && a.lo < b.lo);
+            });
+  row_offsets_.assign(ys_.size() + 1, 0);
+  for (size_t k = 0; k < intervals.size(); k++) {
+    const Interval& in{intervals[k]};
+    if (k > 0 && intervals[k - 1].row == in.row && in.lo <= row_xs_.back()) {
+      row_xs_.back() = std::max(row_xs_.back(), in.hi);
+      continue;
+    }
+    row_xs_.push_back(in.lo);
+    row_xs_.push_back(in.hi);
+    row_offsets_[in.row + 1]++;
+  }
+  for (size_t row = 0; row < ys_.size(); row++) {
+    row_offsets_[row + 1] += row_offsets_[row];
+  }
+}
+
+bool PolygonIndex::OnRow(size_t row, double x) const {
+  // The last interval that starts at or before x.
+  size_t lo{row_offsets_[row]};
+  size_t hi{row_offsets_[row + 1]};
+  while (lo < hi) {
+    const size_t mid{lo + (hi - lo) / 2};
+    if (row_xs_[2 * mid] <= x) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo > row_offsets_[row] && x <= row_xs_[2 * lo - 1];
+}
+
+bool PolygonIndex::IsInside(const Point& pt) const {
+  if (ys_.empty()) {
+    return geometry::IsInside(polygon_, pt);
+  }
+  const double x{pt.X()};
+  const double y{pt.Y()};
+  if (!(y >= ys_.front() && y <= ys_.back())) {
+    return false;
+  }
+  const size_t row{static_cast<size_t>(
+      std::upper_bound(ys_.begin(), ys_.end(), y) - ys_.begin() - 1)};
+  if (ys_[row] == y && OnRow(row, x)) {
+    return true;
+  }
+
+  // Even-odd on the edges of the slab that are left of the point.
+  const auto first{slab_edges_.begin() + offsets_[row]};
+  const auto last{slab_edges_.begin() + offsets_[row + 1]};
+  const auto it{std::partition_point(
+      first, last, [&](const SlabEdge& e) { return Side(e, x, y) < 0; })};
+  if (it != last && Side(*it, x, y) == 0) {
+    return true;
+  }
+  return (it - first) % 2 == 1;
+}
+
+void PolygonIndex::Locate(const double* xs, const double* ys, size_t n,
+                          int* out) const {
+  // The loops below run over the whole block. The decisions are arithmetic
+  // on masks instead of branches, so that they can be vectorized.
+  if (ys_.empty()) {
+    // Winding number, the edges outside and the points inside the loop.
+    std::array<double, kBlock> winding{};
+    std::array<double, kBlock> exact{};
+    const PointCloud& ring{polygon_.GetCloud()};
+    for (size_t k = 0; k < ring.Size(); k++) {
+      const size_t j{k + 1 == ring.Size() ? 0 : k + 1};
+      const double ax{ring.X(k)};
+      const double ay{ring.Y(k)};
+      const double bx{ring.X(j)};
+      const double by{ring.Y(j)};
+      const double y_min{std::min(ay, by)};
+      const double y_max{std::max(ay, by)};
+      for (size_t i = 0; i < n; i++) {
+        const auto [det, bound] = Orient(ax, ay, bx, by, xs[i], ys[i]);
+        // 1 if the edge crosses the row of the point upwards, -1 downwards.
+        const double dir{(ay <= ys[i] ? 1.0 : 0.0) - (by <= ys[i] ? 1.0 : 0.0)};
+        const double side{(det > bound ? 1.0 : 0.0) -
+                          (det < -bound ? 1.0 : 0.0)};
+        // Counts if the point is on the left of an upward edge, or on the
+        // right of a downward edge.
+        winding[i] += std::max(dir * side, 0.0) * dir;
+        const double in_range{(ys[i] >= y_min ? 1.0 : 0.0) *
+                              (ys[i] <= y_max ? 1.0 : 0.0)};
+        exact[i] += side == 0.0 ? in_range : 0.0;
+      }
+    }
+    for (size_t i = 0; i < n; i++) {
+      out[i] = exact[i] != 0.0 ? static_cast<int>(IsInside(Point{xs[i], ys[i]}))
+                               : static_cast<int>(winding[i] != 0.0);
+    }
+    return;
+  }
+
+  // The slab of each point, a branchless upper bound on the rows.
+  std::array<size_t, kBlock> row{};
+  const double* rows{ys_.data()};
+  for (size_t len = ys_.size(), half = len / 2; len > 1;
+       len -= half, half = len / 2) {
+    for (size_t i = 0; i < n; i++) {
+      row[i] = rows[row[i] + half] <= ys[i] ? row[i] + half : row[i];
+    }
+  }
+
+  // The number of edges left of each point, a branchless partition point
+  // over the edges of its slab. Points on a row are tested exactly.
+  std::array<size_t, kBlock> first{};
+  std::array<size_t, kBlock> last{};
+  std::array<size_t, kBlock> exact{};
+  const double y_min{ys_.front()};
+  const double y_max{ys_.back()};
+  for (size_t i = 0; i < n; i++) {
+    const bool in_range{ys[i] >= y_min && ys[i] <= y_max};
+    first[i] = offsets_[row[i]];
+    last[i] = in_range ? offsets_[row[i] + 1] : first[i];
+    exact[i] = in_range && rows[row[i]] == ys[i];
+  }
+  std::array<size_t, kBlock> left = first;
+  std::array<size_t, kBlock> count{};
+  for (size_t i = 0; i < n; i++) {
+    count[i] = last[i] - first[i];
+  }
+  const SlabEdge* edges{slab_edges_.data()};
+  for (uint32_t step = 0; step < steps_; step++) {
+    for (size_t i = 0; i < n; i++) {
+      const size_t half{count[i] / 2};
+      const SlabEdge& e{edges[left[i] + half]};
+      const auto [det, bound] = Orient(e.ax, e.ay, e.bx, e.by, xs[i], ys[i]);
+      const size_t active{static_cast<size_t>(count[i] > 0)};
+      const size_t right{static_cast<size_t>(det < -bound) & active};
+      exact[i] |= static_cast<size_t>(std::abs(det) <= bound) & active;
+      // If right, the edges up to the middle one are left of the point.
+      left[i] += right * (half + 1);
+      count[i] = half - right * (2 * half + 1 - count[i]);
+    }
+  }
+  // The point may be on the first edge to its right.
+  for (size_t i = 0; i < n; i++) {
+    const SlabEdge& e{edges[left[i]]};
+    const auto [det, bound] = Orient(e.ax, e.ay, e.bx, e.by, xs[i], ys[i]);
+    exact[i] |= static_cast<size_t>(std::abs(det) <= bound) &
+                static_cast<size_t>(left[i] < last[i]);
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    out[i] = exact[i] != 0
+                 ? static_cast<int>(IsInside(Point{xs[i], ys[i]}))
+                 : static_cast<int>((left[i] - first[i]) % 2 == 1);
+  }
+}
+
+std::vector<int> PolygonIndex::IsInside(const PointCloud& points,
+                                        size_t nbr_threads) const {
+  const size_t n{points.Size()};
+  std::vector<int> inside(n, 0);
+  const size_t threads{NumberOfThreads(nbr_threads, n)};
+  std::atomic<size_t> next{0};
+
+  const auto worker = [&]() {
+    for (size_t begin = next.fetch_add(kBlock); begin < n;
+         begin = next.fetch_add(kBlock)) {
+      Locate(points.Xs().data() + begin, points.Ys().data() + begin,
+             std::min(kBlock, n - begin), inside.data() + begin);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threads; t++) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& w : workers) {
+    w.join();
+  }
+  return inside;
+}
+
+size_t PolygonIndex::SlabEdgeCount() const {
+  return offsets_.empty() ? 0 : offsets_.back();
+}
+
+// /////////////////////////////
+// MARK: Triangulation
+
+std::vector<std::array<size_t, 3>> Triangulate(
+    const PolygonWithHoles& polygon) {
+  return EarClipper{polygon}.Triangles();
+}
+
+std::vector<std::array<size_t, 3>> Triangulate(const Polygon& polygon) {
+  return Triangulate(PolygonWithHoles{polygon, {}});
+}
+
+}  // namespace algo::geometry
@@ -7,8 +7,17 @@
 #include "algo_graph.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
 #include <numeric>
 #include <queue>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define ALGO_GRAPH_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace algo::graph {
 
@@ -261,6 +270,39 @@ bool UndirectedGraph::IsBipartite() const
   return true;
 }
 
+// MARK: Triangles
+
+SortedAdjacency UndirectedGraph::Freeze() const
+{
+  SortedAdjacency adj;
+  adj.offsets.reserve(Size() + 1);
+  adj.offsets.push_back(0);
+
+  for (size_t i = 0; i < Size(); ++i) {
+    const auto begin = adj.neighbors.size();
+
+    for (const auto &conn : At(i)) {
+      adj.neighbors.push_back(conn.node);
+    }
+
+    // Sort and remove parallel edges.
+    std::sort(adj.neighbors.begin() + begin, adj.neighbors.end());
+    adj.neighbors.erase(std::unique(adj.neighbors.begin() + begin, adj.neighbors.end()), adj.neighbors.end());
+    adj.offsets.push_back(adj.neighbors.size());
+  }
+  return adj;
+}
+
+Counts UndirectedGraph::TriangleCount(size_t nbr_threads) const
+{
+  return graph::TriangleCount(Freeze(), nbr_threads);
+}
+
+Weights UndirectedGraph::ClusteringCoefficient(size_t nbr_threads) const
+{
+  return graph::ClusteringCoefficient(Freeze(), nbr_threads);
+}
+
 // //////////////////////////////////////////
 // - MARK: DirectedGraph -
 
@@ -705,4 +747,140 @@ double DirectedWeightedGraph::MaxFlowEdmondsKarp(size_t source, size_t dest)
   return max_flow;
 }
 
+// //////////////////////////////////////////
+// - MARK: Sorted adjacency -
+
+namespace {
+
+constexpr size_t kTriangleChunk{64UL};
+
+/// \brief Intersects two sorted lists without duplicates and calls emit for
+/// each common element. With SSE2, blocks of four are compared all-against-all
+/// before falling back to a scalar merge for the tails.
+template<typename Emit>
+void IntersectSorted(const int *a, size_t na, const int *b, size_t nb, Emit &&emit)
+{
+  size_t i{0};
+  size_t j{0};
+
+#ifdef ALGO_GRAPH_SSE2
+  while (i + 4 <= na && j + 4 <= nb) {
+    const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+
+    // Compare va with all four rotations of vb.
+    auto eq = _mm_cmpeq_epi32(va, vb);
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+
+    const auto mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+    for (int k = 0; mask != 0 && k < 4; ++k) {
+      if (mask & (1 << k)) emit(a[i + k]);
+    }
+
+    const auto a_max = a[i + 3];
+    const auto b_max = b[j + 3];
+    if (a_max <= b_max) i += 4;
+    if (b_max <= a_max) j += 4;
+  }
+#endif
+
+  while (i < na && j < nb) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      emit(a[i]);
+      ++i;
+      ++j;
+    }
+  }
+}
+
+/// \brief Returns the number of threads to use for n work items.
+size_t NumberOfThreads(size_t nbr_threads, size_t n)
+{
+  if (nbr_threads == 0) {
+    nbr_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(1, std::min(nbr_threads, n / kTriangleChunk + 1));
+}
+
+}// namespace
+
+Counts TriangleCount(const SortedAdjacency &adj, size_t nbr_threads)
+{
+  if (adj.offsets.size() < 2) return Counts{};
+
+  const size_t n{adj.offsets.size() - 1};
+  const auto degree = [&adj](size_t u) { return adj.offsets[u + 1] - adj.offsets[u]; };
+  const auto ranked_before = [&degree](size_t u, size_t v) {
+    return degree(u) < degree(v) || (degree(u) == degree(v) && u < v);
+  };
+
+  // Orient each edge from lower to higher rank, keeps the lists sorted by id.
+  std::vector<size_t> offsets(n + 1, 0);
+  Nodes out;
+  out.reserve(adj.neighbors.size() / 2);
+
+  for (size_t u = 0; u < n; ++u) {
+    for (size_t k = adj.offsets[u]; k < adj.offsets[u + 1]; ++k) {
+      if (ranked_before(u, adj.neighbors[k])) out.push_back(adj.neighbors[k]);
+    }
+    offsets[u + 1] = out.size();
+  }
+
+  const auto threads = NumberOfThreads(nbr_threads, n);
+  std::vector<Counts> partial(threads, Counts(n, 0));
+  std::atomic<size_t> next{0};
+
+  auto worker = [&](Counts &counts) {
+    for (auto begin = next.fetch_add(kTriangleChunk); begin < n; begin = next.fetch_add(kTriangleChunk)) {
+      const auto end = std::min(begin + kTriangleChunk, n);
+
+      for (auto u = begin; u < end; ++u) {
+        const auto *out_u = out.data() + offsets[u];
+        const auto size_u = offsets[u + 1] - offsets[u];
+
+        for (size_t k = 0; k < size_u; ++k) {
+          const auto v = static_cast<size_t>(out_u[k]);
+          IntersectSorted(out_u, size_u, out.data() + offsets[v], offsets[v + 1] - offsets[v], [&](int w) {
+            ++counts[u];
+            ++counts[v];
+            ++counts[w];
+          });
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t t = 1; t < threads; ++t) {
+    pool.emplace_back(worker, std::ref(partial[t]));
+  }
+  worker(partial.front());
+  for (auto &thread : pool) thread.join();
+
+  for (size_t t = 1; t < threads; ++t) {
+    std::transform(partial.front().begin(), partial.front().end(), partial[t].begin(), partial.front().begin(), std::plus<>());
+  }
+  return partial.front();
+}
+
+Weights ClusteringCoefficient(const SortedAdjacency &adj, size_t nbr_threads)
+{
+  const auto triangles = TriangleCount(adj, nbr_threads);
+  Weights coefficients(triangles.size(), 0.0);
+
+  for (size_t u = 0; u < triangles.size(); ++u) {
+    const auto degree = static_cast<double>(adj.offsets[u + 1] - adj.offsets[u]);
+    if (degree >= 2.0) {
+      coefficients[u] = 2.0 * static_cast<double>(triangles[u]) / (degree * (degree - 1.0));
+    }
+  }
+  return coefficients;
+}
+
 }// namespace algo::graph
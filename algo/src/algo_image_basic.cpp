@@ -9,6 +9,8 @@
 
 #include <algorithm>
 
+#include "algo_image_color.hpp"
+
 namespace algo::image {
 
 /////////////////////////////////////////////
@@ -67,6 +69,34 @@ void IntegralImage::Set(const int& x, const int& y, const uint32_t& value)
   data[y * size.cols + x] = value;
 }
 
+/////////////////////////////////////////////
+/// Instruction sets
+/////////////////////////////////////////////
+
+namespace {
+
+Simd DetectSimd()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Simd::AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return Simd::SSE2;
+  }
+#endif
+  return Simd::SCALAR;
+}
+
+}// namespace
+
+Simd DetectedSimd()
+{
+  static const Simd simd{DetectSimd()};
+  return simd;
+}
+
 /////////////////////////////////////////////
 /// Fundamental functions
 /////////////////////////////////////////////
@@ -82,15 +112,7 @@ Img NewImgGray(const int& rows, const int& cols)
 
 Img ToGray(const Img3& img3)
 {
-  int size{img3.size.rows * img3.size.cols};
-  Data8 data(size, 0);
-
-  for (int i = 0; i < size; i++) {
-    data[i] = 0.3 * img3.data[Red][i] + 0.59 * img3.data[Green][i] + 0.11 * img3.data[Blue][i];
-  }
-
-  Img img{data, img3.size};
-  return img;
+  return ToGray(ViewOf(img3));
 }
 
 ImgF ToFloat(const Img& img)
@@ -179,11 +201,67 @@ Img Subtract(const Img& im1, const Img& im2)
   return img;
 }
 
+/////////////////////////////////////////////
+/// Image views
+/////////////////////////////////////////////
+
+namespace {
+
+template <typename Image, typename T>
+Image FromViewPriv(const View<const T>& view)
+{
+  if (view.Empty()) {
+    return Image{{}, Size{0, 0}};
+  }
+  Image res{decltype(res.data)(static_cast<size_t>(view.size.rows) * view.size.cols), view.size};
+  for (int y = 0; y < view.size.rows; y++) {
+    std::copy(view.Row(y), view.Row(y) + view.size.cols, res.data.begin() + static_cast<size_t>(y) * view.size.cols);
+  }
+  return res;
+}
+
+}// namespace
+
+ImgView ViewOf(Img& im)
+{
+  return ImgView{im.data.data(), im.size, im.size.cols};
+}
+
+ConstImgView ViewOf(const Img& im)
+{
+  return ConstImgView{im.data.data(), im.size, im.size.cols};
+}
+
+ImgViewF ViewOf(ImgF& im)
+{
+  return ImgViewF{im.data.data(), im.size, im.size.cols};
+}
+
+ConstImgViewF ViewOf(const ImgF& im)
+{
+  return ConstImgViewF{im.data.data(), im.size, im.size.cols};
+}
+
+Img FromView(const ConstImgView& view)
+{
+  return FromViewPriv<Img>(view);
+}
+
+ImgF FromViewF(const ConstImgViewF& view)
+{
+  return FromViewPriv<ImgF>(view);
+}
+
 /////////////////////////////////////////////
 /// Integral images
 /////////////////////////////////////////////
 
 IntegralImage ImgToIntegralImage(const Img& im)
+{
+  return ImgToIntegralImage(ViewOf(im));
+}
+
+IntegralImage ImgToIntegralImage(const ConstImgView& im)
 {
   IntegralImage img{Data32(im.size.rows * im.size.cols, 0), im.size};
 
@@ -0,0 +1,924 @@
+///
+/// \brief Source code for color image layouts and color conversions.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_image_color.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ALGO_IMAGE_COLOR_X86
+#include <immintrin.h>
+#endif
+
+namespace algo::image {
+
+namespace {
+
+// The gray weights of red, green and blue in 14 bits, they add up to 1 << 14.
+constexpr int kShift{14};
+constexpr int kHalf{1 << (kShift - 1)};
+constexpr std::array<int, 3> kGrayWeights{4915, 9667, 1802};
+
+/// \brief The BT.601 YUV to RGB weights in 14 bits, `r = y * (Y - y_offset) + rv * (V - 128)` and so on.
+struct YuvWeights {
+  int y_offset;
+  int y;
+  int rv;
+  int gu;
+  int gv;
+  int bu;// Even, so that half of it fits in 16 bits.
+};
+
+constexpr YuvWeights kVideoWeights{16, 19077, 26149, 6419, 13320, 33050};
+constexpr YuvWeights kFullWeights{0, 16384, 22970, 5638, 11700, 29032};
+
+/// The weights of the bytes of an interleaved pixel, 0 for a byte that is not a color.
+using ByteWeights = std::array<int, 4>;
+/// A row of each byte of an interleaved pixel.
+using Planes = std::array<uint8_t*, 4>;
+using ConstPlanes = std::array<const uint8_t*, 4>;
+
+/// \brief A row of chroma values, see YuvView.
+struct ChromaRow {
+  const uint8_t* u;
+  const uint8_t* v;
+  int step;
+};
+
+inline uint8_t Clamp8(const int& v)
+{
+  return static_cast<uint8_t>(std::clamp(v, 0, 255));
+}
+
+/////////////////////////////////////////////
+/// Scalar row kernels
+/////////////////////////////////////////////
+
+// The vector kernels handle as many whole vectors as fit in the row and leave the rest, [begin, end), to these.
+
+void GrayPlanesScalar(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, int begin, int end)
+{
+  for (int x = begin; x < end; x++) {
+    dst[x] = static_cast<uint8_t>((kGrayWeights[0] * r[x] + kGrayWeights[1] * g[x] + kGrayWeights[2] * b[x]) >> kShift);
+  }
+}
+
+template <int Step>
+void GrayPackedScalar(const uint8_t* src, const ByteWeights& w, uint8_t* dst, int begin, int end)
+{
+  for (int x = begin; x < end; x++) {
+    const uint8_t* p{src + x * Step};
+    int sum{w[0] * p[0] + w[1] * p[1] + w[2] * p[2]};
+    if constexpr (Step == 4) {
+      sum += w[3] * p[3];
+    }
+    dst[x] = static_cast<uint8_t>(sum >> kShift);
+  }
+}
+
+template <int Step>
+void SplitScalar(const uint8_t* src, const Planes& dst, int begin, int end)
+{
+  for (int x = begin; x < end; x++) {
+    for (int k = 0; k < Step; k++) {
+      dst[k][x] = src[x * Step + k];
+    }
+  }
+}
+
+template <int Step>
+void MergeScalar(const ConstPlanes& src, uint8_t* dst, int begin, int end)
+{
+  for (int x = begin; x < end; x++) {
+    for (int k = 0; k < Step; k++) {
+      dst[x * Step + k] = src[k][x];
+    }
+  }
+}
+
+void YuvScalar(const uint8_t* y, const ChromaRow& uv, const YuvWeights& w, const Planes& rgb, int begin, int end)
+{
+  for (int x = begin; x < end; x++) {
+    const int c{y[x] - w.y_offset};
+    const int d{uv.u[(x >> 1) * uv.step] - 128};
+    const int e{uv.v[(x >> 1) * uv.step] - 128};
+    rgb[0][x] = Clamp8((w.y * c + w.rv * e + kHalf) >> kShift);
+    rgb[1][x] = Clamp8((w.y * c - w.gu * d - w.gv * e + kHalf) >> kShift);
+    rgb[2][x] = Clamp8((w.y * c + w.bu * d + kHalf) >> kShift);
+  }
+}
+
+void YuvGrayScalar(const uint8_t* y, const YuvWeights& w, uint8_t* dst, int begin, int end)
+{
+  for (int x = begin; x < end; x++) {
+    dst[x] = Clamp8((w.y * (y[x] - w.y_offset) + kHalf) >> kShift);
+  }
+}
+
+void GrayPlanesRowScalar(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, int cols)
+{
+  GrayPlanesScalar(r, g, b, dst, 0, cols);
+}
+
+template <int Step>
+void GrayPackedRowScalar(const uint8_t* src, const ByteWeights& w, uint8_t* dst, int cols)
+{
+  GrayPackedScalar<Step>(src, w, dst, 0, cols);
+}
+
+template <int Step>
+void SplitRowScalar(const uint8_t* src, const Planes& dst, int cols)
+{
+  SplitScalar<Step>(src, dst, 0, cols);
+}
+
+template <int Step>
+void MergeRowScalar(const ConstPlanes& src, uint8_t* dst, int cols)
+{
+  MergeScalar<Step>(src, dst, 0, cols);
+}
+
+void YuvRowScalar(const uint8_t* y, const ChromaRow& uv, const YuvWeights& w, const Planes& rgb, int cols)
+{
+  YuvScalar(y, uv, w, rgb, 0, cols);
+}
+
+void YuvGrayRowScalar(const uint8_t* y, const YuvWeights& w, uint8_t* dst, int cols)
+{
+  YuvGrayScalar(y, w, dst, 0, cols);
+}
+
+#ifdef ALGO_IMAGE_COLOR_X86
+
+/////////////////////////////////////////////
+/// Vector row kernels
+/////////////////////////////////////////////
+
+// The sums are computed in 32 bits with _mm_madd_epi16 on pairs of 16-bit values, the same sums as the scalar
+// kernels, so every instruction set gives the same image.
+
+/// \brief Returns a and b as the two 16-bit halves of a 32-bit value, the weights of one madd pair.
+constexpr int32_t Pair(const int& a, const int& b)
+{
+  return static_cast<int32_t>((static_cast<uint32_t>(static_cast<uint16_t>(b)) << 16U) | static_cast<uint16_t>(a));
+}
+
+/// \brief The byte that holds channel c of pixel i of 16 pixels of 3 bytes, in the 16 byte block of them, -1 if
+/// it is in another block. ScatterMask3 is the inverse, the pixel of each byte of a block.
+constexpr std::array<int8_t, 16> GatherMask3(const int& c, const int& block)
+{
+  std::array<int8_t, 16> mask{};
+  for (int i = 0; i < 16; i++) {
+    const int src{3 * i + c - 16 * block};
+    mask[i] = static_cast<int8_t>(src >= 0 && src < 16 ? src : -1);
+  }
+  return mask;
+}
+
+constexpr std::array<int8_t, 16> ScatterMask3(const int& c, const int& block)
+{
+  std::array<int8_t, 16> mask{};
+  for (int j = 0; j < 16; j++) {
+    const int byte{16 * block + j};
+    mask[j] = static_cast<int8_t>(byte % 3 == c ? byte / 3 : -1);
+  }
+  return mask;
+}
+
+constexpr std::array<std::array<int8_t, 16>, 9> kGather3{
+    GatherMask3(0, 0), GatherMask3(0, 1), GatherMask3(0, 2), GatherMask3(1, 0), GatherMask3(1, 1),
+    GatherMask3(1, 2), GatherMask3(2, 0), GatherMask3(2, 1), GatherMask3(2, 2)};
+constexpr std::array<std::array<int8_t, 16>, 9> kScatter3{
+    ScatterMask3(0, 0), ScatterMask3(0, 1), ScatterMask3(0, 2), ScatterMask3(1, 0), ScatterMask3(1, 1),
+    ScatterMask3(1, 2), ScatterMask3(2, 0), ScatterMask3(2, 1), ScatterMask3(2, 2)};
+// Transposes the 4x4 bytes of 4 pixels of 4 bytes, it is its own inverse.
+constexpr std::array<int8_t, 16> kTranspose4{0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15};
+
+__attribute__((target("sse2"))) inline __m128i Load(const uint8_t* src)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+
+__attribute__((target("sse2"))) inline void Store(uint8_t* dst, const __m128i& v)
+{
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+}
+
+__attribute__((target("sse2"))) inline __m128i Mask(const std::array<int8_t, 16>& mask)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask.data()));
+}
+
+/// \brief Splits 16 pixels of 3 bytes into 16 bytes of each.
+__attribute__((target("avx2"))) inline void Deinterleave3(const uint8_t* src, __m128i (&out)[3])
+{
+  const __m128i in[3]{Load(src), Load(src + 16), Load(src + 32)};
+  for (int c = 0; c < 3; c++) {
+    out[c] = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(in[0], Mask(kGather3[3 * c])),
+                                       _mm_shuffle_epi8(in[1], Mask(kGather3[3 * c + 1]))),
+                          _mm_shuffle_epi8(in[2], Mask(kGather3[3 * c + 2])));
+  }
+}
+
+/// \brief Transposes 4 vectors of 4 32-bit values.
+__attribute__((target("sse2"))) inline void Transpose4(__m128i (&v)[4])
+{
+  const __m128i t0{_mm_unpacklo_epi32(v[0], v[1])};
+  const __m128i t1{_mm_unpacklo_epi32(v[2], v[3])};
+  const __m128i t2{_mm_unpackhi_epi32(v[0], v[1])};
+  const __m128i t3{_mm_unpackhi_epi32(v[2], v[3])};
+  v[0] = _mm_unpacklo_epi64(t0, t1);
+  v[1] = _mm_unpackhi_epi64(t0, t1);
+  v[2] = _mm_unpacklo_epi64(t2, t3);
+  v[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/// \brief Packs the 32-bit values of the 16 pixels [lo | hi], as from unpacklo and unpackhi, to bytes.
+__attribute__((target("avx2"))) inline __m128i PackAvx2(const __m256i& lo, const __m256i& hi)
+{
+  const __m256i words{_mm256_packs_epi32(lo, hi)};
+  return _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+}
+
+/// \brief The gray values of 16 pixels from the 16-bit values of their three weighted channels.
+__attribute__((target("avx2"))) inline __m128i GrayAvx2(const __m256i& c0, const __m256i& c1, const __m256i& c2,
+                                                        const __m256i& w01, const __m256i& w2)
+{
+  const __m256i zero{_mm256_setzero_si256()};
+  const __m256i lo{_mm256_add_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(c0, c1), w01),
+                                    _mm256_madd_epi16(_mm256_unpacklo_epi16(c2, zero), w2))};
+  const __m256i hi{_mm256_add_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(c0, c1), w01),
+                                    _mm256_madd_epi16(_mm256_unpackhi_epi16(c2, zero), w2))};
+  return PackAvx2(_mm256_srli_epi32(lo, kShift), _mm256_srli_epi32(hi, kShift));
+}
+
+__attribute__((target("avx2"))) void GrayPlanesAvx2(const uint8_t* r, const uint8_t* g, const uint8_t* b,
+                                                    uint8_t* dst, int cols)
+{
+  const __m256i w01{_mm256_set1_epi32(Pair(kGrayWeights[0], kGrayWeights[1]))};
+  const __m256i w2{_mm256_set1_epi32(Pair(kGrayWeights[2], 0))};
+  int x{0};
+  for (; x + 16 <= cols; x += 16) {
+    Store(dst + x, GrayAvx2(_mm256_cvtepu8_epi16(Load(r + x)), _mm256_cvtepu8_epi16(Load(g + x)),
+                            _mm256_cvtepu8_epi16(Load(b + x)), w01, w2));
+  }
+  GrayPlanesScalar(r, g, b, dst, x, cols);
+}
+
+__attribute__((target("avx2"))) void GrayPacked3Avx2(const uint8_t* src, const ByteWeights& w, uint8_t* dst,
+                                                     int cols)
+{
+  const __m256i w01{_mm256_set1_epi32(Pair(w[0], w[1]))};
+  const __m256i w2{_mm256_set1_epi32(Pair(w[2], 0))};
+  __m128i bytes[3]{};
+  int x{0};
+  // The last 16 byte load of a vector ends at the last byte of its 16 pixels.
+  for (; x + 16 <= cols; x += 16) {
+    Deinterleave3(src + 3 * x, bytes);
+    Store(dst + x, GrayAvx2(_mm256_cvtepu8_epi16(bytes[0]), _mm256_cvtepu8_epi16(bytes[1]),
+                            _mm256_cvtepu8_epi16(bytes[2]), w01, w2));
+  }
+  GrayPackedScalar<3>(src, w, dst, x, cols);
+}
+
+/// \brief The gray values of 8 pixels of 4 bytes, in 32 bits.
+__attribute__((target("avx2"))) inline __m256i Gray4Avx2(const uint8_t* src, const __m256i& w02, const __m256i& w13)
+{
+  const __m256i v{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src))};
+  const __m256i sum{_mm256_add_epi32(_mm256_madd_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x00FF00FF)), w02),
+                                     _mm256_madd_epi16(_mm256_srli_epi16(v, 8), w13))};
+  return _mm256_srli_epi32(sum, kShift);
+}
+
+__attribute__((target("avx2"))) void GrayPacked4Avx2(const uint8_t* src, const ByteWeights& w, uint8_t* dst,
+                                                     int cols)
+{
+  // Bytes 0 and 2 of each pixel are a madd pair, and bytes 1 and 3.
+  const __m256i w02{_mm256_set1_epi32(Pair(w[0], w[2]))};
+  const __m256i w13{_mm256_set1_epi32(Pair(w[1], w[3]))};
+  int x{0};
+  for (; x + 16 <= cols; x += 16) {
+    // packs gives the pixels 0-3, 8-11, 4-7 and 12-15, the permute puts them in order.
+    const __m256i words{_mm256_permute4x64_epi64(
+        _mm256_packs_epi32(Gray4Avx2(src + 4 * x, w02, w13), Gray4Avx2(src + 4 * x + 32, w02, w13)),
+        _MM_SHUFFLE(3, 1, 2, 0))};
+    Store(dst + x, _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1)));
+  }
+  GrayPackedScalar<4>(src, w, dst, x, cols);
+}
+
+__attribute__((target("avx2"))) void Split3Avx2(const uint8_t* src, const Planes& dst, int cols)
+{
+  __m128i bytes[3]{};
+  int x{0};
+  for (; x + 16 <= cols; x += 16) {
+    Deinterleave3(src + 3 * x, bytes);
+    for (int k = 0; k < 3; k++) {
+      Store(dst[k] + x, bytes[k]);
+    }
+  }
+  SplitScalar<3>(src, dst, x, cols);
+}
+
+__attribute__((target("avx2"))) void Split4Avx2(const uint8_t* src, const Planes& dst, int cols)
+{
+  const __m128i transpose{Mask(kTranspose4)};
+  __m128i v[4]{};
+  int x{0};
+  for (; x + 16 <= cols; x += 16) {
+    for (int i = 0; i < 4; i++) {
+      v[i] = _mm_shuffle_epi8(Load(src + 4 * x + 16 * i), transpose);
+    }
+    Transpose4(v);
+    for (int k = 0; k < 4; k++) {
+      Store(dst[k] + x, v[k]);
+    }
+  }
+  SplitScalar<4>(src, dst, x, cols);
+}
+
+__attribute__((target("avx2"))) void Merge3Avx2(const ConstPlanes& src, uint8_t* dst, int cols)
+{
+  int x{0};
+  for (; x + 16 <= cols; x += 16) {
+    const __m128i in[3]{Load(src[0] + x), Load(src[1] + x), Load(src[2] + x)};
+    for (int block = 0; block < 3; block++) {
+      Store(dst + 3 * x + 16 * block,
+            _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(in[0], Mask(kScatter3[block])),
+                                      _mm_shuffle_epi8(in[1], Mask(kScatter3[3 + block]))),
+                         _mm_shuffle_epi8(in[2], Mask(kScatter3[6 + block]))));
+    }
+  }
+  MergeScalar<3>(src, dst, x, cols);
+}
+
+__attribute__((target("avx2"))) void Merge4Avx2(const ConstPlanes& src, uint8_t* dst, int cols)
+{
+  const __m128i transpose{Mask(kTranspose4)};
+  __m128i v[4]{};
+  int x{0};
+  for (; x + 16 <= cols; x += 16) {
+    for (int k = 0; k < 4; k++) {
+      v[k] = Load(src[k] + x);
+    }
+    Transpose4(v);
+    for (int i = 0; i < 4; i++) {
+      Store(dst + 4 * x + 16 * i, _mm_shuffle_epi8(v[i], transpose));
+    }
+  }
+  MergeScalar<4>(src, dst, x, cols);
+}
+
+/// \brief Loads the U and V values of 8 pixel pairs, from the two planes of I420 or the interleaved plane of NV12.
+/// \return False if the chroma is neither.
+__attribute__((target("sse2"))) inline bool LoadChroma8(const ChromaRow& uv, const int& x, __m128i& u, __m128i& v)
+{
+  if (uv.step == 1) {
+    u = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(uv.u + x / 2));
+    v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(uv.v + x / 2));
+    return true;
+  }
+  if (uv.step == 2 && (uv.v == uv.u + 1 || uv.u == uv.v + 1)) {
+    const __m128i both{Load(std::min(uv.u, uv.v) + x)};
+    const __m128i first{_mm_packus_epi16(_mm_and_si128(both, _mm_set1_epi16(0xFF)), _mm_setzero_si128())};
+    const __m128i second{_mm_packus_epi16(_mm_srli_epi16(both, 8), _mm_setzero_si128())};
+    u = uv.u < uv.v ? first : second;
+    v = uv.u < uv.v ? second : first;
+    return true;
+  }
+  return false;
+}
+
+/// \brief Rounds the 32-bit sums of 16 pixels [lo | hi] in 14 bits to bytes.
+__attribute__((target("avx2"))) inline __m128i RoundAvx2(const __m256i& lo, const __m256i& hi)
+{
+  const __m256i half{_mm256_set1_epi32(kHalf)};
+  return PackAvx2(_mm256_srai_epi32(_mm256_add_epi32(lo, half), kShift),
+                  _mm256_srai_epi32(_mm256_add_epi32(hi, half), kShift));
+}
+
+__attribute__((target("avx2"))) void YuvAvx2(const uint8_t* y, const ChromaRow& uv, const YuvWeights& w,
+                                             const Planes& rgb, int cols)
+{
+  const __m256i zero{_mm256_setzero_si256()};
+  const __m256i y_offset{_mm256_set1_epi16(static_cast<int16_t>(w.y_offset))};
+  const __m256i c128{_mm256_set1_epi16(128)};
+  const __m256i wr{_mm256_set1_epi32(Pair(w.y, w.rv))};
+  const __m256i wg{_mm256_set1_epi32(Pair(w.y, -w.gu))};
+  const __m256i wgv{_mm256_set1_epi32(Pair(-w.gv, 0))};
+  const __m256i wb{_mm256_set1_epi32(Pair(w.y, w.bu / 2))};
+
+  int x{0};
+  __m128i u8{};
+  __m128i v8{};
+  for (; x + 16 <= cols && LoadChroma8(uv, x, u8, v8); x += 16) {
+    const __m256i c{_mm256_sub_epi16(_mm256_cvtepu8_epi16(Load(y + x)), y_offset)};
+    const __m256i d{_mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpacklo_epi8(u8, u8)), c128)};
+    const __m256i e{_mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpacklo_epi8(v8, v8)), c128)};
+    const __m256i d2{_mm256_add_epi16(d, d)};
+
+    Store(rgb[0] + x, RoundAvx2(_mm256_madd_epi16(_mm256_unpacklo_epi16(c, e), wr),
+                               _mm256_madd_epi16(_mm256_unpackhi_epi16(c, e), wr)));
+    Store(rgb[1] + x, RoundAvx2(_mm256_add_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(c, d), wg),
+                                                _mm256_madd_epi16(_mm256_unpacklo_epi16(e, zero), wgv)),
+                               _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(c, d), wg),
+                                                _mm256_madd_epi16(_mm256_unpackhi_epi16(e, zero), wgv))));
+    Store(rgb[2] + x, RoundAvx2(_mm256_madd_epi16(_mm256_unpacklo_epi16(c, d2), wb),
+                               _mm256_madd_epi16(_mm256_unpackhi_epi16(c, d2), wb)));
+  }
+  YuvScalar(y, uv, w, rgb, x, cols);
+}
+
+__attribute__((target("avx2"))) void YuvGrayAvx2(const uint8_t* y, const YuvWeights& w, uint8_t* dst, int cols)
+{
+  const __m256i y_offset{_mm256_set1_epi16(static_cast<int16_t>(w.y_offset))};
+  const __m256i one{_mm256_set1_epi16(1)};
+  const __m256i wy{_mm256_set1_epi32(Pair(w.y, kHalf))};
+  int x{0};
+  for (; x + 16 <= cols; x += 16) {
+    const __m256i c{_mm256_sub_epi16(_mm256_cvtepu8_epi16(Load(y + x)), y_offset)};
+    Store(dst + x, PackAvx2(_mm256_srai_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(c, one), wy), kShift),
+                            _mm256_srai_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(c, one), wy), kShift)));
+  }
+  YuvGrayScalar(y, w, dst, x, cols);
+}
+
+/// \brief Packs the 32-bit values of 8 pixels [lo, hi] to bytes, in the low half.
+__attribute__((target("sse2"))) inline __m128i PackSse2(const __m128i& lo, const __m128i& hi)
+{
+  return _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+}
+
+__attribute__((target("sse2"))) inline void StoreLow(uint8_t* dst, const __m128i& v)
+{
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), v);
+}
+
+/// \brief The 16-bit values of 8 bytes.
+__attribute__((target("sse2"))) inline __m128i Widen8(const uint8_t* src)
+{
+  return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)), _mm_setzero_si128());
+}
+
+__attribute__((target("sse2"))) void GrayPlanesSse2(const uint8_t* r, const uint8_t* g, const uint8_t* b,
+                                                    uint8_t* dst, int cols)
+{
+  const __m128i zero{_mm_setzero_si128()};
+  const __m128i w01{_mm_set1_epi32(Pair(kGrayWeights[0], kGrayWeights[1]))};
+  const __m128i w2{_mm_set1_epi32(Pair(kGrayWeights[2], 0))};
+  int x{0};
+  for (; x + 8 <= cols; x += 8) {
+    const __m128i c0{Widen8(r + x)};
+    const __m128i c1{Widen8(g + x)};
+    const __m128i c2{Widen8(b + x)};
+    const __m128i lo{_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(c0, c1), w01),
+                                   _mm_madd_epi16(_mm_unpacklo_epi16(c2, zero), w2))};
+    const __m128i hi{_mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(c0, c1), w01),
+                                   _mm_madd_epi16(_mm_unpackhi_epi16(c2, zero), w2))};
+    StoreLow(dst + x, PackSse2(_mm_srli_epi32(lo, kShift), _mm_srli_epi32(hi, kShift)));
+  }
+  GrayPlanesScalar(r, g, b, dst, x, cols);
+}
+
+/// \brief The gray values of 4 pixels of 4 bytes, in 32 bits.
+__attribute__((target("sse2"))) inline __m128i Gray4Sse2(const uint8_t* src, const __m128i& w02, const __m128i& w13)
+{
+  const __m128i v{Load(src)};
+  const __m128i sum{_mm_add_epi32(_mm_madd_epi16(_mm_and_si128(v, _mm_set1_epi32(0x00FF00FF)), w02),
+                                  _mm_madd_epi16(_mm_srli_epi16(v, 8), w13))};
+  return _mm_srli_epi32(sum, kShift);
+}
+
+__attribute__((target("sse2"))) void GrayPacked4Sse2(const uint8_t* src, const ByteWeights& w, uint8_t* dst,
+                                                     int cols)
+{
+  const __m128i w02{_mm_set1_epi32(Pair(w[0], w[2]))};
+  const __m128i w13{_mm_set1_epi32(Pair(w[1], w[3]))};
+  int x{0};
+  for (; x + 8 <= cols; x += 8) {
+    StoreLow(dst + x, PackSse2(Gray4Sse2(src + 4 * x, w02, w13), Gray4Sse2(src + 4 * x + 16, w02, w13)));
+  }
+  GrayPackedScalar<4>(src, w, dst, x, cols);
+}
+
+/// \brief Rounds the 32-bit sums of 8 pixels [lo, hi] in 14 bits to bytes, in the low half.
+__attribute__((target("sse2"))) inline __m128i RoundSse2(const __m128i& lo, const __m128i& hi)
+{
+  const __m128i half{_mm_set1_epi32(kHalf)};
+  return PackSse2(_mm_srai_epi32(_mm_add_epi32(lo, half), kShift), _mm_srai_epi32(_mm_add_epi32(hi, half), kShift));
+}
+
+__attribute__((target("sse2"))) void YuvSse2(const uint8_t* y, const ChromaRow& uv, const YuvWeights& w,
+                                             const Planes& rgb, int cols)
+{
+  const __m128i zero{_mm_setzero_si128()};
+  const __m128i y_offset{_mm_set1_epi16(static_cast<int16_t>(w.y_offset))};
+  const __m128i c128{_mm_set1_epi16(128)};
+  const __m128i wr{_mm_set1_epi32(Pair(w.y, w.rv))};
+  const __m128i wg{_mm_set1_epi32(Pair(w.y, -w.gu))};
+  const __m128i wgv{_mm_set1_epi32(Pair(-w.gv, 0))};
+  const __m128i wb{_mm_set1_epi32(Pair(w.y, w.bu / 2))};
+
+  // 16 pixels per chroma load, as two vectors of 8.
+  int x{0};
+  __m128i u8{};
+  __m128i v8{};
+  for (; x + 16 <= cols && LoadChroma8(uv, x, u8, v8); x += 16) {
+    for (int part = 0; part < 2; part++) {
+      const int px{x + 8 * part};
+      const __m128i u_part{part == 0 ? _mm_unpacklo_epi8(u8, u8) : _mm_srli_si128(_mm_unpacklo_epi8(u8, u8), 8)};
+      const __m128i v_part{part == 0 ? _mm_unpacklo_epi8(v8, v8) : _mm_srli_si128(_mm_unpacklo_epi8(v8, v8), 8)};
+      const __m128i c{_mm_sub_epi16(Widen8(y + px), y_offset)};
+      const __m128i d{_mm_sub_epi16(_mm_unpacklo_epi8(u_part, zero), c128)};
+      const __m128i e{_mm_sub_epi16(_mm_unpacklo_epi8(v_part, zero), c128)};
+      const __m128i d2{_mm_add_epi16(d, d)};
+
+      StoreLow(rgb[0] + px, RoundSse2(_mm_madd_epi16(_mm_unpacklo_epi16(c, e), wr),
+                                     _mm_madd_epi16(_mm_unpackhi_epi16(c, e), wr)));
+      StoreLow(rgb[1] + px, RoundSse2(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(c, d), wg),
+                                                   _mm_madd_epi16(_mm_unpacklo_epi16(e, zero), wgv)),
+                                     _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(c, d), wg),
+                                                   _mm_madd_epi16(_mm_unpackhi_epi16(e, zero), wgv))));
+      StoreLow(rgb[2] + px, RoundSse2(_mm_madd_epi16(_mm_unpacklo_epi16(c, d2), wb),
+                                     _mm_madd_epi16(_mm_unpackhi_epi16(c, d2), wb)));
+    }
+  }
+  YuvScalar(y, uv, w, rgb, x, cols);
+}
+
+__attribute__((target("sse2"))) void YuvGraySse2(const uint8_t* y, const YuvWeights& w, uint8_t* dst, int cols)
+{
+  const __m128i y_offset{_mm_set1_epi16(static_cast<int16_t>(w.y_offset))};
+  const __m128i one{_mm_set1_epi16(1)};
+  const __m128i wy{_mm_set1_epi32(Pair(w.y, kHalf))};
+  int x{0};
+  for (; x + 8 <= cols; x += 8) {
+    const __m128i c{_mm_sub_epi16(Widen8(y + x), y_offset)};
+    StoreLow(dst + x, PackSse2(_mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(c, one), wy), kShift),
+                               _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(c, one), wy), kShift)));
+  }
+  YuvGrayScalar(y, w, dst, x, cols);
+}
+
+#endif// ALGO_IMAGE_COLOR_X86
+
+/// \brief The row kernels of an instruction set.
+struct Kernels {
+  void (*gray_planes)(const uint8_t*, const uint8_t*, const uint8_t*, uint8_t*, int);
+  void (*gray3)(const uint8_t*, const ByteWeights&, uint8_t*, int);
+  void (*gray4)(const uint8_t*, const ByteWeights&, uint8_t*, int);
+  void (*split3)(const uint8_t*, const Planes&, int);
+  void (*split4)(const uint8_t*, const Planes&, int);
+  void (*merge3)(const ConstPlanes&, uint8_t*, int);
+  void (*merge4)(const ConstPlanes&, uint8_t*, int);
+  void (*yuv)(const uint8_t*, const ChromaRow&, const YuvWeights&, const Planes&, int);
+  void (*yuv_gray)(const uint8_t*, const YuvWeights&, uint8_t*, int);
+};
+
+Kernels SelectKernels(const Simd& simd)
+{
+  Kernels kernels{GrayPlanesRowScalar,   GrayPackedRowScalar<3>, GrayPackedRowScalar<4>,
+                  SplitRowScalar<3>,     SplitRowScalar<4>,      MergeRowScalar<3>,
+                  MergeRowScalar<4>,     YuvRowScalar,           YuvGrayRowScalar};
+  switch (std::min(simd, DetectedSimd())) {
+#ifdef ALGO_IMAGE_COLOR_X86
+    case Simd::AVX2:
+      return Kernels{GrayPlanesAvx2, GrayPacked3Avx2, GrayPacked4Avx2, Split3Avx2, Split4Avx2,
+                     Merge3Avx2,     Merge4Avx2,      YuvAvx2,         YuvGrayAvx2};
+    case Simd::SSE2:
+      kernels.gray_planes = GrayPlanesSse2;
+      kernels.gray4 = GrayPacked4Sse2;
+      kernels.yuv = YuvSse2;
+      kernels.yuv_gray = YuvGraySse2;
+      break;
+#endif
+    default: break;
+  }
+  return kernels;
+}
+
+/// \brief How the channels of a view are stored.
+struct Packing {
+  int step{0};                 // 1 for planes, 3 or 4 for interleaved pixels, 0 for any other view.
+  std::array<int, 3> offsets{};// The byte of each channel in an interleaved pixel.
+};
+
+Packing PackingOf(const Img3View& im)
+{
+  if (im.step == 1) {
+    return Packing{1, {}};
+  }
+  if (im.step != 3 && im.step != 4) {
+    return Packing{};
+  }
+  const uint8_t* first{std::min({im.data[Red], im.data[Green], im.data[Blue]})};
+  Packing packing{im.step, {}};
+  for (int c = 0; c < 3; c++) {
+    packing.offsets[c] = static_cast<int>(im.data[c] - first);
+  }
+  const auto& o = packing.offsets;
+  if (o[0] == o[1] || o[0] == o[2] || o[1] == o[2] || *std::max_element(o.begin(), o.end()) >= im.step) {
+    return Packing{};
+  }
+  return packing;
+}
+
+/// \brief Returns the first byte of the first pixel of row y of an interleaved view.
+const uint8_t* PixelRow(const Img3View& im, const Packing& packing, const int& y)
+{
+  return im.Row(Red, y) - packing.offsets[Red];
+}
+
+/// \brief Returns the three channels of row y of im as planes, split into tmp if im is not planar.
+std::array<const uint8_t*, 3> PlanarRow(const Img3View& im, const Packing& packing, const Kernels& kernels,
+                                        const int& y, std::array<Data8, 4>& tmp)
+{
+  const int cols{im.size.cols};
+  if (packing.step == 1) {
+    return {im.Row(Red, y), im.Row(Green, y), im.Row(Blue, y)};
+  }
+  const Planes planes{tmp[0].data(), tmp[1].data(), tmp[2].data(), tmp[3].data()};
+  if (packing.step == 3) {
+    kernels.split3(PixelRow(im, packing, y), planes, cols);
+  } else if (packing.step == 4) {
+    kernels.split4(PixelRow(im, packing, y), planes, cols);
+  } else {
+    for (int c = 0; c < 3; c++) {
+      for (int x = 0; x < cols; x++) {
+        tmp[c][x] = im.At(c, x, y);
+      }
+    }
+    return {tmp[0].data(), tmp[1].data(), tmp[2].data()};
+  }
+  const auto& o = packing.offsets;
+  return {tmp[o[Red]].data(), tmp[o[Green]].data(), tmp[o[Blue]].data()};
+}
+
+std::array<int, 3> ChannelOffsets(const PixelFormat& format)
+{
+  if (format == PixelFormat::BGR || format == PixelFormat::BGRA) {
+    return {2, 1, 0};
+  }
+  return {0, 1, 2};
+}
+
+}// namespace
+
+/////////////////////////////////////////////
+/// Interleaved images
+/////////////////////////////////////////////
+
+int BytesPerPixel(const PixelFormat& format)
+{
+  return format == PixelFormat::RGBA || format == PixelFormat::BGRA ? 4 : 3;
+}
+
+/////////////////////////////////////////////
+/// Color views
+/////////////////////////////////////////////
+
+bool Img3View::Empty() const
+{
+  return data[Red] == nullptr || data[Green] == nullptr || data[Blue] == nullptr || size.rows <= 0
+      || size.cols <= 0;
+}
+
+Img3View Img3View::Roi(const Rectangle& rect) const
+{
+  if (rect.x < 0 || rect.y < 0 || rect.width <= 0 || rect.height <= 0 || rect.x + rect.width > size.cols
+      || rect.y + rect.height > size.rows) {
+    return Img3View{};
+  }
+  Img3View view{*this};
+  for (int c = 0; c < 3; c++) {
+    view.data[c] = Row(c, rect.y) + rect.x * step;
+  }
+  view.size = Size{rect.height, rect.width};
+  return view;
+}
+
+Img3View ViewOf(const Img3& im)
+{
+  const size_t size{static_cast<size_t>(std::max(0, im.size.rows)) * std::max(0, im.size.cols)};
+  if (im.data[Red].size() < size || im.data[Green].size() < size || im.data[Blue].size() < size) {
+    return Img3View{};
+  }
+  return Img3View{{im.data[Red].data(), im.data[Green].data(), im.data[Blue].data()}, im.size, im.size.cols, 1};
+}
+
+Img3View ViewOf(const ImgInterleaved& im)
+{
+  const size_t size{static_cast<size_t>(std::max(0, im.size.rows)) * std::max(0, im.size.cols)};
+  if (im.data.size() < size * BytesPerPixel(im.format)) {
+    return Img3View{};
+  }
+  return InterleavedView(im.data.data(), im.size, im.format);
+}
+
+Img3View InterleavedView(const uint8_t* data, const Size& size, const PixelFormat& format, const int& stride)
+{
+  if (data == nullptr) {
+    return Img3View{};
+  }
+  const int step{BytesPerPixel(format)};
+  const std::array<int, 3> offsets{ChannelOffsets(format)};
+  return Img3View{{data + offsets[Red], data + offsets[Green], data + offsets[Blue]},
+                  size,
+                  stride > 0 ? stride : size.cols * step,
+                  step};
+}
+
+/////////////////////////////////////////////
+/// Layout conversions
+/////////////////////////////////////////////
+
+Img3 ToPlanar(const Img3View& im, Simd simd)
+{
+  if (im.Empty()) {
+    return Img3{{}, Size{0, 0}};
+  }
+  const int cols{im.size.cols};
+  const Packing packing{PackingOf(im)};
+  const Kernels kernels{SelectKernels(simd)};
+
+  Img3 res{{}, im.size};
+  for (auto& plane : res.data) {
+    plane.resize(static_cast<size_t>(im.size.rows) * cols);
+  }
+  Data8 alpha(cols);
+  for (int y = 0; y < im.size.rows; y++) {
+    const size_t row{static_cast<size_t>(y) * cols};
+    if (packing.step == 3 || packing.step == 4) {
+      Planes planes{alpha.data(), alpha.data(), alpha.data(), alpha.data()};
+      for (int c = 0; c < 3; c++) {
+        planes[packing.offsets[c]] = res.data[c].data() + row;
+      }
+      (packing.step == 3 ? kernels.split3 : kernels.split4)(PixelRow(im, packing, y), planes, cols);
+      continue;
+    }
+    for (int c = 0; c < 3; c++) {
+      for (int x = 0; x < cols; x++) {
+        res.data[c][row + x] = im.At(c, x, y);
+      }
+    }
+  }
+  return res;
+}
+
+ImgInterleaved ToInterleaved(const Img3View& im, const PixelFormat& format, Simd simd)
+{
+  if (im.Empty()) {
+    return ImgInterleaved{{}, Size{0, 0}, format};
+  }
+  const int cols{im.size.cols};
+  const int step{BytesPerPixel(format)};
+  const std::array<int, 3> offsets{ChannelOffsets(format)};
+  const Packing packing{PackingOf(im)};
+  const Kernels kernels{SelectKernels(simd)};
+
+  ImgInterleaved res{Data8(static_cast<size_t>(im.size.rows) * cols * step), im.size, format};
+  const Data8 alpha(cols, 255);
+  std::array<Data8, 4> tmp{Data8(cols), Data8(cols), Data8(cols), Data8(cols)};
+  for (int y = 0; y < im.size.rows; y++) {
+    const std::array<const uint8_t*, 3> channels{PlanarRow(im, packing, kernels, y, tmp)};
+    ConstPlanes src{alpha.data(), alpha.data(), alpha.data(), alpha.data()};
+    for (int c = 0; c < 3; c++) {
+      src[offsets[c]] = channels[c];
+    }
+    uint8_t* dst{res.data.data() + static_cast<size_t>(y) * cols * step};
+    (step == 3 ? kernels.merge3 : kernels.merge4)(src, dst, cols);
+  }
+  return res;
+}
+
+bool ToGray(const Img3View& im, const ImgView& out, Simd simd)
+{
+  if (im.Empty() || out.Empty() || !(out.size == im.size)) {
+    return false;
+  }
+  const int cols{im.size.cols};
+  const Packing packing{PackingOf(im)};
+  const Kernels kernels{SelectKernels(simd)};
+  ByteWeights weights{};
+  for (int c = 0; c < 3; c++) {
+    weights[packing.offsets[c]] = kGrayWeights[c];
+  }
+
+  for (int y = 0; y < im.size.rows; y++) {
+    uint8_t* dst{out.Row(y)};
+    if (packing.step == 1) {
+      kernels.gray_planes(im.Row(Red, y), im.Row(Green, y), im.Row(Blue, y), dst, cols);
+    } else if (packing.step == 3) {
+      kernels.gray3(PixelRow(im, packing, y), weights, dst, cols);
+    } else if (packing.step == 4) {
+      kernels.gray4(PixelRow(im, packing, y), weights, dst, cols);
+    } else {
+      for (int x = 0; x < cols; x++) {
+        const int sum{kGrayWeights[0] * im.At(Red, x, y) + kGrayWeights[1] * im.At(Green, x, y)
+                      + kGrayWeights[2] * im.At(Blue, x, y)};
+        dst[x] = static_cast<uint8_t>(sum >> kShift);
+      }
+    }
+  }
+  return true;
+}
+
+Img ToGray(const Img3View& im, Simd simd)
+{
+  if (im.Empty()) {
+    return Img{{}, Size{0, 0}};
+  }
+  Img res{Data8(static_cast<size_t>(im.size.rows) * im.size.cols), im.size};
+  ToGray(im, ViewOf(res), simd);
+  return res;
+}
+
+/////////////////////////////////////////////
+/// YUV
+/////////////////////////////////////////////
+
+namespace {
+
+bool IsEmpty(const YuvView& im)
+{
+  return im.y == nullptr || im.u == nullptr || im.v == nullptr || im.size.rows <= 0 || im.size.cols <= 0;
+}
+
+const YuvWeights& WeightsOf(const YuvRange& range)
+{
+  return range == YuvRange::FULL ? kFullWeights : kVideoWeights;
+}
+
+}// namespace
+
+YuvView I420View(const uint8_t* data, const Size& size, const YuvRange& range)
+{
+  if (data == nullptr) {
+    return YuvView{};
+  }
+  const int uv_cols{(size.cols + 1) / 2};
+  const int uv_rows{(size.rows + 1) / 2};
+  const uint8_t* u{data + static_cast<size_t>(size.rows) * size.cols};
+  return YuvView{data, u, u + static_cast<size_t>(uv_rows) * uv_cols, size, size.cols, uv_cols, 1, range};
+}
+
+YuvView Nv12View(const uint8_t* data, const Size& size, const YuvRange& range)
+{
+  if (data == nullptr) {
+    return YuvView{};
+  }
+  const uint8_t* u{data + static_cast<size_t>(size.rows) * size.cols};
+  return YuvView{data, u, u + 1, size, size.cols, 2 * ((size.cols + 1) / 2), 2, range};
+}
+
+Img3 YuvToRgb(const YuvView& im, Simd simd)
+{
+  if (IsEmpty(im)) {
+    return Img3{{}, Size{0, 0}};
+  }
+  const int cols{im.size.cols};
+  const Kernels kernels{SelectKernels(simd)};
+  const YuvWeights& weights{WeightsOf(im.range)};
+
+  Img3 res{{}, im.size};
+  for (auto& plane : res.data) {
+    plane.resize(static_cast<size_t>(im.size.rows) * cols);
+  }
+  for (int y = 0; y < im.size.rows; y++) {
+    const size_t row{static_cast<size_t>(y) * cols};
+    const size_t uv_row{static_cast<size_t>(y / 2) * im.uv_stride};
+    kernels.yuv(im.y + static_cast<size_t>(y) * im.y_stride, ChromaRow{im.u + uv_row, im.v + uv_row, im.uv_step},
+                weights, Planes{&res.data[Red][row], &res.data[Green][row], &res.data[Blue][row], nullptr}, cols);
+  }
+  return res;
+}
+
+Img YuvToGray(const YuvView& im, Simd simd)
+{
+  if (IsEmpty(im)) {
+    return Img{{}, Size{0, 0}};
+  }
+  const int cols{im.size.cols};
+  const Kernels kernels{SelectKernels(simd)};
+  const YuvWeights& weights{WeightsOf(im.range)};
+
+  Img res{Data8(static_cast<size_t>(im.size.rows) * cols), im.size};
+  for (int y = 0; y < im.size.rows; y++) {
+    const uint8_t* src{im.y + static_cast<size_t>(y) * im.y_stride};
+    uint8_t* dst{&res.data[static_cast<size_t>(y) * cols]};
+    if (im.range == YuvRange::FULL) {
+      std::memcpy(dst, src, cols);
+    } else {
+      kernels.yuv_gray(src, weights, dst, cols);
+    }
+  }
+  return res;
+}
+
+}// namespace algo::image
@@ -87,13 +87,9 @@ struct c_comp {
   }
 } c_comp;
 
-}// namespace
-
-Points Corners(const Img& im, const int& threshold, const CornerDetType& det_type, const int& n_best, const int& min_dist, const GaussWindowSettings& g_win_set)
+/// \brief Finds the corners of the blurred image imm, as Corners.
+Points CornersPriv(const Img& imm, const int& threshold, const CornerDetType& det_type, const int& n_best, const int& min_dist)
 {
-  // http://dept.me.umn.edu/courses/me5286/vision/Notes/2015/ME5286-Lecture8.pdf
-  // Blur image with Gaussian, compute derivatives, do some tricks.
-  Img imm{filter::GaussianBlur(im, g_win_set.size, g_win_set.sigma)};
   const Img Ix1{filter::Convolve(imm, filter::KernelType::SOBEL_X)};
   const Img Ix2{FlipX(filter::Convolve(FlipX(imm), filter::KernelType::SOBEL_X))};
   const Img Ix{MaxOf(Ix1, Ix2)};
@@ -101,8 +97,8 @@ Points Corners(const Img& im, const int& threshold, const CornerDetType& det_typ
   const Img Iy2{FlipY(filter::Convolve(FlipY(imm), filter::KernelType::SOBEL_Y))};
   const Img Iy{MaxOf(Iy1, Iy2)};
 
-  const int kNCols{im.size.cols};
-  const int kNRows{im.size.rows};
+  const int kNCols{imm.size.cols};
+  const int kNRows{imm.size.rows};
 
   Points points;
   std::vector<double> r_val(kNCols * kNRows, 0.0);
@@ -146,7 +142,7 @@ Points Corners(const Img& im, const int& threshold, const CornerDetType& det_typ
   // Get points that are not too close.
   if (min_dist > 0) {
     std::vector<bool> skips(corner_pts.size(), false);
-    for (size_t i = 0; i < corner_pts.size() - 1; i++) {
+    for (size_t i = 0; i + 1 < corner_pts.size(); i++) {
       for (size_t j = i + 1; j < corner_pts.size(); j++) {
         if (Euclidean(corner_pts[i], corner_pts[j]) < min_dist * min_dist) {// Avoid computing sqrt.
           skips[j] = true;
@@ -165,6 +161,36 @@ Points Corners(const Img& im, const int& threshold, const CornerDetType& det_typ
   return corner_pts;
 }
 
+}// namespace
+
+Points Corners(const Img& im, const int& threshold, const CornerDetType& det_type, const int& n_best, const int& min_dist, const GaussWindowSettings& g_win_set)
+{
+  // http://dept.me.umn.edu/courses/me5286/vision/Notes/2015/ME5286-Lecture8.pdf
+  // Blur image with Gaussian, compute derivatives, do some tricks.
+  return CornersPriv(filter::GaussianBlur(im, g_win_set.size, g_win_set.sigma), threshold, det_type, n_best, min_dist);
+}
+
+Points Corners(const ConstImgView& im, const int& threshold, const CornerDetType& det_type, const int& n_best, const int& min_dist, const GaussWindowSettings& g_win_set)
+{
+  Img blurred{Data8(static_cast<size_t>(im.size.rows) * im.size.cols), im.size};
+  if (im.Empty() || !filter::GaussianBlur(im, ViewOf(blurred), g_win_set.size, g_win_set.sigma)) {
+    return Points{};
+  }
+  return CornersPriv(blurred, threshold, det_type, n_best, min_dist);
+}
+
+Points Corners(const Pyramid& pyr, const int& octave, const int& threshold, const CornerDetType& det_type, const int& n_best, const int& min_dist)
+{
+  if (octave < 0 || octave >= pyr.Octaves()) {
+    return Points{};
+  }
+  Points corners{CornersPriv(pyr.Smoothed(octave), threshold, det_type, n_best, min_dist)};
+  for (auto& pt : corners) {
+    pt = Point{pt.x << octave, pt.y << octave};
+  }
+  return corners;
+}
+
 /////////////////////////////////////////////
 /// FAST Corners
 /////////////////////////////////////////////
@@ -175,7 +201,7 @@ constexpr std::array<Point, 32> bresenham{{{3, 0}, {3, -1}, {2, -2}, {1, -3}, {0
 
 ///\brief Returns a counter for how many pixels that are darker and brighter (+- pixel_thr) than the candidate pixel (x,y).
 // If the pixels are not continuous, the counter(s) will be reset.
-constexpr auto CornerMeasure = [](const Img& im, auto x, auto y, auto count_thr, auto pixel_thr) {
+constexpr auto CornerMeasure = [](const ConstImgView& im, auto x, auto y, auto count_thr, auto pixel_thr) {
   int dark_count{0};  // Counter to check how many pixels that are darker then the centre pixel on the Bresenham circle.
   int bright_count{0};// Counter for brighter.
 
@@ -200,6 +226,11 @@ constexpr auto CornerMeasure = [](const Img& im, auto x, auto y, auto count_thr,
 }// namespace
 
 Points FASTCorners(const Img& im, const int& intensity_threshold, const int& corner_threshold)
+{
+  return FASTCorners(ViewOf(im), intensity_threshold, corner_threshold);
+}
+
+Points FASTCorners(const ConstImgView& im, const int& intensity_threshold, const int& corner_threshold)
 {
   Points points;
   for (int i = 3; i < im.size.cols - 3; i++) {
@@ -220,64 +251,33 @@ namespace {
 
 using Mat = std::vector<std::vector<float>>;
 
-std::vector<Mat> gaussians;
-
-constexpr auto DoGPyramid = [](const Img& img, const auto& nbr_octaves, const auto& nbr_gaussians) {
-  //std::vector<Img> pyramid;// DoG images.
-  float sigma{1.6};// Starting value for std in DoG.
-  float k = M_SQRT2;
-  const Size kSize{3, 3};
-  std::vector<Mat> pyramid;
-  Mat diff{static_cast<size_t>(img.size.rows), std::vector<float>(img.size.cols, 0)};
-  Mat gaussian{static_cast<size_t>(img.size.rows), std::vector<float>(img.size.cols, 0)};
-
-  Img gaussian_prev{algo::image::filter::GaussianBlur(img, kSize, k * sigma)};
-  //Img gaussian_prev = algo::image::filter::Convolve(img, filter::KernelType::GAUSSIAN_BLUR);
-  Img gaussian_next;
-  // Generates the pyramid.
-  for (int i = 0; i < nbr_octaves; i++) {
-    for (int j = 0; j < nbr_gaussians; j++) {
-
-      gaussian_next = algo::image::filter::GaussianBlur(gaussian_prev, kSize, k * sigma);
-      //gaussian_next = algo::image::filter::Convolve(gaussian_prev, filter::KernelType::GAUSSIAN_BLUR);
-      for (int y = kSize.rows; y < (img.size.rows - kSize.rows); y++) {
-        for (int x = kSize.cols; x < (img.size.cols - kSize.cols); x++) {
-          diff[y][x] = gaussian_prev.data[y * img.size.cols + x] - gaussian_next.data[y * img.size.cols + x];
-          gaussian[y][x] = gaussian_prev.data[y * img.size.cols + x];
+// Keypoints closer to the border of an octave than this are skipped, in the pixels of the octave.
+constexpr int kFrameLimit{5};
+
+/// \brief Checks that the centre pixel is smaller or larger than all its 26 neighbors.
+/// b == below, m == middle, a == above
+bool IsExtrema(const ConstImgViewF& b, const ConstImgViewF& m, const ConstImgViewF& a, const int& xx, const int& yy)
+{
+  const float cp{m.At(xx, yy)};
+  bool is_mini{true};
+  bool is_maxi{true};
+  for (int y = yy - 1; y <= yy + 1; y++) {
+    for (int x = xx - 1; x <= xx + 1; x++) {
+      for (const auto* level : {&b, &m, &a}) {
+        if (level == &m && x == xx && y == yy) {
+          continue;
         }
+        const float v{level->At(x, y)};
+        is_mini = is_mini && v > cp;
+        is_maxi = is_maxi && v < cp;
       }
-      gaussians.emplace_back(gaussian);
-      pyramid.emplace_back(diff);
-      gaussian_prev = gaussian_next;
     }
-    sigma *= 2.0;
+    if (!is_mini && !is_maxi) {
+      return false;
+    }
   }
-  return pyramid;
-};
-
-// b == below, m == middle, a == above
-constexpr auto IsExtrema = [](const Mat& b, const Mat& m, const Mat& a, const auto& xx, const auto& yy) {
-  const float cp{m[yy][xx]};
-  const int xn{xx - 1}, xp{xx + 1}, yn{yy - 1}, yp{yy + 1};
-  // Check that the centre pixel is smaller than all its 26 neighbors.
-  bool is_mini = m[yn][xn] >= cp && m[yy][xn] >= cp && m[yp][xn] >= cp && m[yn][xx] >= cp
-      && m[yp][xx] >= cp && m[yn][xp] >= cp && m[yy][xp] >= cp && m[yp][xp] >= cp
-      && b[yn][xn] >= cp && b[yy][xn] >= cp && b[yp][xn] >= cp && b[yn][xx] >= cp
-      && b[yy][xx] >= cp && b[yp][xx] >= cp && b[yn][xp] >= cp && b[yy][xp] >= cp
-      && b[yp][xp] >= cp && a[yn][xn] >= cp && a[yy][xn] >= cp && a[yp][xn] >= cp
-      && a[yn][xx] >= cp && a[yy][xx] >= cp && a[yp][xx] >= cp && a[yn][xp] >= cp
-      && a[yy][xp] >= cp && a[yp][xp] >= cp && cp;
-  // Check that the centre pixel is larger than all its 26 neighbors.
-  bool is_maxi = m[yn][xn] <= cp && m[yy][xn] <= cp && m[yp][xn] <= cp && m[yn][xx] <= cp
-      && m[yp][xx] <= cp && m[yn][xp] <= cp && m[yy][xp] <= cp && m[yp][xp] <= cp
-      && b[yn][xn] <= cp && b[yy][xn] <= cp && b[yp][xn] <= cp && b[yn][xx] <= cp
-      && b[yy][xx] <= cp && b[yp][xx] <= cp && b[yn][xp] <= cp && b[yy][xp] <= cp
-      && b[yp][xp] <= cp && a[yn][xn] <= cp && a[yy][xn] <= cp && a[yp][xn] <= cp
-      && a[yn][xx] <= cp && a[yy][xx] <= cp && a[yp][xx] <= cp && a[yn][xp] <= cp
-      && a[yy][xp] <= cp && a[yp][xp] <= cp && cp;
-
   return is_mini || is_maxi;
-};
+}
 
 constexpr auto determinant = [](const float& a, const float& b, const float& c,
                                 const float& d, const float& e, const float& f,
@@ -292,7 +292,7 @@ inline void SolveEq(const Mat& H, const std::vector<float>& d, float& x, float&
   float detH{determinant(H[0][0], H[0][1], H[0][2], H[1][0], H[1][1], H[1][2], H[2][0], H[2][1], H[2][2])};
   float detm1{determinant(d[0], H[0][1], H[0][2], d[1], H[1][1], H[1][2], d[2], H[2][1], H[2][2])};
   float detm2{determinant(H[0][0], d[0], H[0][2], H[1][0], d[1], H[1][2], H[2][0], d[2], H[2][2])};
-  float detm3{determinant(H[0][0], H[0][1], d[0], H[1][0], H[1][1], d[1], H[2][0], H[1][1], d[2])};
+  float detm3{determinant(H[0][0], H[0][1], d[0], H[1][0], H[1][1], d[1], H[2][0], H[2][1], d[2])};
   x = detm1 / detH;
   y = detm2 / detH;
   z = detm3 / detH;
@@ -302,35 +302,54 @@ inline void SolveEq(const Mat& H, const std::vector<float>& d, float& x, float&
 
 Keypoints SiftKeypoints(const Img& img, const int& nbr_gaussians, const int& nbr_octaves, const float& contrast_offset, const float& edge_threshold)
 {
-  std::vector<Mat> pyr{DoGPyramid(img, nbr_octaves, nbr_gaussians)};
+  // An octave has nbr_scales + 3 Gaussians.
+  const Pyramid pyr{img, nbr_octaves, std::max(1, nbr_gaussians - 3)};
+  return SiftKeypoints(pyr, contrast_offset, edge_threshold);
+}
+
+Keypoints SiftKeypoints(const ConstImgView& im, const int& nbr_gaussians, const int& nbr_octaves, const float& contrast_offset, const float& edge_threshold)
+{
+  const Pyramid pyr{im, nbr_octaves, std::max(1, nbr_gaussians - 3)};
+  return SiftKeypoints(pyr, contrast_offset, edge_threshold);
+}
+
+Keypoints SiftKeypoints(const Pyramid& pyr, const float& contrast_offset, const float& edge_threshold)
+{
   std::vector<float> d_deriv(3, 0);
   Keypoints keypoints;
   Mat hessian;
 
   const float kSc1St{0.5f}, kSc2Nd{1.0f}, kScXy{0.25f};
-  const int kFrameLimit{10};
   float x1, x2, x3, v2, dxx, dyy, dss, dxy, dxs, dys;
 
-  for (int x = kFrameLimit; x < img.size.cols - kFrameLimit; x++) {
-    for (int y = kFrameLimit; y < img.size.rows - kFrameLimit; y++) {
-      for (size_t i = 0; i < pyr.size() - 2; i++) {
-        // Get three layers from the pyramid. pyr[i] = previous layer, pyr[i+1] current layer, pyr[i+2] next layer.
-
-        if (IsExtrema(pyr[i], pyr[i + 1], pyr[i + 2], x, y)) {
+  for (int o = 0; o < pyr.Octaves(); o++) {
+    const Size kSize{pyr.SizeOf(o)};
+    for (int i = 0; i + 2 < pyr.Levels() - 1; i++) {
+      // Three layers of the octave. b = previous layer, m = current layer, a = next layer.
+      const ConstImgViewF b{pyr.Laplacian(o, i)};
+      const ConstImgViewF m{pyr.Laplacian(o, i + 1)};
+      const ConstImgViewF a{pyr.Laplacian(o, i + 2)};
+      const ConstImgViewF L{pyr.Gaussian(o, i + 1)};
+
+      for (int y = kFrameLimit; y < kSize.rows - kFrameLimit; y++) {
+        for (int x = kFrameLimit; x < kSize.cols - kFrameLimit; x++) {
+          if (!IsExtrema(b, m, a, x, y)) {
+            continue;
+          }
           // Interpolation of nearby data for accurate position.
           // In other words: Compute offset from dDoG(x,y,sigma), using Taylor expansion, if > 0.5 then discard this point.
           // https://en.wikipedia.org/wiki/Scale-invariant_feature_transform
-          d_deriv[0] = (pyr[i + 1][y][x + 1] - pyr[i + 1][y][x - 1]) * kSc1St;
-          d_deriv[1] = (pyr[i + 1][y + 1][x] - pyr[i + 1][y - 1][x]) * kSc1St;
-          d_deriv[2] = (pyr[i + 2][y][x] - pyr[i][y][x]) * kSc1St;
-
-          v2 = pyr[i + 1][y][x] * 2.0f;
-          dxx = (pyr[i + 1][y][x + 1] + pyr[i + 1][y][x - 1] - v2) * kSc2Nd;
-          dyy = (pyr[i + 1][y + 1][x] + pyr[i + 1][y - 1][x] - v2) * kSc2Nd;
-          dss = (pyr[i + 2][y][x] + pyr[i][y][x] - v2) * kSc2Nd;
-          dxy = (pyr[i + 1][y + 1][x + 1] - pyr[i + 1][y + 1][x - 1] - pyr[i + 1][y - 1][x + 1] + pyr[i + 1][y - 1][x - 1]) * kScXy;
-          dxs = (pyr[i + 2][y][x + 1] - pyr[i + 2][y][x - 1] - pyr[i][y][x + 1] - pyr[i][y][x - 1]) * kScXy;
-          dys = (pyr[i + 2][y + 1][x] - pyr[i + 2][y - 1][x] - pyr[i][y + 1][x] + pyr[i][y - 1][x]) * kScXy;
+          d_deriv[0] = (m.At(x + 1, y) - m.At(x - 1, y)) * kSc1St;
+          d_deriv[1] = (m.At(x, y + 1) - m.At(x, y - 1)) * kSc1St;
+          d_deriv[2] = (a.At(x, y) - b.At(x, y)) * kSc1St;
+
+          v2 = m.At(x, y) * 2.0f;
+          dxx = (m.At(x + 1, y) + m.At(x - 1, y) - v2) * kSc2Nd;
+          dyy = (m.At(x, y + 1) + m.At(x, y - 1) - v2) * kSc2Nd;
+          dss = (a.At(x, y) + b.At(x, y) - v2) * kSc2Nd;
+          dxy = (m.At(x + 1, y + 1) - m.At(x - 1, y + 1) - m.At(x + 1, y - 1) + m.At(x - 1, y - 1)) * kScXy;
+          dxs = (a.At(x + 1, y) - a.At(x - 1, y) - b.At(x + 1, y) + b.At(x - 1, y)) * kScXy;
+          dys = (a.At(x, y + 1) - a.At(x, y - 1) - b.At(x, y + 1) + b.At(x, y - 1)) * kScXy;
 
           hessian = {{dxx, dxy, dxs},
                      {dxy, dyy, dys},
@@ -354,12 +373,12 @@ Keypoints SiftKeypoints(const Img& img, const int& nbr_gaussians, const int& nbr
           if (std::abs(trH * trH / detH) < edge_threshold) {
             continue;
           }
-          Mat& L{gaussians[i]};
           // Radius assignment
-          double rad{std::sqrt(std::pow(L[y][x + 1] - L[y][x - 1], 2) + std::pow(L[y + 1][x] - L[y - 1][x], 2)) / 2.0};
+          double rad{std::sqrt(std::pow(L.At(x + 1, y) - L.At(x - 1, y), 2) + std::pow(L.At(x, y + 1) - L.At(x, y - 1), 2)) / 2.0};
           // Angle assignment
-          double theta{std::atan2(L[y + 1][x] - L[y - 1][x], L[y][x + 1] - L[y][x - 1]) * 180.0 / M_PI};
-          keypoints.emplace_back(feature::Keypoint{x, y, rad, theta});
+          double theta{std::atan2(L.At(x, y + 1) - L.At(x, y - 1), L.At(x + 1, y) - L.At(x - 1, y)) * 180.0 / M_PI};
+          // Back to the pixels of the input image.
+          keypoints.emplace_back(feature::Keypoint{x << o, y << o, rad, theta});
         }
       }
     }
@@ -8,7 +8,20 @@
 #include "algo_image_filter.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ALGO_IMAGE_FILTER_X86
+#include <immintrin.h>
+#endif
 
 namespace algo::image::filter {
 
@@ -36,7 +49,7 @@ constexpr Kernel kernel_dilation_h{0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0};
 constexpr Kernel kernel_dilation{0.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0};
 constexpr Kernel kernel_high_pass{-1.0, -1.0, -1.0, -1.0, 8.0, -1.0, -1.0, -1.0, -1.0};
 
-Kernel GetKernel(const KernelType& filter_type)
+const Kernel& GetKernel(const KernelType& filter_type)
 {
   switch (filter_type) {
     case KernelType::SOBEL_X:
@@ -79,48 +92,346 @@ Kernel GetKernel(const KernelType& filter_type)
 /// Convolutions
 /////////////////////////////////////////////
 
-Data8 ConvolvePriv(const Data8& im, size_t rows, size_t cols, KernelType filter_type)
-{
-  Data8 res(im.size(), 0);
-  const Kernel filter{GetKernel(filter_type)};
-  uint8_t dim{3U};
-  uint8_t sz{static_cast<uint8_t>(dim >> 1U)};
-
-  // Filtering window
-  for (size_t i = sz; i < rows - sz; i++) {
-    for (size_t j = sz; j < cols - sz; j++) {
-      float sum = 0;
-      for (uint8_t k = 0; k < dim; k++) {
-        for (uint8_t m = 0; m < dim; m++) {
-          // Multiply components
-          auto im_num = static_cast<float>((im[(i + k - sz) * cols + (j + m - sz)]));
-          float filt_num = filter[k * dim + m];
-          sum += im_num * filt_num;
-        }
-      }
-      // Check overflow
-      if (sum < 0) sum = 0;
-      if (sum > 255) sum = 255;
+namespace {
+
+/// \brief A gray view, or one channel of a color view, with the pixels of a row step apart.
+struct ChannelView {
+  const uint8_t* data;
+  Size size;
+  int stride;
+  int step;
+
+  ChannelView(const ConstImgView& im) : data{im.data}, size{im.size}, stride{im.stride}, step{1} {}
+  ChannelView(const Img3View& im, const int& c) : data{im.data[c]}, size{im.size}, stride{im.stride}, step{im.step} {}
+
+  /// \brief Returns the first pixel of row y.
+  [[nodiscard]] const uint8_t* Row(const int& y) const { return data + static_cast<ptrdiff_t>(y) * stride; }
+};
+
+/// \brief Copies count pixels, step apart in src, to dst.
+inline void CopyPixels(const uint8_t* src, const int& step, const int& count, uint8_t* dst)
+{
+  if (step == 1) {
+    std::copy(src, src + count, dst);
+    return;
+  }
+  for (int i = 0; i < count; i++) {
+    dst[i] = src[static_cast<ptrdiff_t>(i) * step];
+  }
+}
 
-      res[i * cols + j] = static_cast<uint8_t>(sum);
+/// \brief Sets the pixels of out outside of the rows [top, bottom) and the columns [left, right) to 0.
+template <typename T>
+void ZeroBorder(const View<T>& out, const int& top, const int& bottom, const int& left, const int& right)
+{
+  for (int y = 0; y < out.size.rows; y++) {
+    T* row{out.Row(y)};
+    if (y < top || y >= bottom || left >= right) {
+      std::fill(row, row + out.size.cols, T{0});
+      continue;
     }
+    std::fill(row, row + left, T{0});
+    std::fill(row + right, row + out.size.cols, T{0});
   }
-  return res;
 }
 
-Img Convolve(const Img& im, KernelType filter_type)
+using Rows = std::array<const uint8_t*, 3>;
+
+/// \brief A 3x3 kernel prepared for the row functions.
+/// \details Kernels with weights that are integers after a shift of at most kMaxShift bits are applied in 16-bit
+/// integer arithmetic. The result is the same as with floats, since the float sum of such weights is exact.
+struct RowKernel {
+  Kernel weights;
+  std::array<int16_t, 9> int_weights;// weights * 2^shift.
+  int shift;
+  bool integral;
+};
+
+/// \brief The taps of a kernel on three rows, the non-zero ones first and in row major order. Output pixel j reads
+/// src[t][j - 1] for each tap t. The zero weights do not change the sum, the vector functions leave them out.
+struct Taps {
+  std::array<const uint8_t*, 9> src;
+  std::array<float, 9> weights;
+  std::array<int16_t, 9> int_weights;
+  size_t size;// Non-zero taps.
+  int shift;
+};
+
+// The row functions take the taps by value, so that the stores to dst can not alias them.
+using RowFunc = void (*)(Taps taps, uint8_t* dst, size_t cols);
+
+constexpr int kMaxShift{4};
+constexpr int kMaxIntSum{32767};
+
+RowKernel PrepareKernel(const Kernel& weights)
+{
+  RowKernel kernel{weights, {}, 0, false};
+  for (int shift = 0; shift <= kMaxShift; shift++) {
+    int abs_sum{0};
+    bool integral{true};
+    for (size_t i = 0; i < weights.size(); i++) {
+      const float w{std::ldexp(weights[i], shift)};
+      integral = integral && w == std::round(w);
+      kernel.int_weights[i] = static_cast<int16_t>(w);
+      abs_sum += static_cast<int>(std::abs(w)) * 255;
+    }
+    if (integral && abs_sum <= kMaxIntSum) {
+      kernel.shift = shift;
+      kernel.integral = true;
+      return kernel;
+    }
+  }
+  return kernel;
+}
+
+Taps SortedTaps(const Rows& rows, const RowKernel& kernel)
+{
+  Taps taps{};
+  taps.shift = kernel.shift;
+  size_t zeros{9};
+  for (size_t k = 0; k < 3; k++) {
+    for (size_t m = 0; m < 3; m++) {
+      const size_t i{kernel.weights[k * 3 + m] != 0.0F ? taps.size++ : --zeros};
+      taps.src[i] = rows[k] + m;
+      taps.weights[i] = kernel.weights[k * 3 + m];
+      taps.int_weights[i] = kernel.int_weights[k * 3 + m];
+    }
+  }
+  return taps;
+}
+
+/// \brief Convolves the pixels [begin, end) of a row, one pixel at a time. All nine taps are summed, which lets the
+/// compiler unroll and vectorize the loops.
+void PixelsF(Taps taps, uint8_t* dst, size_t begin, size_t end)
+{
+  for (size_t j = begin; j < end; j++) {
+    float sum{0.0F};
+    for (size_t t = 0; t < taps.src.size(); t++) {
+      sum += static_cast<float>(taps.src[t][j - 1]) * taps.weights[t];
+    }
+    dst[j] = static_cast<uint8_t>(std::clamp(sum, 0.0F, 255.0F));
+  }
+}
+
+void PixelsI(Taps taps, uint8_t* dst, size_t begin, size_t end)
+{
+  const int max{255 << taps.shift};
+  for (size_t j = begin; j < end; j++) {
+    int sum{0};
+    for (size_t t = 0; t < taps.src.size(); t++) {
+      sum += taps.src[t][j - 1] * taps.int_weights[t];
+    }
+    dst[j] = static_cast<uint8_t>(std::clamp(sum, 0, max) >> taps.shift);
+  }
+}
+
+void RowScalarF(Taps taps, uint8_t* dst, size_t cols)
+{
+  PixelsF(taps, dst, 1, cols - 1);
+}
+
+void RowScalarI(Taps taps, uint8_t* dst, size_t cols)
+{
+  PixelsI(taps, dst, 1, cols - 1);
+}
+
+#ifdef ALGO_IMAGE_FILTER_X86
+
+// The vector row functions compute the same sums in the same order as the scalar ones, so the results are identical.
+// Each handles as many whole vectors as fit in the row and leaves the rest to PixelsF or PixelsI.
+
+__attribute__((target("sse2"))) void RowSse2F(Taps taps, uint8_t* dst, size_t cols)
+{
+  __m128 weights[9];
+  for (size_t t = 0; t < taps.size; t++) {
+    weights[t] = _mm_set1_ps(taps.weights[t]);
+  }
+  const __m128i zero{_mm_setzero_si128()};
+  const __m128 lo{_mm_setzero_ps()};
+  const __m128 hi{_mm_set1_ps(255.0F)};
+  size_t j{1};
+  // Two vectors of 4 pixels at a time, so that the two chains of additions overlap.
+  for (; j + 8 <= cols - 1; j += 8) {
+    __m128 sum0{_mm_setzero_ps()};
+    __m128 sum1{_mm_setzero_ps()};
+    for (size_t t = 0; t < taps.size; t++) {
+      const auto* p = reinterpret_cast<const __m128i*>(taps.src[t] + j - 1);
+      const __m128i px{_mm_unpacklo_epi8(_mm_loadl_epi64(p), zero)};
+      const __m128 px0{_mm_cvtepi32_ps(_mm_unpacklo_epi16(px, zero))};
+      const __m128 px1{_mm_cvtepi32_ps(_mm_unpackhi_epi16(px, zero))};
+      sum0 = _mm_add_ps(sum0, _mm_mul_ps(px0, weights[t]));
+      sum1 = _mm_add_ps(sum1, _mm_mul_ps(px1, weights[t]));
+    }
+    const __m128i res0{_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(sum0, lo), hi))};
+    const __m128i res1{_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(sum1, lo), hi))};
+    const __m128i res{_mm_packs_epi32(res0, res1)};
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), _mm_packus_epi16(res, res));
+  }
+  PixelsF(taps, dst, j, cols - 1);
+}
+
+__attribute__((target("sse2"))) void RowSse2I(Taps taps, uint8_t* dst, size_t cols)
+{
+  __m128i weights[9];
+  for (size_t t = 0; t < taps.size; t++) {
+    weights[t] = _mm_set1_epi16(taps.int_weights[t]);
+  }
+  const __m128i zero{_mm_setzero_si128()};
+  const __m128i hi{_mm_set1_epi16(static_cast<int16_t>(255 << taps.shift))};
+  const __m128i shift{_mm_cvtsi32_si128(taps.shift)};
+  size_t j{1};
+  for (; j + 8 <= cols - 1; j += 8) {
+    __m128i sum{_mm_setzero_si128()};
+    for (size_t t = 0; t < taps.size; t++) {
+      const auto* p = reinterpret_cast<const __m128i*>(taps.src[t] + j - 1);
+      const __m128i px{_mm_unpacklo_epi8(_mm_loadl_epi64(p), zero)};
+      sum = _mm_add_epi16(sum, _mm_mullo_epi16(px, weights[t]));
+    }
+    sum = _mm_sra_epi16(_mm_min_epi16(_mm_max_epi16(sum, zero), hi), shift);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), _mm_packus_epi16(sum, sum));
+  }
+  PixelsI(taps, dst, j, cols - 1);
+}
+
+__attribute__((target("avx2"))) void RowAvx2F(Taps taps, uint8_t* dst, size_t cols)
 {
-  Img res{im};
-  res.data = ConvolvePriv(res.data, im.size.rows, im.size.cols, filter_type);
+  __m256 weights[9];
+  for (size_t t = 0; t < taps.size; t++) {
+    weights[t] = _mm256_set1_ps(taps.weights[t]);
+  }
+  const __m256 lo{_mm256_setzero_ps()};
+  const __m256 hi{_mm256_set1_ps(255.0F)};
+  size_t j{1};
+  // Two vectors of 8 pixels at a time, so that the two chains of additions overlap.
+  for (; j + 16 <= cols - 1; j += 16) {
+    __m256 sum0{_mm256_setzero_ps()};
+    __m256 sum1{_mm256_setzero_ps()};
+    for (size_t t = 0; t < taps.size; t++) {
+      const __m128i px{_mm_loadu_si128(reinterpret_cast<const __m128i*>(taps.src[t] + j - 1))};
+      const __m256 px0{_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(px))};
+      const __m256 px1{_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(px, 8)))};
+      sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(px0, weights[t]));
+      sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(px1, weights[t]));
+    }
+    const __m256i res0{_mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(sum0, lo), hi))};
+    const __m256i res1{_mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(sum1, lo), hi))};
+    // Packing works within 128-bit lanes, put the pixels back in order.
+    const __m256i res{_mm256_permute4x64_epi64(_mm256_packs_epi32(res0, res1), 0xd8)};
+    const __m128i packed{_mm_packus_epi16(_mm256_castsi256_si128(res), _mm256_extracti128_si256(res, 1))};
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j), packed);
+  }
+  PixelsF(taps, dst, j, cols - 1);
+}
+
+__attribute__((target("avx2"))) void RowAvx2I(Taps taps, uint8_t* dst, size_t cols)
+{
+  __m256i weights[9];
+  for (size_t t = 0; t < taps.size; t++) {
+    weights[t] = _mm256_set1_epi16(taps.int_weights[t]);
+  }
+  const __m256i zero{_mm256_setzero_si256()};
+  const __m256i hi{_mm256_set1_epi16(static_cast<int16_t>(255 << taps.shift))};
+  const __m128i shift{_mm_cvtsi32_si128(taps.shift)};
+  size_t j{1};
+  for (; j + 16 <= cols - 1; j += 16) {
+    __m256i sum{_mm256_setzero_si256()};
+    for (size_t t = 0; t < taps.size; t++) {
+      const auto* p = reinterpret_cast<const __m128i*>(taps.src[t] + j - 1);
+      const __m256i px{_mm256_cvtepu8_epi16(_mm_loadu_si128(p))};
+      sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(px, weights[t]));
+    }
+    sum = _mm256_sra_epi16(_mm256_min_epi16(_mm256_max_epi16(sum, zero), hi), shift);
+    // Packing works within 128-bit lanes, gather the low half of each lane.
+    const __m256i packed{_mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08)};
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j), _mm256_castsi256_si128(packed));
+  }
+  PixelsI(taps, dst, j, cols - 1);
+}
+
+#endif// ALGO_IMAGE_FILTER_X86
+
+RowFunc SelectRowFunc(const RowKernel& kernel, Simd simd)
+{
+  switch (std::min(simd, DetectedSimd())) {
+#ifdef ALGO_IMAGE_FILTER_X86
+    case Simd::AVX2:
+      return kernel.integral ? RowAvx2I : RowAvx2F;
+    case Simd::SSE2:
+      return kernel.integral ? RowSse2I : RowSse2F;
+#endif
+    default: break;
+  }
+  return kernel.integral ? RowScalarI : RowScalarF;
+}
+
+void ConvolvePriv(const ChannelView& im, const ImgView& out, KernelType filter_type, Simd simd)
+{
+  const int rows{im.size.rows};
+  const int cols{im.size.cols};
+  if (rows < 3 || cols < 3) {
+    ZeroBorder(out, 0, 0, 0, 0);
+    return;
+  }
+  const RowKernel kernel{PrepareKernel(GetKernel(filter_type))};
+  const RowFunc row_func{SelectRowFunc(kernel, simd)};
+
+  // The row functions read whole vectors of neighbouring pixels. Interleaved rows are gathered into a ring of three
+  // rows as they come into the kernel, every row once.
+  std::array<Data8, 3> ring;
+  const auto row = [&im, &ring, &cols](const int& y) {
+    if (im.step == 1) {
+      return im.Row(y);
+    }
+    Data8& dst{ring[y % 3]};
+    dst.resize(cols);
+    CopyPixels(im.Row(y), im.step, cols, dst.data());
+    return static_cast<const uint8_t*>(dst.data());
+  };
+
+  Rows src{nullptr, row(0), row(1)};
+  for (int i = 1; i < rows - 1; i++) {
+    src = Rows{src[1], src[2], row(i + 1)};
+    row_func(SortedTaps(src, kernel), out.Row(i), cols);
+  }
+  ZeroBorder(out, 1, rows - 1, 1, cols - 1);
+}
+
+}// namespace
+
+Img Convolve(const Img& im, KernelType filter_type, Simd simd)
+{
+  Img res{Data8(im.data.size()), im.size};
+  if (!im.data.empty()) {
+    ConvolvePriv(ViewOf(im), ViewOf(res), filter_type, simd);
+  }
   return res;
 }
 
-Img3 Convolve3(const Img3& im, KernelType filter_type)
+bool Convolve(const ConstImgView& im, const ImgView& out, KernelType filter_type, Simd simd)
+{
+  if (im.Empty() || out.Empty() || !(out.size == im.size)) {
+    return false;
+  }
+  ConvolvePriv(im, out, filter_type, simd);
+  return true;
+}
+
+Img3 Convolve3(const Img3& im, KernelType filter_type, Simd simd)
+{
+  return Convolve3(ViewOf(im), filter_type, simd);
+}
+
+Img3 Convolve3(const Img3View& im, KernelType filter_type, Simd simd)
 {
-  Img3 res{im};
-  res.data[Red] = ConvolvePriv(res.data[Red], im.size.rows, im.size.cols, filter_type);
-  res.data[Green] = ConvolvePriv(res.data[Green], im.size.rows, im.size.cols, filter_type);
-  res.data[Blue] = ConvolvePriv(res.data[Blue], im.size.rows, im.size.cols, filter_type);
+  if (im.Empty()) {
+    return Img3{{}, Size{0, 0}};
+  }
+  Img3 res{{}, im.size};
+  for (const uint8_t channel : {Red, Green, Blue}) {
+    res.data[channel].resize(static_cast<size_t>(im.size.rows) * im.size.cols);
+    ConvolvePriv(ChannelView{im, channel}, ImgView{res.data[channel].data(), im.size, im.size.cols}, filter_type,
+                 simd);
+  }
   return res;
 }
 
@@ -129,128 +440,575 @@ Img3 Convolve3(const Img3& im, KernelType filter_type)
 /////////////////////////////////////////////
 
 namespace {
-/// \brief Computes the 2D gauss value at x, y with standard deviation sigma.
-constexpr auto Gauss2D = [](auto x, auto y, auto sigma) {
-  float a = 1.0 / (2.0 * M_PI * sigma * sigma);
-  //float a{1.0};
-  float b = -(x * x + y * y) / (2.0 * sigma * sigma);
-  return a * std::pow(M_E, b);
-};
 
-ImgF GaussianKernel(const Size& size, const float& sigma)
+constexpr float kRecursiveMinSigma{0.5F};
+constexpr size_t kRecursiveRows{8};
+
+/// \brief Returns a normalized 1D Gaussian kernel with size weights, a single 1 if sigma is not positive.
+Dataf GaussianKernel(const int& size, const float& sigma)
 {
-  ImgF kernel{Dataf(size.cols * size.rows, 0), size};
-  const int kDimX{size.cols / 2};
-  const int kDimY{size.rows / 2};
-  float sum{0.0};
+  Dataf kernel(size, 0.0F);
+  const int kCenter{size / 2};
+  if (sigma <= 0.0F) {
+    kernel[kCenter] = 1.0F;
+    return kernel;
+  }
+  float sum{0.0F};
+  for (int i = 0; i < size; i++) {
+    const float x{static_cast<float>(i - kCenter)};
+    kernel[i] = std::exp(-x * x / (2.0F * sigma * sigma));
+    sum += kernel[i];
+  }
+  for (auto& w : kernel) {
+    w /= sum;
+  }
+  return kernel;
+}
+
+bool FitsSeparable(const Size& size, const Dataf& kernel_x, const Dataf& kernel_y)
+{
+  const int kCols{static_cast<int>(kernel_x.size())};
+  const int kRows{static_cast<int>(kernel_y.size())};
+  return kCols % 2 == 1 && kRows % 2 == 1 && kCols < size.cols && kRows < size.rows;
+}
 
-  for (int x = size.cols - 1; x >= 0; --x) {
-    for (int y = size.rows - 1; y >= 0; --y) {
-      kernel.data[y * kernel.size.cols + x] = Gauss2D(kDimX - x, kDimY - y, sigma);
-      sum += kernel.data[y * kernel.size.cols + x];
+/// \brief Convolves the rows with kernel_x into a float image, then its columns with kernel_y into out.
+/// \details Both passes run a tap at a time over a whole row, so the inner loops are simple enough for the compiler
+/// to vectorize. The pixels closer to the border than half a kernel are 0. Results in 8 bits are rounded.
+template <typename T, typename O>
+void SeparablePriv(const View<const T>& im, const View<O>& out, const Dataf& kernel_x, const Dataf& kernel_y)
+{
+  const size_t kRows = im.size.rows;
+  const size_t kCols = im.size.cols;
+  const size_t kSizeX{kernel_x.size() >> 1U};
+  const size_t kSizeY{kernel_y.size() >> 1U};
+  const size_t kBegin{kSizeX};
+  const size_t kEnd{kCols - kSizeX};
+
+  // Rows, only the columns where kernel_x fits.
+  Dataf rows(kRows * kCols, 0.0F);
+  for (size_t y = 0; y < kRows; y++) {
+    const T* src{im.Row(static_cast<int>(y))};
+    float* dst{&rows[y * kCols]};
+    for (size_t m = 0; m < kernel_x.size(); m++) {
+      const float w{kernel_x[m]};
+      for (size_t x = kBegin; x < kEnd; x++) {
+        dst[x] += static_cast<float>(src[x + m - kSizeX]) * w;
+      }
     }
   }
-  if (sum == 0.0) {
-    return kernel;
+
+  // Columns, a row of sums at a time.
+  Dataf sums(kCols, 0.0F);
+  for (size_t y = kSizeY; y < kRows - kSizeY; y++) {
+    std::fill(sums.begin(), sums.end(), 0.0F);
+    for (size_t k = 0; k < kernel_y.size(); k++) {
+      const float* src{&rows[(y + k - kSizeY) * kCols]};
+      const float w{kernel_y[k]};
+      for (size_t x = kBegin; x < kEnd; x++) {
+        sums[x] += src[x] * w;
+      }
+    }
+    O* dst{out.Row(static_cast<int>(y))};
+    for (size_t x = kBegin; x < kEnd; x++) {
+      if constexpr (std::is_same_v<O, float>) {
+        dst[x] = sums[x];
+      } else {
+        // Rounds half up, the values are not negative after the clamp.
+        dst[x] = static_cast<uint8_t>(std::clamp(sums[x], 0.0F, 255.0F) + 0.5F);
+      }
+    }
   }
-  for (int x = size.cols - 1; x >= 0; --x) {
-    for (int y = size.rows - 1; y >= 0; --y) {
-      kernel.data[y * kernel.size.cols + x] /= sum;
+  ZeroBorder(out, static_cast<int>(kSizeY), static_cast<int>(kRows - kSizeY), static_cast<int>(kBegin),
+             static_cast<int>(kEnd));
+}
+
+Img ToImg(const ImgF& im)
+{
+  Img res{Data8(im.data.size(), 0), im.size};
+  // Rounds half up, the values are not negative after the clamp.
+  std::transform(im.data.begin(), im.data.end(), res.data.begin(), [](float v) {
+    return static_cast<uint8_t>(std::clamp(v, 0.0F, 255.0F) + 0.5F);
+  });
+  return res;
+}
+
+/// \brief Coefficients of the recursive Gaussian, normalized so that a constant passes through unchanged.
+struct RecursiveCoefficients {
+  float b;
+  float b1, b2, b3;
+};
+
+/// \brief The coefficients of Young, van Vliet and van Ginkel (2002), from the three poles of their fit to the
+/// Gaussian. The impulse response of a forward and a backward pass has the standard deviation sigma.
+RecursiveCoefficients YoungVanVliet(const float& sigma)
+{
+  constexpr double kM0{1.16680};
+  constexpr double kM1{1.10783};
+  constexpr double kM2{1.40586};
+  const double q{1.31564 * (std::sqrt(1.0 + 0.490811 * sigma * sigma) - 1.0)};
+  const double scale{(kM0 + q) * (kM1 * kM1 + kM2 * kM2 + 2.0 * kM1 * q + q * q)};
+  const double b1{q * (2.0 * kM0 * kM1 + kM1 * kM1 + kM2 * kM2 + (2.0 * kM0 + 4.0 * kM1) * q + 3.0 * q * q) / scale};
+  const double b2{-q * q * (kM0 + 2.0 * kM1 + 3.0 * q) / scale};
+  const double b3{q * q * q / scale};
+  return {static_cast<float>(1.0 - (b1 + b2 + b3)), static_cast<float>(b1), static_cast<float>(b2),
+          static_cast<float>(b3)};
+}
+
+/// \brief Runs the causal and then the anti-causal filter along the rows, in place. The values outside of a row are
+/// taken to be its first and its last value. The rows are filtered kRecursiveRows at a time, so that their chains of
+/// dependent multiplications overlap.
+void RecursiveRows(const ImgViewF& im, const RecursiveCoefficients& c)
+{
+  const size_t kRows = im.size.rows;
+  const size_t kCols = im.size.cols;
+  const size_t kStride = im.stride;
+  for (size_t y = 0; y < kRows; y += kRecursiveRows) {
+    const size_t kN{std::min(kRecursiveRows, kRows - y)};
+    float* data{im.Row(static_cast<int>(y))};
+    std::array<float, kRecursiveRows> w1{}, w2{}, w3{};
+    const auto step = [&](size_t x) {
+      for (size_t r = 0; r < kN; r++) {
+        float& v{data[r * kStride + x]};
+        v = c.b * v + c.b1 * w1[r] + c.b2 * w2[r] + c.b3 * w3[r];
+        w3[r] = w2[r];
+        w2[r] = w1[r];
+        w1[r] = v;
+      }
+    };
+
+    for (size_t r = 0; r < kN; r++) {
+      w1[r] = w2[r] = w3[r] = data[r * kStride];
+    }
+    for (size_t x = 0; x < kCols; x++) {
+      step(x);
+    }
+    for (size_t r = 0; r < kN; r++) {
+      w2[r] = w3[r] = w1[r];
+    }
+    for (size_t x = kCols; x-- > 0;) {
+      step(x);
     }
   }
-  return kernel;
+}
+
+/// \brief Runs the filters down the columns, a whole row at a time, so that the memory is read in order.
+void RecursiveColumns(const ImgViewF& im, const RecursiveCoefficients& c)
+{
+  const int kRows{im.size.rows};
+  const size_t kCols = im.size.cols;
+  const auto step = [&](float* v, const float* w1, const float* w2, const float* w3) {
+    for (size_t x = 0; x < kCols; x++) {
+      v[x] = c.b * v[x] + c.b1 * w1[x] + c.b2 * w2[x] + c.b3 * w3[x];
+    }
+  };
+
+  const Dataf first(im.Row(0), im.Row(0) + kCols);
+  const float* w1{first.data()};
+  const float* w2{w1};
+  const float* w3{w1};
+  for (int i = 0; i < kRows; i++) {
+    float* v{im.Row(i)};
+    step(v, w1, w2, w3);
+    w3 = w2;
+    w2 = w1;
+    w1 = v;
+  }
+
+  const Dataf last(im.Row(kRows - 1), im.Row(kRows - 1) + kCols);
+  w1 = w2 = w3 = last.data();
+  for (int i = kRows; i-- > 0;) {
+    float* v{im.Row(i)};
+    step(v, w1, w2, w3);
+    w3 = w2;
+    w2 = w1;
+    w1 = v;
+  }
+}
+
+void RecursiveGaussianPriv(const ImgViewF& im, const float& sigma)
+{
+  const RecursiveCoefficients kCoeffs{YoungVanVliet(sigma)};
+  RecursiveRows(im, kCoeffs);
+  RecursiveColumns(im, kCoeffs);
 }
 
 }//namespace
 
-Img GaussianBlur(const Img& im, const Size& size, const float& sigma)
+ImgF SeparableFilter(const ImgF& im, const Dataf& kernel_x, const Dataf& kernel_y)
 {
-  // Size x,y must be odd! Test
-  if (size.rows % 2 == 0 || size.cols % 2 == 0) {
+  if (!FitsSeparable(im.size, kernel_x, kernel_y)) {
+    return ImgF{{}, Size{0, 0}};
+  }
+  ImgF res{Dataf(im.data.size()), im.size};
+  SeparablePriv(ViewOf(im), ViewOf(res), kernel_x, kernel_y);
+  return res;
+}
+
+Img SeparableFilter(const Img& im, const Dataf& kernel_x, const Dataf& kernel_y)
+{
+  if (!FitsSeparable(im.size, kernel_x, kernel_y)) {
     return Img{{}, Size{0, 0}};
   }
-  // Window size larger than image size
-  if (size.rows >= im.size.rows || size.cols >= im.size.cols) {
+  Img res{Data8(im.data.size()), im.size};
+  SeparablePriv(ViewOf(im), ViewOf(res), kernel_x, kernel_y);
+  return res;
+}
+
+bool SeparableFilter(const ConstImgView& im, const ImgView& out, const Dataf& kernel_x, const Dataf& kernel_y)
+{
+  if (im.Empty() || out.Empty() || !(out.size == im.size) || !FitsSeparable(im.size, kernel_x, kernel_y)) {
+    return false;
+  }
+  SeparablePriv(im, out, kernel_x, kernel_y);
+  return true;
+}
+
+bool SeparableFilter(const ConstImgViewF& im, const ImgViewF& out, const Dataf& kernel_x, const Dataf& kernel_y)
+{
+  if (im.Empty() || out.Empty() || !(out.size == im.size) || !FitsSeparable(im.size, kernel_x, kernel_y)) {
+    return false;
+  }
+  SeparablePriv(im, out, kernel_x, kernel_y);
+  return true;
+}
+
+Img BoxBlur(const Img& im, const Size& size)
+{
+  if (size.rows <= 0 || size.cols <= 0) {
     return Img{{}, Size{0, 0}};
   }
-  //const ImgF kernel{GaussianKernel(size, sigma)};
-  const ImgF kernel{GaussianKernel(size, sigma)};
-  Img res{Data8(im.size.rows * im.size.cols, 0), im.size};
+  return SeparableFilter(im, Dataf(size.cols, 1.0F / size.cols), Dataf(size.rows, 1.0F / size.rows));
+}
 
-  const size_t kCols = size.cols;
-  const size_t kRows = size.rows;
-  const size_t kSizeX = kCols >> 1U;
-  const size_t kSizeY = kRows >> 1U;
+bool BoxBlur(const ConstImgView& im, const ImgView& out, const Size& size)
+{
+  if (size.rows <= 0 || size.cols <= 0) {
+    return false;
+  }
+  return SeparableFilter(im, out, Dataf(size.cols, 1.0F / size.cols), Dataf(size.rows, 1.0F / size.rows));
+}
 
-  // Filtering window
-  for (size_t x = kSizeX; x < im.size.cols - kSizeX; x++) {
-    for (size_t y = kSizeY; y < im.size.rows - kSizeY; y++) {
+Img GaussianBlur(const Img& im, const Size& size, const float& sigma)
+{
+  // The window size must be odd and smaller than the image.
+  if (size.rows <= 0 || size.cols <= 0) {
+    return Img{{}, Size{0, 0}};
+  }
+  return SeparableFilter(im, GaussianKernel(size.cols, sigma), GaussianKernel(size.rows, sigma));
+}
 
-      double sum = 0;
-      for (int m = 0; m < size.cols; m++) {
-        for (int k = 0; k < size.rows; k++) {
-          // Image value * kernel value
-          sum += static_cast<double>(im.data[(y + k - kSizeY) * im.size.cols + (x + m - kSizeX)]) * kernel.data[k * kernel.size.cols + m];
-        }
-      }
-      res.data[y * res.size.cols + x] = sum;//static_cast<uint8_t>(std::max(std::min(255.0, sum), 0.0));
-    }
+bool GaussianBlur(const ConstImgView& im, const ImgView& out, const Size& size, const float& sigma)
+{
+  if (size.rows <= 0 || size.cols <= 0) {
+    return false;
+  }
+  return SeparableFilter(im, out, GaussianKernel(size.cols, sigma), GaussianKernel(size.rows, sigma));
+}
+
+ImgF GaussianBlurF(const ImgF& im, const Size& size, const float& sigma)
+{
+  if (size.rows <= 0 || size.cols <= 0) {
+    return ImgF{{}, Size{0, 0}};
   }
+  return SeparableFilter(im, GaussianKernel(size.cols, sigma), GaussianKernel(size.rows, sigma));
+}
+
+bool GaussianBlurF(const ConstImgViewF& im, const ImgViewF& out, const Size& size, const float& sigma)
+{
+  if (size.rows <= 0 || size.cols <= 0) {
+    return false;
+  }
+  return SeparableFilter(im, out, GaussianKernel(size.cols, sigma), GaussianKernel(size.rows, sigma));
+}
+
+ImgF RecursiveGaussianBlurF(const ImgF& im, const float& sigma)
+{
+  if (sigma < kRecursiveMinSigma || im.data.empty()) {
+    return ImgF{{}, Size{0, 0}};
+  }
+  ImgF res{im};
+  RecursiveGaussianPriv(ViewOf(res), sigma);
   return res;
 }
 
+bool RecursiveGaussianBlurF(const ImgViewF& im, const float& sigma)
+{
+  if (sigma < kRecursiveMinSigma || im.Empty()) {
+    return false;
+  }
+  RecursiveGaussianPriv(im, sigma);
+  return true;
+}
+
+Img RecursiveGaussianBlur(const Img& im, const float& sigma)
+{
+  if (sigma < kRecursiveMinSigma || im.data.empty()) {
+    return Img{{}, Size{0, 0}};
+  }
+  ImgF res{Dataf(im.data.begin(), im.data.end()), im.size};
+  RecursiveGaussianPriv(ViewOf(res), sigma);
+  return ToImg(res);
+}
+
 /////////////////////////////////////////////
 /// Median filters
 /////////////////////////////////////////////
 
-Data8 MedianFilterPriv(const Data8& im, const int& rows, const int& cols, const int& w_width, const int& w_height)
+namespace {
+
+// Pixels run through the sorting networks at a time, enough for the compiler to fill the vector registers.
+constexpr int kMedianLanes{32};
+// Columns filtered at a time by the histograms, a strip of column histograms fits in the L2 cache.
+constexpr int kMedianStrip{256};
+constexpr int kFineBins{256};
+constexpr int kCoarseBins{16};
+constexpr int kCoarseShift{4};
+
+using Lanes = std::array<uint8_t, kMedianLanes>;
+using Comparator = std::pair<uint8_t, uint8_t>;
+
+/// \brief Median of 9 in 19 comparators.
+/// \link <a href="http://ndevilla.free.fr/median/median.pdf">N. Devillard. Fast median search: an ANSI C
+/// implementation, 1998.</a>
+constexpr std::array<Comparator, 19> kMedian9{{{1, 2}, {4, 5}, {7, 8}, {0, 1}, {3, 4}, {6, 7}, {1, 2},
+                                                {4, 5}, {7, 8}, {0, 3}, {5, 8}, {4, 7}, {3, 6}, {1, 4},
+                                                {2, 5}, {4, 7}, {4, 2}, {6, 4}, {4, 2}}};
+
+/// \brief Median of 25 in 99 comparators, from the same paper.
+constexpr std::array<Comparator, 99> kMedian25{
+    {{0, 1},   {3, 4},   {2, 4},   {2, 3},   {6, 7},   {5, 7},   {5, 6},   {9, 10},  {8, 10},  {8, 9},
+     {12, 13}, {11, 13}, {11, 12}, {15, 16}, {14, 16}, {14, 15}, {18, 19}, {17, 19}, {17, 18}, {21, 22},
+     {20, 22}, {20, 21}, {23, 24}, {2, 5},   {3, 6},   {0, 6},   {0, 3},   {4, 7},   {1, 7},   {1, 4},
+     {11, 14}, {8, 14},  {8, 11},  {12, 15}, {9, 15},  {9, 12},  {13, 16}, {10, 16}, {10, 13}, {20, 23},
+     {17, 23}, {17, 20}, {21, 24}, {18, 24}, {18, 21}, {19, 22}, {8, 17},  {9, 18},  {0, 18},  {0, 9},
+     {10, 19}, {1, 19},  {1, 10},  {11, 20}, {2, 20},  {2, 11},  {12, 21}, {3, 21},  {3, 12},  {13, 22},
+     {4, 22},  {4, 13},  {14, 23}, {5, 23},  {5, 14},  {15, 24}, {6, 24},  {6, 15},  {7, 16},  {7, 19},
+     {13, 21}, {15, 23}, {7, 13},  {7, 15},  {1, 9},   {3, 11},  {5, 17},  {11, 17}, {9, 17},  {4, 10},
+     {6, 12},  {7, 14},  {4, 6},   {4, 7},   {12, 14}, {10, 14}, {6, 7},   {10, 12}, {6, 10},  {6, 17},
+     {12, 17}, {7, 17},  {7, 10},  {12, 18}, {7, 12},  {10, 18}, {12, 20}, {10, 20}, {10, 12}}};
+
+/// \brief Puts the smaller of a and b in a and the larger in b, lane by lane.
+inline void SortLanes(Lanes& a, Lanes& b)
+{
+  for (int i = 0; i < kMedianLanes; i++) {
+    const uint8_t lo{std::min(a[i], b[i])};
+    b[i] = std::max(a[i], b[i]);
+    a[i] = lo;
+  }
+}
+
+/// \brief Median filter with a w x w window, w * w an odd number, by a sorting network.
+/// \details Each lane of the network is one pixel, so kMedianLanes neighbouring pixels are filtered by the same
+/// min and max instructions, without branches.
+template <size_t N>
+void MedianNetworkPriv(const ChannelView& im, const ImgView& out, const int& w, const std::array<Comparator, N>& network)
+{
+  const int rows{im.size.rows};
+  const int cols{im.size.cols};
+  const int edge{w / 2};
+  std::vector<Lanes> taps(w * w);
+
+  for (int y = edge; y < rows - edge; y++) {
+    for (int x = edge; x < cols - edge; x += kMedianLanes) {
+      const int count{std::min(kMedianLanes, cols - edge - x)};
+
+      for (int wy = 0; wy < w; wy++) {
+        const uint8_t* src{im.Row(y + wy - edge) + static_cast<ptrdiff_t>(x - edge) * im.step};
+        for (int wx = 0; wx < w; wx++) {
+          CopyPixels(src + static_cast<ptrdiff_t>(wx) * im.step, im.step, count, taps[wy * w + wx].data());
+        }
+      }
+      for (const auto& [a, b] : network) {
+        SortLanes(taps[a], taps[b]);
+      }
+      std::copy(taps[w * w / 2].begin(), taps[w * w / 2].begin() + count, out.Row(y) + x);
+    }
+  }
+}
+
+/// \brief Adds, or subtracts, n bins of a column histogram to those of the window.
+template <typename Count, int n>
+inline void AddBins(Count* window, const Count* col, const int& sign)
 {
-  Data8 res(rows * cols, 0);
-  int edge_x{w_width / 2};
-  int edge_y{w_height / 2};
+  for (int b = 0; b < n; b++) {
+    window[b] += sign * col[b];
+  }
+}
+
+/// \brief Median filter of any window size in constant time per pixel, as Perreault and Hebert.
+/// \details Every column has a histogram of its w_height pixels in the window rows, in kFineBins bins and in
+/// kCoarseBins coarse bins of kSegment values each. Moving down a row adds one pixel to each column histogram and
+/// removes one. Moving right along a row adds the coarse histogram of the column that enters the window and
+/// subtracts the one that leaves, and the median is looked up in the coarse bins first. The fine bins of the window
+/// are only brought up to date for the coarse bin that holds the median, from where that segment was last used,
+/// which for most images is a column or two back. The image is filtered in strips of kMedianStrip columns, so that
+/// their column histograms stay in the cache. Count must hold w_width * w_height.
+/// \link <a href="https://doi.org/10.1109/TIP.2007.902329">S. Perreault, P. Hebert. Median filtering in constant
+/// time, 2007.</a>
+template <typename Count>
+void MedianHistogramPriv(const ChannelView& im, const ImgView& out, const int& w_width, const int& w_height)
+{
+  const int rows{im.size.rows};
+  const int cols{im.size.cols};
+  constexpr int kSegment{kFineBins / kCoarseBins};
+  const int edge_x{w_width / 2};
+  const int edge_y{w_height / 2};
+  const int rank{w_width * w_height / 2};
+
+  std::vector<Count> col_fine;
+  std::vector<Count> col_coarse;
+  // The window histograms, the fine segment c counts the window with its left column at first[c].
+  std::array<Count, kFineBins> fine{};
+  std::array<Count, kCoarseBins> coarse{};
+  std::array<int, kCoarseBins> first{};
+
+  // The windows of a strip have their left column in [strip, strip_end).
+  for (int strip = 0; strip + w_width <= cols; strip += kMedianStrip) {
+    const int strip_end{std::min(strip + kMedianStrip, cols - w_width + 1)};
+    const int width{strip_end - strip + w_width - 1};
+    col_fine.assign(width * kFineBins, 0);
+    col_coarse.assign(width * kCoarseBins, 0);
+
+    auto update_row = [&](const int& row, const int& sign) {
+      const uint8_t* src{im.Row(row) + static_cast<ptrdiff_t>(strip) * im.step};
+      const auto add = [&](const int& x, const uint8_t& px) {
+        col_fine[x * kFineBins + px] += sign;
+        col_coarse[x * kCoarseBins + (px >> kCoarseShift)] += sign;
+      };
+      // Gray views keep the unit stride known to the compiler.
+      if (im.step == 1) {
+        for (int x = 0; x < width; x++) {
+          add(x, src[x]);
+        }
+      } else {
+        for (int x = 0; x < width; x++) {
+          add(x, src[static_cast<ptrdiff_t>(x) * im.step]);
+        }
+      }
+    };
+    for (int row = 0; row < w_height - 1; row++) {
+      update_row(row, 1);
+    }
+
+    for (int y = edge_y; y + w_height - edge_y <= rows; y++) {
+      update_row(y - edge_y + w_height - 1, 1);
+
+      coarse.fill(0);
+      for (int col = 0; col < w_width; col++) {
+        AddBins<Count, kCoarseBins>(coarse.data(), &col_coarse[col * kCoarseBins], 1);
+      }
+      // Far enough back that the segments are counted anew when first used.
+      first.fill(-w_width);
+
+      for (int left = 0;; left++) {
+        int seen{0};
+        int c{0};
+        while (seen + static_cast<int>(coarse[c]) <= rank) {
+          seen += static_cast<int>(coarse[c]);
+          c++;
+        }
 
-  for (int x = 0; x < cols - edge_x; x++) {
-    for (int y = 0; y < rows - edge_y; y++) {
+        Count* segment{&fine[c * kSegment]};
+        if (left - first[c] >= w_width) {
+          std::fill(segment, segment + kSegment, 0);
+          for (int col = left; col < left + w_width; col++) {
+            AddBins<Count, kSegment>(segment, &col_fine[col * kFineBins + c * kSegment], 1);
+          }
+        } else {
+          for (int col = first[c]; col < left; col++) {
+            AddBins<Count, kSegment>(segment, &col_fine[col * kFineBins + c * kSegment], -1);
+            AddBins<Count, kSegment>(segment, &col_fine[(col + w_width) * kFineBins + c * kSegment], 1);
+          }
+        }
+        first[c] = left;
 
-      std::vector<int> window(w_height * w_height, 0);
-      int i{0};
+        int v{0};
+        while (seen + static_cast<int>(segment[v]) <= rank) {
+          seen += static_cast<int>(segment[v]);
+          v++;
+        }
+        out.Row(y)[strip + left + edge_x] = static_cast<uint8_t>(c * kSegment + v);
 
-      for (int wx = 0; wx < w_width; wx++) {
-        for (int wy = 0; wy < w_height; wy++) {
-          window[i] = im[(y + wy - edge_y) * cols + (x + wx - edge_x)];
-          i++;
+        if (strip + left + 1 >= strip_end) {
+          break;
         }
+        AddBins<Count, kCoarseBins>(coarse.data(), &col_coarse[(left + w_width) * kCoarseBins], 1);
+        AddBins<Count, kCoarseBins>(coarse.data(), &col_coarse[left * kCoarseBins], -1);
       }
-      std::sort(window.begin(), window.end());
-      res[y * cols + x] = window[w_width * w_height / 2];
+      update_row(y - edge_y, -1);
     }
   }
-  return res;
 }
 
+/// \brief The median of the w_width x w_height window around each pixel, the pixels closer to the border than the
+/// window reaches are 0. For an even number of pixels in the window, the larger of the two middle values is taken.
+void MedianFilterPriv(const ChannelView& im, const ImgView& out, const int& w_width, const int& w_height)
+{
+  if (w_width == 3 && w_height == 3) {
+    MedianNetworkPriv(im, out, 3, kMedian9);
+  } else if (w_width == 5 && w_height == 5) {
+    MedianNetworkPriv(im, out, 5, kMedian25);
+  } else if (w_width * w_height <= std::numeric_limits<uint16_t>::max()) {
+    MedianHistogramPriv<uint16_t>(im, out, w_width, w_height);
+  } else {
+    MedianHistogramPriv<uint32_t>(im, out, w_width, w_height);
+  }
+  const int edge_x{w_width / 2};
+  const int edge_y{w_height / 2};
+  ZeroBorder(out, edge_y, im.size.rows - w_height + edge_y + 1, edge_x, im.size.cols - w_width + edge_x + 1);
+}
+
+bool FitsMedian(const Size& size, const Size& w_size)
+{
+  return w_size.rows < size.rows && w_size.cols < size.cols && w_size.rows > 0 && w_size.cols > 0;
+}
+
+}// namespace
+
 Img MedianFilter(const Img& im, const Size& w_size)
 {
-  if (w_size.rows >= im.size.rows || w_size.cols >= im.size.cols) {
+  if (!FitsMedian(im.size, w_size)) {
     return Img{{}, Size{0, 0}};
   }
-
-  Img res;
-  res.data = MedianFilterPriv(im.data, im.size.rows, im.size.cols, w_size.cols, w_size.rows);
-  res.size = im.size;
+  Img res{Data8(im.data.size()), im.size};
+  MedianFilterPriv(ViewOf(im), ViewOf(res), w_size.cols, w_size.rows);
   return res;
 }
 
+bool MedianFilter(const ConstImgView& im, const ImgView& out, const Size& w_size)
+{
+  if (im.Empty() || out.Empty() || !(out.size == im.size) || !FitsMedian(im.size, w_size)) {
+    return false;
+  }
+  MedianFilterPriv(im, out, w_size.cols, w_size.rows);
+  return true;
+}
+
 Img3 MedianFilter3(const Img3& im, const Size& w_size)
 {
-  if (w_size.rows >= im.size.rows || w_size.cols >= im.size.cols) {
+  return MedianFilter3(ViewOf(im), w_size);
+}
+
+Img3 MedianFilter3(const Img3View& im, const Size& w_size)
+{
+  if (im.Empty() || !FitsMedian(im.size, w_size)) {
     return Img3{{}, Size{0, 0}};
   }
 
-  Img3 res;
-  res.data[Red] = MedianFilterPriv(im.data[Red], im.size.rows, im.size.cols, w_size.cols, w_size.rows);
-  res.data[Green] = MedianFilterPriv(im.data[Green], im.size.rows, im.size.cols, w_size.cols, w_size.rows);
-  res.data[Blue] = MedianFilterPriv(im.data[Blue], im.size.rows, im.size.cols, w_size.cols, w_size.rows);
-  res.size = im.size;
+  // The channels are independent, one thread each.
+  Img3 res{{}, im.size};
+  std::vector<std::thread> workers;
+  for (const uint8_t channel : {Red, Green, Blue}) {
+    res.data[channel].resize(static_cast<size_t>(im.size.rows) * im.size.cols);
+    workers.emplace_back([&im, &res, &w_size, channel]() {
+      MedianFilterPriv(ChannelView{im, channel}, ImgView{res.data[channel].data(), im.size, im.size.cols},
+                       w_size.cols, w_size.rows);
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
   return res;
 }
 
@@ -263,47 +1021,59 @@ namespace threshold {
 Img Fixed(const Img& im, const uint8_t& threshold, const bool& cut_white)
 {
   Img img{im};
-
-  std::for_each(img.data.begin(), img.data.end(), [threshold, cut_white](uint8_t& x) {
-    if (x > threshold) {
-      x = cut_white ? 255 : 0;
-    } else {
-      x = cut_white ? 0 : 255;
-    }
-  });
+  Fixed(ViewOf(im), ViewOf(img), threshold, cut_white);
   return img;
 }
 
+bool Fixed(const ConstImgView& im, const ImgView& out, const uint8_t& threshold, const bool& cut_white)
+{
+  if (!(out.size == im.size)) {
+    return false;
+  }
+  const uint8_t above{static_cast<uint8_t>(cut_white ? 255 : 0)};
+  const uint8_t below{static_cast<uint8_t>(cut_white ? 0 : 255)};
+  for (int y = 0; y < im.size.rows; y++) {
+    std::transform(im.Row(y), im.Row(y) + im.size.cols, out.Row(y),
+                   [threshold, above, below](const uint8_t& x) { return x > threshold ? above : below; });
+  }
+  return true;
+}
+
 Img Adaptive(const Img& im, const int& region_size, const bool& cut_white)
 {
-  // Thresholding window is too big.
-  if (region_size >= im.size.cols || region_size >= im.size.rows) {
+  Img res{Data8(im.size.rows * im.size.cols, 0), im.size};
+  if (!Adaptive(ViewOf(im), ViewOf(res), region_size, cut_white)) {
     return Img{{}, Size{0, 0}};
   }
+  return res;
+}
 
-  IntegralImage img{ImgToIntegralImage(im)};
-  Img res{Data8(im.size.rows * im.size.cols, 0), im.size};
+bool Adaptive(const ConstImgView& im, const ImgView& out, const int& region_size, const bool& cut_white)
+{
+  // Thresholding window is too big.
+  if (im.Empty() || !(out.size == im.size) || region_size >= im.size.cols || region_size >= im.size.rows) {
+    return false;
+  }
 
+  const IntegralImage img{ImgToIntegralImage(im)};
   const int kMargin{region_size / 2};
+  const uint8_t above{static_cast<uint8_t>(cut_white ? 255 : 0)};
+  const uint8_t below{static_cast<uint8_t>(cut_white ? 0 : 255)};
 
-  for (int x = kMargin; x < im.size.cols - kMargin; x++) {
-    for (int y = kMargin; y < img.size.rows - kMargin; y++) {
-
-      Rectangle box{x - kMargin, y - kMargin, region_size, region_size};
-      uint32_t box_sum{IntegralBoxSum(img, box)};
-      uint32_t avg = box_sum / (region_size * region_size);
-
-      if (im.At(x, y) > avg) {
-        res.Set(x, y, 255);
+  // Every pixel reads its own value before it is written, out may be im.
+  for (int y = 0; y < im.size.rows; y++) {
+    for (int x = 0; x < im.size.cols; x++) {
+      bool is_above{false};
+      if (x >= kMargin && x < im.size.cols - kMargin && y >= kMargin && y < im.size.rows - kMargin) {
+        Rectangle box{x - kMargin, y - kMargin, region_size, region_size};
+        uint32_t box_sum{IntegralBoxSum(img, box)};
+        uint32_t avg = box_sum / (region_size * region_size);
+        is_above = im.At(x, y) > avg;
       }
+      out.At(x, y) = is_above ? above : below;
     }
   }
-
-  if (!cut_white) {
-    std::for_each(res.data.begin(), res.data.end(), [](uint8_t& x) { x = x == 0 ? 255 : 0; });
-  }
-
-  return res;
+  return true;
 }
 
 }// namespace threshold
@@ -19,18 +19,19 @@ namespace algo::image::object {
 /// Canny
 /////////////////////////////////////////////
 
-Img ExtractCannyEdges(const Img& im, const int& threshold_min, const int& threshold_max)
+namespace {
+
+/// \brief Detects the edges of the smoothed image img, as ExtractCannyEdges.
+Img CannyPriv(const Img& img, const int& threshold_min, const int& threshold_max)
 {
-  const int kNPixels{im.size.rows * im.size.cols};
-  // Smooth with Gaussian kernel
-  Img img{Convolve(im, filter::KernelType::GAUSSIAN_BLUR)};
+  const int kNPixels{img.size.rows * img.size.cols};
   // Intensity gradients
   Img gx{Convolve(img, filter::KernelType::SOBEL_X)};
   Img gy{Convolve(img, filter::KernelType::SOBEL_Y)};
 
   // Magnitude
-  Img gm{im};
-  Img th{Data8(kNPixels, 0), im.size};
+  Img gm{img};
+  Img th{Data8(kNPixels, 0), img.size};
 
   for (int i = 0; i < kNPixels; i++) {
     gm[i] = std::hypot(gx[i], gy[i]);
@@ -41,11 +42,11 @@ Img ExtractCannyEdges(const Img& im, const int& threshold_min, const int& thresh
 
   // Non-maximum suppression
   Img np{gm};
-  Img thr_edges{Data8(kNPixels, 0), im.size};
+  Img thr_edges{Data8(kNPixels, 0), img.size};
 
-  for (int x = 0; x < im.size.cols; x++) {
-    for (int y = 0; y < im.size.rows; y++) {
-      if (x == 0 || y == 0 || x == im.size.cols || y == im.size.rows) {
+  for (int x = 0; x < img.size.cols; x++) {
+    for (int y = 0; y < img.size.rows; y++) {
+      if (x == 0 || y == 0 || x == img.size.cols - 1 || y == img.size.rows - 1) {
         np.Set(x, y, 0);
         continue;
       }
@@ -80,10 +81,10 @@ Img ExtractCannyEdges(const Img& im, const int& threshold_min, const int& thresh
   }
 
   // Tracking by hysteresis
-  Img res{Data8(kNPixels, 0), im.size};
+  Img res{Data8(kNPixels, 0), img.size};
 
-  for (int x = 0; x < im.size.cols; x++) {
-    for (int y = 0; y < im.size.rows; y++) {
+  for (int x = 0; x < img.size.cols; x++) {
+    for (int y = 0; y < img.size.rows; y++) {
 
       if (thr_edges.At(x, y) == 0) continue;
 
@@ -112,6 +113,38 @@ Img ExtractCannyEdges(const Img& im, const int& threshold_min, const int& thresh
   return res;
 }
 
+}// namespace
+
+Img ExtractCannyEdges(const Img& im, const int& threshold_min, const int& threshold_max)
+{
+  // Smooth with Gaussian kernel
+  return CannyPriv(Convolve(im, filter::KernelType::GAUSSIAN_BLUR), threshold_min, threshold_max);
+}
+
+bool ExtractCannyEdges(const ConstImgView& im, const ImgView& out, const int& threshold_min, const int& threshold_max)
+{
+  if (im.Empty() || !(out.size == im.size)) {
+    return false;
+  }
+  Img blurred{Data8(static_cast<size_t>(im.size.rows) * im.size.cols), im.size};
+  Convolve(im, ViewOf(blurred), filter::KernelType::GAUSSIAN_BLUR);
+  const Img edges{CannyPriv(blurred, threshold_min, threshold_max)};
+  // im is read only by the blur, out may be im.
+  const ConstImgView kEdges{ViewOf(edges)};
+  for (int y = 0; y < im.size.rows; y++) {
+    std::copy(kEdges.Row(y), kEdges.Row(y) + im.size.cols, out.Row(y));
+  }
+  return true;
+}
+
+Img ExtractCannyEdges(const Pyramid& pyr, const int& octave, const int& threshold_min, const int& threshold_max)
+{
+  if (octave < 0 || octave >= pyr.Octaves()) {
+    return Img{{}, Size{0, 0}};
+  }
+  return CannyPriv(pyr.Smoothed(octave), threshold_min, threshold_max);
+}
+
 /////////////////////////////////////////////
 /// Line detection
 /////////////////////////////////////////////
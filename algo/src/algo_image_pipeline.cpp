@@ -0,0 +1,182 @@
+///
+/// \brief Source code for chains of image operations run band by band.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_image_pipeline.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+namespace algo::image {
+
+namespace {
+
+// A band of about this many pixels fits in the L2 cache, also with the float rows of a separable filter.
+constexpr int kBandPixels{1 << 18};
+constexpr int kMinBandRows{8};
+
+Lut Identity()
+{
+  Lut lut{};
+  std::iota(lut.begin(), lut.end(), 0);
+  return lut;
+}
+
+void ApplyLut(const Lut& lut, uint8_t* first, uint8_t* last)
+{
+  std::transform(first, last, first, [&lut](const uint8_t& v) { return lut[v]; });
+}
+
+}// namespace
+
+/////////////////////////////////////////////
+/// Pipeline
+/////////////////////////////////////////////
+
+Pipeline& Pipeline::Convolve(const filter::KernelType& kernel_type)
+{
+  return Window([kernel_type](const Img& im) { return filter::Convolve(im, kernel_type); }, 1);
+}
+
+Pipeline& Pipeline::GaussianBlur(const Size& size, const float& sigma)
+{
+  return Window([size, sigma](const Img& im) { return filter::GaussianBlur(im, size, sigma); }, size.rows / 2);
+}
+
+Pipeline& Pipeline::MedianFilter(const Size& w_size)
+{
+  return Window([w_size](const Img& im) { return filter::MedianFilter(im, w_size); }, w_size.rows / 2);
+}
+
+Pipeline& Pipeline::Adaptive(const int& region_size, const bool& cut_white)
+{
+  return Window(
+      [region_size, cut_white](const Img& im) { return filter::threshold::Adaptive(im, region_size, cut_white); },
+      region_size / 2);
+}
+
+Pipeline& Pipeline::Fixed(const uint8_t& threshold, const bool& cut_white)
+{
+  Lut lut{};
+  for (int v = 0; v < 256; v++) {
+    lut[v] = (v > threshold) == cut_white ? 255 : 0;
+  }
+  return Map(lut);
+}
+
+Pipeline& Pipeline::Invert()
+{
+  Lut lut{};
+  for (int v = 0; v < 256; v++) {
+    lut[v] = static_cast<uint8_t>(255 - v);
+  }
+  return Map(lut);
+}
+
+Pipeline& Pipeline::Map(const Lut& lut)
+{
+  // Two tables in a row are one table.
+  if (!stages_.empty() && !stages_.back().op) {
+    Lut& last{stages_.back().lut};
+    for (auto& v : last) {
+      v = lut[v];
+    }
+    return *this;
+  }
+  stages_.push_back(Stage{{}, 0, lut});
+  return *this;
+}
+
+Pipeline& Pipeline::Window(const tile::Operation& op, const int& halo)
+{
+  stages_.push_back(Stage{op, std::max(0, halo), Identity()});
+  return *this;
+}
+
+int Pipeline::Halo() const
+{
+  int halo{0};
+  for (const auto& stage : stages_) {
+    halo += stage.halo;
+  }
+  return halo;
+}
+
+Img Pipeline::Run(const Img& im, const size_t& nbr_threads, const int& band_rows) const
+{
+  if (im.data.empty() || im.data.size() != static_cast<size_t>(im.size.rows) * im.size.cols) {
+    return Img{{}, Size{0, 0}};
+  }
+  const size_t cols{static_cast<size_t>(im.size.cols)};
+  return RunBands(
+      im.size,
+      [&im, cols](const int& top, const int& bottom, uint8_t* dst) {
+        std::copy(im.data.begin() + top * cols, im.data.begin() + bottom * cols, dst);
+      },
+      nbr_threads, band_rows);
+}
+
+Img Pipeline::Run(const Img3& im, const size_t& nbr_threads, const int& band_rows) const
+{
+  return Run(ViewOf(im), nbr_threads, band_rows);
+}
+
+Img Pipeline::Run(const Img3View& im, const size_t& nbr_threads, const int& band_rows) const
+{
+  if (im.Empty()) {
+    return Img{{}, Size{0, 0}};
+  }
+  const int cols{im.size.cols};
+  return RunBands(
+      im.size,
+      [&im, cols](const int& top, const int& bottom, uint8_t* dst) {
+        const Size size{bottom - top, cols};
+        ToGray(im.Roi(Rectangle{0, top, cols, size.rows}), ImgView{dst, size, cols});
+      },
+      nbr_threads, band_rows);
+}
+
+Img Pipeline::RunBands(const Size& size, const Reader& read, const size_t& nbr_threads, const int& band_rows) const
+{
+  const int cols{size.cols};
+  // The point-wise stages at the front are applied while reading the input.
+  const auto first_window = std::find_if(stages_.begin(), stages_.end(), [](const Stage& s) { return bool(s.op); });
+  const Lut lead{first_window == stages_.begin() ? Identity() : stages_.front().lut};
+
+  Img res{Data8(static_cast<size_t>(size.rows) * cols), size};
+  std::atomic<bool> failed{false};
+
+  auto run_band = [&](const tile::Band& band) {
+    if (failed) {
+      return;
+    }
+    const Size tile_size{band.bottom - band.top, cols};
+    Img tile{Data8(static_cast<size_t>(tile_size.rows) * cols), tile_size};
+    read(band.top, band.bottom, tile.data.data());
+    ApplyLut(lead, tile.data.data(), tile.data.data() + tile.data.size());
+
+    for (auto stage = first_window; stage != stages_.end(); ++stage) {
+      if (stage->op) {
+        tile = stage->op(tile);
+        if (!(tile.size == tile_size) || tile.data.size() != static_cast<size_t>(tile_size.rows) * cols) {
+          failed = true;
+          return;
+        }
+      } else {
+        ApplyLut(stage->lut, tile.data.data(), tile.data.data() + tile.data.size());
+      }
+    }
+    const auto src = tile.data.begin() + (band.first - band.top) * cols;
+    std::copy(src, src + band.rows * cols, res.data.begin() + band.first * cols);
+  };
+
+  const int rows_per_band{band_rows > 0 ? band_rows : std::max(kMinBandRows, kBandPixels / cols)};
+  tile::ForEachBand(size.rows, Halo(), run_band, nbr_threads, rows_per_band);
+  return failed ? Img{{}, Size{0, 0}} : res;
+}
+
+}// namespace algo::image
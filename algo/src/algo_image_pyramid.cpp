@@ -0,0 +1,167 @@
+///
+/// \brief Source code for Gaussian and Laplacian image pyramids.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_image_pyramid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "algo_image_filter.hpp"
+
+namespace algo::image {
+
+namespace {
+
+// The recursive Gaussian is not accurate for a smaller sigma, a smaller blur of the input is skipped.
+constexpr float kMinBlur{0.5F};
+
+/// \brief Rounds the values of a level to 8 bits, as the filters do.
+Img ToImg(const ConstImgViewF& im)
+{
+  Img res{Data8(static_cast<size_t>(im.size.rows) * im.size.cols), im.size};
+  for (int y = 0; y < im.size.rows; y++) {
+    std::transform(im.Row(y), im.Row(y) + im.size.cols, res.data.begin() + static_cast<ptrdiff_t>(y) * im.size.cols,
+                   [](const float& v) { return static_cast<uint8_t>(std::clamp(v, 0.0F, 255.0F) + 0.5F); });
+  }
+  return res;
+}
+
+}// namespace
+
+/////////////////////////////////////////////
+/// Pyramid
+/////////////////////////////////////////////
+
+Pyramid::Pyramid(const Img& im, const int& nbr_octaves, const int& nbr_scales, const float& sigma,
+                 const float& input_sigma)
+    : Pyramid(im.data.size() == static_cast<size_t>(im.size.rows) * im.size.cols ? ViewOf(im) : ConstImgView{},
+              nbr_octaves, nbr_scales, sigma, input_sigma)
+{
+}
+
+Pyramid::Pyramid(const ConstImgView& im, const int& nbr_octaves, const int& nbr_scales, const float& sigma,
+                 const float& input_sigma)
+{
+  const int kRows{im.size.rows};
+  const int kCols{im.size.cols};
+  if (im.Empty() || nbr_octaves <= 0 || nbr_scales <= 0 || input_sigma < 0.0F || std::min(kRows, kCols) < kMinSide) {
+    return;
+  }
+  // The blur from one level to the next grows with the level, the first one is the smallest.
+  const float kStep{std::pow(2.0F, 1.0F / static_cast<float>(nbr_scales))};
+  if (sigma * std::sqrt(kStep * kStep - 1.0F) < kMinBlur) {
+    return;
+  }
+  nbr_scales_ = nbr_scales;
+  sigma_ = sigma;
+
+  const int kLevels{Levels()};
+  Size size{im.size};
+  size_t offset{0};
+  for (int o = 0; o < nbr_octaves && std::min(size.rows, size.cols) >= kMinSide; o++) {
+    octaves_.push_back(Octave{size, offset});
+    offset += static_cast<size_t>(2 * kLevels - 1) * size.rows * size.cols;
+    size = Size{size.rows / 2, size.cols / 2};
+  }
+  data_.resize(offset);
+
+  for (int o = 0; o < Octaves(); o++) {
+    const Size kSize{octaves_[o].size};
+    const size_t kPixels{static_cast<size_t>(kSize.rows) * kSize.cols};
+    const auto level = [&](const int& l) { return ImgViewF{LevelData(o, l), kSize, kSize.cols}; };
+
+    if (o == 0) {
+      for (int y = 0; y < kRows; y++) {
+        std::copy(im.Row(y), im.Row(y) + kCols, LevelData(0, 0) + static_cast<ptrdiff_t>(y) * kCols);
+      }
+      const float kBlur{std::sqrt(std::max(0.0F, sigma * sigma - input_sigma * input_sigma))};
+      if (kBlur >= kMinBlur) {
+        filter::RecursiveGaussianBlurF(level(0), kBlur);
+      }
+    } else {
+      // Level nbr_scales has twice the sigma of level 0, in the pixels of this octave it is sigma again.
+      const ConstImgViewF kPrev{Gaussian(o - 1, nbr_scales)};
+      const ImgViewF kFirst{level(0)};
+      for (int y = 0; y < kSize.rows; y++) {
+        const float* src{kPrev.Row(2 * y)};
+        float* dst{kFirst.Row(y)};
+        for (int x = 0; x < kSize.cols; x++) {
+          dst[x] = src[2 * x];
+        }
+      }
+    }
+
+    for (int l = 1; l < kLevels; l++) {
+      // sqrt(sigma_l^2 - sigma_(l-1)^2), with sigma_l = sigma * kStep^l.
+      const float kBlur{sigma * std::pow(kStep, static_cast<float>(l - 1)) * std::sqrt(kStep * kStep - 1.0F)};
+      std::copy(LevelData(o, l - 1), LevelData(o, l - 1) + kPixels, LevelData(o, l));
+      filter::RecursiveGaussianBlurF(level(l), kBlur);
+    }
+
+    for (int l = 0; l + 1 < kLevels; l++) {
+      const float* below{LevelData(o, l)};
+      const float* above{LevelData(o, l + 1)};
+      float* dog{LevelData(o, kLevels + l)};
+      for (size_t i = 0; i < kPixels; i++) {
+        dog[i] = above[i] - below[i];
+      }
+    }
+    smoothed_.push_back(ToImg(Gaussian(o, 0)));
+  }
+}
+
+Size Pyramid::SizeOf(const int& o) const
+{
+  if (o < 0 || o >= Octaves()) {
+    return Size{0, 0};
+  }
+  return octaves_[o].size;
+}
+
+float Pyramid::Sigma(const int& o, const int& l) const
+{
+  return sigma_ * std::pow(2.0F, static_cast<float>(o) + static_cast<float>(l) / static_cast<float>(nbr_scales_));
+}
+
+ConstImgViewF Pyramid::Gaussian(const int& o, const int& l) const
+{
+  if (o < 0 || o >= Octaves() || l < 0 || l >= Levels()) {
+    return ConstImgViewF{};
+  }
+  return ConstImgViewF{LevelData(o, l), octaves_[o].size, octaves_[o].size.cols};
+}
+
+ConstImgViewF Pyramid::Laplacian(const int& o, const int& l) const
+{
+  if (o < 0 || o >= Octaves() || l < 0 || l >= Levels() - 1) {
+    return ConstImgViewF{};
+  }
+  return ConstImgViewF{LevelData(o, Levels() + l), octaves_[o].size, octaves_[o].size.cols};
+}
+
+const Img& Pyramid::Smoothed(const int& o) const
+{
+  static const Img kEmpty{{}, Size{0, 0}};
+  if (o < 0 || o >= Octaves()) {
+    return kEmpty;
+  }
+  return smoothed_[o];
+}
+
+float* Pyramid::LevelData(const int& o, const int& l)
+{
+  const Size& size{octaves_[o].size};
+  return data_.data() + octaves_[o].offset + static_cast<size_t>(l) * size.rows * size.cols;
+}
+
+const float* Pyramid::LevelData(const int& o, const int& l) const
+{
+  const Size& size{octaves_[o].size};
+  return data_.data() + octaves_[o].offset + static_cast<size_t>(l) * size.rows * size.cols;
+}
+
+}// namespace algo::image
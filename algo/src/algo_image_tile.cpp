@@ -0,0 +1,146 @@
+///
+/// \brief Source code for running image operations on row bands in parallel.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include "algo_image_tile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace algo::image::tile {
+
+namespace {
+
+// More bands than threads, so that a thread that finishes early takes another band.
+constexpr int kBandsPerThread{4};
+// Fewer rows than this and the halos are a large part of the work.
+constexpr int kMinBandRows{16};
+
+size_t NumberOfThreads(size_t nbr_threads)
+{
+  if (nbr_threads == 0) {
+    nbr_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  return nbr_threads;
+}
+
+/// \brief Splits rows into bands of at least band_rows rows, as even as possible.
+std::vector<Band> SplitRows(const int& rows, const int& halo, const size_t& threads, int band_rows)
+{
+  if (band_rows <= 0) {
+    const int target{static_cast<int>(threads) * kBandsPerThread};
+    band_rows = std::max(kMinBandRows, (rows + target - 1) / target);
+  }
+  band_rows = std::max(band_rows, 2 * halo + 1);
+
+  const int n{std::max(1, rows / band_rows)};
+  std::vector<Band> bands;
+  for (int i = 0; i < n; i++) {
+    const int first{static_cast<int>(static_cast<int64_t>(rows) * i / n)};
+    const int end{static_cast<int>(static_cast<int64_t>(rows) * (i + 1) / n)};
+    bands.push_back(Band{first, end - first, std::max(0, first - halo), std::min(rows, end + halo)});
+  }
+  return bands;
+}
+
+template <typename Image, typename Op>
+Image RunPriv(const Image& im, const Op& op, const int& halo, const size_t& nbr_threads, const int& band_rows)
+{
+  const int rows{im.size.rows};
+  const int cols{im.size.cols};
+  if (im.data.empty() || halo < 0 || im.data.size() != static_cast<size_t>(rows) * cols) {
+    return Image{{}, Size{0, 0}};
+  }
+
+  Image res{decltype(im.data)(im.data.size()), im.size};
+  std::atomic<bool> failed{false};
+  ForEachBand(
+      rows, halo,
+      [&](const Band& band) {
+        if (failed) {
+          return;
+        }
+        if (band.top == 0 && band.bottom == rows) {
+          res = op(im);
+          failed = !(res.size == im.size) || res.data.size() != im.data.size();
+          return;
+        }
+        const Image tile{decltype(im.data)(im.data.begin() + band.top * cols, im.data.begin() + band.bottom * cols),
+                         Size{band.bottom - band.top, cols}};
+        const Image out{op(tile)};
+        if (!(out.size == tile.size) || out.data.size() != tile.data.size()) {
+          failed = true;
+          return;
+        }
+        const auto src = out.data.begin() + (band.first - band.top) * cols;
+        std::copy(src, src + band.rows * cols, res.data.begin() + band.first * cols);
+      },
+      nbr_threads, band_rows);
+  return failed ? Image{{}, Size{0, 0}} : res;
+}
+
+}// namespace
+
+/////////////////////////////////////////////
+/// Band execution
+/////////////////////////////////////////////
+
+void ForEachBand(const int& rows, const int& halo, const std::function<void(const Band&)>& func,
+                 const size_t& nbr_threads, const int& band_rows)
+{
+  if (rows <= 0 || halo < 0) {
+    return;
+  }
+  const size_t threads{NumberOfThreads(nbr_threads)};
+  const std::vector<Band> bands{SplitRows(rows, halo, threads, band_rows)};
+
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&]() {
+    for (size_t b = next++; b < bands.size() && !failed; b = next++) {
+      try {
+        func(bands[b]);
+      } catch (...) {
+        const std::lock_guard<std::mutex> lock{error_mutex};
+        if (!error) {
+          error = std::current_exception();
+        }
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < std::min(threads, bands.size()); t++) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : workers) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+Img Run(const Img& im, const Operation& op, const int& halo, const size_t& nbr_threads, const int& band_rows)
+{
+  return RunPriv(im, op, halo, nbr_threads, band_rows);
+}
+
+ImgF RunF(const ImgF& im, const OperationF& op, const int& halo, const size_t& nbr_threads, const int& band_rows)
+{
+  return RunPriv(im, op, halo, nbr_threads, band_rows);
+}
+
+}// namespace algo::image::tile
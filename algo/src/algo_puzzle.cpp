@@ -6,6 +6,8 @@
 
 #include "algo_puzzle.hpp"
 
+#include <algorithm>
+
 /////////////////////////////////////////////
 /// Sudoku
 /////////////////////////////////////////////
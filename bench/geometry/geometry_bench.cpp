@@ -0,0 +1,711 @@
+///
+/// \brief Geometry benchmarks.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "algo.hpp"
+
+using namespace std;
+using namespace algo::geometry;
+
+namespace {
+
+using Orient2DFunc = double (*)(double, double, double, double, double,
+                                double);
+using InCircleFunc = double (*)(double, double, double, double, double,
+                                double, double, double);
+
+constexpr size_t kPredicateCalls{1UL << 22};
+
+double NaiveOrient2D(double ax, double ay, double bx, double by, double cx,
+                     double cy)
+{
+  return (ax - cx) * (by - cy) - (ay - cy) * (bx - cx);
+}
+
+double NaiveInCircle(double ax, double ay, double bx, double by, double cx,
+                     double cy, double dx, double dy)
+{
+  const double adx{ax - dx};
+  const double bdx{bx - dx};
+  const double cdx{cx - dx};
+  const double ady{ay - dy};
+  const double bdy{by - dy};
+  const double cdy{cy - dy};
+  return (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy)
+         + (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy)
+         + (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+}
+
+vector<double> UniformCoordinates(size_t n, unsigned seed)
+{
+  mt19937_64 gen{seed};
+  uniform_real_distribution<double> dist{0.0, 1.0};
+  vector<double> coords(n);
+  for (auto& c : coords) {
+    c = dist(gen);
+  }
+  return coords;
+}
+
+/// \brief Returns the elapsed time per call in nanoseconds.
+double NanosPerCall(chrono::steady_clock::time_point start)
+{
+  const chrono::duration<double, nano> elapsed{chrono::steady_clock::now()
+                                               - start};
+  return elapsed.count() / static_cast<double>(kPredicateCalls);
+}
+
+/// \brief Times an orientation predicate. The predicate is called through a
+/// volatile pointer, so that neither side gets inlined.
+double TimeOrient2D(Orient2DFunc volatile func, const vector<double>& coords,
+                    double& checksum)
+{
+  const size_t n{coords.size() - 6};
+  const auto start = chrono::steady_clock::now();
+  for (size_t i = 0; i < kPredicateCalls; i++) {
+    const double* c{coords.data() + (i * 7) % n};
+    checksum += func(c[0], c[1], c[2], c[3], c[4], c[5]) > 0.0 ? 1.0 : 0.0;
+  }
+  return NanosPerCall(start);
+}
+
+/// \brief Times an in-circle predicate, see TimeOrient2D.
+double TimeInCircle(InCircleFunc volatile func, const vector<double>& coords,
+                    double& checksum)
+{
+  const size_t n{coords.size() - 8};
+  const auto start = chrono::steady_clock::now();
+  for (size_t i = 0; i < kPredicateCalls; i++) {
+    const double* c{coords.data() + (i * 7) % n};
+    checksum += func(c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7]) > 0.0
+                    ? 1.0
+                    : 0.0;
+  }
+  return NanosPerCall(start);
+}
+
+void PrintRow(const string& name, double naive, double robust)
+{
+  cout << left << setw(12) << name << right << fixed << setprecision(2)
+       << setw(12) << naive << setw(12) << robust << setw(10)
+       << robust / naive << endl;
+}
+
+/// \brief Times the filtered predicates against the plain determinants on
+/// random, non-degenerate, inputs where the filter should decide almost
+/// every call.
+void BenchPredicates()
+{
+  const vector<double> coords{UniformCoordinates(1UL << 16, 42U)};
+  double checksum{0.0};
+
+  cout << left << setw(12) << "predicate" << right << setw(12) << "naive ns"
+       << setw(12) << "robust ns" << setw(10) << "ratio" << endl;
+
+  // Warm up.
+  TimeOrient2D(predicates::Orient2D, coords, checksum);
+
+  const double naive_orient{TimeOrient2D(NaiveOrient2D, coords, checksum)};
+  const double robust_orient{
+      TimeOrient2D(predicates::Orient2D, coords, checksum)};
+  PrintRow("orient2d", naive_orient, robust_orient);
+
+  const double naive_incircle{TimeInCircle(NaiveInCircle, coords, checksum)};
+  const double robust_incircle{
+      TimeInCircle(predicates::InCircle, coords, checksum)};
+  PrintRow("incircle", naive_incircle, robust_incircle);
+
+  cout << "checksum " << checksum << endl;
+}
+
+/// \brief Returns the elapsed time in seconds.
+double Seconds(chrono::steady_clock::time_point start)
+{
+  const chrono::duration<double> elapsed{chrono::steady_clock::now() - start};
+  return elapsed.count();
+}
+
+void PrintThroughput(const string& name, size_t queries, double seconds)
+{
+  cout << left << setw(24) << name << right << fixed << setprecision(0)
+       << setw(14) << static_cast<double>(queries) / seconds << " queries/s"
+       << endl;
+}
+
+/// \brief R-tree build times and query throughput on small random triangles,
+/// against a linear scan over the bounding rectangles.
+void BenchRTree()
+{
+  constexpr size_t kPolygons{200000};
+  constexpr size_t kQueries{100000};
+  constexpr size_t kLinearQueries{200};
+  constexpr double kWindow{2.0};
+
+  const vector<double> coords{UniformCoordinates(4 * kPolygons, 7U)};
+  vector<Polygon> polygons;
+  polygons.reserve(kPolygons);
+  for (size_t i = 0; i < kPolygons; i++) {
+    const double x{coords[4 * i] * 1000.0};
+    const double y{coords[4 * i + 1] * 1000.0};
+    const double w{0.1 + coords[4 * i + 2]};
+    const double h{0.1 + coords[4 * i + 3]};
+    polygons.emplace_back(Points{{x, y}, {x + w, y}, {x + w / 2.0, y + h}});
+  }
+  const vector<double> query_coords{UniformCoordinates(2 * kQueries, 8U)};
+  const auto query_point = [&](size_t i) {
+    return Point{query_coords[2 * i] * 1000.0,
+                 query_coords[2 * i + 1] * 1000.0};
+  };
+  size_t checksum{0};
+
+  auto start = chrono::steady_clock::now();
+  const RTree tree{polygons};
+  cout << "STR bulk load " << kPolygons << " polygons: " << fixed
+       << setprecision(3) << Seconds(start) << " s, height " << tree.Height() << endl;
+
+  start = chrono::steady_clock::now();
+  RTree dynamic;
+  for (size_t i = 0; i < kPolygons; i++) {
+    dynamic.Insert(i, polygons[i]);
+  }
+  cout << "Insert " << kPolygons << " polygons: " << fixed
+       << setprecision(3) << Seconds(start) << " s, height " << dynamic.Height() << endl;
+
+  start = chrono::steady_clock::now();
+  for (size_t i = 0; i < kQueries; i++) {
+    const Point pt{query_point(i)};
+    checksum += tree.Search(Rectangle{pt, kWindow, kWindow}).size();
+  }
+  PrintThroughput("window, STR", kQueries, Seconds(start));
+
+  start = chrono::steady_clock::now();
+  for (size_t i = 0; i < kQueries; i++) {
+    const Point pt{query_point(i)};
+    checksum += dynamic.Search(Rectangle{pt, kWindow, kWindow}).size();
+  }
+  PrintThroughput("window, inserted", kQueries, Seconds(start));
+
+  start = chrono::steady_clock::now();
+  for (size_t i = 0; i < kQueries; i++) {
+    checksum += tree.Contains(query_point(i)).size();
+  }
+  PrintThroughput("point containment", kQueries, Seconds(start));
+
+  start = chrono::steady_clock::now();
+  for (size_t i = 0; i < kQueries; i++) {
+    checksum += tree.Nearest(query_point(i)).front();
+  }
+  PrintThroughput("nearest", kQueries, Seconds(start));
+
+  // The linear scan keeps the bounding rectangles in a flat array.
+  vector<double> boxes;
+  boxes.reserve(4 * kPolygons);
+  for (const auto& polygon : polygons) {
+    const Rectangle rect{polygon.BoundingRectangle()};
+    boxes.insert(boxes.end(),
+                 {rect.GetPoint().X(), rect.GetPoint().Y(),
+                  rect.GetPoint().X() + rect.GetWidth(),
+                  rect.GetPoint().Y() + rect.GetHeight()});
+  }
+  start = chrono::steady_clock::now();
+  for (size_t i = 0; i < kLinearQueries; i++) {
+    const Point pt{query_point(i)};
+    for (size_t j = 0; j < kPolygons; j++) {
+      const double* b{boxes.data() + 4 * j};
+      checksum += (b[0] <= pt.X() + kWindow && pt.X() <= b[2]
+                   && b[1] <= pt.Y() + kWindow && pt.Y() <= b[3])
+                      ? 1
+                      : 0;
+    }
+  }
+  PrintThroughput("window, linear scan", kLinearQueries, Seconds(start));
+
+  cout << "checksum " << checksum << endl;
+}
+
+/// \brief Convex hull times on normally distributed points, all at once,
+/// on threads and streamed in chunks.
+void BenchHull()
+{
+  constexpr size_t kPoints{1UL << 21};
+  constexpr size_t kChunk{1UL << 14};
+
+  mt19937_64 gen{11U};
+  normal_distribution<double> dist{0.0, 1.0};
+  PointCloud cloud;
+  cloud.Reserve(kPoints);
+  for (size_t i = 0; i < kPoints; i++) {
+    cloud.PushBack(dist(gen), dist(gen));
+  }
+  size_t checksum{0};
+
+  auto start = chrono::steady_clock::now();
+  checksum += ConvexHull(cloud, 1).Size();
+  cout << "monotone chain, 1 thread   " << fixed << setprecision(3)
+       << Seconds(start) << " s" << endl;
+
+  start = chrono::steady_clock::now();
+  checksum += ConvexHull(cloud, 0).Size();
+  cout << "monotone chain, " << setw(2) << thread::hardware_concurrency()
+       << " threads " << fixed << setprecision(3) << Seconds(start) << " s"
+       << endl;
+
+  // Sorting dominates the above, the chain alone on sorted input.
+  vector<pair<double, double>> sorted;
+  sorted.reserve(kPoints);
+  for (size_t i = 0; i < kPoints; i++) {
+    sorted.emplace_back(cloud.X(i), cloud.Y(i));
+  }
+  sort(sorted.begin(), sorted.end());
+  PointCloud sorted_cloud;
+  sorted_cloud.Reserve(kPoints);
+  for (const auto& [x, y] : sorted) {
+    sorted_cloud.PushBack(x, y);
+  }
+  start = chrono::steady_clock::now();
+  checksum += MonotoneChain(sorted_cloud).Size();
+  cout << "monotone chain, sorted     " << fixed << setprecision(3)
+       << Seconds(start) << " s" << endl;
+
+  start = chrono::steady_clock::now();
+  StreamingHull stream;
+  for (size_t first = 0; first < kPoints; first += kChunk) {
+    PointCloud chunk;
+    chunk.Reserve(kChunk);
+    for (size_t i = first; i < first + kChunk; i++) {
+      chunk.PushBack(cloud.X(i), cloud.Y(i));
+    }
+    stream.Add(chunk);
+  }
+  checksum += stream.Hull().Size();
+  cout << "streaming, chunks of " << kChunk << " " << fixed
+       << setprecision(3) << Seconds(start) << " s" << endl;
+
+  cout << "checksum " << checksum << endl;
+}
+
+/// \brief A star shaped polygon with n corners around (cx, cy) and wavy
+/// sides, the lowest corner second. Convex if there are no waves.
+Polygon StarPolygon(mt19937_64& gen, size_t n, double cx, double cy,
+                    double waves)
+{
+  constexpr double kRadius{75.0};
+  constexpr double kPi{3.141592653589793};
+  const double step{2.0 * kPi / static_cast<double>(n)};
+  // Small jitter, so that the sides are not smooth curves.
+  uniform_real_distribution<double> jitter{-0.2 * step, 0.2 * step};
+  PointCloud ring;
+  ring.Reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    // From straight down, counter clockwise.
+    const double angle{-0.5 * kPi + step * static_cast<double>(i)};
+    const double r{waves == 0.0 ? kRadius
+                                : kRadius + 20.0 * sin(waves * angle) +
+                                      kRadius * jitter(gen)};
+    ring.PushBack(cx + r * cos(angle), cy + r * sin(angle));
+  }
+  // The polygon checks the turn at the second corner, the lowest one is
+  // convex.
+  size_t lowest{0};
+  for (size_t i = 1; i < n; i++) {
+    if (ring.Y(i) < ring.Y(lowest)) {
+      lowest = i;
+    }
+  }
+  PointCloud rotated;
+  rotated.Reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    const size_t k{(lowest + n - 1 + i) % n};
+    rotated.PushBack(ring.X(k), ring.Y(k));
+  }
+  return Polygon{std::move(rotated)};
+}
+
+/// \brief Boolean operations on large wavy polygons with the sweep, and on
+/// convex polygons with and without the Sutherland-Hodgman fast path.
+void BenchClip()
+{
+  constexpr size_t kCorners{1UL << 18};
+
+  mt19937_64 gen{13U};
+  const Polygon a{StarPolygon(gen, kCorners, 0.0, 0.0, 7.0)};
+  const Polygon b{StarPolygon(gen, kCorners, 40.0, 10.0, 11.0)};
+  size_t checksum{0};
+
+  const pair<BooleanOp, string> ops[]{
+      {BooleanOp::kIntersection, "intersection"},
+      {BooleanOp::kUnion, "union"},
+      {BooleanOp::kDifference, "difference"},
+      {BooleanOp::kXor, "xor"}};
+  for (const auto& [op, name] : ops) {
+    const auto start = chrono::steady_clock::now();
+    const auto result = Clip(a, b, op);
+    const double seconds{Seconds(start)};
+    size_t corners{0};
+    for (const auto& polygon : result) {
+      corners += polygon.outer.GetCloud().Size();
+    }
+    checksum += corners;
+    cout << setw(12) << name << ", 2 x " << kCorners << " corners: " << fixed
+         << setprecision(3) << seconds << " s, " << result.size()
+         << " polygons, " << corners << " corners" << endl;
+  }
+
+  // Many small convex polygons, the fast path against the sweep, which the
+  // overload for sets of polygons always takes.
+  for (const size_t corners : {4UL, 16UL, 64UL, 256UL}) {
+    const size_t rounds{(1UL << 20) / (corners * corners) + 1};
+    const Polygon c{StarPolygon(gen, corners, 0.0, 0.0, 0.0)};
+    const Polygon d{StarPolygon(gen, corners, 40.0, 10.0, 0.0)};
+    const vector<PolygonWithHoles> c_set{{c, {}}};
+    const vector<PolygonWithHoles> d_set{{d, {}}};
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; i++) {
+      checksum += ConvexClip(c, d).Size();
+    }
+    const double fast{Seconds(start) / static_cast<double>(rounds)};
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; i++) {
+      checksum += Clip(c_set, d_set, BooleanOp::kIntersection).size();
+    }
+    const double sweep{Seconds(start) / static_cast<double>(rounds)};
+    cout << "convex, 2 x " << setw(3) << corners << " corners: "
+         << "Sutherland-Hodgman " << fixed << setprecision(2) << fast * 1e6
+         << " us, sweep " << sweep * 1e6 << " us" << endl;
+  }
+
+  cout << "checksum " << checksum << endl;
+}
+
+/// \brief Point in polygon, many points against one fence: the winding
+/// number, the slab index point by point and the batch queries.
+void BenchInside()
+{
+  constexpr size_t kPoints{1UL << 22};
+
+  mt19937_64 gen{17U};
+  uniform_real_distribution<double> coord{-100.0, 100.0};
+  PointCloud points;
+  points.Reserve(kPoints);
+  for (size_t i = 0; i < kPoints; i++) {
+    points.PushBack(coord(gen), coord(gen));
+  }
+  size_t checksum{0};
+
+  for (const size_t corners : {8UL, 64UL, 1024UL, 65536UL}) {
+    const Polygon fence{StarPolygon(gen, corners, 0.0, 0.0, 7.0)};
+    auto start = chrono::steady_clock::now();
+    const PolygonIndex index{fence};
+    const double build{Seconds(start)};
+
+    // The winding number is O(n) per point, a sample is enough.
+    const size_t sample{min(kPoints, (1UL << 26) / corners)};
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < sample; i++) {
+      checksum += IsInside(fence, points.At(i));
+    }
+    const double winding{Seconds(start) / static_cast<double>(sample)};
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < kPoints; i++) {
+      checksum += index.IsInside(points.At(i));
+    }
+    const double scalar{Seconds(start) / static_cast<double>(kPoints)};
+
+    start = chrono::steady_clock::now();
+    for (const int inside : index.IsInside(points, 1)) {
+      checksum += inside;
+    }
+    const double batch{Seconds(start) / static_cast<double>(kPoints)};
+
+    start = chrono::steady_clock::now();
+    for (const int inside : index.IsInside(points)) {
+      checksum += inside;
+    }
+    const double threads{Seconds(start) / static_cast<double>(kPoints)};
+
+    cout << setw(6) << corners << " corners, " << index.SlabEdgeCount()
+         << " slab edges, build " << fixed << setprecision(2)
+         << build * 1e3 << " ms, ns per point: winding " << winding * 1e9
+         << ", index " << scalar * 1e9 << ", batch " << batch * 1e9
+         << ", threads " << threads * 1e9 << endl;
+  }
+
+  cout << "checksum " << checksum << endl;
+}
+
+/// \brief Ear clipping of wavy polygons, with and without holes.
+void BenchEarcut()
+{
+  mt19937_64 gen{19U};
+  size_t checksum{0};
+
+  for (const size_t corners : {1000UL, 10000UL, 100000UL, 1000000UL}) {
+    PolygonWithHoles polygon{StarPolygon(gen, corners, 0.0, 0.0, 7.0), {}};
+    auto start = chrono::steady_clock::now();
+    checksum += Triangulate(polygon.outer).size();
+    const double plain{Seconds(start)};
+
+    // Square holes on a grid well inside the polygon.
+    for (double x = -35.0; x <= 35.0; x += 5.0) {
+      for (double y = -35.0; y <= 35.0; y += 5.0) {
+        polygon.holes.emplace_back(
+            Points{{x, y}, {x + 2.0, y}, {x + 2.0, y + 2.0}, {x, y + 2.0}});
+      }
+    }
+    start = chrono::steady_clock::now();
+    checksum += Triangulate(polygon).size();
+    const double holes{Seconds(start)};
+
+    cout << setw(7) << corners << " corners: " << fixed << setprecision(2)
+         << plain * 1e3 << " ms, with " << polygon.holes.size()
+         << " holes " << holes * 1e3 << " ms" << endl;
+  }
+
+  cout << "checksum " << checksum << endl;
+}
+
+// /////////////////////////////
+// MARK: Suite
+
+/// \brief Point distributions of the suite.
+enum class Distribution { kUniform, kClustered, kCircle, kCollinear };
+
+/// \brief One timed run of the suite.
+struct SuiteResult {
+  string distribution;
+  string algorithm;
+  size_t points;
+  unsigned seed;
+  size_t runs;
+  double seconds;  // The fastest run.
+  string status;   // ok, error or skipped.
+};
+
+// Sizes that are predicted to take longer than this are skipped.
+constexpr double kSuiteBudget{120.0};
+// Small inputs are run again until this much time has passed.
+constexpr double kSuiteMinTime{0.2};
+
+/// \brief Returns n points of a distribution, the same for the same seed.
+/// \details Uniform in the unit square, Gaussian clusters around 16 random
+/// centers, on the unit circle, and on one line.
+PointCloud SuitePoints(Distribution dist, size_t n, unsigned seed)
+{
+  constexpr size_t kClusters{16};
+  constexpr double kPi{3.141592653589793};
+
+  mt19937_64 gen{seed};
+  uniform_real_distribution<double> unit{0.0, 1.0};
+  normal_distribution<double> spread{0.0, 0.01};
+  vector<pair<double, double>> centers(kClusters);
+  for (auto& [x, y] : centers) {
+    x = unit(gen);
+    y = unit(gen);
+  }
+  PointCloud cloud;
+  cloud.Reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    switch (dist) {
+      case Distribution::kUniform:
+        cloud.PushBack(unit(gen), unit(gen));
+        break;
+      case Distribution::kClustered: {
+        const auto& [x, y] = centers[gen() % kClusters];
+        cloud.PushBack(x + spread(gen), y + spread(gen));
+        break;
+      }
+      case Distribution::kCircle: {
+        const double angle{2.0 * kPi * unit(gen)};
+        cloud.PushBack(cos(angle), sin(angle));
+        break;
+      }
+      case Distribution::kCollinear: {
+        const double t{unit(gen)};
+        cloud.PushBack(t, 2.0 * t + 1.0);
+        break;
+      }
+    }
+  }
+  return cloud;
+}
+
+void PrintCsv(const vector<SuiteResult>& results)
+{
+  cout << "distribution,algorithm,points,seed,runs,seconds,ns_per_point,"
+          "status"
+       << endl;
+  for (const auto& r : results) {
+    cout << r.distribution << ',' << r.algorithm << ',' << r.points << ','
+         << r.seed << ',' << r.runs << ',' << scientific << setprecision(6)
+         << r.seconds << ',' << fixed << setprecision(3)
+         << r.seconds * 1e9 / static_cast<double>(r.points) << ','
+         << r.status << endl;
+  }
+}
+
+void PrintJson(const vector<SuiteResult>& results)
+{
+  cout << "[" << endl;
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& r{results[i]};
+    cout << "  {\"distribution\": \"" << r.distribution
+         << "\", \"algorithm\": \"" << r.algorithm << "\", \"points\": "
+         << r.points << ", \"seed\": " << r.seed << ", \"runs\": " << r.runs
+         << ", \"seconds\": " << scientific << setprecision(6) << r.seconds
+         << ", \"ns_per_point\": " << fixed << setprecision(3)
+         << r.seconds * 1e9 / static_cast<double>(r.points)
+         << ", \"status\": \"" << r.status << "\"}"
+         << (i + 1 < results.size() ? "," : "") << endl;
+  }
+  cout << "]" << endl;
+}
+
+/// \brief Times the Grid algorithms on every distribution, from 10^2 to
+/// 10^max_exp points, and prints the results as CSV or JSON.
+/// \details Each algorithm runs at least once and until kSuiteMinTime has
+/// passed, the fastest run is reported. The next size is predicted from the
+/// growth between the last two, at least ten times and a thousand times
+/// after the first, and skipped if it would take longer than kSuiteBudget.
+/// Inputs that the algorithm rejects are reported as errors. Progress and
+/// the checksum go to stderr.
+void BenchSuite(const string& format, int max_exp, unsigned seed)
+{
+  const pair<Distribution, string> distributions[]{
+      {Distribution::kUniform, "uniform"},
+      {Distribution::kClustered, "clustered"},
+      {Distribution::kCircle, "circle"},
+      {Distribution::kCollinear, "collinear"}};
+  size_t checksum{0};
+  const pair<string, function<void(const Grid&)>> algorithms[]{
+      {"ConvexHull",
+       [&](const Grid& grid) {
+         checksum += grid.ConvexHull().GetCloud().Size();
+       }},
+      {"ClosestPairOfPoints",
+       [&](const Grid& grid) {
+         checksum += grid.ClosestPairOfPoints().first.X() > 0.5;
+       }},
+      {"MinEnclosingCircle",
+       [&](const Grid& grid) {
+         checksum += grid.MinEnclosingCircle().Radius() > 0.5;
+       }},
+      {"MinBoundingBox",
+       [&](const Grid& grid) {
+         checksum += grid.MinBoundingBox().GetCloud().Size();
+       }},
+      {"Triangulation",
+       [&](const Grid& grid) { checksum += grid.Triangulation().size(); }},
+      {"DelaunayTriangulation", [&](const Grid& grid) {
+         checksum += grid.DelaunayTriangulation().size();
+       }}};
+
+  vector<SuiteResult> results;
+  for (const auto& [dist, dist_name] : distributions) {
+    // The last two times of each algorithm, zero if not run.
+    vector<pair<double, double>> times(size(algorithms), {0.0, 0.0});
+    for (size_t n = 100; n <= static_cast<size_t>(pow(10.0, max_exp));
+         n *= 10) {
+      const Grid grid{SuitePoints(dist, n, seed)};
+      for (size_t a = 0; a < size(algorithms); a++) {
+        const auto& [name, run] = algorithms[a];
+        SuiteResult result{dist_name, name, n, seed, 0, 0.0, "ok"};
+        const auto [prev, last] = times[a];
+        const double growth{prev > 0.0 ? max(10.0, last / prev) : 1000.0};
+        if (last * growth > kSuiteBudget) {
+          result.status = "skipped";
+          results.push_back(result);
+          continue;
+        }
+        cerr << dist_name << " " << name << " " << n << endl;
+        try {
+          double total{0.0};
+          double fastest{numeric_limits<double>::infinity()};
+          while (result.runs == 0 || total < kSuiteMinTime) {
+            const auto start = chrono::steady_clock::now();
+            run(grid);
+            const double seconds{Seconds(start)};
+            fastest = min(fastest, seconds);
+            total += seconds;
+            result.runs++;
+          }
+          result.seconds = fastest;
+          times[a] = {last, fastest};
+        } catch (const exception&) {
+          result.status = "error";
+          times[a] = {0.0, 0.0};
+        }
+        results.push_back(result);
+      }
+    }
+  }
+
+  if (format == "json") {
+    PrintJson(results);
+  } else {
+    PrintCsv(results);
+  }
+  cerr << "checksum " << checksum << endl;
+}
+
+void PrintHelp()
+{
+  cout << "Benchmarks: Robust predicates <predicates>, R-tree <rtree>, "
+          "convex hull <hull>, polygon clipping <clip>, point in "
+          "polygon <inside>, ear clipping <earcut>, Grid algorithms on "
+          "seeded distributions <suite [csv|json] [max exponent] [seed]>."
+       << endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    PrintHelp();
+    return -1;
+  }
+  const string arg1{argv[1]};
+
+  if (arg1 == "predicates") {
+    BenchPredicates();
+  } else if (arg1 == "rtree") {
+    BenchRTree();
+  } else if (arg1 == "hull") {
+    BenchHull();
+  } else if (arg1 == "clip") {
+    BenchClip();
+  } else if (arg1 == "inside") {
+    BenchInside();
+  } else if (arg1 == "earcut") {
+    BenchEarcut();
+  } else if (arg1 == "suite") {
+    const string format{argc > 2 ? argv[2] : "csv"};
+    const int max_exp{argc > 3 ? stoi(argv[3]) : 7};
+    const unsigned seed{argc > 4 ? static_cast<unsigned>(stoul(argv[4])) : 1U};
+    BenchSuite(format, max_exp, seed);
+  } else {
+    PrintHelp();
+    return -1;
+  }
+  return 0;
+}
@@ -0,0 +1,559 @@
+///
+/// \brief Image benchmarks.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "algo.hpp"
+
+using namespace std;
+using namespace algo::image;
+using namespace algo::image::filter;
+
+namespace {
+
+// Measurements are repeated until this much time has passed.
+constexpr double kMinTime{0.3};
+
+const vector<pair<string, KernelType>> kKernels{
+    {"SOBEL_X", KernelType::SOBEL_X},
+    {"SOBEL_Y", KernelType::SOBEL_Y},
+    {"EDGE_DETECT", KernelType::EDGE_DETECT},
+    {"SMOOTHING", KernelType::SMOOTHING},
+    {"SHARPEN_MODEST", KernelType::SHARPEN_MODEST},
+    {"SHARPEN_AGGRESSIVE", KernelType::SHARPEN_AGGRESSIVE},
+    {"GAUSSIAN_BLUR", KernelType::GAUSSIAN_BLUR},
+    {"BLUR_HARD", KernelType::BLUR_HARD},
+    {"BLUR_SOFT", KernelType::BLUR_SOFT},
+    {"HIGH_PASS", KernelType::HIGH_PASS},
+    {"EMBOSS", KernelType::EMBOSS},
+    {"WEIGHTED_AVERAGE", KernelType::WEIGHTED_AVERAGE},
+    {"DILATION_HORIZONTAL", KernelType::DILATION_HORIZONTAL},
+    {"DILATION_VERTICAL", KernelType::DILATION_VERTICAL},
+    {"DILATION", KernelType::DILATION},
+};
+
+double Seconds(chrono::steady_clock::time_point start)
+{
+  const chrono::duration<double> elapsed{chrono::steady_clock::now() - start};
+  return elapsed.count();
+}
+
+Img RandomImg(int rows, int cols, unsigned seed)
+{
+  mt19937 gen{seed};
+  uniform_int_distribution<int> dist{0, 255};
+  Img im{Data8(static_cast<size_t>(rows) * cols), Size{rows, cols}};
+  for (auto& px : im.data) {
+    px = static_cast<uint8_t>(dist(gen));
+  }
+  return im;
+}
+
+/// \brief Runs func until kMinTime has passed.
+/// \return Megapixels per second.
+template <typename Func>
+double MegapixelsPerSecond(const Img& im, Func func)
+{
+  size_t runs{0};
+  const auto start = chrono::steady_clock::now();
+  do {
+    func();
+    runs++;
+  } while (Seconds(start) < kMinTime);
+  const double pixels{static_cast<double>(im.data.size()) * runs};
+  return pixels / Seconds(start) * 1e-6;
+}
+
+// /////////////////////////////
+// MARK: Convolve
+
+/// \brief The kernels of algo_image_filter.cpp, for the baseline.
+array<float, 9> BaselineKernel(KernelType type)
+{
+  const map<KernelType, array<float, 9>> kernels{
+      {KernelType::SOBEL_X, {-0.5F, 0, 0.5F, -1, 0, 1, -0.5F, 0, 0.5F}},
+      {KernelType::SOBEL_Y, {-0.5F, -1, -0.5F, 0, 0, 0, 0.5F, 1, 0.5F}},
+      {KernelType::EDGE_DETECT, {1, 0, -1, 0, 0, 0, -1, 0, 1}},
+      {KernelType::SMOOTHING,
+       {1 / 13.0F, 2 / 13.0F, 1 / 13.0F, 2 / 13.0F, 4 / 13.0F, 2 / 13.0F,
+        1 / 13.0F, 2 / 13.0F, 1 / 13.0F}},
+      {KernelType::SHARPEN_MODEST,
+       {-1 / 9.0F, -1 / 9.0F, -1 / 9.0F, -1 / 9.0F, 17 / 9.0F, -1 / 9.0F,
+        -1 / 9.0F, -1 / 9.0F, -1 / 9.0F}},
+      {KernelType::SHARPEN_AGGRESSIVE, {0, -1, 0, -1, 5, -1, 0, -1, 0}},
+      {KernelType::GAUSSIAN_BLUR,
+       {1 / 16.0F, 2 / 16.0F, 1 / 16.0F, 2 / 16.0F, 4 / 16.0F, 2 / 16.0F,
+        1 / 16.0F, 2 / 16.0F, 1 / 16.0F}},
+      {KernelType::BLUR_HARD,
+       {1 / 9.0F, 1 / 9.0F, 1 / 9.0F, 1 / 9.0F, 1 / 9.0F, 1 / 9.0F, 1 / 9.0F,
+        1 / 9.0F, 1 / 9.0F}},
+      {KernelType::BLUR_SOFT, {0, 0.125F, 0, 0.125F, 0.5F, 0.125F, 0, 0.125F, 0}},
+      {KernelType::HIGH_PASS, {-1, -1, -1, -1, 8, -1, -1, -1, -1}},
+      {KernelType::EMBOSS, {-2, -1, 0, -1, 1, 1, 0, 1, 2}},
+      {KernelType::WEIGHTED_AVERAGE,
+       {1 / 16.0F, 2 / 16.0F, 1 / 16.0F, 2 / 16.0F, 4 / 16.0F, 2 / 16.0F,
+        1 / 16.0F, 2 / 16.0F, 1 / 16.0F}},
+      {KernelType::DILATION_HORIZONTAL, {0, 0, 0, 1, 1, 1, 0, 0, 0}},
+      {KernelType::DILATION_VERTICAL, {0, 1, 0, 0, 1, 0, 0, 1, 0}},
+      {KernelType::DILATION, {0, 1, 0, 1, 1, 1, 0, 1, 0}},
+  };
+  return kernels.at(type);
+}
+
+/// \brief Convolve as it was before the row kernels, every tap of every pixel
+/// in float.
+Data8 BaselineConvolve(const Img& im, const array<float, 9>& filter)
+{
+  const size_t rows = im.size.rows;
+  const size_t cols = im.size.cols;
+  Data8 res(im.data.size(), 0);
+  for (size_t i = 1; i < rows - 1; i++) {
+    for (size_t j = 1; j < cols - 1; j++) {
+      float sum = 0;
+      for (size_t k = 0; k < 3; k++) {
+        for (size_t m = 0; m < 3; m++) {
+          auto im_num = static_cast<float>(im.data[(i + k - 1) * cols + (j + m - 1)]);
+          sum += im_num * filter[k * 3 + m];
+        }
+      }
+      if (sum < 0) sum = 0;
+      if (sum > 255) sum = 255;
+      res[i * cols + j] = static_cast<uint8_t>(sum);
+    }
+  }
+  return res;
+}
+
+/// \brief The instruction sets of this CPU.
+vector<pair<string, Simd>> Simds()
+{
+  vector<pair<string, Simd>> simds{{"scalar", Simd::SCALAR}};
+  if (DetectedSimd() >= Simd::SSE2) {
+    simds.emplace_back("sse2", Simd::SSE2);
+  }
+  if (DetectedSimd() >= Simd::AVX2) {
+    simds.emplace_back("avx2", Simd::AVX2);
+  }
+  return simds;
+}
+
+void BenchConvolve(int rows, int cols)
+{
+  const Img im{RandomImg(rows, cols, 7U)};
+  const vector<pair<string, Simd>> simds{Simds()};
+
+  cout << rows << "x" << cols << " image, megapixels per second" << endl;
+  cout << left << setw(20) << "kernel" << right << setw(10) << "baseline";
+  for (const auto& [name, simd] : simds) {
+    cout << setw(10) << name;
+  }
+  cout << endl;
+
+  size_t checksum{0};
+  for (const auto& [name, type] : kKernels) {
+    const auto filter = BaselineKernel(type);
+    Data8 expected;
+    const double baseline{MegapixelsPerSecond(im, [&]() { expected = BaselineConvolve(im, filter); })};
+    cout << left << setw(20) << name << right << fixed << setprecision(1) << setw(10) << baseline;
+
+    for (const auto& simd : simds) {
+      Img res;
+      const double mps{MegapixelsPerSecond(im, [&]() { res = Convolve(im, type, simd.second); })};
+      cout << setw(10) << mps << (res.data == expected ? "" : " mismatch");
+      checksum += res.data[res.data.size() / 2];
+    }
+    cout << endl;
+  }
+  cout << "checksum " << checksum << endl;
+}
+
+// /////////////////////////////
+// MARK: Blur
+
+/// \brief GaussianBlur as it was before the separable filter, the whole 2D
+/// window per pixel, accumulated in double.
+Img BaselineGaussianBlur(const Img& im, int window, float sigma)
+{
+  vector<float> kernel(static_cast<size_t>(window) * window);
+  float sum{0.0F};
+  for (int k = 0; k < window; k++) {
+    for (int m = 0; m < window; m++) {
+      const float dx{static_cast<float>(m - window / 2)};
+      const float dy{static_cast<float>(k - window / 2)};
+      kernel[k * window + m] = exp(-(dx * dx + dy * dy) / (2.0F * sigma * sigma));
+      sum += kernel[k * window + m];
+    }
+  }
+  for (auto& w : kernel) {
+    w /= sum;
+  }
+
+  const int half{window / 2};
+  Img res{Data8(im.data.size(), 0), im.size};
+  for (int y = half; y < im.size.rows - half; y++) {
+    for (int x = half; x < im.size.cols - half; x++) {
+      double acc{0.0};
+      for (int k = 0; k < window; k++) {
+        for (int m = 0; m < window; m++) {
+          acc += static_cast<double>(im.data[(y + k - half) * im.size.cols + x + m - half]) * kernel[k * window + m];
+        }
+      }
+      res.data[y * im.size.cols + x] = static_cast<uint8_t>(acc);
+    }
+  }
+  return res;
+}
+
+void BenchBlur(int rows, int cols)
+{
+  const Img im{RandomImg(rows, cols, 11U)};
+  cout << rows << "x" << cols << " image, megapixels per second" << endl;
+  cout << right << setw(6) << "sigma" << setw(8) << "window" << setw(10) << "2D"
+       << setw(12) << "separable" << setw(12) << "recursive" << endl;
+
+  size_t checksum{0};
+  for (const float sigma : {1.0F, 2.0F, 4.0F, 8.0F, 16.0F, 32.0F}) {
+    // The window covers three sigma on each side.
+    const int window{2 * static_cast<int>(ceil(3.0F * sigma)) + 1};
+    Img res;
+    cout << setw(6) << fixed << setprecision(0) << sigma << setw(8) << window << setprecision(1);
+    // The 2D window is quadratic in its size, only the small ones are run.
+    if (window <= 13) {
+      cout << setw(10) << MegapixelsPerSecond(im, [&]() { res = BaselineGaussianBlur(im, window, sigma); });
+      checksum += res.data[res.data.size() / 2];
+    } else {
+      cout << setw(10) << "-";
+    }
+    cout << setw(12) << MegapixelsPerSecond(im, [&]() { res = GaussianBlur(im, Size{window, window}, sigma); });
+    checksum += res.data[res.data.size() / 2];
+    cout << setw(12) << MegapixelsPerSecond(im, [&]() { res = RecursiveGaussianBlur(im, sigma); }) << endl;
+    checksum += res.data[res.data.size() / 2];
+  }
+  cout << "checksum " << checksum << endl;
+}
+
+// /////////////////////////////
+// MARK: Median
+
+/// \brief MedianFilter as it was before the histograms, a vector per pixel,
+/// sorted.
+Img BaselineMedian(const Img& im, int window)
+{
+  const int half{window / 2};
+  Img res{Data8(im.data.size(), 0), im.size};
+  for (int y = half; y < im.size.rows - half; y++) {
+    for (int x = half; x < im.size.cols - half; x++) {
+      vector<int> values(static_cast<size_t>(window) * window, 0);
+      size_t i{0};
+      for (int k = 0; k < window; k++) {
+        for (int m = 0; m < window; m++) {
+          values[i++] = im.data[(y + k - half) * im.size.cols + x + m - half];
+        }
+      }
+      sort(values.begin(), values.end());
+      res.data[y * im.size.cols + x] = static_cast<uint8_t>(values[values.size() / 2]);
+    }
+  }
+  return res;
+}
+
+void BenchMedian(int rows, int cols)
+{
+  const Img im{RandomImg(rows, cols, 13U)};
+  Img3 im3{Data8_3{im.data, RandomImg(rows, cols, 14U).data, RandomImg(rows, cols, 15U).data}, im.size};
+  cout << rows << "x" << cols << " image, megapixels per second" << endl;
+  cout << right << setw(8) << "window" << setw(10) << "baseline" << setw(10) << "median" << setw(10) << "median3"
+       << endl;
+
+  size_t checksum{0};
+  for (const int window : {3, 5, 7, 9, 15, 31, 63}) {
+    Img res;
+    cout << setw(8) << window << fixed << setprecision(1);
+    // Sorting every window gets slow quickly, only the small ones are run.
+    if (window <= 9) {
+      Img expected;
+      cout << setw(10) << MegapixelsPerSecond(im, [&]() { expected = BaselineMedian(im, window); });
+      res = MedianFilter(im, Size{window, window});
+      cout << (res.data == expected.data ? "" : " mismatch");
+    } else {
+      cout << setw(10) << "-";
+    }
+    cout << setw(10) << MegapixelsPerSecond(im, [&]() { res = MedianFilter(im, Size{window, window}); });
+    checksum += res.data[res.data.size() / 2 + cols / 2];
+    Img3 res3;
+    cout << setw(10) << MegapixelsPerSecond(im, [&]() { res3 = MedianFilter3(im3, Size{window, window}); }) << endl;
+    checksum += res3.data[Blue][res3.data[Blue].size() / 2 + cols / 2];
+  }
+  cout << "checksum " << checksum << endl;
+}
+
+// /////////////////////////////
+// MARK: Tile
+
+void BenchTile(int rows, int cols)
+{
+  const Img im{RandomImg(rows, cols, 17U)};
+  const vector<tuple<string, tile::Operation, int>> ops{
+      {"convolve", [](const Img& band) { return Convolve(band, KernelType::SOBEL_X); }, 1},
+      {"gaussian 9x9", [](const Img& band) { return GaussianBlur(band, Size{9, 9}, 2.0F); }, 4},
+      {"median 7x7", [](const Img& band) { return MedianFilter(band, Size{7, 7}); }, 3},
+      {"adaptive 15", [](const Img& band) { return threshold::Adaptive(band, 15, true); }, 7},
+      {"canny", [](const Img& band) { return algo::image::object::ExtractCannyEdges(band); }, 4},
+  };
+  vector<size_t> threads{1};
+  while (threads.back() * 2 <= max(1U, thread::hardware_concurrency())) {
+    threads.push_back(threads.back() * 2);
+  }
+
+  cout << rows << "x" << cols << " image, megapixels per second" << endl;
+  cout << left << setw(14) << "operation" << right << setw(10) << "whole";
+  for (const size_t t : threads) {
+    cout << setw(10) << to_string(t) + " thr";
+  }
+  cout << endl;
+
+  size_t checksum{0};
+  for (const auto& [name, op, halo] : ops) {
+    Img expected;
+    cout << left << setw(14) << name << right << fixed << setprecision(1) << setw(10)
+         << MegapixelsPerSecond(im, [&, &op = op]() { expected = op(im); });
+    for (const size_t t : threads) {
+      Img res;
+      cout << setw(10) << MegapixelsPerSecond(im, [&, &op = op, halo = halo]() { res = tile::Run(im, op, halo, t); });
+      cout << (res.data == expected.data ? "" : " mismatch");
+      checksum += res.data[res.data.size() / 2 + cols / 2];
+    }
+    cout << endl;
+  }
+  cout << "checksum " << checksum << endl;
+}
+
+// /////////////////////////////
+// MARK: Pipeline
+
+void BenchPipeline(int rows, int cols)
+{
+  const Img3 im{Data8_3{RandomImg(rows, cols, 19U).data, RandomImg(rows, cols, 20U).data,
+                        RandomImg(rows, cols, 21U).data},
+                Size{rows, cols}};
+  cout << rows << "x" << cols << " color image, gray, blur 5x5, Sobel x, threshold, megapixels per second" << endl;
+
+  Img expected;
+  const double eager{MegapixelsPerSecond(ToGray(im), [&]() {
+    expected = threshold::Fixed(Convolve(GaussianBlur(ToGray(im), Size{5, 5}, 1.0F), KernelType::SOBEL_X), 40, true);
+  })};
+  cout << left << setw(24) << "one image per stage" << right << fixed << setprecision(1) << setw(10) << eager << endl;
+
+  Pipeline pipeline;
+  pipeline.GaussianBlur(Size{5, 5}, 1.0F).Convolve(KernelType::SOBEL_X).Fixed(40, true);
+  for (const size_t threads : {size_t{1}, size_t{0}}) {
+    Img res;
+    const double fused{MegapixelsPerSecond(expected, [&]() { res = pipeline.Run(im, threads); })};
+    cout << left << setw(24) << (threads == 1 ? "pipeline, 1 thread" : "pipeline, all cores") << right << setw(10)
+         << fused << (res.data == expected.data ? "" : " mismatch") << endl;
+  }
+}
+
+// /////////////////////////////
+// MARK: Color
+
+/// \brief ToGray as it was before the fixed point weights, on planes only.
+Img BaselineToGray(const Img3& im)
+{
+  Img res{Data8(im.data[0].size()), im.size};
+  for (size_t i = 0; i < res.data.size(); i++) {
+    res.data[i] = static_cast<uint8_t>(0.3 * im.data[0][i] + 0.59 * im.data[1][i] + 0.11 * im.data[2][i]);
+  }
+  return res;
+}
+
+void BenchColor(int rows, int cols)
+{
+  const Img3 im{Data8_3{RandomImg(rows, cols, 22U).data, RandomImg(rows, cols, 23U).data,
+                        RandomImg(rows, cols, 24U).data},
+                Size{rows, cols}};
+  const ImgInterleaved rgb{ToInterleaved(ViewOf(im), PixelFormat::RGB)};
+  const ImgInterleaved bgra{ToInterleaved(ViewOf(im), PixelFormat::BGRA)};
+  const Img yuv{RandomImg(rows + rows / 2, cols, 25U)};
+  const YuvView nv12{Nv12View(yuv.data.data(), im.size)};
+  const vector<pair<string, Simd>> simds{Simds()};
+  const Img gray{RandomImg(rows, cols, 26U)};
+
+  cout << rows << "x" << cols << " color image, megapixels per second" << endl;
+  cout << left << setw(20) << "conversion" << right << setw(10) << "baseline";
+  for (const auto& [name, simd] : simds) {
+    cout << setw(10) << name;
+  }
+  cout << endl;
+
+  Img expected;
+  const double baseline{MegapixelsPerSecond(gray, [&]() { expected = BaselineToGray(im); })};
+  size_t checksum{expected.data[expected.data.size() / 2]};
+  const vector<pair<string, function<Data8(Simd)>>> conversions{
+      {"gray, planes", [&](Simd simd) { return ToGray(ViewOf(im), simd).data; }},
+      {"gray, RGB", [&](Simd simd) { return ToGray(ViewOf(rgb), simd).data; }},
+      {"gray, BGRA", [&](Simd simd) { return ToGray(ViewOf(bgra), simd).data; }},
+      {"RGB to planes", [&](Simd simd) { return ToPlanar(ViewOf(rgb), simd).data[1]; }},
+      {"planes to BGRA", [&](Simd simd) { return ToInterleaved(ViewOf(im), PixelFormat::BGRA, simd).data; }},
+      {"NV12 to RGB", [&](Simd simd) { return YuvToRgb(nv12, simd).data[1]; }},
+  };
+
+  for (const auto& [name, convert] : conversions) {
+    cout << left << setw(20) << name << right << fixed << setprecision(1) << setw(10);
+    if (name == "gray, planes") {
+      cout << baseline;
+    } else {
+      cout << "-";
+    }
+    Data8 first;
+    for (const auto& simd : simds) {
+      Data8 res;
+      const double mps{MegapixelsPerSecond(gray, [&, &convert = convert]() { res = convert(simd.second); })};
+      if (first.empty()) {
+        first = res;
+      }
+      cout << setw(10) << mps << (res == first ? "" : " mismatch");
+      checksum += res[res.size() / 2];
+    }
+    cout << endl;
+  }
+  cout << "checksum " << checksum << endl;
+}
+
+// /////////////////////////////
+// MARK: Pyramid
+
+/// \brief The DoG pyramid of SiftKeypoints before Pyramid, nbr_octaves * nbr_gaussians blurs of the full image with
+/// a 3x3 window, stored as rows of floats.
+size_t BaselineDoGPyramid(const Img& img, int nbr_octaves, int nbr_gaussians)
+{
+  using Mat = vector<vector<float>>;
+  float sigma{1.6F};
+  const float k = M_SQRT2;
+  const Size kSize{3, 3};
+  vector<Mat> pyramid;
+  vector<Mat> gaussians;
+  Mat diff{static_cast<size_t>(img.size.rows), vector<float>(img.size.cols, 0)};
+  Mat gaussian{static_cast<size_t>(img.size.rows), vector<float>(img.size.cols, 0)};
+  Img gaussian_prev{GaussianBlur(img, kSize, k * sigma)};
+  for (int i = 0; i < nbr_octaves; i++) {
+    for (int j = 0; j < nbr_gaussians; j++) {
+      const Img gaussian_next{GaussianBlur(gaussian_prev, kSize, k * sigma)};
+      for (int y = kSize.rows; y < (img.size.rows - kSize.rows); y++) {
+        for (int x = kSize.cols; x < (img.size.cols - kSize.cols); x++) {
+          diff[y][x] = gaussian_prev.data[y * img.size.cols + x] - gaussian_next.data[y * img.size.cols + x];
+          gaussian[y][x] = gaussian_prev.data[y * img.size.cols + x];
+        }
+      }
+      gaussians.emplace_back(gaussian);
+      pyramid.emplace_back(diff);
+      gaussian_prev = gaussian_next;
+    }
+    sigma *= 2.0F;
+  }
+  return pyramid.size() + gaussians.size();
+}
+
+void BenchPyramid(int rows, int cols)
+{
+  const Img im{RecursiveGaussianBlur(RandomImg(rows, cols, 27U), 2.0F)};
+  cout << rows << "x" << cols << " image, 5 octaves, megapixels per second" << endl;
+  const auto print = [](const string& name, double mps) {
+    cout << left << setw(36) << name << right << fixed << setprecision(1) << setw(10) << mps << endl;
+  };
+
+  size_t checksum{0};
+  print("DoG pyramid, full size octaves", MegapixelsPerSecond(im, [&]() { checksum += BaselineDoGPyramid(im, 5, 5); }));
+  print("Pyramid", MegapixelsPerSecond(im, [&]() { checksum += Pyramid{im, 5, 2}.Octaves(); }));
+  print("SIFT", MegapixelsPerSecond(im, [&]() { checksum += feature::SiftKeypoints(im, 5, 5).size(); }));
+  print("SIFT, Canny, corners, separately", MegapixelsPerSecond(im, [&]() {
+          checksum += feature::SiftKeypoints(im, 5, 5).size();
+          checksum += object::ExtractCannyEdges(im).data[0];
+          checksum += feature::Corners(im, 1e6, feature::CornerDetType::kHarris, 0, 0, {Size{11, 11}, 1.6F}).size();
+        }));
+  print("SIFT, Canny, corners, one pyramid", MegapixelsPerSecond(im, [&]() {
+          const Pyramid pyr{im, 5, 2};
+          checksum += feature::SiftKeypoints(pyr).size();
+          checksum += object::ExtractCannyEdges(pyr, 0).data[0];
+          checksum += feature::Corners(pyr, 0, 1e6).size();
+        }));
+  cout << "checksum " << checksum << endl;
+}
+
+void PrintHelp()
+{
+  cout << "Benchmarks: 3x3 convolutions against the per pixel baseline "
+          "<convolve [rows] [cols]>, Gaussian blur with a 2D window, "
+          "separable and recursive <blur [rows] [cols]>, median filters against "
+          "sorting every window <median [rows] [cols]>, filters on row bands "
+          "over 1, 2, 4, ... threads <tile [rows] [cols]>, a chain of filters "
+          "as one image per stage and as a pipeline <pipeline [rows] [cols]>, gray, "
+          "layout and YUV conversions <color [rows] [cols]>, the scale space "
+          "of SIFT and detectors sharing it <pyramid [rows] [cols]>."
+       << endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    PrintHelp();
+    return -1;
+  }
+  const string arg1{argv[1]};
+
+  if (arg1 == "convolve") {
+    // A 4K frame by default.
+    const int rows{argc > 2 ? stoi(argv[2]) : 2160};
+    const int cols{argc > 3 ? stoi(argv[3]) : 3840};
+    BenchConvolve(rows, cols);
+  } else if (arg1 == "blur") {
+    const int rows{argc > 2 ? stoi(argv[2]) : 2160};
+    const int cols{argc > 3 ? stoi(argv[3]) : 3840};
+    BenchBlur(rows, cols);
+  } else if (arg1 == "median") {
+    const int rows{argc > 2 ? stoi(argv[2]) : 2160};
+    const int cols{argc > 3 ? stoi(argv[3]) : 3840};
+    BenchMedian(rows, cols);
+  } else if (arg1 == "tile") {
+    const int rows{argc > 2 ? stoi(argv[2]) : 2160};
+    const int cols{argc > 3 ? stoi(argv[3]) : 3840};
+    BenchTile(rows, cols);
+  } else if (arg1 == "pipeline") {
+    const int rows{argc > 2 ? stoi(argv[2]) : 2160};
+    const int cols{argc > 3 ? stoi(argv[3]) : 3840};
+    BenchPipeline(rows, cols);
+  } else if (arg1 == "color") {
+    const int rows{argc > 2 ? stoi(argv[2]) : 2160};
+    const int cols{argc > 3 ? stoi(argv[3]) : 3840};
+    BenchColor(rows, cols);
+  } else if (arg1 == "pyramid") {
+    const int rows{argc > 2 ? stoi(argv[2]) : 2160};
+    const int cols{argc > 3 ? stoi(argv[3]) : 3840};
+    BenchPyramid(rows, cols);
+  } else {
+    PrintHelp();
+    return -1;
+  }
+  return 0;
+}
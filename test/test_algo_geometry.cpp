@@ -9,6 +9,7 @@
 #include <cmath>
 #include <cstddef>
 #include <limits>
+#include <random>
 #include <stdexcept>
 #include <vector>
 
@@ -107,6 +108,82 @@ TEST(Point, NormalizePointInOrigin) {
   EXPECT_EQ(pt2.Y(), 0);
 }
 
+// /////////////////////////////
+// MARK: PointCloud
+
+TEST(PointCloud, Constructor) {
+  const geo::Points pts{{1, 2}, {3, 4}, {5, 6}};
+  const geo::PointCloud cloud{pts};
+  EXPECT_EQ(cloud.Size(), 3);
+  EXPECT_EQ(cloud.X(1), 3.0);
+  EXPECT_EQ(cloud.Y(2), 6.0);
+  EXPECT_EQ(cloud.At(0), pts.at(0));
+  EXPECT_EQ(cloud.ToPoints(), pts);
+  EXPECT_THROW(geo::PointCloud({1.0, 2.0}, {1.0}), std::invalid_argument);
+}
+
+TEST(PointCloud, Distances) {
+  const geo::PointCloud cloud{{0.0, 3.0, -3.0}, {0.0, 4.0, 0.0}};
+  const std::vector<double> expected{0.0, 5.0, 3.0};
+  EXPECT_EQ(cloud.Distances({0, 0}), expected);
+}
+
+TEST(PointCloud, Orientations) {
+  const geo::PointCloud cloud{{0.5, 0.5, 2.0}, {1.0, -1.0, 0.0}};
+  const std::vector<int> expected{1, -1, 0};
+  EXPECT_EQ(cloud.Orientations({0, 0}, {1, 0}), expected);
+}
+
+TEST(PointCloud, OrientationsNearCollinear) {
+  // A few ulps off the line through (12, 12) and (24, 24), where the naive
+  // determinant is 0.
+  const double e{std::ldexp(1.0, -53)};
+  const geo::PointCloud cloud{{0.5 - 8 * e, 0.5 - 7 * e, 0.5},
+                              {0.5 - 7 * e, 0.5 - 8 * e, 0.5}};
+  const std::vector<int> expected{1, -1, 0};
+  EXPECT_EQ(cloud.Orientations({12, 12}, {24, 24}), expected);
+}
+
+TEST(PointCloud, BoundingRectangle) {
+  const geo::PointCloud cloud{geo::Points{{-2, 1}, {3, -4}, {1, 5}}};
+  auto rect = cloud.BoundingRectangle();
+  EXPECT_EQ(rect.GetPoint(), geo::Point(-2, -4));
+  EXPECT_EQ(rect.GetWidth(), 5.0);
+  EXPECT_EQ(rect.GetHeight(), 9.0);
+  EXPECT_THROW(geo::PointCloud{}.BoundingRectangle(), std::invalid_argument);
+}
+
+TEST(PointCloud, Centroid) {
+  const geo::PointCloud cloud{geo::Points{{0, 0}, {4, 0}, {4, 2}, {0, 2}}};
+  EXPECT_EQ(cloud.Centroid(), geo::Point(2, 1));
+  EXPECT_THROW(geo::PointCloud{}.Centroid(), std::invalid_argument);
+}
+
+TEST(PointCloud, Rotate) {
+  const geo::PointCloud cloud{geo::Points{{2, 1}, {1, 2}}};
+  auto rotated = cloud.Rotate(kPi / 2.0, {1, 1});
+  const double thr{0.0001};
+  EXPECT_NEAR(rotated.X(0), 1.0, thr);
+  EXPECT_NEAR(rotated.Y(0), 2.0, thr);
+  EXPECT_NEAR(rotated.X(1), 0.0, thr);
+  EXPECT_NEAR(rotated.Y(1), 1.0, thr);
+}
+
+TEST(PointCloud, ConsumedByPolygonAndGrid) {
+  geo::PointCloud cloud{{1.0, -1.0, -1.0, 1.0}, {1.0, 1.0, -1.0, -1.0}};
+  const double* xs{cloud.Xs().data()};
+  const geo::Polygon polygon{std::move(cloud)};
+  EXPECT_EQ(polygon.GetCloud().Xs().data(), xs);
+  EXPECT_EQ(polygon.Area(), 4.0);
+  EXPECT_EQ(polygon.BoundingRectangle().Area(), 4.0);
+
+  geo::PointCloud grid_cloud{polygon.GetCloud()};
+  const double* ys{grid_cloud.Ys().data()};
+  const geo::Grid grid{std::move(grid_cloud)};
+  EXPECT_EQ(grid.GetCloud().Ys().data(), ys);
+  EXPECT_EQ(grid.ConvexHull().GetPoints().size(), 4);
+}
+
 // /////////////////////////////
 // MARK: Edge
 
@@ -160,6 +237,16 @@ TEST(Edge, IntersectE) {
   EXPECT_FALSE(e1.Intersect(e2));
 }
 
+TEST(Edge, IntersectNearlyCollinear) {
+  // e2 starts a tiny bit to the left of e1 and crosses it, the naive
+  // orientation test rounds the start point onto e1.
+  const geo::Edge e1{{0.1, 0.3}, {0.7, 2.1}};
+  const geo::Point start{0.4, 3 * 0.4};
+  const geo::Edge e2{start, {start.X() + 0.5, start.Y() - 1.0}};
+  EXPECT_TRUE(e1.Intersect(e2));
+  EXPECT_EQ(e1.Location(start), 1);
+}
+
 TEST(Edge, IntersectF) {
   // Parallel
   const geo::Edge e1{{0, 0}, {4, 0}};
@@ -235,6 +322,15 @@ TEST(Circle, Area) {
   EXPECT_NEAR(circle.Area(), 5 * 5 * kPi, 0.001);
 }
 
+TEST(Circle, IsInsideExact) {
+  // Just outside, the rounded distance says on the circle.
+  const geo::Circle circle{{0.1, 0.1}, 0.5};
+  EXPECT_FALSE(circle.IsInside({0.4, 0.5}));
+  EXPECT_TRUE(circle.IsInside({std::nextafter(0.4, 0.0), 0.5}));
+  EXPECT_TRUE(circle.IsInside({0.1, 0.6}));
+  EXPECT_FALSE(circle.IsInside({0.1, std::nextafter(0.6, 1.0)}));
+}
+
 TEST(Circle, IsInside) {
   const geo::Circle circle{{0, 0}, 1};  // Unit circle
   EXPECT_TRUE(circle.IsInside({0, 0}));
@@ -319,6 +415,15 @@ TEST(Polygon, BoundingRectangleB) {
   EXPECT_EQ(rect.Area(), 4.0);
 }
 
+TEST(Polygon, BoundingRectangleNegative) {
+  const geo::Points pts{{-3, -3}, {-1, -3}, {-1, -2}, {-3, -2}};
+  const geo::Polygon polygon{pts};
+  auto rect = polygon.BoundingRectangle();
+  EXPECT_EQ(rect.GetPoint(), geo::Point(-3, -3));
+  EXPECT_EQ(rect.GetWidth(), 2.0);
+  EXPECT_EQ(rect.GetHeight(), 1.0);
+}
+
 TEST(Polygon, Rotate) {
   const geo::Points pts{{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
   const geo::Polygon pn1{pts};
@@ -404,6 +509,17 @@ TEST(Triangle, IsInside) {
   EXPECT_FALSE(triangle.IsInside({4, 4}));
 }
 
+TEST(Triangle, IsInsideBoundary) {
+  // The points are on the hypotenuse y = x, which the old area comparison
+  // got wrong because of roundoff.
+  const geo::Triangle triangle{{0, 0}, {3, 0}, {3, 3}};
+  for (int i = 1; i < 30; i++) {
+    const double t{i * 0.1};
+    EXPECT_TRUE(triangle.IsInside({t, t}));
+    EXPECT_FALSE(triangle.IsInside({t, std::nextafter(t, 4.0)}));
+  }
+}
+
 TEST(Triangle, HasEdgeA) {
   const geo::Triangle triangle{{0, 0}, {1, 0}, {1, 1}};
   const geo::Edge e1{{0, 0}, {1, 0}};
@@ -604,6 +720,16 @@ TEST(Grid, ConvexHullFailB) {
   EXPECT_THROW(grid.ConvexHull(), std::invalid_argument);
 }
 
+// The hull polygon checks that it is counter clockwise on three nearly
+// collinear corners.
+TEST(Grid, ConvexHullNearCollinear) {
+  const double e{std::ldexp(1.0, -53)};
+  const geo::Grid grid{
+      {{0.5 - 8 * e, 0.5 - 7 * e}, {12, 12}, {24, 24}, {-100, 50}}};
+  EXPECT_NO_THROW(grid.ConvexHull());
+  EXPECT_EQ(grid.ConvexHull().GetPoints().size(), 4);
+}
+
 namespace {
 
 // const auto kXComp = [](auto p1, auto p2) { return p1.X() < p2.X(); };
@@ -738,6 +864,98 @@ TEST(Grid, MinEnclosingCircleFivePoints) {
   EXPECT_EQ(circle.Origin().Y(), 1);
 }
 
+TEST(Grid, MinEnclosingCircleBruteForce) {
+  // The smallest circle over two or three of the points that contains all.
+  std::mt19937 gen{5};
+  std::uniform_real_distribution<double> dist{-10.0, 10.0};
+  geo::Points pts;
+  for (size_t i = 0; i < 25; i++) {
+    pts.emplace_back(dist(gen), dist(gen));
+  }
+  const auto contains_all = [&pts](double x, double y, double r) {
+    return std::all_of(pts.begin(), pts.end(), [&](const geo::Point& p) {
+      return p.Dist({x, y}) <= r * (1.0 + 1e-9);
+    });
+  };
+  double best{std::numeric_limits<double>::max()};
+  for (size_t i = 0; i < pts.size(); i++) {
+    for (size_t j = i + 1; j < pts.size(); j++) {
+      const geo::Point& p{pts[i]};
+      const geo::Point& q{pts[j]};
+      const double r{p.Dist(q) / 2.0};
+      if (contains_all((p.X() + q.X()) / 2.0, (p.Y() + q.Y()) / 2.0, r)) {
+        best = std::min(best, r);
+      }
+      for (size_t k = j + 1; k < pts.size(); k++) {
+        const geo::Point b{q - p};
+        const geo::Point c{pts[k] - p};
+        const double d{2.0 * (b.X() * c.Y() - b.Y() * c.X())};
+        const double bb{b.X() * b.X() + b.Y() * b.Y()};
+        const double cc{c.X() * c.X() + c.Y() * c.Y()};
+        const double x{(c.Y() * bb - b.Y() * cc) / d};
+        const double y{(b.X() * cc - c.X() * bb) / d};
+        const double r3{std::sqrt(x * x + y * y)};
+        if (contains_all(p.X() + x, p.Y() + y, r3)) {
+          best = std::min(best, r3);
+        }
+      }
+    }
+  }
+
+  const geo::Grid grid{pts};
+  const auto circle = grid.MinEnclosingCircle();
+  EXPECT_NEAR(circle.Radius(), best, 1e-9);
+  EXPECT_TRUE(contains_all(circle.Origin().X(), circle.Origin().Y(),
+                           circle.Radius()));
+}
+
+TEST(Grid, MinEnclosingCircleManyPoints) {
+  // Deep enough to overflow the stack of a recursive Welzl.
+  geo::PointCloud cloud;
+  const size_t n{1000000};
+  for (size_t i = 0; i < n; i++) {
+    const double angle{2.0 * kPi * static_cast<double>(i) / n};
+    const double r{static_cast<double>(i % 7) / 6.0};
+    cloud.PushBack(3.0 + r * std::cos(angle), -1.0 + r * std::sin(angle));
+  }
+  const geo::Grid grid{std::move(cloud)};
+  const auto circle = grid.MinEnclosingCircle();
+  EXPECT_NEAR(circle.Radius(), 1.0, 1e-6);
+  EXPECT_NEAR(circle.Origin().X(), 3.0, 1e-6);
+  EXPECT_NEAR(circle.Origin().Y(), -1.0, 1e-6);
+}
+
+TEST(MinEnclosingCircles, Groups) {
+  const geo::PointCloud cloud{geo::Points{
+      {0, 0}, {10, 10}, {2, 0}, {12, 10}, {5, 5}, {1, 1}, {11, 12}}};
+  const std::vector<int> labels{0, 2, 0, 2, -1, 0, 2};
+  const auto circles = geo::MinEnclosingCircles(cloud, labels);
+  ASSERT_EQ(circles.size(), 3);
+
+  EXPECT_DOUBLE_EQ(circles[0].Radius(), 1.0);
+  EXPECT_DOUBLE_EQ(circles[0].Origin().X(), 1.0);
+  EXPECT_DOUBLE_EQ(circles[0].Origin().Y(), 0.0);
+  EXPECT_EQ(circles[1].Radius(), 0.0);
+  const auto circle2 = geo::Grid{geo::Points{{10, 10}, {12, 10}, {11, 12}}}
+                           .MinEnclosingCircle();
+  EXPECT_DOUBLE_EQ(circles[2].Radius(), circle2.Radius());
+
+  EXPECT_TRUE(geo::MinEnclosingCircles(geo::PointCloud{}, {}).empty());
+  EXPECT_THROW(geo::MinEnclosingCircles(cloud, {0, 1}),
+               std::invalid_argument);
+
+  // Labels are bounded by the number of points, a large one is not a size.
+  EXPECT_THROW(geo::MinEnclosingCircles(cloud, {0, 0, 0, 0, 0, 0, 7}),
+               std::invalid_argument);
+  EXPECT_THROW(
+      geo::MinEnclosingCircles(
+          cloud, {0, 0, 0, 0, 0, 0, std::numeric_limits<int>::max()}),
+      std::invalid_argument);
+  EXPECT_EQ(geo::MinEnclosingCircles(cloud, {0, 0, 0, 0, 0, 0, 6}).size(), 7);
+  EXPECT_TRUE(
+      geo::MinEnclosingCircles(cloud, {-1, -1, -1, -1, -1, -1, -1}).empty());
+}
+
 // /////////////////////////////
 // MARK: Triangulate
 
@@ -751,6 +969,15 @@ TEST(Grid, TriangulateSimple) {
   EXPECT_EQ(lines.size(), 5);
 }
 
+TEST(Grid, TriangulateEdgeCount) {
+  // 3n - 3 - h edges, h = 5 points on the hull.
+  const geo::Points points{{2, 3}, {5, 8}, {9, 1}, {4, 6}, {7, 4},
+                           {1, 9}, {6, 2}, {3, 5}, {8, 7}, {5, 5}};
+  EXPECT_EQ(geo::Grid{points}.Triangulation().size(), 22);
+  const geo::Points one{{1, 1}};
+  EXPECT_TRUE(geo::Grid{one}.Triangulation().empty());
+}
+
 // /////////////////////////////
 // MARK: DelaunayTriangulation
 
@@ -785,9 +1012,11 @@ TEST(Grid, DelaunayTriangulationA) {
                            {0.7021881308033912, 0.6105661712668082},
                            {0.5817400080742834, 0.745314932767162}};
 
+  // A triangulation of n points with h points on the hull has 3n - 3 - h
+  // edges, here h = 8.
   const geo::Grid grid{points};
   auto de_tri = grid.DelaunayTriangulation();
-  EXPECT_EQ(de_tri.size(), 33);
+  EXPECT_EQ(de_tri.size(), 34);
 }
 
 TEST(Grid, DelaunayTriangulationB) {
@@ -795,5 +1024,5 @@ TEST(Grid, DelaunayTriangulationB) {
                            {1, 9}, {6, 2}, {3, 5}, {8, 7}, {5, 5}};
   const geo::Grid grid{points};
   auto de_tri = grid.DelaunayTriangulation();
-  EXPECT_EQ(de_tri.size(), 21);
+  EXPECT_EQ(de_tri.size(), 22);  // h = 5
 }
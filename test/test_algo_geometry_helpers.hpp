@@ -0,0 +1,35 @@
+///
+/// \brief Random point clouds shared by the geometry unit tests.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#ifndef ALGO_TEST_TEST_ALGO_GEOMETRY_HELPERS_HPP_
+#define ALGO_TEST_TEST_ALGO_GEOMETRY_HELPERS_HPP_
+
+#include <cstddef>
+#include <random>
+
+#include "include/algo_geometry.hpp"
+
+namespace algo_test {
+
+/// n points with both coordinates drawn from dist, e.g. a
+/// std::uniform_real_distribution<double>, the same ones for the same seed.
+template <typename Distribution>
+algo::geometry::PointCloud RandomCloud(size_t n, unsigned seed,
+                                       Distribution dist) {
+  std::mt19937 gen{seed};
+  algo::geometry::PointCloud cloud;
+  cloud.Reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    const double x{dist(gen)};
+    cloud.PushBack(x, dist(gen));
+  }
+  return cloud;
+}
+
+}  // namespace algo_test
+
+#endif  // ALGO_TEST_TEST_ALGO_GEOMETRY_HELPERS_HPP_
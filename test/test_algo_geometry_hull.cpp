@@ -0,0 +1,233 @@
+///
+/// \brief Unit tests for convex hull algorithms.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_geometry.hpp"
+#include "include/algo_geometry_hull.hpp"
+#include "test_algo_geometry_helpers.hpp"
+
+namespace {
+namespace geo = algo::geometry;
+namespace pred = algo::geometry::predicates;
+using algo_test::RandomCloud;
+
+// The coordinates of the random clouds.
+const std::normal_distribution<double> kCoords{0.0, 10.0};
+
+/// Checks that the hull is strictly convex, counter clockwise and that no
+/// point is outside of it.
+void ExpectHull(const geo::PointCloud& hull, const geo::PointCloud& cloud) {
+  const size_t h{hull.Size()};
+  ASSERT_GE(h, 3);
+  for (size_t i = 0; i < h; i++) {
+    const geo::Point a{hull.At(i)};
+    const geo::Point b{hull.At((i + 1) % h)};
+    EXPECT_GT(pred::Orient2D(a, b, hull.At((i + 2) % h)), 0.0);
+    for (size_t j = 0; j < cloud.Size(); j++) {
+      EXPECT_GE(pred::Orient2D(a, b, cloud.At(j)), 0.0);
+    }
+  }
+}
+
+void ExpectEqual(const geo::PointCloud& a, const geo::PointCloud& b) {
+  EXPECT_EQ(a.Xs(), b.Xs());
+  EXPECT_EQ(a.Ys(), b.Ys());
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: MonotoneChain
+
+TEST(MonotoneChain, Square) {
+  // Sorted, with an inner point, points on the edges and duplicates.
+  const geo::PointCloud sorted{geo::Points{
+      {0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 1}, {2, 0}, {2, 2}, {2, 2}}};
+  const auto hull = geo::MonotoneChain(sorted);
+  ExpectEqual(hull,
+              geo::PointCloud{geo::Points{{0, 0}, {2, 0}, {2, 2}, {0, 2}}});
+}
+
+TEST(MonotoneChain, StartsAtLowestPoint) {
+  const geo::PointCloud sorted{geo::Points{{0, 1}, {1, 0}, {2, 2}}};
+  ExpectEqual(geo::MonotoneChain(sorted),
+              geo::PointCloud{geo::Points{{1, 0}, {2, 2}, {0, 1}}});
+}
+
+TEST(MonotoneChain, Degenerate) {
+  EXPECT_TRUE(geo::MonotoneChain(geo::PointCloud{}).Empty());
+  EXPECT_EQ(geo::MonotoneChain(geo::PointCloud{geo::Points{{1, 1}, {1, 1}}})
+                .Size(),
+            1);
+  const auto line = geo::MonotoneChain(
+      geo::PointCloud{geo::Points{{0, 0}, {1, 1}, {2, 2}, {3, 3}}});
+  ExpectEqual(line, geo::PointCloud{geo::Points{{0, 0}, {3, 3}}});
+}
+
+TEST(MonotoneChain, NotSorted) {
+  const geo::PointCloud unsorted{geo::Points{{1, 0}, {0, 0}}};
+  EXPECT_THROW(geo::MonotoneChain(unsorted), std::invalid_argument);
+}
+
+// /////////////////////////////
+// MARK: ConvexHull
+
+TEST(ConvexHull, Random) {
+  const auto cloud = RandomCloud(2000, 3, kCoords);
+  ExpectHull(geo::ConvexHull(cloud), cloud);
+}
+
+TEST(ConvexHull, Circle) {
+  // All points are corners.
+  geo::PointCloud cloud;
+  const size_t n{360};
+  for (size_t i = 0; i < n; i++) {
+    const double angle{2.0 * M_PI * static_cast<double>(i) / n};
+    cloud.PushBack(std::cos(angle), std::sin(angle));
+  }
+  const auto hull = geo::ConvexHull(cloud);
+  EXPECT_EQ(hull.Size(), n);
+  ExpectHull(hull, cloud);
+}
+
+TEST(ConvexHull, Threads) {
+  const auto cloud = RandomCloud(300000, 5, kCoords);
+  const auto hull = geo::ConvexHull(cloud, 1);
+  for (const size_t threads : {0, 2, 4, 7}) {
+    ExpectEqual(geo::ConvexHull(cloud, threads), hull);
+  }
+}
+
+// /////////////////////////////
+// MARK: RotatingCalipers
+
+TEST(RotatingCalipers, BruteForce) {
+  for (unsigned seed = 0; seed < 30; seed++) {
+    const auto hull =
+        geo::ConvexHull(RandomCloud(20 + seed * 11, seed, kCoords));
+    const size_t h{hull.Size()};
+
+    // Every edge as the base of a box, measured directly.
+    double area{INFINITY};
+    double perimeter{INFINITY};
+    double width{INFINITY};
+    double diameter{0.0};
+    for (size_t i = 0; i < h; i++) {
+      const geo::Point p{hull.At(i)};
+      const geo::Point q{hull.At((i + 1) % h)};
+      const double len{p.Dist(q)};
+      const double ux{(q.X() - p.X()) / len};
+      const double uy{(q.Y() - p.Y()) / len};
+      double lo{0.0};
+      double hi{0.0};
+      double height{0.0};
+      for (size_t j = 0; j < h; j++) {
+        const double dx{hull.X(j) - p.X()};
+        const double dy{hull.Y(j) - p.Y()};
+        lo = std::min(lo, dx * ux + dy * uy);
+        hi = std::max(hi, dx * ux + dy * uy);
+        height = std::max(height, ux * dy - uy * dx);
+        diameter = std::max(diameter, hull.At(i).Dist(hull.At(j)));
+      }
+      area = std::min(area, (hi - lo) * height);
+      perimeter = std::min(perimeter, 2.0 * (hi - lo + height));
+      width = std::min(width, height);
+    }
+
+    const auto metrics = geo::RotatingCalipers(hull);
+    EXPECT_NEAR(metrics.min_area_box.length * metrics.min_area_box.height,
+                area, 1e-9 * area);
+    EXPECT_NEAR(
+        2.0 * (metrics.min_perimeter_box.length +
+               metrics.min_perimeter_box.height),
+        perimeter, 1e-9 * perimeter);
+    EXPECT_NEAR(metrics.diameter, diameter, 1e-12 * diameter);
+    EXPECT_NEAR(metrics.width, width, 1e-12 * diameter);
+
+    // The hull is inside the boxes.
+    for (const auto& box : {metrics.min_area_box, metrics.min_perimeter_box}) {
+      for (size_t c = 0; c < 4; c++) {
+        const auto& a = box.corners[c];
+        const auto& b = box.corners[(c + 1) % 4];
+        for (size_t j = 0; j < h; j++) {
+          EXPECT_GE(pred::Orient2D(a, b, hull.At(j)), -1e-9 * diameter);
+        }
+      }
+    }
+  }
+}
+
+TEST(RotatingCalipers, Rectangle) {
+  // A 4 x 1 rectangle turned 30 degrees.
+  const double c{std::cos(M_PI / 6.0)};
+  const double s{std::sin(M_PI / 6.0)};
+  geo::PointCloud cloud;
+  for (const auto& [x, y] : std::vector<std::pair<double, double>>{
+           {0, 0}, {4, 0}, {4, 1}, {0, 1}, {2, 0.5}, {1, 0}}) {
+    cloud.PushBack(c * x - s * y, s * x + c * y);
+  }
+  const auto metrics = geo::RotatingCalipers(geo::ConvexHull(cloud));
+  EXPECT_NEAR(metrics.min_area_box.length * metrics.min_area_box.height, 4.0,
+              1e-12);
+  EXPECT_NEAR(metrics.diameter, std::sqrt(17.0), 1e-12);
+  EXPECT_NEAR(metrics.width, 1.0, 1e-12);
+
+  const geo::Grid grid{cloud};
+  EXPECT_NEAR(grid.MinBoundingBox().Area(), 4.0, 1e-12);
+}
+
+TEST(RotatingCalipers, Degenerate) {
+  const auto point = geo::RotatingCalipers(geo::PointCloud{geo::Points{{1, 2}}});
+  EXPECT_EQ(point.diameter, 0.0);
+  EXPECT_EQ(point.min_area_box.corners[2], (geo::Point{1, 2}));
+
+  const auto segment =
+      geo::RotatingCalipers(geo::PointCloud{geo::Points{{0, 0}, {3, 4}}});
+  EXPECT_EQ(segment.diameter, 5.0);
+  EXPECT_EQ(segment.width, 0.0);
+  EXPECT_EQ(segment.min_perimeter_box.length, 5.0);
+
+  EXPECT_THROW(geo::RotatingCalipers(geo::PointCloud{}), std::invalid_argument);
+}
+
+// /////////////////////////////
+// MARK: StreamingHull
+
+TEST(StreamingHull, Chunks) {
+  const auto cloud = RandomCloud(20000, 7, kCoords);
+  geo::StreamingHull stream;
+  EXPECT_TRUE(stream.Hull().Empty());
+
+  for (size_t first = 0; first < cloud.Size(); first += 997) {
+    geo::PointCloud chunk;
+    for (size_t i = first; i < std::min(first + 997, cloud.Size()); i++) {
+      chunk.PushBack(cloud.At(i));
+    }
+    stream.Add(chunk);
+  }
+  EXPECT_EQ(stream.Count(), cloud.Size());
+  ExpectEqual(stream.Hull(), geo::ConvexHull(cloud));
+
+  // A single point outside grows the hull.
+  stream.Add(geo::Point{1000, 1000});
+  const auto hull = stream.Hull();
+  EXPECT_EQ(stream.Count(), cloud.Size() + 1);
+  ExpectHull(hull, cloud);
+  bool found{false};
+  for (size_t i = 0; i < hull.Size(); i++) {
+    found = found || hull.At(i) == geo::Point{1000, 1000};
+  }
+  EXPECT_TRUE(found);
+}
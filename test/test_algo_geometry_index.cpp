@@ -0,0 +1,345 @@
+///
+/// \brief Unit tests for spatial indexes.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_geometry.hpp"
+#include "include/algo_geometry_index.hpp"
+#include "test_algo_geometry_helpers.hpp"
+
+namespace {
+namespace geo = algo::geometry;
+using algo_test::RandomCloud;
+
+// The coordinates of the random clouds.
+const std::uniform_real_distribution<double> kCoords{-100.0, 100.0};
+
+/// \brief All indices sorted by distance to pt, by brute force.
+std::vector<size_t> SortedByDistance(const geo::PointCloud& cloud,
+                                     const geo::Point& pt) {
+  std::vector<size_t> ids(cloud.Size());
+  for (size_t i = 0; i < ids.size(); i++) {
+    ids[i] = i;
+  }
+  const std::vector<double> dists{cloud.Distances(pt)};
+  std::stable_sort(ids.begin(), ids.end(),
+                   [&](size_t a, size_t b) { return dists[a] < dists[b]; });
+  return ids;
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: KdTree
+
+TEST(KdTree, Empty) {
+  const geo::KdTree tree{geo::PointCloud{}};
+  EXPECT_EQ(tree.Size(), 0);
+  EXPECT_EQ(tree.Nearest({0, 0}), geo::KdTree::kNone);
+  EXPECT_TRUE(tree.KNearest({0, 0}, 3).empty());
+  EXPECT_TRUE(tree.Radius({0, 0}, 10).empty());
+  EXPECT_TRUE(tree.Range(geo::Rectangle{{0, 0}, 1, 1}).empty());
+}
+
+TEST(KdTree, Small) {
+  const geo::PointCloud cloud{geo::Points{{0, 0}, {5, 5}, {2, 1}, {-3, 4}}};
+  const geo::KdTree tree{cloud};
+  EXPECT_EQ(tree.Nearest({4, 4}), 1);
+  EXPECT_EQ(tree.Nearest({-10, 10}), 3);
+  EXPECT_EQ(tree.KNearest({0, 0}, 2), (std::vector<size_t>{0, 2}));
+  EXPECT_EQ(tree.KNearest({0, 0}, 10).size(), 4);
+}
+
+TEST(KdTree, Nearest) {
+  const geo::PointCloud cloud{RandomCloud(5000, 1, kCoords)};
+  const geo::KdTree tree{cloud, 4};
+  const geo::PointCloud queries{RandomCloud(200, 2, kCoords)};
+
+  for (size_t q = 0; q < queries.Size(); q++) {
+    const geo::Point pt{queries.At(q)};
+    const size_t nearest{tree.Nearest(pt)};
+    EXPECT_EQ(cloud.At(nearest).Dist(pt),
+              cloud.At(SortedByDistance(cloud, pt).front()).Dist(pt));
+  }
+}
+
+TEST(KdTree, KNearest) {
+  const geo::PointCloud cloud{RandomCloud(3000, 3, kCoords)};
+  const geo::KdTree tree{cloud};
+  const geo::PointCloud queries{RandomCloud(50, 4, kCoords)};
+
+  for (size_t q = 0; q < queries.Size(); q++) {
+    const geo::Point pt{queries.At(q)};
+    const auto knn = tree.KNearest(pt, 10);
+    const auto expected = SortedByDistance(cloud, pt);
+    ASSERT_EQ(knn.size(), 10);
+    for (size_t i = 0; i < knn.size(); i++) {
+      EXPECT_EQ(cloud.At(knn[i]).Dist(pt), cloud.At(expected[i]).Dist(pt));
+    }
+  }
+}
+
+TEST(KdTree, Radius) {
+  const geo::PointCloud cloud{RandomCloud(3000, 5, kCoords)};
+  const geo::KdTree tree{cloud};
+  const geo::Point pt{10, -20};
+  auto found = tree.Radius(pt, 15);
+  std::sort(found.begin(), found.end());
+
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < cloud.Size(); i++) {
+    const double dx{cloud.X(i) - pt.X()};
+    const double dy{cloud.Y(i) - pt.Y()};
+    if (dx * dx + dy * dy <= 15.0 * 15.0) {
+      expected.emplace_back(i);
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(found, expected);
+}
+
+TEST(KdTree, Range) {
+  const geo::PointCloud cloud{RandomCloud(3000, 6, kCoords)};
+  const geo::KdTree tree{cloud};
+  // Negative width and height, the corner is the top right.
+  const geo::Rectangle rect{{40, 30}, -25, -50};
+  auto found = tree.Range(rect);
+  std::sort(found.begin(), found.end());
+
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < cloud.Size(); i++) {
+    if (cloud.X(i) >= 15 && cloud.X(i) <= 40 && cloud.Y(i) >= -20 &&
+        cloud.Y(i) <= 30) {
+      expected.emplace_back(i);
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(found, expected);
+}
+
+TEST(KdTree, RangeBoundary) {
+  geo::PointCloud cloud;
+  for (int x = 0; x < 10; x++) {
+    for (int y = 0; y < 10; y++) {
+      cloud.PushBack(x, y);
+    }
+  }
+  const geo::KdTree tree{cloud};
+  EXPECT_EQ(tree.Range(geo::Rectangle{{2, 3}, 2, 1}).size(), 6);
+  EXPECT_EQ(tree.Radius({5, 5}, 1).size(), 5);
+}
+
+TEST(KdTree, Duplicates) {
+  geo::PointCloud cloud;
+  for (size_t i = 0; i < 100; i++) {
+    cloud.PushBack(1, 1);
+  }
+  cloud.PushBack(2, 2);
+  const geo::KdTree tree{cloud};
+  EXPECT_EQ(tree.Nearest({3, 3}), 100);
+  EXPECT_EQ(tree.Radius({1, 1}, 0).size(), 100);
+  EXPECT_EQ(tree.KNearest({3, 3}, 3).front(), 100);
+}
+
+TEST(KdTree, Batched) {
+  const geo::PointCloud cloud{RandomCloud(20000, 7, kCoords)};
+  const geo::PointCloud queries{RandomCloud(1000, 8, kCoords)};
+  // Parallel and sequential builds give the same tree.
+  const geo::KdTree tree{cloud, 4};
+  const geo::KdTree sequential{cloud, 1};
+
+  const auto nearest = tree.Nearest(queries, 4);
+  const auto knn = tree.KNearest(queries, 5, 3);
+  ASSERT_EQ(nearest.size(), queries.Size());
+  ASSERT_EQ(knn.size(), queries.Size());
+  for (size_t q = 0; q < queries.Size(); q++) {
+    EXPECT_EQ(nearest[q], sequential.Nearest(queries.At(q)));
+    EXPECT_EQ(knn[q], sequential.KNearest(queries.At(q), 5));
+  }
+}
+
+// /////////////////////////////
+// MARK: RTree
+
+namespace {
+
+/// \brief Random small triangles, the bounding rectangles are returned in
+/// boxes as {x_min, y_min, x_max, y_max}.
+std::vector<geo::Polygon> RandomTriangles(
+    size_t n, unsigned seed, std::vector<std::vector<double>>& boxes) {
+  std::mt19937 gen{seed};
+  std::uniform_real_distribution<double> pos{-100.0, 100.0};
+  std::uniform_real_distribution<double> size{0.1, 5.0};
+  std::vector<geo::Polygon> polygons;
+  for (size_t i = 0; i < n; i++) {
+    const double x{pos(gen)};
+    const double y{pos(gen)};
+    const double w{size(gen)};
+    const double h{size(gen)};
+    polygons.emplace_back(
+        geo::Points{{x, y}, {x + w, y}, {x + w / 2.0, y + h}});
+    boxes.push_back({x, y, x + w, y + h});
+  }
+  return polygons;
+}
+
+std::vector<size_t> Sorted(std::vector<size_t> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+/// \brief Ids of the boxes that overlap the window, by brute force.
+std::vector<size_t> Overlapping(const std::vector<std::vector<double>>& boxes,
+                                const std::vector<bool>& present,
+                                double x_min, double y_min, double x_max,
+                                double y_max) {
+  std::vector<size_t> ids;
+  for (size_t i = 0; i < boxes.size(); i++) {
+    const auto& b = boxes[i];
+    if (present[i] && b[0] <= x_max && x_min <= b[2] && b[1] <= y_max &&
+        y_min <= b[3]) {
+      ids.emplace_back(i);
+    }
+  }
+  return ids;
+}
+
+double SegmentDist(const geo::Edge& edge, const geo::Point& pt) {
+  const geo::Point a{edge.GetStart()};
+  const geo::Point d{edge.GetEnd() - a};
+  const double len2{d.X() * d.X() + d.Y() * d.Y()};
+  double t{((pt.X() - a.X()) * d.X() + (pt.Y() - a.Y()) * d.Y()) / len2};
+  t = std::max(0.0, std::min(1.0, t));
+  return pt.Dist({a.X() + t * d.X(), a.Y() + t * d.Y()});
+}
+
+}  // namespace
+
+TEST(RTree, Empty) {
+  const geo::RTree tree;
+  EXPECT_EQ(tree.Size(), 0);
+  EXPECT_EQ(tree.Height(), 1);
+  EXPECT_TRUE(tree.Search(geo::Rectangle{{0, 0}, 1, 1}).empty());
+  EXPECT_TRUE(tree.Contains({0, 0}).empty());
+  EXPECT_TRUE(tree.Nearest({0, 0}, 3).empty());
+  const geo::RTree edges{std::vector<geo::Edge>{}};
+  EXPECT_TRUE(edges.Search(geo::Rectangle{{0, 0}, 1, 1}).empty());
+}
+
+TEST(RTree, BulkLoad) {
+  std::vector<std::vector<double>> boxes;
+  const auto polygons = RandomTriangles(2000, 1, boxes);
+  const geo::RTree tree{polygons};
+  const std::vector<bool> present(boxes.size(), true);
+  EXPECT_EQ(tree.Size(), 2000);
+  EXPECT_GT(tree.Height(), 1);
+
+  EXPECT_EQ(Sorted(tree.Search(geo::Rectangle{{-20, 10}, 30, 15})),
+            Overlapping(boxes, present, -20, 10, 10, 25));
+  for (double x = -90; x < 90; x += 17) {
+    EXPECT_EQ(Sorted(tree.Contains({x, -x / 2})),
+              Overlapping(boxes, present, x, -x / 2, x, -x / 2));
+  }
+}
+
+TEST(RTree, InsertRemove) {
+  std::vector<std::vector<double>> boxes;
+  const auto polygons = RandomTriangles(1500, 2, boxes);
+  geo::RTree tree;
+  std::vector<bool> present(boxes.size(), true);
+  for (size_t i = 0; i < polygons.size(); i++) {
+    tree.Insert(i, polygons[i]);
+  }
+  EXPECT_EQ(tree.Size(), 1500);
+  EXPECT_EQ(Sorted(tree.Search(geo::Rectangle{{-50, -50}, 40, 70})),
+            Overlapping(boxes, present, -50, -50, -10, 20));
+
+  for (size_t i = 0; i < polygons.size(); i += 2) {
+    EXPECT_TRUE(tree.Remove(i, polygons[i]));
+    present[i] = false;
+  }
+  EXPECT_FALSE(tree.Remove(0, polygons[0]));
+  EXPECT_FALSE(tree.Remove(1, polygons[3]));
+  EXPECT_EQ(tree.Size(), 750);
+  EXPECT_EQ(Sorted(tree.Search(geo::Rectangle{{-50, -50}, 40, 70})),
+            Overlapping(boxes, present, -50, -50, -10, 20));
+  EXPECT_EQ(Sorted(tree.Search(geo::Rectangle{{-100, -100}, 200, 200})),
+            Overlapping(boxes, present, -100, -100, 100, 100));
+
+  for (size_t i = 1; i < polygons.size(); i += 2) {
+    EXPECT_TRUE(tree.Remove(i, polygons[i]));
+  }
+  EXPECT_EQ(tree.Size(), 0);
+  EXPECT_EQ(tree.Height(), 1);
+  EXPECT_TRUE(tree.Contains(polygons[1].GetPoints().front()).empty());
+}
+
+TEST(RTree, Nearest) {
+  std::vector<std::vector<double>> boxes;
+  const auto polygons = RandomTriangles(1000, 3, boxes);
+  const geo::RTree tree{polygons};
+  const geo::Point pt{3, -7};
+
+  const auto nearest = tree.Nearest(pt, 5);
+  ASSERT_EQ(nearest.size(), 5);
+  std::vector<double> dists;
+  for (const auto& b : boxes) {
+    const double dx{std::max({b[0] - pt.X(), 0.0, pt.X() - b[2]})};
+    const double dy{std::max({b[1] - pt.Y(), 0.0, pt.Y() - b[3]})};
+    dists.emplace_back(std::sqrt(dx * dx + dy * dy));
+  }
+  std::vector<double> expected{dists};
+  std::sort(expected.begin(), expected.end());
+  for (size_t i = 0; i < nearest.size(); i++) {
+    EXPECT_EQ(dists[nearest[i]], expected[i]);
+  }
+}
+
+TEST(RTree, Edges) {
+  std::mt19937 gen{4};
+  std::uniform_real_distribution<double> pos{-100.0, 100.0};
+  std::vector<geo::Edge> edges;
+  for (size_t i = 0; i < 1000; i++) {
+    const double x{pos(gen)};
+    const double y{pos(gen)};
+    // Horizontal and vertical edges have flat bounding rectangles.
+    if (i % 3 == 0) {
+      edges.emplace_back(geo::Point{x, y}, geo::Point{x + 4, y});
+    } else if (i % 3 == 1) {
+      edges.emplace_back(geo::Point{x, y}, geo::Point{x, y - 4});
+    } else {
+      edges.emplace_back(geo::Point{x, y}, geo::Point{x - 3, y + 2});
+    }
+  }
+  geo::RTree tree{edges};
+  const geo::Point pt{10, 10};
+  const auto distance = [&](size_t id) { return SegmentDist(edges[id], pt); };
+
+  const auto nearest = tree.Nearest(pt, 3, distance);
+  std::vector<double> expected;
+  for (const auto& edge : edges) {
+    expected.emplace_back(SegmentDist(edge, pt));
+  }
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(nearest.size(), 3);
+  for (size_t i = 0; i < nearest.size(); i++) {
+    EXPECT_EQ(distance(nearest[i]), expected[i]);
+  }
+
+  EXPECT_EQ(tree.Contains(edges[0].GetStart()).empty(), false);
+  EXPECT_TRUE(tree.Remove(0, edges[0]));
+  tree.Insert(1000, edges[0]);
+  EXPECT_EQ(tree.Size(), 1000);
+  const auto found = tree.Contains(edges[0].GetStart());
+  EXPECT_NE(std::find(found.begin(), found.end(), 1000), found.end());
+  EXPECT_EQ(std::find(found.begin(), found.end(), 0), found.end());
+}
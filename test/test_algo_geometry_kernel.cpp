@@ -0,0 +1,265 @@
+///
+/// \brief Unit tests for geometry kernels on templated coordinates.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_geometry.hpp"
+#include "include/algo_geometry_kernel.hpp"
+
+namespace {
+namespace geo = algo::geometry;
+
+std::vector<geo::PointF> RandomPointsF(size_t n, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_real_distribution<float> dist{-100.0F, 100.0F};
+  std::vector<geo::PointF> points(n);
+  for (auto& p : points) {
+    p = {dist(gen), dist(gen)};
+  }
+  return points;
+}
+
+std::vector<geo::PointI> RandomPointsI(size_t n, int32_t range,
+                                       unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int32_t> dist{-range, range};
+  std::vector<geo::PointI> points(n);
+  for (auto& p : points) {
+    p = {dist(gen), dist(gen)};
+  }
+  return points;
+}
+
+template <typename T>
+std::vector<geo::Point> ToPoints(const std::vector<geo::BasicPoint<T>>& pts) {
+  std::vector<geo::Point> points;
+  for (const auto& p : pts) {
+    points.emplace_back(p.x, p.y);
+  }
+  return points;
+}
+
+template <typename T>
+double Dist(const geo::BasicPoint<T>& p, const geo::BasicPoint<T>& q) {
+  return std::hypot(double(p.x) - double(q.x), double(p.y) - double(q.y));
+}
+
+template <typename T>
+bool SharesEnd(const geo::BasicEdge<T>& e, const geo::BasicEdge<T>& f) {
+  return e.first == f.first || e.first == f.second || e.second == f.first ||
+         e.second == f.second;
+}
+
+/// Checks that no two edges cross or overlap, other than at common ends, and
+/// that there are 3n - 3 - h edges for n points with h on the hull.
+template <typename T>
+void ExpectTriangulation(const std::vector<geo::BasicEdge<T>>& edges,
+                         size_t n, size_t h) {
+  ASSERT_EQ(edges.size(), 3 * n - 3 - h);
+  for (size_t i = 0; i < edges.size(); i++) {
+    for (size_t j = i + 1; j < edges.size(); j++) {
+      if (!SharesEnd(edges[i], edges[j])) {
+        ASSERT_FALSE(geo::Intersect(edges[i], edges[j]));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: Predicates
+
+TEST(AlgoGeometryKernel, OrientationIntegerExact) {
+  // Doubles computing the determinant directly lose the last bits here.
+  const geo::PointI a{-2000000000, -2000000000};
+  const geo::PointI b{2000000000, 1999999999};
+  const geo::PointI c{0, -1};
+  const geo::PointI d{0, 0};
+  EXPECT_EQ(geo::Orientation(a, b, c), -1);
+  EXPECT_EQ(geo::Orientation(a, b, d), 1);
+  EXPECT_EQ(geo::Orientation(a, a, b), 0);
+
+  const geo::PointI p{1, 1};
+  const geo::PointI q{3, 3};
+  EXPECT_EQ(geo::Orientation(p, q, geo::PointI{1000, 1000}), 0);
+  EXPECT_EQ(geo::Orientation(p, q, geo::PointI{1000, 1001}), 1);
+  EXPECT_EQ(geo::Orientation(q, p, geo::PointI{1000, 1001}), -1);
+}
+
+TEST(AlgoGeometryKernel, OrientationFloatExact) {
+  const geo::PointF a{0.5F, 0.5F};
+  const geo::PointF b{12.0F, 12.0F};
+  const geo::PointF c{24.0F, 24.0F};
+  const geo::PointF d{24.0F, std::nextafter(24.0F, 25.0F)};
+  EXPECT_EQ(geo::Orientation(a, b, c), 0);
+  EXPECT_EQ(geo::Orientation(a, b, d), 1);
+}
+
+TEST(AlgoGeometryKernel, InCircle) {
+  const geo::PointI a{-5, 0};
+  const geo::PointI b{5, 0};
+  const geo::PointI c{0, 5};
+  EXPECT_EQ(geo::InCircle(a, b, c, geo::PointI{0, 0}), 1);
+  EXPECT_EQ(geo::InCircle(a, b, c, geo::PointI{3, -4}), 0);
+  EXPECT_EQ(geo::InCircle(a, b, c, geo::PointI{4, -4}), -1);
+
+  // Outside of the 64-bit range, decided on doubles.
+  const int32_t m{1 << 20};
+  EXPECT_EQ(geo::InCircle(geo::PointI{-5 * m, 0}, geo::PointI{5 * m, 0},
+                          geo::PointI{0, 5 * m}, geo::PointI{3 * m, -4 * m}),
+            0);
+
+  const geo::PointF e{-5.0F, 0.0F};
+  const geo::PointF f{5.0F, 0.0F};
+  const geo::PointF g{0.0F, 5.0F};
+  EXPECT_EQ(geo::InCircle(e, f, g, geo::PointF{3.0F, -4.0F}), 0);
+  EXPECT_EQ(geo::InCircle(e, f, g, geo::PointF{0.0F, 4.99F}), 1);
+}
+
+TEST(AlgoGeometryKernel, Intersect) {
+  const geo::EdgeI e{{0, 0}, {10, 10}};
+  EXPECT_TRUE(geo::Intersect(e, geo::EdgeI{{0, 10}, {10, 0}}));
+  EXPECT_TRUE(geo::Intersect(e, geo::EdgeI{{5, 5}, {20, 0}}));
+  EXPECT_TRUE(geo::Intersect(e, geo::EdgeI{{10, 10}, {20, 20}}));
+  EXPECT_FALSE(geo::Intersect(e, geo::EdgeI{{11, 11}, {20, 20}}));
+  EXPECT_FALSE(geo::Intersect(e, geo::EdgeI{{1, 0}, {10, 9}}));
+}
+
+// /////////////////////////////
+// MARK: BasicGrid
+
+TEST(AlgoGeometryKernel, ConvexHull) {
+  for (unsigned seed = 0; seed < 10; seed++) {
+    const auto points = RandomPointsI(500, 50, seed);
+    const auto hull = geo::GridI{points}.ConvexHull();
+    const auto expected = geo::Grid{ToPoints(points)}.ConvexHull().GetCloud();
+
+    ASSERT_EQ(hull.size(), expected.Size());
+    for (size_t i = 0; i < hull.size(); i++) {
+      EXPECT_EQ(hull[i].x, expected.X(i));
+      EXPECT_EQ(hull[i].y, expected.Y(i));
+    }
+  }
+}
+
+TEST(AlgoGeometryKernel, ConvexHullCollinear) {
+  const std::vector<geo::PointI> points{{0, 0}, {1, 1}, {2, 2}, {3, 3}};
+  EXPECT_THROW(geo::GridI{points}.ConvexHull(), std::invalid_argument);
+  EXPECT_THROW(geo::GridI{points}.MinBoundingBox(), std::invalid_argument);
+}
+
+TEST(AlgoGeometryKernel, ClosestPairOfPoints) {
+  for (unsigned seed = 0; seed < 10; seed++) {
+    const auto points = RandomPointsF(1000, seed);
+    const auto [p, q] = geo::GridF{points}.ClosestPairOfPoints();
+
+    double best{std::numeric_limits<double>::infinity()};
+    for (size_t i = 0; i < points.size(); i++) {
+      for (size_t j = i + 1; j < points.size(); j++) {
+        best = std::min(best, Dist(points[i], points[j]));
+      }
+    }
+    EXPECT_EQ(Dist(p, q), best);
+  }
+  const std::vector<geo::PointF> one{{1.0F, 1.0F}};
+  EXPECT_THROW(geo::GridF{one}.ClosestPairOfPoints(), std::invalid_argument);
+}
+
+TEST(AlgoGeometryKernel, ClosestPairOfPointsDuplicate) {
+  auto points = RandomPointsI(1000, 1000000, 1);
+  points.push_back(points[10]);
+  const auto [p, q] = geo::GridI{points}.ClosestPairOfPoints();
+  EXPECT_EQ(p, points[10]);
+  EXPECT_EQ(q, points[10]);
+}
+
+TEST(AlgoGeometryKernel, ClosestPairOfPointsNearInt32Limits) {
+  // The squared distances are about 2^62, 100 apart, equal in double.
+  const std::vector<geo::PointI> points{{-2147483643, 1000000000},
+                                        {-1073741818, 1000000010},
+                                        {0, 0},
+                                        {1073741825, 0}};
+  const auto [p, q] = geo::GridI{points}.ClosestPairOfPoints();
+  EXPECT_EQ(p, points[2]);
+  EXPECT_EQ(q, points[3]);
+
+  // Random points across the whole int32 range, against all pairs.
+  for (unsigned seed = 0; seed < 5; seed++) {
+    const auto cloud = RandomPointsI(300, 2147483647, seed);
+    const auto [r, s] = geo::GridI{cloud}.ClosestPairOfPoints();
+    const auto squared = [](const geo::PointI& a, const geo::PointI& b) {
+      const long double dx{static_cast<long double>(a.x) - b.x};
+      const long double dy{static_cast<long double>(a.y) - b.y};
+      return dx * dx + dy * dy;
+    };
+    long double best{std::numeric_limits<long double>::infinity()};
+    for (size_t i = 0; i < cloud.size(); i++) {
+      for (size_t j = i + 1; j < cloud.size(); j++) {
+        best = std::min(best, squared(cloud[i], cloud[j]));
+      }
+    }
+    EXPECT_EQ(squared(r, s), best);
+  }
+}
+
+TEST(AlgoGeometryKernel, MinEnclosingCircleAndBox) {
+  const auto points = RandomPointsF(1000, 3);
+  const geo::Grid grid{ToPoints(points)};
+  const auto circle = geo::GridF{points}.MinEnclosingCircle();
+  EXPECT_NEAR(circle.Radius(), grid.MinEnclosingCircle().Radius(), 1e-9);
+
+  const auto box = geo::GridF{points}.MinBoundingBox();
+  EXPECT_NEAR(box.Area(), grid.MinBoundingBox().Area(), 1e-6);
+}
+
+TEST(AlgoGeometryKernel, Triangulation) {
+  for (unsigned seed = 0; seed < 5; seed++) {
+    const auto points = RandomPointsF(300, seed);
+    const geo::GridF grid{points};
+    ExpectTriangulation(grid.Triangulation(), points.size(),
+                        grid.ConvexHull().size());
+  }
+}
+
+TEST(AlgoGeometryKernel, TriangulationIntegerDegenerate) {
+  // A small range gives duplicates and many collinear points.
+  for (unsigned seed = 0; seed < 5; seed++) {
+    const auto points = RandomPointsI(300, 10, seed);
+    const auto edges = geo::GridI{points}.Triangulation();
+    for (size_t i = 0; i < edges.size(); i++) {
+      for (size_t j = i + 1; j < edges.size(); j++) {
+        if (!SharesEnd(edges[i], edges[j])) {
+          ASSERT_FALSE(geo::Intersect(edges[i], edges[j]));
+        }
+      }
+    }
+  }
+
+  const std::vector<geo::PointI> line{{0, 0}, {2, 2}, {1, 1}, {1, 1}};
+  EXPECT_EQ(geo::GridI{line}.Triangulation().size(), 2);
+}
+
+TEST(AlgoGeometryKernel, DelaunayTriangulation) {
+  const auto points = RandomPointsI(1000, 1 << 20, 4);
+  const geo::GridI grid{points};
+  const auto edges = grid.DelaunayTriangulation();
+  EXPECT_EQ(edges.size(),
+            geo::Grid{ToPoints(points)}.DelaunayTriangulation().size());
+  ExpectTriangulation(edges, points.size(), grid.ConvexHull().size());
+
+  const std::vector<geo::PointI> line{{0, 0}, {1, 1}, {2, 2}};
+  EXPECT_TRUE(geo::GridI{line}.DelaunayTriangulation().empty());
+}
@@ -0,0 +1,449 @@
+///
+/// \brief Unit tests for triangle meshes.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_geometry.hpp"
+#include "include/algo_geometry_mesh.hpp"
+#include "include/algo_geometry_polygon.hpp"
+#include "test_algo_geometry_helpers.hpp"
+
+namespace {
+namespace geo = algo::geometry;
+namespace pred = algo::geometry::predicates;
+using algo_test::RandomCloud;
+
+// The coordinates of the random clouds.
+const std::uniform_real_distribution<double> kCoords{0.0, 1.0};
+
+/// Checks the twins, the orientation of each triangle and that no point lies
+/// strictly inside the circum circle of any triangle.
+void ExpectDelaunay(const geo::TriangleMesh& mesh) {
+  const auto& cloud = mesh.GetCloud();
+
+  for (size_t e = 0; e < mesh.HalfEdgeCount(); e++) {
+    const size_t twin{mesh.Twin(e)};
+    if (twin != geo::TriangleMesh::kNone) {
+      EXPECT_EQ(mesh.Twin(twin), e);
+      EXPECT_EQ(mesh.Vertex(twin), mesh.Vertex(geo::TriangleMesh::Next(e)));
+    }
+  }
+
+  for (size_t t = 0; t < mesh.TriangleCount(); t++) {
+    const auto v = mesh.TriangleVertices(t);
+    const auto a = cloud.At(v[0]);
+    const auto b = cloud.At(v[1]);
+    const auto c = cloud.At(v[2]);
+    EXPECT_GT(pred::Orient2D(a, b, c), 0.0);
+
+    for (size_t i = 0; i < cloud.Size(); i++) {
+      EXPECT_LE(pred::InCircle(a, b, c, cloud.At(i)), 0.0);
+    }
+  }
+}
+
+/// Checks the twins and the orientations, and that every edge that is not
+/// constrained is locally Delaunay.
+void ExpectConstrainedDelaunay(const geo::TriangleMesh& mesh) {
+  const auto& cloud = mesh.GetCloud();
+  for (size_t e = 0; e < mesh.HalfEdgeCount(); e++) {
+    const size_t twin{mesh.Twin(e)};
+    if (twin == geo::TriangleMesh::kNone) {
+      continue;
+    }
+    EXPECT_EQ(mesh.Twin(twin), e);
+    EXPECT_EQ(mesh.Vertex(twin), mesh.Vertex(geo::TriangleMesh::Next(e)));
+    EXPECT_EQ(mesh.IsConstrained(e), mesh.IsConstrained(twin));
+    if (!mesh.IsConstrained(e)) {
+      EXPECT_LE(pred::InCircle(
+                    cloud.At(mesh.Vertex(e)),
+                    cloud.At(mesh.Vertex(geo::TriangleMesh::Next(e))),
+                    cloud.At(mesh.Vertex(geo::TriangleMesh::Prev(e))),
+                    cloud.At(mesh.Vertex(geo::TriangleMesh::Prev(twin)))),
+                0.0);
+    }
+  }
+  for (size_t t = 0; t < mesh.TriangleCount(); t++) {
+    const auto v = mesh.TriangleVertices(t);
+    EXPECT_GT(pred::Orient2D(cloud.At(v[0]), cloud.At(v[1]), cloud.At(v[2])),
+              0.0);
+  }
+}
+
+/// The half-edge from u to v, kNone if there is none.
+size_t FindEdge(const geo::TriangleMesh& mesh, size_t u, size_t v) {
+  for (size_t e = 0; e < mesh.HalfEdgeCount(); e++) {
+    if (mesh.Vertex(e) == u && mesh.Vertex(geo::TriangleMesh::Next(e)) == v) {
+      return e;
+    }
+  }
+  return geo::TriangleMesh::kNone;
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: Predicates
+
+TEST(Predicates, Orient2D) {
+  EXPECT_GT(pred::Orient2D({0, 0}, {1, 0}, {0, 1}), 0.0);
+  EXPECT_LT(pred::Orient2D({0, 0}, {0, 1}, {1, 0}), 0.0);
+  EXPECT_EQ(pred::Orient2D({0, 0}, {1, 1}, {2, 2}), 0.0);
+}
+
+TEST(Predicates, Orient2DNearlyCollinear) {
+  // The naive determinant gets the sign wrong for these inputs.
+  const double x{0.5};
+  const double y{0.5 + std::numeric_limits<double>::epsilon()};
+  EXPECT_GT(pred::Orient2D(x, y, 12.0, 12.0, 24.0, 24.0), 0.0);
+  EXPECT_EQ(pred::Orient2D(0.1, 0.1, 0.2, 0.2, 0.3, 0.3) == 0.0,
+            pred::Orient2D(0.3, 0.3, 0.2, 0.2, 0.1, 0.1) == 0.0);
+}
+
+TEST(Predicates, InCircle) {
+  EXPECT_GT(pred::InCircle({-1, 0}, {1, 0}, {0, 1}, {0, 0}), 0.0);
+  EXPECT_LT(pred::InCircle({-1, 0}, {1, 0}, {0, 1}, {2, 2}), 0.0);
+  EXPECT_EQ(pred::InCircle({-1, 0}, {1, 0}, {0, 1}, {0, -1}), 0.0);
+  // Exactly cocircular, far from the origin.
+  const double o{1048576.5};
+  EXPECT_EQ(pred::InCircle({o - 3, o}, {o + 3, o}, {o, o + 3}, {o, o - 3}),
+            0.0);
+  EXPECT_EQ(pred::InCircle({o - 5, o}, {o + 4, o - 3}, {o + 3, o + 4},
+                           {o - 4, o - 3}),
+            0.0);
+}
+
+TEST(Predicates, Orient2DAdaptive) {
+  // Points a few ulps around the line y = x, the exact sign of the
+  // determinant is the sign of j - i.
+  const double ulp{std::numeric_limits<double>::epsilon() / 2.0};
+  for (int i = -16; i <= 16; i++) {
+    for (int j = -16; j <= 16; j++) {
+      const double px{0.5 + i * ulp};
+      const double py{0.5 + j * ulp};
+      const double det{pred::Orient2D(px, py, 12.0, 12.0, 24.0, 24.0)};
+      EXPECT_EQ(det > 0.0, j > i);
+      EXPECT_EQ(det < 0.0, j < i);
+      // The sign is invariant under cyclic permutations.
+      const double cyclic{pred::Orient2D(12.0, 12.0, 24.0, 24.0, px, py)};
+      EXPECT_EQ(det > 0.0, cyclic > 0.0);
+      EXPECT_EQ(det < 0.0, cyclic < 0.0);
+    }
+  }
+}
+
+TEST(Predicates, InCircleAdaptive) {
+  // d a few ulps from the unit circle, the differences to d are not exact.
+  const double ulp{std::numeric_limits<double>::epsilon() / 2.0};
+  for (int k = -16; k <= 16; k++) {
+    const double dy{-1.0 + k * ulp};
+    const double det{pred::InCircle(1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, dy)};
+    EXPECT_EQ(det > 0.0, dy > -1.0);
+    EXPECT_EQ(det < 0.0, dy < -1.0);
+    const double cyclic{
+        pred::InCircle(0.0, 1.0, -1.0, 0.0, 1.0, 0.0, 0.0, dy)};
+    EXPECT_EQ(det > 0.0, cyclic > 0.0);
+    EXPECT_EQ(det < 0.0, cyclic < 0.0);
+  }
+}
+
+TEST(Predicates, CompareIntersection) {
+  // The lines y = x and y = 1 - x meet at (0.5, 0.5).
+  const geo::Point a{0, 0};
+  const geo::Point b{1, 1};
+  const geo::Point c{0, 1};
+  const geo::Point d{1, 0};
+  EXPECT_EQ(pred::CompareIntersection(a, b, c, d, {0.5, 0.5}), 0);
+  EXPECT_EQ(pred::CompareIntersection(a, b, c, d, {0.5, 0.25}), 1);
+  EXPECT_EQ(pred::CompareIntersection(a, b, c, d, {0.75, 0.0}), -1);
+  EXPECT_THROW(pred::CompareIntersection(a, b, {0, 1}, {1, 2}, {0, 0}),
+               std::invalid_argument);
+
+  // x = 1/3 is not representable, the nearest double is below it.
+  const geo::Point e{0, 0};
+  const geo::Point f{1, 3};
+  const geo::Point g{0, 1};
+  const geo::Point h{1, 1};
+  const double third{1.0 / 3.0};
+  EXPECT_EQ(pred::CompareIntersection(e, f, g, h, {third, 1.0}), 1);
+  EXPECT_EQ(pred::CompareIntersection(
+                e, f, g, h, {std::nextafter(third, 1.0), 0.0}),
+            -1);
+  EXPECT_EQ(pred::CompareIntersection(
+                e, f, g, h, {std::nextafter(third, 0.0), 2.0}),
+            1);
+
+  // Three lines through (1/3, 1).
+  EXPECT_EQ(pred::CompareIntersections(e, f, g, h, {0, 2}, {1, -1}, g, h), 0);
+  EXPECT_EQ(pred::CompareIntersections(e, f, g, h, {0, 2}, {1, -2}, g, h),
+            1);
+}
+
+// /////////////////////////////
+// MARK: TriangleMesh
+
+TEST(TriangleMesh, Constructor) {
+  EXPECT_THROW(geo::TriangleMesh(geo::PointCloud{}, {0, 1}, {0, 1}),
+               std::invalid_argument);
+  const geo::PointCloud cloud{geo::Points{{0, 0}, {1, 0}, {0, 1}}};
+  const geo::TriangleMesh mesh{cloud, {0, 1, 2}, {3, 3, 3}};
+  EXPECT_EQ(mesh.TriangleCount(), 1);
+}
+
+TEST(TriangleMesh, NextPrev) {
+  EXPECT_EQ(geo::TriangleMesh::Next(3), 4);
+  EXPECT_EQ(geo::TriangleMesh::Next(5), 3);
+  EXPECT_EQ(geo::TriangleMesh::Prev(3), 5);
+  EXPECT_EQ(geo::TriangleMesh::Prev(4), 3);
+}
+
+TEST(TriangleMesh, DelaunayTooFewPoints) {
+  const auto mesh = geo::TriangleMesh::Delaunay(
+      geo::PointCloud{geo::Points{{0, 0}, {1, 1}, {1, 1}}});
+  EXPECT_EQ(mesh.TriangleCount(), 0);
+  EXPECT_TRUE(mesh.GetEdges().empty());
+}
+
+TEST(TriangleMesh, DelaunayCollinear) {
+  const auto mesh = geo::TriangleMesh::Delaunay(
+      geo::PointCloud{geo::Points{{0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4}}});
+  EXPECT_EQ(mesh.TriangleCount(), 0);
+}
+
+TEST(TriangleMesh, DelaunaySquare) {
+  const auto mesh = geo::TriangleMesh::Delaunay(
+      geo::PointCloud{geo::Points{{0, 0}, {1, 0}, {1, 1}, {0, 1}, {0.5, 0.5}}});
+  EXPECT_EQ(mesh.TriangleCount(), 4);
+  EXPECT_EQ(mesh.GetEdges().size(), 8);
+  ExpectDelaunay(mesh);
+
+  // The center point is shared by all triangles, all of them have two
+  // neighbours.
+  for (size_t t = 0; t < mesh.TriangleCount(); t++) {
+    size_t neighbors{0};
+    for (const auto n : mesh.TriangleNeighbors(t)) {
+      neighbors += n != geo::TriangleMesh::kNone ? 1 : 0;
+    }
+    EXPECT_EQ(neighbors, 2);
+  }
+}
+
+TEST(TriangleMesh, DelaunayDuplicates) {
+  const auto mesh = geo::TriangleMesh::Delaunay(geo::PointCloud{
+      geo::Points{{0, 0}, {2, 0}, {0, 0}, {1, 2}, {2, 0}, {1, 2}}});
+  EXPECT_EQ(mesh.TriangleCount(), 1);
+  EXPECT_EQ(mesh.GetCloud().Size(), 6);
+}
+
+TEST(TriangleMesh, DelaunayLattice) {
+  // Every four neighbouring lattice points are cocircular.
+  geo::PointCloud cloud;
+  const size_t side{20};
+  for (size_t i = 0; i < side; i++) {
+    for (size_t j = 0; j < side; j++) {
+      cloud.PushBack(static_cast<double>(i), static_cast<double>(j));
+    }
+  }
+  const auto mesh = geo::TriangleMesh::Delaunay(cloud);
+  EXPECT_EQ(mesh.TriangleCount(), 2 * (side - 1) * (side - 1));
+  ExpectDelaunay(mesh);
+}
+
+TEST(TriangleMesh, DelaunayRandom) {
+  const auto mesh = geo::TriangleMesh::Delaunay(RandomCloud(300, 3, kCoords));
+  ExpectDelaunay(mesh);
+
+  // Euler: t = 2n - 2 - h.
+  size_t hull{0};
+  for (const auto twin : mesh.Twins()) {
+    hull += twin == geo::TriangleMesh::kNone ? 1 : 0;
+  }
+  EXPECT_EQ(mesh.TriangleCount(), 2 * 300 - 2 - hull);
+}
+
+TEST(TriangleMesh, GridDelaunayMesh) {
+  const geo::Grid grid{RandomCloud(100, 5, kCoords)};
+  const auto mesh = grid.DelaunayMesh();
+  EXPECT_EQ(mesh.GetEdges().size(), grid.DelaunayTriangulation().size());
+  EXPECT_EQ(mesh.GetTriangles().size(), mesh.TriangleCount());
+}
+
+// /////////////////////////////
+// MARK: Constrained Delaunay
+
+TEST(TriangleMesh, ConstrainedDelaunayRhombus) {
+  // The Delaunay triangulation has the short diagonal, the constraint is the
+  // long one.
+  const geo::PointCloud cloud{geo::Points{{0, 0}, {10, 0}, {5, 1}, {5, -1}}};
+  EXPECT_NE(FindEdge(geo::TriangleMesh::Delaunay(cloud), 2, 3),
+            geo::TriangleMesh::kNone);
+
+  const auto mesh = geo::TriangleMesh::ConstrainedDelaunay(cloud, {{0, 1}});
+  EXPECT_EQ(mesh.TriangleCount(), 2);
+  const size_t e{FindEdge(mesh, 0, 1)};
+  ASSERT_NE(e, geo::TriangleMesh::kNone);
+  EXPECT_TRUE(mesh.IsConstrained(e));
+  EXPECT_TRUE(mesh.IsConstrained(mesh.Twin(e)));
+  EXPECT_EQ(FindEdge(mesh, 2, 3), geo::TriangleMesh::kNone);
+  ExpectConstrainedDelaunay(mesh);
+
+  // The hull edges are already there.
+  const auto hull = geo::TriangleMesh::ConstrainedDelaunay(cloud, {{3, 1}});
+  EXPECT_TRUE(hull.IsConstrained(FindEdge(hull, 3, 1)));
+  EXPECT_FALSE(geo::TriangleMesh::Delaunay(cloud).IsConstrained(0));
+}
+
+TEST(TriangleMesh, ConstrainedDelaunayThroughPoints) {
+  // A constraint along points on a line is split at them.
+  const geo::PointCloud cloud{geo::Points{
+      {0, 0}, {3, 0}, {1, 0}, {2, 0}, {1.5, 3}, {1.5, -3}, {0.5, 0.2}}};
+  const auto mesh = geo::TriangleMesh::ConstrainedDelaunay(cloud, {{0, 1}});
+  ExpectConstrainedDelaunay(mesh);
+  for (const auto& [u, v] : {std::pair<size_t, size_t>{0, 2}, {2, 3}, {3, 1}}) {
+    const size_t e{FindEdge(mesh, u, v)};
+    ASSERT_NE(e, geo::TriangleMesh::kNone);
+    EXPECT_TRUE(mesh.IsConstrained(e));
+  }
+}
+
+TEST(TriangleMesh, ConstrainedDelaunayRandom) {
+  for (unsigned seed = 0; seed < 10; seed++) {
+    const auto cloud = RandomCloud(200, seed, kCoords);
+    // Constraints between random points, the ones that would cross an
+    // earlier one or pass through a point are left out.
+    srand(seed + 100);
+    std::vector<std::pair<size_t, size_t>> constraints;
+    while (constraints.size() < 30) {
+      const size_t a{static_cast<size_t>(rand()) % cloud.Size()};
+      const size_t b{static_cast<size_t>(rand()) % cloud.Size()};
+      if (a == b) {
+        continue;
+      }
+      bool ok{true};
+      for (const auto& [c, d] : constraints) {
+        const geo::Edge e1{cloud.At(a), cloud.At(b)};
+        const geo::Edge e2{cloud.At(c), cloud.At(d)};
+        ok = ok && (a == c || a == d || b == c || b == d ||
+                    !geo::AnyIntersection({e1, e2}));
+        ok = ok && !(a == c && b == d) && !(a == d && b == c);
+      }
+      if (ok) {
+        constraints.emplace_back(a, b);
+      }
+    }
+
+    const auto mesh =
+        geo::TriangleMesh::ConstrainedDelaunay(cloud, constraints);
+    ExpectConstrainedDelaunay(mesh);
+    EXPECT_EQ(mesh.TriangleCount(),
+              geo::TriangleMesh::Delaunay(cloud).TriangleCount());
+    size_t constrained{0};
+    for (const auto& [a, b] : constraints) {
+      const size_t e{FindEdge(mesh, a, b)};
+      const size_t f{FindEdge(mesh, b, a)};
+      ASSERT_TRUE(e != geo::TriangleMesh::kNone ||
+                  f != geo::TriangleMesh::kNone)
+          << "seed " << seed << " constraint " << a << ", " << b;
+      EXPECT_TRUE(mesh.IsConstrained(e != geo::TriangleMesh::kNone ? e : f));
+    }
+    for (size_t e = 0; e < mesh.HalfEdgeCount(); e++) {
+      constrained += mesh.IsConstrained(e) ? 1 : 0;
+    }
+    EXPECT_GE(constrained, constraints.size());
+  }
+}
+
+TEST(TriangleMesh, ConstrainedDelaunayInvalid) {
+  const geo::PointCloud cloud{
+      geo::Points{{0, 0}, {2, 0}, {2, 2}, {0, 2}, {1, 3}, {1, -1}}};
+  EXPECT_THROW(geo::TriangleMesh::ConstrainedDelaunay(cloud, {{0, 6}}),
+               std::invalid_argument);
+  EXPECT_THROW(
+      geo::TriangleMesh::ConstrainedDelaunay(cloud, {{0, 2}, {1, 3}}),
+      std::invalid_argument);
+
+  // Duplicated and collinear points.
+  const geo::PointCloud duplicates{
+      geo::Points{{0, 0}, {4, 0}, {2, 1}, {2, -1}, {4, 0}}};
+  const auto mesh =
+      geo::TriangleMesh::ConstrainedDelaunay(duplicates, {{0, 4}, {2, 2}});
+  ExpectConstrainedDelaunay(mesh);
+  EXPECT_EQ(mesh.TriangleCount(), 2);
+  const geo::PointCloud line{geo::Points{{0, 0}, {1, 1}, {2, 2}}};
+  EXPECT_EQ(
+      geo::TriangleMesh::ConstrainedDelaunay(line, {{0, 2}}).TriangleCount(),
+      0);
+}
+
+// /////////////////////////////
+// MARK: Voronoi
+
+TEST(Voronoi, NearestSite) {
+  const auto sites = RandomCloud(100, 9, kCoords);
+  const geo::Rectangle box{{0.1, 0.2}, 0.7, 0.6};
+  const auto cells = geo::VoronoiDiagram(sites, box);
+
+  double area{0.0};
+  std::vector<size_t> cell_of(sites.Size(), cells.size());
+  for (size_t c = 0; c < cells.size(); c++) {
+    area += cells[c].cell.Area();
+    if (c > 0) {
+      EXPECT_LT(cells[c - 1].site, cells[c].site);
+    }
+    cell_of[cells[c].site] = c;
+  }
+  EXPECT_NEAR(area, 0.7 * 0.6, 1e-9);
+
+  // Each point of the box is in the cell of its nearest site.
+  for (double x = 0.105; x < 0.8; x += 0.01) {
+    for (double y = 0.205; y < 0.8; y += 0.01) {
+      const geo::Point pt{x, y};
+      size_t nearest{0};
+      for (size_t i = 1; i < sites.Size(); i++) {
+        if (sites.At(i).Dist(pt) < sites.At(nearest).Dist(pt)) {
+          nearest = i;
+        }
+      }
+      ASSERT_LT(cell_of[nearest], cells.size());
+      EXPECT_TRUE(geo::IsInside(cells[cell_of[nearest]].cell, pt));
+    }
+  }
+}
+
+TEST(Voronoi, Degenerate) {
+  const geo::Rectangle box{{0, 0}, 4, 2};
+  EXPECT_TRUE(geo::VoronoiDiagram(geo::PointCloud{}, box).empty());
+
+  // One site, the cell is the box.
+  const auto one =
+      geo::VoronoiDiagram(geo::PointCloud{geo::Points{{10, 10}}}, box);
+  ASSERT_EQ(one.size(), 1);
+  EXPECT_DOUBLE_EQ(one[0].cell.Area(), 8.0);
+
+  // Collinear sites give strips, the duplicate no cell of its own.
+  const auto strips = geo::VoronoiDiagram(
+      geo::PointCloud{geo::Points{{0.5, 1}, {1.5, 1}, {2.5, 1}, {1.5, 1}}},
+      box);
+  ASSERT_EQ(strips.size(), 3);
+  EXPECT_NEAR(strips[0].cell.Area(), 2.0, 1e-9);
+  EXPECT_NEAR(strips[1].cell.Area(), 2.0, 1e-9);
+  EXPECT_NEAR(strips[2].cell.Area(), 4.0, 1e-9);
+
+  // Sites far from the box, only some cells reach it.
+  const auto far = geo::VoronoiDiagram(
+      geo::PointCloud{geo::Points{{-100, 1}, {-90, 1}, {-80, 1}}}, box);
+  ASSERT_EQ(far.size(), 1);
+  EXPECT_EQ(far[0].site, 2);
+}
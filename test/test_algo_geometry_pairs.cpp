@@ -0,0 +1,181 @@
+///
+/// \brief Unit tests for closest pair algorithms.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_geometry.hpp"
+#include "include/algo_geometry_pairs.hpp"
+#include "test_algo_geometry_helpers.hpp"
+
+namespace {
+namespace geo = algo::geometry;
+using algo_test::RandomCloud;
+
+// The coordinates of the random clouds.
+const std::uniform_real_distribution<double> kCoords{0.0, 100.0};
+
+/// All pairs, closest first.
+std::vector<geo::PointPair> AllPairs(const geo::PointCloud& cloud) {
+  std::vector<geo::PointPair> pairs;
+  for (size_t i = 0; i < cloud.Size(); i++) {
+    for (size_t j = i + 1; j < cloud.Size(); j++) {
+      pairs.push_back({i, j, cloud.At(i).Dist(cloud.At(j))});
+    }
+  }
+  std::sort(pairs.begin(), pairs.end(), [](const auto& p, const auto& q) {
+    return p.dist < q.dist;
+  });
+  return pairs;
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: Closest
+
+TEST(ClosestPairs, ClosestBruteForce) {
+  geo::ClosestPairs pairs;
+  for (unsigned seed = 0; seed < 50; seed++) {
+    const auto cloud = RandomCloud(2 + seed * 7, seed, kCoords);
+    const auto expected = AllPairs(cloud).front();
+
+    const auto closest = pairs.Closest(cloud);
+    EXPECT_LT(closest.first, closest.second);
+    EXPECT_DOUBLE_EQ(closest.dist, expected.dist);
+    EXPECT_DOUBLE_EQ(
+        cloud.At(closest.first).Dist(cloud.At(closest.second)), expected.dist);
+
+    const auto hashed = pairs.ClosestHashed(cloud, seed);
+    EXPECT_LT(hashed.first, hashed.second);
+    EXPECT_DOUBLE_EQ(hashed.dist, expected.dist);
+  }
+}
+
+TEST(ClosestPairs, ClosestManyPoints) {
+  const auto cloud = RandomCloud(200000, 11, kCoords);
+  geo::ClosestPairs pairs;
+  const auto closest = pairs.Closest(cloud);
+  EXPECT_DOUBLE_EQ(pairs.ClosestHashed(cloud).dist, closest.dist);
+  EXPECT_DOUBLE_EQ(pairs.ClosestHashed(cloud, 7).dist, closest.dist);
+}
+
+TEST(ClosestPairs, ClosestDegenerate) {
+  geo::ClosestPairs pairs;
+  // Duplicates are at distance zero.
+  const geo::PointCloud duplicates{
+      geo::Points{{0, 0}, {3, 4}, {1, 1}, {5, 5}, {3, 4}}};
+  for (const auto& closest :
+       {pairs.Closest(duplicates), pairs.ClosestHashed(duplicates)}) {
+    EXPECT_EQ(closest.first, 1);
+    EXPECT_EQ(closest.second, 4);
+    EXPECT_EQ(closest.dist, 0.0);
+  }
+
+  // All points on a vertical line.
+  geo::PointCloud line;
+  for (int i = 0; i < 100; i++) {
+    line.PushBack(1.0, i * i);
+  }
+  EXPECT_EQ(pairs.Closest(line).dist, 1.0);
+  EXPECT_EQ(pairs.ClosestHashed(line).dist, 1.0);
+
+  // The grid would need too many cells, falls back to the sweep.
+  const geo::PointCloud spread{geo::Points{{0, 0}, {1e300, 0}, {1, 1e-300}}};
+  EXPECT_EQ(pairs.ClosestHashed(spread).second, 2);
+
+  EXPECT_THROW(pairs.Closest(geo::PointCloud{geo::Points{{0, 0}}}),
+               std::invalid_argument);
+  EXPECT_THROW(pairs.ClosestHashed(geo::PointCloud{}), std::invalid_argument);
+}
+
+// /////////////////////////////
+// MARK: KClosest
+
+TEST(ClosestPairs, KClosest) {
+  geo::ClosestPairs pairs;
+  for (unsigned seed = 0; seed < 20; seed++) {
+    const auto cloud = RandomCloud(60 + seed * 13, seed, kCoords);
+    const auto all = AllPairs(cloud);
+    for (const size_t k : {1, 5, 100}) {
+      const auto& closest = pairs.KClosest(cloud, k);
+      ASSERT_EQ(closest.size(), k);
+      for (size_t i = 0; i < k; i++) {
+        EXPECT_DOUBLE_EQ(closest[i].dist, all[i].dist);
+        EXPECT_LT(closest[i].first, closest[i].second);
+      }
+    }
+  }
+
+  // Taller than wide, the sweep goes along y.
+  geo::PointCloud tall;
+  for (int i = 0; i < 10; i++) {
+    tall.PushBack(i % 2, i * 3.0);
+  }
+  const auto& closest = pairs.KClosest(tall, 2);
+  ASSERT_EQ(closest.size(), 2);
+  EXPECT_DOUBLE_EQ(closest[1].dist, AllPairs(tall)[1].dist);
+
+  // Fewer pairs than asked for.
+  const geo::PointCloud three{geo::Points{{0, 0}, {1, 0}, {0, 2}}};
+  ASSERT_EQ(pairs.KClosest(three, 10).size(), 3);
+  EXPECT_EQ(pairs.KClosest(three, 10).back().dist, AllPairs(three)[2].dist);
+  EXPECT_TRUE(pairs.KClosest(three, 0).empty());
+}
+
+// /////////////////////////////
+// MARK: WithinDistance
+
+TEST(ClosestPairs, WithinDistance) {
+  geo::ClosestPairs pairs;
+  for (unsigned seed = 0; seed < 20; seed++) {
+    const auto cloud = RandomCloud(200 + seed * 17, seed, kCoords);
+    for (const double dist : {0.5, 3.0, 20.0}) {
+      std::vector<geo::PointPair> expected;
+      for (const auto& pair : AllPairs(cloud)) {
+        if (pair.dist <= dist) {
+          expected.push_back(pair);
+        }
+      }
+      std::sort(expected.begin(), expected.end(),
+                [](const auto& p, const auto& q) {
+                  return p.first < q.first ||
+                         (p.first == q.first && p.second < q.second);
+                });
+
+      const auto& within = pairs.WithinDistance(cloud, dist);
+      ASSERT_EQ(within.size(), expected.size());
+      for (size_t i = 0; i < within.size(); i++) {
+        EXPECT_EQ(within[i].first, expected[i].first);
+        EXPECT_EQ(within[i].second, expected[i].second);
+        EXPECT_DOUBLE_EQ(within[i].dist, expected[i].dist);
+      }
+    }
+  }
+}
+
+TEST(ClosestPairs, WithinDistanceDegenerate) {
+  geo::ClosestPairs pairs;
+  const geo::PointCloud cloud{
+      geo::Points{{0, 0}, {3, 4}, {1, 1}, {0, 0}, {3, 4}, {3, 4}}};
+
+  // Only the duplicates.
+  const auto& zero = pairs.WithinDistance(cloud, 0.0);
+  ASSERT_EQ(zero.size(), 4);
+  EXPECT_EQ(zero[0].first, 0);
+  EXPECT_EQ(zero[0].second, 3);
+  EXPECT_EQ(zero[3].first, 4);
+  EXPECT_EQ(zero[3].second, 5);
+
+  // The distance is inclusive.
+  EXPECT_EQ(pairs.WithinDistance(cloud, 5.0).size(), 15);
+  EXPECT_TRUE(pairs.WithinDistance(cloud, -1.0).empty());
+}
@@ -0,0 +1,662 @@
+///
+/// \brief Unit tests for polygon and segment algorithms.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_geometry.hpp"
+#include "include/algo_geometry_polygon.hpp"
+
+namespace {
+namespace geo = algo::geometry;
+
+using Pairs = std::vector<std::pair<size_t, size_t>>;
+
+Pairs ToPairs(const std::vector<geo::Intersection>& intersections) {
+  Pairs pairs;
+  for (const auto& inter : intersections) {
+    pairs.emplace_back(inter.first, inter.second);
+  }
+  return pairs;
+}
+
+struct IntPoint {
+  int64_t x;
+  int64_t y;
+  bool operator==(const IntPoint& other) const {
+    return x == other.x && y == other.y;
+  }
+};
+
+int Orient(const IntPoint& a, const IntPoint& b, const IntPoint& c) {
+  const int64_t det{(b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)};
+  return (det > 0) - (det < 0);
+}
+
+bool OnSegment(const IntPoint& a, const IntPoint& b, const IntPoint& p) {
+  return Orient(a, b, p) == 0 && std::min(a.x, b.x) <= p.x &&
+         p.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= p.y &&
+         p.y <= std::max(a.y, b.y);
+}
+
+/// \brief Brute force version of Intersections on integer coordinates.
+bool Intersect(const IntPoint& a, const IntPoint& b, const IntPoint& c,
+               const IntPoint& d) {
+  const auto shared = [&](const IntPoint& p) {
+    return (p == a || p == b) && (p == c || p == d);
+  };
+  const int o1{Orient(a, b, c)};
+  const int o2{Orient(a, b, d)};
+  const int o3{Orient(c, d, a)};
+  const int o4{Orient(c, d, b)};
+  if (o1 * o2 < 0 && o3 * o4 < 0) {
+    return true;
+  }
+  // Otherwise the common points are end points on the other segment.
+  std::vector<IntPoint> common;
+  for (const auto& p : {a, b}) {
+    if (OnSegment(c, d, p)) {
+      common.push_back(p);
+    }
+  }
+  for (const auto& p : {c, d}) {
+    if (OnSegment(a, b, p)) {
+      common.push_back(p);
+    }
+  }
+  // Two distinct common points is an overlap, also for equal segments.
+  return std::any_of(common.begin(), common.end(),
+                     [&](const IntPoint& p) {
+                       return !shared(p) || !(p == common.front());
+                     });
+}
+
+/// \brief Even-odd test, for points off the boundary.
+bool InRing(const geo::PointCloud& ring, double x, double y) {
+  bool inside{false};
+  for (size_t i = 0, j = ring.Size() - 1; i < ring.Size(); j = i++) {
+    if ((ring.Y(i) > y) != (ring.Y(j) > y) &&
+        x < ring.X(j) + (y - ring.Y(j)) * (ring.X(i) - ring.X(j)) /
+                            (ring.Y(i) - ring.Y(j))) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+/// \brief The number of result polygons that contain the point.
+int Cover(const std::vector<geo::PolygonWithHoles>& result, double x,
+          double y) {
+  int count{0};
+  for (const auto& polygon : result) {
+    bool in_hole{false};
+    for (const auto& hole : polygon.holes) {
+      in_hole = in_hole || InRing(hole.GetCloud(), x, y);
+    }
+    count += InRing(polygon.outer.GetCloud(), x, y) && !in_hole;
+  }
+  return count;
+}
+
+double Area(const std::vector<geo::PolygonWithHoles>& result) {
+  double area{0.0};
+  for (const auto& polygon : result) {
+    area += polygon.outer.Area();
+    for (const auto& hole : polygon.holes) {
+      area -= hole.Area();
+    }
+  }
+  return area;
+}
+
+/// \brief A star shaped polygon around (cx, cy), on integer coordinates if
+/// snapped, which gives many shared points and collinear edges. None if the
+/// snapped points are not a simple polygon.
+std::optional<geo::Polygon> Star(std::mt19937& gen, size_t n, double cx,
+                                 double cy, bool snap) {
+  std::uniform_real_distribution<double> angle{0.0, 2.0 * M_PI};
+  std::uniform_real_distribution<double> radius{3.0, 10.0};
+  std::vector<double> angles(n);
+  for (auto& a : angles) {
+    a = angle(gen);
+  }
+  std::sort(angles.begin(), angles.end());
+  geo::Points points;
+  for (const double a : angles) {
+    const double r{radius(gen)};
+    double x{cx + r * std::cos(a)};
+    double y{cy + r * std::sin(a)};
+    if (snap) {
+      x = std::round(x);
+      y = std::round(y);
+    }
+    if (points.empty() || !(points.back() == geo::Point{x, y})) {
+      points.emplace_back(x, y);
+    }
+  }
+  while (points.size() > 1 && points.back() == points.front()) {
+    points.pop_back();
+  }
+  // The lowest point second, the polygon checks the turn there.
+  const auto lowest = std::min_element(
+      points.begin(), points.end(), [](const auto& p, const auto& q) {
+        return p.Y() < q.Y() || (p.Y() == q.Y() && p.X() < q.X());
+      });
+  std::rotate(points.begin(), lowest, points.end());
+  std::rotate(points.rbegin(), points.rbegin() + 1, points.rend());
+  try {
+    geo::Polygon polygon{points};
+    if (geo::IsSimple(polygon)) {
+      return polygon;
+    }
+  } catch (const std::invalid_argument&) {
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+// /////////////////////////////
+// MARK: Segment intersection
+
+TEST(Intersections, Empty) {
+  EXPECT_TRUE(geo::Intersections({}).empty());
+  EXPECT_FALSE(geo::AnyIntersection({}));
+}
+
+TEST(Intersections, Crossing) {
+  const std::vector<geo::Edge> edges{geo::Edge{{0, 0}, {4, 4}},
+                                     geo::Edge{{0, 4}, {4, 0}},
+                                     geo::Edge{{5, 0}, {6, 1}}};
+  const auto inters = geo::Intersections(edges);
+  ASSERT_EQ(inters.size(), 1);
+  EXPECT_EQ(inters[0].first, 0);
+  EXPECT_EQ(inters[0].second, 1);
+  EXPECT_DOUBLE_EQ(inters[0].point.X(), 2.0);
+  EXPECT_DOUBLE_EQ(inters[0].point.Y(), 2.0);
+  EXPECT_TRUE(geo::AnyIntersection(edges));
+}
+
+TEST(Intersections, Degenerate) {
+  const std::vector<geo::Edge> edges{
+      geo::Edge{{0, 0}, {2, 0}},  // Shares (2, 0) with 1, not an intersection.
+      geo::Edge{{2, 0}, {4, 0}},
+      geo::Edge{{1, 0}, {1, 3}},  // T-junction with 0.
+      geo::Edge{{3, 0}, {5, 0}},  // Collinear overlap with 1.
+      geo::Edge{{1, 1}, {1, 2}},  // Vertical overlap with 2.
+      geo::Edge{{7, 7}, {8, 8}},
+  };
+  EXPECT_EQ(ToPairs(geo::Intersections(edges)),
+            (Pairs{{0, 2}, {1, 3}, {2, 4}}));
+}
+
+TEST(Intersections, SharedEndPoints) {
+  // A star of edges meeting at the origin, as in a mesh.
+  std::vector<geo::Edge> edges;
+  const geo::Points ends{{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, -1}};
+  for (const auto& pt : ends) {
+    edges.emplace_back(geo::Point{0, 0}, pt);
+  }
+  EXPECT_TRUE(geo::Intersections(edges).empty());
+  EXPECT_FALSE(geo::AnyIntersection(edges));
+
+  edges.emplace_back(geo::Point{-1, 0}, geo::Point{1, 0});
+  EXPECT_EQ(geo::Intersections(edges).size(), 5);
+}
+
+TEST(Intersections, BruteForceGrid) {
+  // Small integer coordinates give many collinear and touching segments.
+  std::mt19937 gen{7};
+  std::uniform_int_distribution<int64_t> dist{0, 12};
+  for (int round = 0; round < 20; round++) {
+    std::vector<IntPoint> ends;
+    std::vector<geo::Edge> edges;
+    for (int i = 0; i < 60; i++) {
+      const IntPoint a{dist(gen), dist(gen)};
+      IntPoint b{dist(gen), dist(gen)};
+      if (a == b) {
+        b.x++;
+      }
+      ends.push_back(a);
+      ends.push_back(b);
+      edges.emplace_back(
+          geo::Point{static_cast<double>(a.x), static_cast<double>(a.y)},
+          geo::Point{static_cast<double>(b.x), static_cast<double>(b.y)});
+    }
+
+    Pairs expected;
+    for (size_t i = 0; i < edges.size(); i++) {
+      for (size_t j = i + 1; j < edges.size(); j++) {
+        if (Intersect(ends[2 * i], ends[2 * i + 1], ends[2 * j],
+                      ends[2 * j + 1])) {
+          expected.emplace_back(i, j);
+        }
+      }
+    }
+    EXPECT_EQ(ToPairs(geo::Intersections(edges)), expected);
+    EXPECT_EQ(geo::AnyIntersection(edges), !expected.empty());
+  }
+}
+
+TEST(Intersections, BruteForceRandom) {
+  std::mt19937 gen{11};
+  std::uniform_real_distribution<double> dist{-100.0, 100.0};
+  std::uniform_real_distribution<double> step{-10.0, 10.0};
+  std::vector<geo::Edge> edges;
+  for (int i = 0; i < 500; i++) {
+    const geo::Point a{dist(gen), dist(gen)};
+    edges.emplace_back(a, geo::Point{a.X() + step(gen), a.Y() + step(gen)});
+  }
+
+  Pairs expected;
+  for (size_t i = 0; i < edges.size(); i++) {
+    for (size_t j = i + 1; j < edges.size(); j++) {
+      if (edges[i].Intersect(edges[j])) {
+        expected.emplace_back(i, j);
+      }
+    }
+  }
+  const auto inters = geo::Intersections(edges);
+  EXPECT_EQ(ToPairs(inters), expected);
+  for (const auto& inter : inters) {
+    for (const auto& edge : {edges[inter.first], edges[inter.second]}) {
+      const geo::Point dir{edge.GetEnd() - edge.GetStart()};
+      const geo::Point rel{inter.point - edge.GetStart()};
+      const double t{(rel.X() * dir.X() + rel.Y() * dir.Y()) /
+                     (dir.X() * dir.X() + dir.Y() * dir.Y())};
+      const geo::Point proj{edge.GetStart().X() + t * dir.X(),
+                            edge.GetStart().Y() + t * dir.Y()};
+      EXPECT_NEAR(proj.Dist(inter.point), 0.0, 1e-9);
+      EXPECT_GE(t, -1e-9);
+      EXPECT_LE(t, 1.0 + 1e-9);
+    }
+  }
+}
+
+// /////////////////////////////
+// MARK: Simple polygon
+
+TEST(IsSimple, Simple) {
+  const geo::Polygon square{geo::Points{{0, 0}, {2, 0}, {2, 2}, {0, 2}}};
+  EXPECT_TRUE(geo::IsSimple(square));
+
+  const geo::Polygon concave{
+      geo::Points{{0, 0}, {4, 0}, {4, 4}, {2, 1}, {0, 4}}};
+  EXPECT_TRUE(geo::IsSimple(concave));
+}
+
+TEST(IsSimple, NotSimple) {
+  // The boundary touches itself at (2, 2), which is a vertex twice.
+  const geo::Polygon pinched{geo::Points{
+      {0, 0}, {4, 0}, {2, 2}, {4, 4}, {0, 4}, {2, 2}}};
+  EXPECT_FALSE(geo::IsSimple(pinched));
+
+  const geo::Polygon bow_tie{geo::Points{{0, 0}, {2, 0}, {0, 2}, {2, 2}}};
+  EXPECT_FALSE(geo::IsSimple(bow_tie));
+
+  // A vertex on a non-adjacent edge.
+  const geo::Polygon touching{
+      geo::Points{{0, 0}, {4, 0}, {4, 4}, {2, 0}, {0, 4}}};
+  EXPECT_FALSE(geo::IsSimple(touching));
+}
+
+// /////////////////////////////
+// MARK: Boolean operations
+
+TEST(Clip, Squares) {
+  const geo::Polygon a{geo::Points{{0, 0}, {4, 0}, {4, 4}, {0, 4}}};
+  const geo::Polygon b{geo::Points{{2, 2}, {6, 2}, {6, 6}, {2, 6}}};
+
+  const auto inter = geo::Clip(a, b, geo::BooleanOp::kIntersection);
+  ASSERT_EQ(inter.size(), 1);
+  EXPECT_EQ(inter[0].outer.GetCloud().Size(), 4);
+  EXPECT_DOUBLE_EQ(Area(inter), 4.0);
+  EXPECT_DOUBLE_EQ(Area(geo::Clip(a, b, geo::BooleanOp::kUnion)), 28.0);
+  EXPECT_DOUBLE_EQ(Area(geo::Clip(a, b, geo::BooleanOp::kDifference)), 12.0);
+  EXPECT_DOUBLE_EQ(Area(geo::Clip(b, a, geo::BooleanOp::kDifference)), 12.0);
+
+  // Two L shapes that touch at (2, 2) and (4, 4).
+  const auto sym = geo::Clip(a, b, geo::BooleanOp::kXor);
+  EXPECT_EQ(sym.size(), 2);
+  EXPECT_DOUBLE_EQ(Area(sym), 24.0);
+}
+
+TEST(Clip, Holes) {
+  const geo::Polygon outer{geo::Points{{0, 0}, {10, 0}, {10, 10}, {0, 10}}};
+  const geo::Polygon inner{geo::Points{{3, 3}, {7, 3}, {7, 7}, {3, 7}}};
+
+  const auto ring = geo::Clip(outer, inner, geo::BooleanOp::kDifference);
+  ASSERT_EQ(ring.size(), 1);
+  ASSERT_EQ(ring[0].holes.size(), 1);
+  EXPECT_DOUBLE_EQ(ring[0].holes[0].Area(), 16.0);
+  EXPECT_DOUBLE_EQ(Area(ring), 84.0);
+  EXPECT_TRUE(geo::Clip(inner, outer, geo::BooleanOp::kDifference).empty());
+
+  // Sets of polygons with holes, filling the hole again.
+  const std::vector<geo::PolygonWithHoles> plug{{inner, {}}};
+  const auto filled = geo::Clip(ring, plug, geo::BooleanOp::kUnion);
+  ASSERT_EQ(filled.size(), 1);
+  EXPECT_TRUE(filled[0].holes.empty());
+  EXPECT_DOUBLE_EQ(Area(filled), 100.0);
+
+  // An island in the hole.
+  const geo::Polygon island{geo::Points{{4, 4}, {6, 4}, {6, 6}, {4, 6}}};
+  const std::vector<geo::PolygonWithHoles> land{{island, {}}};
+  const auto both = geo::Clip(ring, land, geo::BooleanOp::kUnion);
+  ASSERT_EQ(both.size(), 2);
+  EXPECT_DOUBLE_EQ(Area(both), 88.0);
+}
+
+TEST(Clip, Touching) {
+  const geo::Polygon a{geo::Points{{0, 0}, {2, 0}, {2, 2}, {0, 2}}};
+
+  // Apart.
+  const geo::Polygon far{geo::Points{{5, 5}, {6, 5}, {6, 6}, {5, 6}}};
+  EXPECT_EQ(geo::Clip(a, far, geo::BooleanOp::kUnion).size(), 2);
+  EXPECT_TRUE(geo::Clip(a, far, geo::BooleanOp::kIntersection).empty());
+  EXPECT_DOUBLE_EQ(Area(geo::Clip(a, far, geo::BooleanOp::kDifference)), 4.0);
+
+  // At a corner.
+  const geo::Polygon corner{geo::Points{{2, 2}, {4, 2}, {4, 4}, {2, 4}}};
+  EXPECT_EQ(geo::Clip(a, corner, geo::BooleanOp::kUnion).size(), 2);
+  EXPECT_TRUE(geo::Clip(a, corner, geo::BooleanOp::kIntersection).empty());
+
+  // Along an edge, the shared edge and its end points are removed.
+  const geo::Polygon side{geo::Points{{2, 0}, {4, 0}, {4, 2}, {2, 2}}};
+  const auto joined = geo::Clip(a, side, geo::BooleanOp::kUnion);
+  ASSERT_EQ(joined.size(), 1);
+  EXPECT_EQ(joined[0].outer.GetCloud().Size(), 4);
+  EXPECT_DOUBLE_EQ(Area(joined), 8.0);
+  EXPECT_DOUBLE_EQ(Area(geo::Clip(a, side, geo::BooleanOp::kXor)), 8.0);
+
+  // The same polygon.
+  EXPECT_DOUBLE_EQ(Area(geo::Clip(a, a, geo::BooleanOp::kUnion)), 4.0);
+  EXPECT_TRUE(geo::Clip(a, a, geo::BooleanOp::kXor).empty());
+}
+
+TEST(Clip, ConvexClip) {
+  std::mt19937 gen{3};
+  for (int i = 0; i < 50; i++) {
+    geo::PointCloud cloud;
+    geo::PointCloud moved;
+    std::uniform_real_distribution<double> dist{0.0, 10.0};
+    for (int j = 0; j < 20; j++) {
+      const double x{dist(gen)};
+      const double y{dist(gen)};
+      cloud.PushBack(x, y);
+      moved.PushBack(x + 3.0, y);
+    }
+    const geo::Polygon a{geo::Grid{cloud}.ConvexHull()};
+    const geo::Polygon b{geo::Grid{moved}.ConvexHull()};
+
+    // The union goes through the sweep, the intersection does not.
+    const double inter{Area(geo::Clip(a, b, geo::BooleanOp::kIntersection))};
+    const double joined{Area(geo::Clip(a, b, geo::BooleanOp::kUnion))};
+    EXPECT_NEAR(inter, a.Area() + b.Area() - joined, 1e-9);
+    EXPECT_NEAR(geo::Polygon{geo::ConvexClip(a, b)}.Area(), inter, 1e-9);
+  }
+
+  const geo::Polygon a{geo::Points{{0, 0}, {2, 0}, {2, 2}, {0, 2}}};
+  const geo::Polygon far{geo::Points{{5, 5}, {6, 5}, {6, 6}, {5, 6}}};
+  EXPECT_TRUE(geo::ConvexClip(a, far).Empty());
+}
+
+TEST(Clip, BruteForce) {
+  std::mt19937 gen{5};
+  std::uniform_real_distribution<double> offset{-8.0, 8.0};
+  std::uniform_int_distribution<size_t> size{3, 25};
+  for (int i = 0; i < 60; i++) {
+    const bool snap{i % 2 == 0};
+    const auto star_a = Star(gen, size(gen), 0.0, 0.0, snap);
+    const auto star_b = Star(gen, size(gen), offset(gen), offset(gen), snap);
+    if (!star_a || !star_b) {
+      continue;
+    }
+    const geo::Polygon& a{*star_a};
+    const geo::Polygon& b{*star_b};
+    for (const auto op :
+         {geo::BooleanOp::kIntersection, geo::BooleanOp::kUnion,
+          geo::BooleanOp::kDifference, geo::BooleanOp::kXor}) {
+      const auto result = geo::Clip(a, b, op);
+      // Off the grid lines, so never on an edge.
+      for (double x = -19.7; x < 20.0; x += 0.5) {
+        for (double y = -19.9; y < 20.0; y += 0.5) {
+          const bool in_a{InRing(a.GetCloud(), x, y)};
+          const bool in_b{InRing(b.GetCloud(), x, y)};
+          const bool expected{
+              op == geo::BooleanOp::kIntersection ? in_a && in_b
+              : op == geo::BooleanOp::kUnion      ? in_a || in_b
+              : op == geo::BooleanOp::kDifference ? in_a && !in_b
+                                                  : in_a != in_b};
+          ASSERT_EQ(Cover(result, x, y), expected ? 1 : 0)
+              << "round " << i << " at " << x << ", " << y;
+        }
+      }
+    }
+  }
+}
+
+// /////////////////////////////
+// MARK: Point in polygon
+
+TEST(PointInPolygon, Winding) {
+  const geo::Polygon square{geo::Points{{0, 0}, {4, 0}, {4, 4}, {0, 4}}};
+  EXPECT_TRUE(geo::IsInside(square, {2, 2}));
+  EXPECT_TRUE(geo::IsInside(square, {0, 0}));
+  EXPECT_TRUE(geo::IsInside(square, {4, 1}));
+  EXPECT_TRUE(geo::IsInside(square, {3, 4}));
+  EXPECT_FALSE(geo::IsInside(square, {5, 2}));
+  EXPECT_FALSE(geo::IsInside(square, {-1, 4}));
+  EXPECT_FALSE(geo::IsInside(square, {2, 4.000001}));
+
+  // Concave, the notch is outside.
+  const geo::Polygon u{geo::Points{
+      {0, 0}, {6, 0}, {6, 6}, {4, 6}, {4, 2}, {2, 2}, {2, 6}, {0, 6}}};
+  EXPECT_FALSE(geo::IsInside(u, {3, 4}));
+  EXPECT_TRUE(geo::IsInside(u, {3, 2}));
+  EXPECT_TRUE(geo::IsInside(u, {1, 5}));
+  EXPECT_TRUE(geo::IsInside(u, {5, 6}));
+  EXPECT_FALSE(geo::IsInside(u, {3, 6}));
+
+  // A pentagram winds twice around its center.
+  geo::Points star;
+  for (int i = 0; i < 5; i++) {
+    const double a{-M_PI / 2.0 + 0.2 + i * 4.0 * M_PI / 5.0};
+    star.emplace_back(std::cos(a), std::sin(a));
+  }
+  EXPECT_TRUE(geo::IsInside(geo::Polygon{star}, {0.0, 0.0}));
+  EXPECT_FALSE(geo::IsInside(geo::Polygon{star}, {1.0, 1.0}));
+}
+
+TEST(PointInPolygon, IndexBruteForce) {
+  std::mt19937 gen{7};
+  std::uniform_int_distribution<size_t> size{3, 200};
+  std::uniform_real_distribution<double> coord{-12.0, 12.0};
+  for (int i = 0; i < 40; i++) {
+    const bool snap{i % 2 == 0};
+    const auto star = Star(gen, size(gen), 0.0, 0.0, snap);
+    if (!star) {
+      continue;
+    }
+    const geo::PolygonIndex index{*star};
+
+    // On the half grid, which has the corners, rows and edges of the
+    // snapped polygons, and random points.
+    geo::PointCloud queries;
+    for (double x = -11.0; x <= 11.0; x += 0.5) {
+      for (double y = -11.0; y <= 11.0; y += 0.5) {
+        queries.PushBack(x, y);
+      }
+    }
+    for (int k = 0; k < 2000; k++) {
+      queries.PushBack(coord(gen), coord(gen));
+    }
+    const auto batch = index.IsInside(queries, 2);
+    ASSERT_EQ(batch.size(), queries.Size());
+    for (size_t k = 0; k < queries.Size(); k++) {
+      const geo::Point pt{queries.At(k)};
+      const bool expected{geo::IsInside(*star, pt)};
+      ASSERT_EQ(index.IsInside(pt), expected)
+          << "round " << i << " at " << pt.X() << ", " << pt.Y();
+      ASSERT_EQ(batch[k], expected ? 1 : 0)
+          << "round " << i << " at " << pt.X() << ", " << pt.Y();
+      if (k >= queries.Size() - 2000) {
+        EXPECT_EQ(expected, InRing(star->GetCloud(), pt.X(), pt.Y()));
+      }
+    }
+  }
+}
+
+TEST(PointInPolygon, IndexRectilinear) {
+  // A comb with 20 teeth, many corners and horizontal edges on few rows.
+  geo::Points points{{0, 0}, {40, 0}};
+  for (int t = 19; t >= 0; t--) {
+    points.emplace_back(2 * t + 2, 10);
+    points.emplace_back(2 * t + 1, 10);
+    points.emplace_back(2 * t + 1, 2);
+    points.emplace_back(2 * t, 2);
+  }
+  points.pop_back();
+  points.emplace_back(0, 10);
+  const geo::Polygon comb{points};
+  const geo::PolygonIndex index{comb};
+  EXPECT_GT(index.SlabEdgeCount(), 0);
+
+  geo::PointCloud queries;
+  for (double x = -1.0; x <= 41.0; x += 0.25) {
+    for (double y = -1.0; y <= 11.0; y += 0.25) {
+      queries.PushBack(x, y);
+    }
+  }
+  const auto batch = index.IsInside(queries);
+  for (size_t k = 0; k < queries.Size(); k++) {
+    const bool expected{geo::IsInside(comb, queries.At(k))};
+    EXPECT_EQ(index.IsInside(queries.At(k)), expected);
+    EXPECT_EQ(batch[k], expected ? 1 : 0);
+  }
+  EXPECT_TRUE(index.IsInside({1.5, 10}));
+  EXPECT_TRUE(index.IsInside({2, 2}));
+  EXPECT_FALSE(index.IsInside({2.5, 10}));
+  EXPECT_FALSE(index.IsInside({2.5, 5}));
+  EXPECT_TRUE(index.IsInside(geo::PointCloud{}).empty());
+}
+
+// /////////////////////////////
+// MARK: Triangulation
+
+namespace {
+
+/// \brief Checks that the triangles are counter clockwise and cover the
+/// area of the polygon. Without collinear corners there are n + 2h - 2.
+void ExpectTriangulation(const geo::PolygonWithHoles& polygon,
+                         bool collinear = false) {
+  geo::PointCloud corners{polygon.outer.GetCloud()};
+  double area{polygon.outer.Area()};
+  for (const auto& hole : polygon.holes) {
+    for (size_t i = 0; i < hole.GetCloud().Size(); i++) {
+      corners.PushBack(hole.GetCloud().X(i), hole.GetCloud().Y(i));
+    }
+    area -= hole.Area();
+  }
+
+  const auto triangles = geo::Triangulate(polygon);
+  if (!collinear) {
+    EXPECT_EQ(triangles.size(),
+              corners.Size() + 2 * polygon.holes.size() - 2);
+  }
+  double sum{0.0};
+  for (const auto& [a, b, c] : triangles) {
+    ASSERT_LT(std::max({a, b, c}), corners.Size());
+    const double twice{
+        (corners.X(b) - corners.X(a)) * (corners.Y(c) - corners.Y(a)) -
+        (corners.Y(b) - corners.Y(a)) * (corners.X(c) - corners.X(a))};
+    EXPECT_GE(twice, 0.0);
+    sum += twice / 2.0;
+  }
+  EXPECT_NEAR(sum, area, 1e-9 * std::abs(area));
+}
+
+}  // namespace
+
+TEST(Triangulation, Simple) {
+  const geo::Polygon square{geo::Points{{0, 0}, {1, 0}, {1, 1}, {0, 1}}};
+  const auto triangles = geo::Triangulate(square);
+  ASSERT_EQ(triangles.size(), 2);
+  ExpectTriangulation({square, {}});
+
+  // A comb, mostly reflex corners.
+  geo::Points points{{0, 0}, {40, 0}};
+  for (int t = 19; t >= 0; t--) {
+    points.emplace_back(2 * t + 2, 10);
+    points.emplace_back(2 * t + 1, 10);
+    points.emplace_back(2 * t + 1, 2);
+    points.emplace_back(2 * t, 2);
+  }
+  points.pop_back();
+  points.emplace_back(0, 10);
+  ExpectTriangulation({geo::Polygon{points}, {}});
+}
+
+TEST(Triangulation, Stars) {
+  std::mt19937 gen{3};
+  std::uniform_int_distribution<size_t> size{3, 300};
+  for (int i = 0; i < 60; i++) {
+    const bool snap{i % 2 == 0};
+    const auto star = Star(gen, size(gen), 0.0, 0.0, snap);
+    if (star) {
+      ExpectTriangulation({*star, {}}, snap);
+    }
+  }
+
+  // A wavy circle with many corners in each wave.
+  geo::Points points;
+  std::uniform_real_distribution<double> noise{-1e-3, 1e-3};
+  for (int i = 0; i < 100000; i++) {
+    const double a{-M_PI / 2.0 + 2.0 * M_PI * i / 100000.0};
+    const double r{10.0 + std::sin(32.0 * a) + noise(gen)};
+    points.emplace_back(r * std::cos(a), r * std::sin(a));
+  }
+  // The lowest point second, as in Star.
+  const auto lowest = std::min_element(
+      points.begin(), points.end(),
+      [](const auto& p, const auto& q) { return p.Y() < q.Y(); });
+  std::rotate(points.begin(), lowest, points.end());
+  std::rotate(points.rbegin(), points.rbegin() + 1, points.rend());
+  ExpectTriangulation({geo::Polygon{points}, {}});
+}
+
+TEST(Triangulation, Holes) {
+  std::mt19937 gen{5};
+  std::uniform_int_distribution<size_t> size{3, 40};
+  for (int i = 0; i < 20; i++) {
+    geo::PolygonWithHoles polygon{
+        geo::Polygon{geo::Points{{0, 0}, {100, 0}, {100, 100}, {0, 100}}},
+        {}};
+    // Stars reach at most 10 from their centers, so they do not overlap.
+    for (double x = 15.0; x < 100.0; x += 23.0) {
+      for (double y = 15.0; y < 100.0; y += 23.0) {
+        if (auto star = Star(gen, size(gen), x, y, i % 2 == 0)) {
+          polygon.holes.push_back(*star);
+        }
+      }
+    }
+    ExpectTriangulation(polygon, i % 2 == 0);
+  }
+
+  // A hole with a corner on the outer ring.
+  const geo::Polygon outer{geo::Points{{0, 0}, {4, 0}, {4, 4}, {0, 4}}};
+  const geo::Polygon hole{geo::Points{{0, 2}, {2, 1}, {3, 2}, {2, 3}}};
+  ExpectTriangulation({outer, {hole}}, true);
+}
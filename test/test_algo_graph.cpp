@@ -129,6 +129,94 @@ TEST(UndirectedGraph, IsNotBipartite) {
   EXPECT_FALSE(ug.IsBipartite());
 }
 
+// MARK: Triangles
+
+TEST(UndirectedGraph, FreezeSortsAndRemovesDuplicates) {
+  graph::UndirectedGraph ug{4};
+  ug.InsertEdge(0, 3);
+  ug.InsertEdge(0, 1);
+  ug.InsertEdge(0, 3);
+  ug.InsertEdge(2, 1);
+  auto adj = ug.Freeze();
+  std::vector<size_t> offsets{0, 2, 4, 5, 6};
+  graph::Nodes neighbors{1, 3, 0, 2, 1, 0};
+  EXPECT_EQ(adj.offsets, offsets);
+  EXPECT_EQ(adj.neighbors, neighbors);
+}
+
+TEST(UndirectedGraph, TriangleCountInvalid) {
+  const graph::UndirectedGraph ug{0};
+  EXPECT_TRUE(ug.TriangleCount().empty());
+  EXPECT_TRUE(ug.ClusteringCoefficient().empty());
+  EXPECT_TRUE(graph::TriangleCount(graph::SortedAdjacency{}).empty());
+}
+
+TEST(UndirectedGraph, TriangleCountA) {
+  // Two triangles sharing the edge (1, 2) and a pendant node 4.
+  graph::UndirectedGraph ug{5};
+  ug.InsertEdge(0, 1);
+  ug.InsertEdge(0, 2);
+  ug.InsertEdge(1, 2);
+  ug.InsertEdge(1, 3);
+  ug.InsertEdge(2, 3);
+  ug.InsertEdge(3, 4);
+
+  graph::Counts corr{1, 2, 2, 1, 0};
+  EXPECT_EQ(ug.TriangleCount(), corr);
+
+  auto cc = ug.ClusteringCoefficient();
+  EXPECT_DOUBLE_EQ(cc[0], 1.0);
+  EXPECT_DOUBLE_EQ(cc[1], 2.0 / 3.0);
+  EXPECT_DOUBLE_EQ(cc[2], 2.0 / 3.0);
+  EXPECT_DOUBLE_EQ(cc[3], 1.0 / 3.0);
+  EXPECT_DOUBLE_EQ(cc[4], 0.0);
+}
+
+TEST(UndirectedGraph, TriangleCountCompleteGraph) {
+  // Every node in K_n is part of (n - 1)(n - 2) / 2 triangles.
+  const size_t n{40};
+  graph::UndirectedGraph ug{n};
+  for (size_t u = 0; u < n; ++u) {
+    for (size_t v = u + 1; v < n; ++v) ug.InsertEdge(u, v);
+  }
+
+  graph::Counts corr(n, (n - 1) * (n - 2) / 2);
+  EXPECT_EQ(ug.TriangleCount(1), corr);
+  EXPECT_EQ(ug.TriangleCount(4), corr);
+
+  for (const auto &c : ug.ClusteringCoefficient()) EXPECT_DOUBLE_EQ(c, 1.0);
+}
+
+TEST(UndirectedGraph, TriangleCountMatchesBruteForce) {
+  const size_t n{300};
+  graph::UndirectedGraph ug{n};
+  std::vector<std::vector<bool>> adj(n, std::vector<bool>(n, false));
+  srand(7);
+  for (size_t k = 0; k < 6000; ++k) {
+    size_t u = rand() % n;
+    size_t v = rand() % n;
+    if (u == v) continue;
+    ug.InsertEdge(u, v);
+    adj[u][v] = adj[v][u] = true;
+  }
+
+  graph::Counts corr(n, 0);
+  for (size_t u = 0; u < n; ++u) {
+    for (size_t v = u + 1; v < n; ++v) {
+      for (size_t w = v + 1; w < n; ++w) {
+        if (adj[u][v] && adj[v][w] && adj[u][w]) {
+          ++corr[u];
+          ++corr[v];
+          ++corr[w];
+        }
+      }
+    }
+  }
+
+  EXPECT_EQ(ug.TriangleCount(1), corr);
+  EXPECT_EQ(graph::TriangleCount(ug.Freeze(), 8), corr);
+}
+
 /////////////////////////////////////////////
 /// - MARK: DirectedGraph -
 
@@ -149,3 +149,51 @@ TEST(TestAlgoImage, TestMaxOf) {
   EXPECT_EQ(im3.At(0, 1), 255);
   EXPECT_EQ(im3.At(1, 1), 255);
 }
+
+/////////////////////////////////////////////
+/// Image views
+/////////////////////////////////////////////
+
+TEST(TestAlgoImage, TestViewRoi) {
+  std::vector<uint8_t> data(4 * 5);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(i);
+  }
+  img::Img im{data, img::Size{4, 5}};
+
+  const img::ImgView roi{img::ViewOf(im).Roi(img::Rectangle{1, 2, 3, 2})};
+  ASSERT_FALSE(roi.Empty());
+  EXPECT_EQ(roi.size, (img::Size{2, 3}));
+  EXPECT_EQ(roi.stride, 5);
+  EXPECT_EQ(roi.At(0, 0), 11);
+  EXPECT_EQ(roi.At(2, 1), 18);
+
+  // Writes go to the image.
+  roi.At(1, 1) = 200;
+  EXPECT_EQ(im.At(2, 3), 200);
+
+  // A view of a view.
+  EXPECT_EQ(roi.Roi(img::Rectangle{1, 1, 2, 1}).At(1, 0), 18);
+
+  EXPECT_TRUE(img::ViewOf(im).Roi(img::Rectangle{3, 0, 3, 1}).Empty());
+  EXPECT_TRUE(img::ViewOf(im).Roi(img::Rectangle{-1, 0, 1, 1}).Empty());
+  EXPECT_TRUE(img::ViewOf(im).Roi(img::Rectangle{0, 0, 0, 1}).Empty());
+}
+
+TEST(TestAlgoImage, TestFromView) {
+  std::vector<uint8_t> data(4 * 5);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(i);
+  }
+  const img::Img im{data, img::Size{4, 5}};
+
+  const img::Img copy{img::FromView(img::ViewOf(im).Roi(img::Rectangle{1, 1, 2, 3}))};
+  EXPECT_EQ(copy.size, (img::Size{3, 2}));
+  EXPECT_EQ(copy.data, (std::vector<uint8_t>{6, 7, 11, 12, 16, 17}));
+
+  EXPECT_EQ(img::FromView(img::ViewOf(im)).data, im.data);
+  EXPECT_TRUE(img::FromView(img::ConstImgView{}).data.empty());
+
+  const img::ImgF imf{std::vector<float>{1.0F, 2.0F, 3.0F, 4.0F}, img::Size{2, 2}};
+  EXPECT_EQ(img::FromViewF(img::ViewOf(imf).Roi(img::Rectangle{1, 0, 1, 2})).data, (std::vector<float>{2.0F, 4.0F}));
+}
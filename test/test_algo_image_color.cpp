@@ -0,0 +1,230 @@
+///
+/// \brief Unit tests for color image layouts and color conversions.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_image_color.hpp"
+#include "include/algo_image_filter.hpp"
+#include "include/algo_image_pipeline.hpp"
+#include "test_algo_image_helpers.hpp"
+
+namespace {
+namespace img = algo::image;
+namespace filt = algo::image::filter;
+using algo_test::RandomData;
+using algo_test::RandomImg3;
+
+const std::vector<img::Simd> kSimds{img::Simd::SCALAR, img::Simd::SSE2, img::Simd::AVX2};
+const std::vector<img::PixelFormat> kFormats{img::PixelFormat::RGB, img::PixelFormat::BGR, img::PixelFormat::RGBA,
+                                             img::PixelFormat::BGRA};
+
+uint8_t Clamp(double v) {
+  return static_cast<uint8_t>(std::clamp(std::lround(v), 0L, 255L));
+}
+
+}  // namespace
+
+/////////////////////////////////////////////
+/// Layouts
+/////////////////////////////////////////////
+
+TEST(TestAlgoImageColor, InterleavedRoundTrip) {
+  // 37 columns, two vectors of 16 and a rest.
+  const img::Img3 im{RandomImg3(5, 37, 1)};
+  for (const auto format : kFormats) {
+    const int step{img::BytesPerPixel(format)};
+    const bool bgr{format == img::PixelFormat::BGR || format == img::PixelFormat::BGRA};
+    for (const auto simd : kSimds) {
+      const img::ImgInterleaved packed{img::ToInterleaved(img::ViewOf(im), format, simd)};
+      ASSERT_EQ(packed.data.size(), im.data[img::Red].size() * step);
+      for (size_t i = 0; i < im.data[img::Red].size(); i++) {
+        EXPECT_EQ(packed.data[i * step + (bgr ? 2 : 0)], im.data[img::Red][i]);
+        EXPECT_EQ(packed.data[i * step + 1], im.data[img::Green][i]);
+        EXPECT_EQ(packed.data[i * step + (bgr ? 0 : 2)], im.data[img::Blue][i]);
+        if (step == 4) {
+          EXPECT_EQ(packed.data[i * step + 3], 255);
+        }
+      }
+      const img::Img3 planar{img::ToPlanar(img::ViewOf(packed), simd)};
+      EXPECT_EQ(planar.size, im.size);
+      EXPECT_EQ(planar.data, im.data);
+
+      // Interleaved to interleaved.
+      EXPECT_EQ(img::ToInterleaved(img::ViewOf(packed), img::PixelFormat::RGB, simd).data,
+                img::ToInterleaved(img::ViewOf(im), img::PixelFormat::RGB, simd).data);
+    }
+  }
+}
+
+TEST(TestAlgoImageColor, StrideAndRoi) {
+  // Rows of 20 pixels of 3 bytes with 4 bytes of padding.
+  const img::Size size{6, 20};
+  const int stride{64};
+  const img::Data8 buffer{RandomData(size.rows * stride, 3)};
+  const img::Img3View view{img::InterleavedView(buffer.data(), size, img::PixelFormat::BGR, stride)};
+  ASSERT_FALSE(view.Empty());
+  EXPECT_EQ(view.At(img::Red, 2, 1), buffer[stride + 2 * 3 + 2]);
+  EXPECT_EQ(view.At(img::Blue, 2, 1), buffer[stride + 2 * 3]);
+
+  const img::Img3View roi{view.Roi(img::Rectangle{3, 2, 17, 4})};
+  const img::Img3 planar{img::ToPlanar(roi)};
+  ASSERT_EQ(planar.size, (img::Size{4, 17}));
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 17; x++) {
+      for (int c = 0; c < 3; c++) {
+        EXPECT_EQ(planar.data[c][y * 17 + x], view.At(c, x + 3, y + 2));
+      }
+    }
+  }
+  EXPECT_TRUE(view.Roi(img::Rectangle{4, 0, 17, 1}).Empty());
+  EXPECT_TRUE(img::ViewOf(img::Img3{}).Empty());
+  EXPECT_TRUE(img::ToPlanar(img::Img3View{}).data[img::Red].empty());
+}
+
+TEST(TestAlgoImageColor, ToGray) {
+  const img::Img3 im{RandomImg3(7, 45, 4)};
+  const img::Img expected{img::ToGray(im)};
+  for (size_t i = 0; i < expected.data.size(); i++) {
+    const double gray{0.3 * im.data[img::Red][i] + 0.59 * im.data[img::Green][i] + 0.11 * im.data[img::Blue][i]};
+    EXPECT_NEAR(expected.data[i], gray, 1.0);
+    EXPECT_EQ(expected.data[i], (4915 * im.data[img::Red][i] + 9667 * im.data[img::Green][i] +
+                                 1802 * im.data[img::Blue][i]) >> 14);
+  }
+
+  // Every layout and instruction set gives the same image.
+  for (const auto simd : kSimds) {
+    EXPECT_EQ(img::ToGray(img::ViewOf(im), simd).data, expected.data);
+    for (const auto format : kFormats) {
+      const img::ImgInterleaved packed{img::ToInterleaved(img::ViewOf(im), format)};
+      EXPECT_EQ(img::ToGray(img::ViewOf(packed), simd).data, expected.data);
+    }
+  }
+
+  // Any other step, here every other pixel of an RGB buffer.
+  const img::ImgInterleaved packed{img::ToInterleaved(img::ViewOf(im), img::PixelFormat::RGB)};
+  img::Img3View sparse{img::ViewOf(packed)};
+  sparse.step = 6;
+  sparse.size.cols = 22;
+  const img::Img gray{img::ToGray(sparse)};
+  for (int y = 0; y < 7; y++) {
+    for (int x = 0; x < 22; x++) {
+      EXPECT_EQ(gray.At(x, y), expected.At(2 * x, y));
+    }
+  }
+}
+
+/////////////////////////////////////////////
+/// YUV
+/////////////////////////////////////////////
+
+TEST(TestAlgoImageColor, YuvToRgb) {
+  // Odd sizes, the last chroma value covers one column and one row.
+  const img::Size size{9, 39};
+  const size_t luma{static_cast<size_t>(size.rows) * size.cols};
+  const size_t chroma{static_cast<size_t>(5) * 20};
+  const img::Data8 i420{RandomData(luma + 2 * chroma, 5)};
+  img::Data8 nv12{i420.begin(), i420.begin() + luma};
+  for (size_t i = 0; i < chroma; i++) {
+    nv12.push_back(i420[luma + i]);
+    nv12.push_back(i420[luma + chroma + i]);
+  }
+
+  for (const auto range : {img::YuvRange::VIDEO, img::YuvRange::FULL}) {
+    const img::YuvView view{img::I420View(i420.data(), size, range)};
+    const img::Img3 rgb{img::YuvToRgb(view)};
+    ASSERT_EQ(rgb.size, size);
+    for (int y = 0; y < size.rows; y++) {
+      for (int x = 0; x < size.cols; x++) {
+        const bool video{range == img::YuvRange::VIDEO};
+        const double luma_value{video ? 255.0 / 219.0 * (view.y[y * size.cols + x] - 16) : view.y[y * size.cols + x]};
+        const double chroma_scale{video ? 255.0 / 224.0 : 1.0};
+        const double u{chroma_scale * (view.u[(y / 2) * 20 + x / 2] - 128)};
+        const double v{chroma_scale * (view.v[(y / 2) * 20 + x / 2] - 128)};
+        const size_t i{static_cast<size_t>(y) * size.cols + x};
+        EXPECT_NEAR(rgb.data[img::Red][i], Clamp(luma_value + 1.402 * v), 1.0);
+        EXPECT_NEAR(rgb.data[img::Green][i], Clamp(luma_value - 0.344136 * u - 0.714136 * v), 1.0);
+        EXPECT_NEAR(rgb.data[img::Blue][i], Clamp(luma_value + 1.772 * u), 1.0);
+      }
+    }
+    for (const auto simd : kSimds) {
+      EXPECT_EQ(img::YuvToRgb(view, simd).data, rgb.data);
+      EXPECT_EQ(img::YuvToRgb(img::Nv12View(nv12.data(), size, range), simd).data, rgb.data);
+    }
+  }
+}
+
+TEST(TestAlgoImageColor, YuvLimits) {
+  // Black and white in video range, gray in full range.
+  const img::Size size{2, 32};
+  img::Data8 data(64 + 2 * 16, 128);
+  std::fill(data.begin(), data.begin() + 32, 16);
+  std::fill(data.begin() + 32, data.begin() + 64, 235);
+  const img::Img3 rgb{img::YuvToRgb(img::I420View(data.data(), size))};
+  for (int c = 0; c < 3; c++) {
+    EXPECT_EQ(rgb.data[c][0], 0);
+    EXPECT_EQ(rgb.data[c][63], 255);
+  }
+  EXPECT_EQ(img::YuvToGray(img::I420View(data.data(), size)).data[31], 0);
+  EXPECT_EQ(img::YuvToGray(img::I420View(data.data(), size)).data[32], 255);
+
+  const img::Img3 full{img::YuvToRgb(img::I420View(data.data(), size, img::YuvRange::FULL))};
+  for (int c = 0; c < 3; c++) {
+    EXPECT_EQ(full.data[c][0], 16);
+    EXPECT_EQ(full.data[c][63], 235);
+  }
+  EXPECT_TRUE(img::YuvToRgb(img::YuvView{}).data[img::Red].empty());
+}
+
+TEST(TestAlgoImageColor, YuvToGray) {
+  const img::Size size{5, 41};
+  const img::Data8 data{RandomData(5 * 41 + 2 * 3 * 21, 6)};
+  const img::Img full{img::YuvToGray(img::I420View(data.data(), size, img::YuvRange::FULL))};
+  EXPECT_TRUE(std::equal(full.data.begin(), full.data.end(), data.begin()));
+
+  const img::Img video{img::YuvToGray(img::Nv12View(data.data(), size))};
+  for (size_t i = 0; i < video.data.size(); i++) {
+    EXPECT_NEAR(video.data[i], Clamp(255.0 / 219.0 * (data[i] - 16)), 1.0);
+  }
+  for (const auto simd : kSimds) {
+    EXPECT_EQ(img::YuvToGray(img::I420View(data.data(), size), simd).data, video.data);
+  }
+}
+
+/////////////////////////////////////////////
+/// Color functions on interleaved views
+/////////////////////////////////////////////
+
+TEST(TestAlgoImageColor, FiltersOnInterleaved) {
+  const img::Img3 im{RandomImg3(21, 34, 7)};
+  const img::ImgInterleaved packed{img::ToInterleaved(img::ViewOf(im), img::PixelFormat::BGRA)};
+
+  EXPECT_EQ(filt::Convolve3(img::ViewOf(packed), filt::KernelType::EDGE_DETECT).data,
+            filt::Convolve3(im, filt::KernelType::EDGE_DETECT).data);
+  EXPECT_EQ(filt::MedianFilter3(img::ViewOf(packed), img::Size{5, 5}).data,
+            filt::MedianFilter3(im, img::Size{5, 5}).data);
+
+  // Rows wide enough for the vector kernels, and the windows of the sorting network and of the histograms.
+  const img::Img3 wide{RandomImg3(19, 75, 8)};
+  const img::ImgInterleaved rgb{img::ToInterleaved(img::ViewOf(wide), img::PixelFormat::RGB)};
+  for (const auto simd : kSimds) {
+    EXPECT_EQ(filt::Convolve3(img::ViewOf(rgb), filt::KernelType::GAUSSIAN_BLUR, simd).data,
+              filt::Convolve3(wide, filt::KernelType::GAUSSIAN_BLUR, simd).data);
+    EXPECT_EQ(filt::Convolve3(img::ViewOf(rgb), filt::KernelType::EMBOSS, simd).data,
+              filt::Convolve3(wide, filt::KernelType::EMBOSS, simd).data);
+  }
+  for (const img::Size& w_size : {img::Size{3, 3}, img::Size{7, 5}}) {
+    EXPECT_EQ(filt::MedianFilter3(img::ViewOf(rgb), w_size).data, filt::MedianFilter3(wide, w_size).data);
+  }
+
+  img::Pipeline pipeline;
+  pipeline.GaussianBlur(img::Size{3, 3}, 1.0F).Fixed(100, true);
+  EXPECT_EQ(pipeline.Run(img::ViewOf(packed), 2, 5).data, pipeline.Run(im, 2, 5).data);
+}
@@ -5,12 +5,15 @@
 /// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
 ///
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "include/algo_image_basic.hpp"
 #include "include/algo_image_feature.hpp"
+#include "include/algo_image_pyramid.hpp"
 
 namespace {
 namespace img = algo::image;
@@ -192,6 +195,47 @@ TEST(TestAlgoImage, TestCorners) {
   EXPECT_FALSE(pts.empty());
 }
 
+TEST(TestAlgoImage, TestCornersView) {
+  // The image inside of a larger one, found in the coordinates of the view.
+  const img::Img corner_img{GetCornerImg()};
+  const img::Size& size{corner_img.size};
+  img::Img canvas{std::vector<uint8_t>((size.rows + 9) * (size.cols + 7), 50), img::Size{size.rows + 9, size.cols + 7}};
+  const img::ImgView roi{img::ViewOf(canvas).Roi(img::Rectangle{5, 4, size.cols, size.rows})};
+  for (int y = 0; y < size.rows; y++) {
+    for (int x = 0; x < size.cols; x++) {
+      roi.At(x, y) = corner_img.At(x, y);
+    }
+  }
+
+  const imgf::GaussWindowSettings g_win_set{img::Size{5, 5}, 1.0};
+  const img::Points points{imgf::Corners(roi, 1e6, imgf::CornerDetType::kHarris, 8, 5, g_win_set)};
+  const img::Points expected{imgf::Corners(corner_img, 1e6, imgf::CornerDetType::kHarris, 8, 5, g_win_set)};
+  EXPECT_FALSE(points.empty());
+  ASSERT_EQ(points.size(), expected.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    EXPECT_EQ(points[i].x, expected[i].x);
+    EXPECT_EQ(points[i].y, expected[i].y);
+  }
+  EXPECT_TRUE(imgf::Corners(img::ConstImgView{}, 1e2).empty());
+}
+
+TEST(TestAlgoImage, TestCornersOnPyramid) {
+  const img::Img corner_img{GetCornerImg()};
+  const img::Pyramid pyr{corner_img, 2, 2, 1.0F, 0.0F};
+  ASSERT_EQ(pyr.Octaves(), 2);
+  // The first octave is the input blurred with sigma 1, as in Corners with a Gaussian window.
+  img::Points pts{imgf::Corners(pyr, 0, 1e6, imgf::CornerDetType::kHarris, 8, 5)};
+  EXPECT_FALSE(pts.empty());
+  pts = imgf::Corners(pyr, 1, 1e2, imgf::CornerDetType::kShiTomasi, 0, 0);
+  for (const auto& pt : pts) {
+    EXPECT_EQ(pt.x % 2, 0);
+    EXPECT_EQ(pt.y % 2, 0);
+    EXPECT_LT(pt.x, corner_img.size.cols);
+    EXPECT_LT(pt.y, corner_img.size.rows);
+  }
+  EXPECT_TRUE(imgf::Corners(pyr, 2, 1e2).empty());
+}
+
 /////////////////////////////////////////////
 /// FAST Corners
 /////////////////////////////////////////////
@@ -201,3 +245,74 @@ TEST(TestAlgoImage, TestFastCorners) {
   const img::Points points{imgf::FASTCorners(corner_img, 0, 11)};
   EXPECT_GT(points.size(), 0);
 }
+
+TEST(TestAlgoImage, TestFastCornersView) {
+  // The image inside of a larger one, found in the coordinates of the view.
+  const img::Img corner_img{FastImgBrighter()};
+  const img::Size& size{corner_img.size};
+  img::Img canvas{std::vector<uint8_t>((size.rows + 9) * (size.cols + 7), 50), img::Size{size.rows + 9, size.cols + 7}};
+  const img::ImgView roi{img::ViewOf(canvas).Roi(img::Rectangle{5, 4, size.cols, size.rows})};
+  for (int y = 0; y < size.rows; y++) {
+    for (int x = 0; x < size.cols; x++) {
+      roi.At(x, y) = corner_img.At(x, y);
+    }
+  }
+
+  const img::Points points{imgf::FASTCorners(roi, 0, 11)};
+  const img::Points expected{imgf::FASTCorners(corner_img, 0, 11)};
+  EXPECT_GT(points.size(), 0);
+  ASSERT_EQ(points.size(), expected.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    EXPECT_EQ(points[i].x, expected[i].x);
+    EXPECT_EQ(points[i].y, expected[i].y);
+  }
+}
+
+/////////////////////////////////////////////
+/// SIFT Keypoints
+/////////////////////////////////////////////
+
+TEST(TestAlgoImage, TestSiftKeypoints) {
+  // Bright and dark blobs, of a few sizes.
+  img::Img im{std::vector<uint8_t>(96 * 128, 100), img::Size{96, 128}};
+  for (int y = 0; y < im.size.rows; y++) {
+    for (int x = 0; x < im.size.cols; x++) {
+      const double blob1{std::exp(-((x - 30) * (x - 30) + (y - 40) * (y - 40)) / 18.0)};
+      const double blob2{std::exp(-((x - 90) * (x - 90) + (y - 50) * (y - 50)) / 60.0)};
+      im.Set(x, y, static_cast<uint8_t>(100 + 120 * blob1 - 90 * blob2));
+    }
+  }
+  const imgf::Keypoints keypoints{imgf::SiftKeypoints(im, 5, 3)};
+  EXPECT_FALSE(keypoints.empty());
+  for (const auto& kp : keypoints) {
+    EXPECT_GE(kp.x, 0);
+    EXPECT_GE(kp.y, 0);
+    EXPECT_LT(kp.x, im.size.cols);
+    EXPECT_LT(kp.y, im.size.rows);
+  }
+
+  // The same keypoints from a pyramid that is shared with other detectors.
+  const img::Pyramid pyr{im, 3, 2};
+  const imgf::Keypoints shared{imgf::SiftKeypoints(pyr)};
+  ASSERT_EQ(shared.size(), keypoints.size());
+  for (size_t i = 0; i < shared.size(); i++) {
+    EXPECT_EQ(shared[i].x, keypoints[i].x);
+    EXPECT_EQ(shared[i].y, keypoints[i].y);
+    EXPECT_DOUBLE_EQ(shared[i].angle, keypoints[i].angle);
+  }
+  EXPECT_TRUE(imgf::SiftKeypoints(img::Pyramid{}).empty());
+
+  // And from the image inside of a larger one, in the coordinates of the view.
+  img::Img canvas{std::vector<uint8_t>((im.size.rows + 6) * (im.size.cols + 10), 100),
+                  img::Size{im.size.rows + 6, im.size.cols + 10}};
+  const img::ImgView roi{img::ViewOf(canvas).Roi(img::Rectangle{8, 3, im.size.cols, im.size.rows})};
+  for (int y = 0; y < im.size.rows; y++) {
+    std::copy(im.data.begin() + y * im.size.cols, im.data.begin() + (y + 1) * im.size.cols, roi.Row(y));
+  }
+  const imgf::Keypoints in_view{imgf::SiftKeypoints(roi, 5, 3)};
+  ASSERT_EQ(in_view.size(), keypoints.size());
+  for (size_t i = 0; i < in_view.size(); i++) {
+    EXPECT_EQ(in_view[i].x, keypoints[i].x);
+    EXPECT_EQ(in_view[i].y, keypoints[i].y);
+  }
+}
@@ -6,15 +6,79 @@
 ///
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
+#include <functional>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "include/algo_image_filter.hpp"
+#include "test_algo_image_helpers.hpp"
 
 namespace {
 namespace img = algo::image;
 namespace filt = algo::image::filter;
+using algo_test::RandomImg;
+
+const std::vector<filt::KernelType> kAllKernels{
+    filt::KernelType::SOBEL_X,
+    filt::KernelType::SOBEL_Y,
+    filt::KernelType::EDGE_DETECT,
+    filt::KernelType::SMOOTHING,
+    filt::KernelType::SHARPEN_MODEST,
+    filt::KernelType::SHARPEN_AGGRESSIVE,
+    filt::KernelType::GAUSSIAN_BLUR,
+    filt::KernelType::BLUR_HARD,
+    filt::KernelType::BLUR_SOFT,
+    filt::KernelType::EMBOSS,
+    filt::KernelType::WEIGHTED_AVERAGE,
+    filt::KernelType::DILATION_VERTICAL,
+    filt::KernelType::DILATION_HORIZONTAL,
+    filt::KernelType::DILATION,
+    filt::KernelType::HIGH_PASS,
+};
+
+/// Convolves one pixel at a time with every tap in float, as Convolve did before it had row kernels.
+img::Data8 ReferenceConvolve(const img::Img& im, const std::array<float, 9>& kernel) {
+  const int rows{im.size.rows};
+  const int cols{im.size.cols};
+  img::Data8 res(im.data.size(), 0);
+  for (int i = 1; i < rows - 1; i++) {
+    for (int j = 1; j < cols - 1; j++) {
+      float sum{0.0F};
+      for (int k = 0; k < 3; k++) {
+        for (int m = 0; m < 3; m++) {
+          sum += static_cast<float>(im.data[(i + k - 1) * cols + j + m - 1]) * kernel[k * 3 + m];
+        }
+      }
+      res[i * cols + j] = static_cast<uint8_t>(std::clamp(sum, 0.0F, 255.0F));
+    }
+  }
+  return res;
+}
+
+/// The median of every window by sorting, the border pixels 0.
+img::Data8 ReferenceMedian(const img::Img& im, int w_width, int w_height) {
+  const int rows{im.size.rows};
+  const int cols{im.size.cols};
+  img::Data8 res(im.data.size(), 0);
+  for (int y = w_height / 2; y - w_height / 2 + w_height <= rows; y++) {
+    for (int x = w_width / 2; x - w_width / 2 + w_width <= cols; x++) {
+      std::vector<uint8_t> window;
+      for (int wy = 0; wy < w_height; wy++) {
+        for (int wx = 0; wx < w_width; wx++) {
+          window.push_back(im.data[(y + wy - w_height / 2) * cols + x + wx - w_width / 2]);
+        }
+      }
+      std::sort(window.begin(), window.end());
+      res[y * cols + x] = window[window.size() / 2];
+    }
+  }
+  return res;
+}
+
 }  // namespace
 
 /////////////////////////////////////////////
@@ -60,6 +124,39 @@ TEST(TestAlgoImage, TestKernels) {
   }
 }
 
+TEST(TestAlgoImage, TestConvolveSimd) {
+  // One float and one integer kernel, 1/9 and 1/16 weights.
+  const std::array<float, 9> blur_hard{1.0F / 9, 1.0F / 9, 1.0F / 9, 1.0F / 9, 1.0F / 9,
+                                       1.0F / 9, 1.0F / 9, 1.0F / 9, 1.0F / 9};
+  const std::array<float, 9> gauss{1.0F / 16, 2.0F / 16, 1.0F / 16, 2.0F / 16, 4.0F / 16,
+                                   2.0F / 16, 1.0F / 16, 2.0F / 16, 1.0F / 16};
+  const std::vector<filt::Simd> simds{filt::Simd::SCALAR, filt::Simd::SSE2, filt::Simd::AVX2};
+
+  // Widths that leave tails after the vectors.
+  for (const int cols : {3, 17, 40, 101}) {
+    const img::Img im{RandomImg(23, cols, static_cast<unsigned>(cols))};
+    for (const auto simd : simds) {
+      EXPECT_EQ(filt::Convolve(im, filt::KernelType::BLUR_HARD, simd).data, ReferenceConvolve(im, blur_hard));
+      EXPECT_EQ(filt::Convolve(im, filt::KernelType::GAUSSIAN_BLUR, simd).data, ReferenceConvolve(im, gauss));
+    }
+  }
+
+  const img::Img im{RandomImg(31, 77, 1)};
+  for (const auto& kernel : kAllKernels) {
+    const img::Data8 expected{filt::Convolve(im, kernel, filt::Simd::SCALAR).data};
+    for (const auto simd : simds) {
+      EXPECT_EQ(filt::Convolve(im, kernel, simd).data, expected);
+    }
+  }
+}
+
+TEST(TestAlgoImage, TestConvolveSmall) {
+  const img::Img im{RandomImg(2, 5, 1)};
+  const img::Img res{filt::Convolve(im, filt::KernelType::SOBEL_X)};
+  EXPECT_EQ(res.data, img::Data8(10, 0));
+  EXPECT_TRUE(filt::Convolve(img::Img{{}, img::Size{0, 0}}, filt::KernelType::SOBEL_X).data.empty());
+}
+
 /////////////////////////////////////////////
 /// Gaussian blur
 /////////////////////////////////////////////
@@ -99,6 +196,81 @@ TEST(TestAlgoImage, TestGaussianBlur) {
   EXPECT_FALSE(equal(data.begin(), data.end(), img.data.begin()));
 }
 
+TEST(TestAlgoImage, TestGaussianBlurSeparable) {
+  // The separable filter against the 2D window, with the same normalized Gaussian.
+  const img::Img im{RandomImg(40, 50, 2)};
+  const int rows{7};
+  const int cols{5};
+  const double sigma{1.5};
+  const img::Img res{filt::GaussianBlur(im, img::Size{rows, cols}, sigma)};
+  ASSERT_EQ(res.size, im.size);
+
+  std::vector<double> kernel(rows * cols);
+  double sum{0.0};
+  for (int k = 0; k < rows; k++) {
+    for (int m = 0; m < cols; m++) {
+      const double dx{m - cols / 2.0 + 0.5};
+      const double dy{k - rows / 2.0 + 0.5};
+      kernel[k * cols + m] = std::exp(-(dx * dx + dy * dy) / (2.0 * sigma * sigma));
+      sum += kernel[k * cols + m];
+    }
+  }
+  for (int y = 0; y < im.size.rows; y++) {
+    for (int x = 0; x < im.size.cols; x++) {
+      if (y < rows / 2 || y >= im.size.rows - rows / 2 || x < cols / 2 || x >= im.size.cols - cols / 2) {
+        EXPECT_EQ(res.At(x, y), 0);
+        continue;
+      }
+      double expected{0.0};
+      for (int k = 0; k < rows; k++) {
+        for (int m = 0; m < cols; m++) {
+          expected += im.At(x + m - cols / 2, y + k - rows / 2) * kernel[k * cols + m] / sum;
+        }
+      }
+      EXPECT_NEAR(res.At(x, y), expected, 0.5 + 1e-3);
+    }
+  }
+}
+
+TEST(TestAlgoImage, TestBoxBlur) {
+  img::Img im{img::Data8(30 * 20, 77), img::Size{30, 20}};
+  im.Set(10, 10, 77 + 9 * 9);
+  const img::Img res{filt::BoxBlur(im, img::Size{3, 3})};
+  EXPECT_EQ(res.At(10, 10), 77 + 9);
+  EXPECT_EQ(res.At(11, 11), 77 + 9);
+  EXPECT_EQ(res.At(12, 12), 77);
+  EXPECT_EQ(res.At(0, 0), 0);
+  EXPECT_TRUE(filt::BoxBlur(im, img::Size{4, 3}).data.empty());
+  EXPECT_TRUE(filt::BoxBlur(im, img::Size{31, 3}).data.empty());
+}
+
+TEST(TestAlgoImage, TestRecursiveGaussianBlur) {
+  // The response to an impulse is close to a Gaussian with the same sigma.
+  for (const float sigma : {1.0F, 2.0F, 5.0F, 12.0F}) {
+    const int n{static_cast<int>(16 * sigma) + 1};
+    img::ImgF im{img::Dataf(n * n, 0.0F), img::Size{n, n}};
+    im.Set(n / 2, n / 2, 1.0F);
+    const img::ImgF res{filt::RecursiveGaussianBlurF(im, sigma)};
+
+    double sum{0.0};
+    double variance{0.0};
+    for (int y = 0; y < n; y++) {
+      for (int x = 0; x < n; x++) {
+        const double dx{static_cast<double>(x - n / 2)};
+        sum += res.At(x, y);
+        variance += dx * dx * res.At(x, y);
+      }
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-3);
+    EXPECT_NEAR(std::sqrt(variance), sigma, 0.02 * sigma);
+  }
+
+  // Constant images stay constant, also at the borders.
+  const img::Img flat{img::Data8(25 * 35, 200), img::Size{25, 35}};
+  EXPECT_EQ(filt::RecursiveGaussianBlur(flat, 3.0F).data, flat.data);
+  EXPECT_TRUE(filt::RecursiveGaussianBlur(flat, 0.4F).data.empty());
+}
+
 /////////////////////////////////////////////
 /// Median filters
 /////////////////////////////////////////////
@@ -119,6 +291,32 @@ TEST(TestAlgoImage, TestMedianFilter) {
   EXPECT_FALSE(equal(data.begin(), data.end(), img.data.begin()));
 }
 
+TEST(TestAlgoImage, TestMedianFilterReference) {
+  // The sorting networks, 3x3 and 5x5, and the histograms for the others.
+  const img::Img im{RandomImg(41, 70, 5)};
+  for (const auto& [w_width, w_height] : std::vector<std::pair<int, int>>{
+           {3, 3}, {5, 5}, {1, 1}, {2, 2}, {3, 5}, {4, 7}, {7, 7}, {15, 9}, {40, 40}}) {
+    EXPECT_EQ(filt::MedianFilter(im, img::Size{w_height, w_width}).data, ReferenceMedian(im, w_width, w_height));
+  }
+  EXPECT_TRUE(filt::MedianFilter(im, img::Size{0, 3}).data.empty());
+
+  // Wider than a strip of column histograms.
+  const img::Img wide{RandomImg(12, 600, 6)};
+  EXPECT_EQ(filt::MedianFilter(wide, img::Size{7, 4}).data, ReferenceMedian(wide, 4, 7));
+}
+
+TEST(TestAlgoImage, TestMedianFilter3Channels) {
+  const img::Img red{RandomImg(30, 45, 1)};
+  const img::Img green{RandomImg(30, 45, 2)};
+  const img::Img blue{RandomImg(30, 45, 3)};
+  const img::Img3 im{img::Data8_3{red.data, green.data, blue.data}, red.size};
+
+  const img::Img3 res{filt::MedianFilter3(im, img::Size{5, 5})};
+  EXPECT_EQ(res.data[img::Red], ReferenceMedian(red, 5, 5));
+  EXPECT_EQ(res.data[img::Green], ReferenceMedian(green, 5, 5));
+  EXPECT_EQ(res.data[img::Blue], ReferenceMedian(blue, 5, 5));
+}
+
 TEST(TestAlgoImage, TestMedianFilter3WSize) {
   const img::Img3 im{{}, img::Size{2, 2}};
   img::Img3 img{filt::MedianFilter3(im, img::Size{2, 2})};
@@ -180,3 +378,102 @@ TEST(TestAlgoImage, TestAdaptiveThresholding) {
   img::Img img{filt::threshold::Adaptive(im, 2, false)};
   EXPECT_FALSE(equal(data.begin(), data.end(), img.data.begin()));
 }
+
+/////////////////////////////////////////////
+/// Image views
+/////////////////////////////////////////////
+
+TEST(TestAlgoImage, TestFiltersOnViews) {
+  // Filtering a region of an image into a region of another equals filtering a copy of the region.
+  const img::Img im{RandomImg(60, 80, 9)};
+  const img::Rectangle rect{7, 5, 50, 41};
+  const img::ConstImgView roi{img::ViewOf(im).Roi(rect)};
+  const img::Img copy{img::FromView(roi)};
+
+  const std::vector<std::pair<std::function<img::Img(const img::Img&)>,
+                              std::function<bool(const img::ConstImgView&, const img::ImgView&)>>>
+      filters{
+          {[](const img::Img& in) { return filt::Convolve(in, filt::KernelType::SOBEL_X); },
+           [](const img::ConstImgView& in, const img::ImgView& out) {
+             return filt::Convolve(in, out, filt::KernelType::SOBEL_X);
+           }},
+          {[](const img::Img& in) { return filt::GaussianBlur(in, img::Size{5, 7}, 1.5F); },
+           [](const img::ConstImgView& in, const img::ImgView& out) {
+             return filt::GaussianBlur(in, out, img::Size{5, 7}, 1.5F);
+           }},
+          {[](const img::Img& in) { return filt::BoxBlur(in, img::Size{3, 3}); },
+           [](const img::ConstImgView& in, const img::ImgView& out) {
+             return filt::BoxBlur(in, out, img::Size{3, 3});
+           }},
+          {[](const img::Img& in) { return filt::MedianFilter(in, img::Size{3, 3}); },
+           [](const img::ConstImgView& in, const img::ImgView& out) {
+             return filt::MedianFilter(in, out, img::Size{3, 3});
+           }},
+          {[](const img::Img& in) { return filt::MedianFilter(in, img::Size{9, 7}); },
+           [](const img::ConstImgView& in, const img::ImgView& out) {
+             return filt::MedianFilter(in, out, img::Size{9, 7});
+           }},
+          {[](const img::Img& in) { return filt::threshold::Fixed(in, 100, true); },
+           [](const img::ConstImgView& in, const img::ImgView& out) {
+             return filt::threshold::Fixed(in, out, 100, true);
+           }},
+          {[](const img::Img& in) { return filt::threshold::Adaptive(in, 9, false); },
+           [](const img::ConstImgView& in, const img::ImgView& out) {
+             return filt::threshold::Adaptive(in, out, 9, false);
+           }},
+      };
+
+  for (const auto& [filter, filter_view] : filters) {
+    const img::Img expected{filter(copy)};
+    img::Img buffer{std::vector<uint8_t>(70 * 90, 7), img::Size{70, 90}};
+    const img::ImgView out{img::ViewOf(buffer).Roi(img::Rectangle{11, 13, rect.width, rect.height})};
+    ASSERT_TRUE(filter_view(roi, out));
+    EXPECT_EQ(img::FromView(out).data, expected.data);
+
+    // The pixels outside of the output view are left as they were.
+    for (int y = 0; y < buffer.size.rows; y++) {
+      for (int x = 0; x < buffer.size.cols; x++) {
+        if (x < 11 || x >= 11 + rect.width || y < 13 || y >= 13 + rect.height) {
+          ASSERT_EQ(buffer.At(x, y), 7);
+        }
+      }
+    }
+  }
+}
+
+TEST(TestAlgoImage, TestFiltersOnViewsErrors) {
+  const img::Img im{RandomImg(20, 30, 1)};
+  img::Img out{std::vector<uint8_t>(20 * 29), img::Size{20, 29}};
+  EXPECT_FALSE(filt::Convolve(img::ViewOf(im), img::ViewOf(out), filt::KernelType::SOBEL_X));
+  EXPECT_FALSE(filt::GaussianBlur(img::ViewOf(im), img::ViewOf(out), img::Size{3, 3}, 1.0F));
+  EXPECT_FALSE(filt::MedianFilter(img::ViewOf(im), img::ViewOf(out), img::Size{3, 3}));
+  EXPECT_FALSE(filt::threshold::Fixed(img::ViewOf(im), img::ViewOf(out), 10, true));
+  EXPECT_FALSE(filt::threshold::Adaptive(img::ViewOf(im), img::ViewOf(out), 5, true));
+
+  img::Img same{im};
+  EXPECT_FALSE(filt::MedianFilter(img::ViewOf(im), img::ViewOf(same), img::Size{21, 3}));
+  EXPECT_FALSE(filt::GaussianBlur(img::ViewOf(im), img::ViewOf(same), img::Size{4, 3}, 1.0F));
+  EXPECT_FALSE(filt::Convolve(img::ConstImgView{}, img::ImgView{}, filt::KernelType::SOBEL_X));
+  EXPECT_FALSE(filt::threshold::Adaptive(img::ViewOf(im), img::ViewOf(same), 20, true));
+
+  // Fixed runs in place.
+  ASSERT_TRUE(filt::threshold::Fixed(img::ViewOf(same), img::ViewOf(same), 100, false));
+  EXPECT_EQ(same.data, filt::threshold::Fixed(im, 100, false).data);
+
+  // And so does Adaptive.
+  img::Img adaptive{im};
+  ASSERT_TRUE(filt::threshold::Adaptive(img::ViewOf(adaptive), img::ViewOf(adaptive), 5, true));
+  EXPECT_EQ(adaptive.data, filt::threshold::Adaptive(im, 5, true).data);
+}
+
+TEST(TestAlgoImage, TestSeparableFilterOnFloatViews) {
+  const img::Img im{RandomImg(30, 40, 4)};
+  img::ImgF imf{std::vector<float>(im.data.begin(), im.data.end()), im.size};
+  const img::Rectangle rect{3, 4, 30, 20};
+  const img::ImgF expected{filt::GaussianBlurF(img::FromViewF(img::ViewOf(imf).Roi(rect)), img::Size{5, 5}, 1.0F)};
+
+  img::ImgF out{std::vector<float>(static_cast<size_t>(rect.width) * rect.height, -1.0F),
+                img::Size{rect.height, rect.width}};
+  ASSERT_TRUE(filt::GaussianBlurF(img::ViewOf(imf).Roi(rect), img::ViewOf(out), img::Size{5, 5}, 1.0F));
+  EXPECT_EQ(out.data, expected.data);
+}
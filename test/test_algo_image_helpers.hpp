@@ -0,0 +1,44 @@
+///
+/// \brief Random images shared by the image unit tests.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#ifndef ALGO_TEST_TEST_ALGO_IMAGE_HELPERS_HPP_
+#define ALGO_TEST_TEST_ALGO_IMAGE_HELPERS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "include/algo_image_basic.hpp"
+
+namespace algo_test {
+
+/// n pixels drawn uniformly from 0-255, the same ones for the same seed.
+inline algo::image::Data8 RandomData(size_t n, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> dist{0, 255};
+  algo::image::Data8 data(n);
+  for (auto& px : data) {
+    px = static_cast<uint8_t>(dist(gen));
+  }
+  return data;
+}
+
+/// A gray image of random pixels.
+inline algo::image::Img RandomImg(int rows, int cols, unsigned seed) {
+  return algo::image::Img{RandomData(static_cast<size_t>(rows) * cols, seed), algo::image::Size{rows, cols}};
+}
+
+/// A color image of random planes, seeded with seed, seed + 1 and seed + 2.
+inline algo::image::Img3 RandomImg3(int rows, int cols, unsigned seed) {
+  const size_t n{static_cast<size_t>(rows) * cols};
+  return algo::image::Img3{algo::image::Data8_3{RandomData(n, seed), RandomData(n, seed + 1), RandomData(n, seed + 2)},
+                           algo::image::Size{rows, cols}};
+}
+
+}// namespace algo_test
+
+#endif//ALGO_TEST_TEST_ALGO_IMAGE_HELPERS_HPP_
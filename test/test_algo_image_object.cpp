@@ -12,6 +12,7 @@
 #include "gtest/gtest.h"
 #include "include/algo_image_basic.hpp"
 #include "include/algo_image_object.hpp"
+#include "include/algo_image_pyramid.hpp"
 
 namespace {
 namespace img = algo::image;
@@ -168,6 +169,42 @@ TEST(tEstAlgoImage, TestCannyEdge) {
   EXPECT_GT(ratio_blacks, 0.9);
 }
 
+TEST(TestAlgoImage, TestCannyEdgeView) {
+  // A region of the image into a region of another, as the copy of the region.
+  const img::Img test_im{GetTestImage()};
+  const img::Rectangle rect{10, 6, test_im.size.cols - 20, test_im.size.rows - 12};
+  const img::ConstImgView roi{img::ViewOf(test_im).Roi(rect)};
+  const img::Img expected{imgo::ExtractCannyEdges(img::FromView(roi))};
+
+  img::Img buffer{std::vector<uint8_t>((rect.height + 4) * (rect.width + 4), 7), img::Size{rect.height + 4, rect.width + 4}};
+  const img::ImgView out{img::ViewOf(buffer).Roi(img::Rectangle{2, 2, rect.width, rect.height})};
+  ASSERT_TRUE(imgo::ExtractCannyEdges(roi, out));
+  EXPECT_EQ(img::FromView(out).data, expected.data);
+  EXPECT_EQ(buffer.At(0, 0), 7);
+
+  // In place.
+  img::Img same{test_im};
+  ASSERT_TRUE(imgo::ExtractCannyEdges(img::ViewOf(same), img::ViewOf(same)));
+  EXPECT_EQ(same.data, imgo::ExtractCannyEdges(test_im).data);
+
+  EXPECT_FALSE(imgo::ExtractCannyEdges(roi, img::ViewOf(same)));
+  EXPECT_FALSE(imgo::ExtractCannyEdges(img::ConstImgView{}, img::ImgView{}));
+}
+
+TEST(TestAlgoImage, TestCannyEdgeOnPyramid) {
+  const img::Img test_im{GetTestImage()};
+  const img::Pyramid pyr{test_im, 2};
+  ASSERT_EQ(pyr.Octaves(), 2);
+  for (int o = 0; o < pyr.Octaves(); o++) {
+    // The blur of the pyramid is wider than the 3x3 kernel, the gradients are weaker.
+    const img::Img canny_img{imgo::ExtractCannyEdges(pyr, o, 10, 30)};
+    EXPECT_EQ(canny_img.size, pyr.SizeOf(o));
+    EXPECT_TRUE(std::all_of(canny_img.data.begin(), canny_img.data.end(), [](uint8_t v) { return v == 0 || v == 255; }));
+    EXPECT_TRUE(std::any_of(canny_img.data.begin(), canny_img.data.end(), [](uint8_t v) { return v == 255; }));
+  }
+  EXPECT_TRUE(imgo::ExtractCannyEdges(pyr, 2).data.empty());
+}
+
 /////////////////////////////////////////////
 /// Line detect
 /////////////////////////////////////////////
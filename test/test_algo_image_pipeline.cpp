@@ -0,0 +1,69 @@
+///
+/// \brief Unit tests for chains of image operations run band by band.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_image_filter.hpp"
+#include "include/algo_image_pipeline.hpp"
+#include "test_algo_image_helpers.hpp"
+
+namespace {
+namespace img = algo::image;
+namespace filt = algo::image::filter;
+using algo_test::RandomData;
+using algo_test::RandomImg3;
+
+}  // namespace
+
+TEST(TestAlgoImagePipeline, SameAsEager) {
+  const img::Img3 im{RandomImg3(97, 53, 1)};
+  img::Pipeline pipeline;
+  pipeline.GaussianBlur(img::Size{5, 5}, 1.0F).Convolve(filt::KernelType::SOBEL_X).Fixed(40, true);
+  EXPECT_EQ(pipeline.Halo(), 3);
+
+  const img::Img gray{img::ToGray(im)};
+  const img::Img blur{filt::GaussianBlur(gray, img::Size{5, 5}, 1.0F)};
+  const img::Img expected{filt::threshold::Fixed(filt::Convolve(blur, filt::KernelType::SOBEL_X), 40, true)};
+
+  for (const size_t threads : {1, 2, 5}) {
+    for (const int band_rows : {0, 1, 9, 30}) {
+      EXPECT_EQ(pipeline.Run(im, threads, band_rows).data, expected.data);
+    }
+  }
+  EXPECT_EQ(pipeline.Run(gray, 3, 10).data, expected.data);
+}
+
+TEST(TestAlgoImagePipeline, PointWiseAndWindows) {
+  const img::Img im{RandomData(80 * 41, 4), img::Size{80, 41}};
+  img::Pipeline pipeline;
+  pipeline.Invert().Fixed(100, false).MedianFilter(img::Size{3, 3}).Adaptive(7, true).Invert();
+
+  img::Img expected{filt::threshold::Fixed(img::InvertPixels(im), 100, false)};
+  expected = filt::threshold::Adaptive(filt::MedianFilter(expected, img::Size{3, 3}), 7, true);
+  expected = img::InvertPixels(expected);
+  EXPECT_EQ(pipeline.Run(im, 4, 12).data, expected.data);
+
+  // Only point-wise stages.
+  img::Pipeline lut;
+  lut.Fixed(128, true).Invert();
+  EXPECT_EQ(lut.Run(im, 2, 5).data, img::InvertPixels(filt::threshold::Fixed(im, 128, true)).data);
+  EXPECT_EQ(img::Pipeline{}.Run(im).data, im.data);
+}
+
+TEST(TestAlgoImagePipeline, Errors) {
+  img::Pipeline pipeline;
+  pipeline.Convolve(filt::KernelType::SOBEL_Y);
+  EXPECT_TRUE(pipeline.Run(img::Img{{}, img::Size{0, 0}}).data.empty());
+  EXPECT_TRUE(pipeline.Run(img::Img3{{img::Data8(6), img::Data8(6), img::Data8(5)}, img::Size{2, 3}}).data.empty());
+
+  // The window is as large as the image.
+  const img::Img im{RandomData(40, 5), img::Size{8, 5}};
+  pipeline.MedianFilter(img::Size{5, 5});
+  EXPECT_TRUE(pipeline.Run(im).data.empty());
+}
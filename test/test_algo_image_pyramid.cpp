@@ -0,0 +1,137 @@
+///
+/// \brief Unit tests for image pyramids.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_image_filter.hpp"
+#include "include/algo_image_pyramid.hpp"
+
+namespace {
+namespace img = algo::image;
+namespace filt = algo::image::filter;
+
+/// A smooth image, a few waves across it.
+img::Img WaveImg(int rows, int cols) {
+  img::Img im{img::Data8(static_cast<size_t>(rows) * cols), img::Size{rows, cols}};
+  for (int y = 0; y < rows; y++) {
+    for (int x = 0; x < cols; x++) {
+      const double v{128.0 + 60.0 * std::sin(x * 0.21) + 60.0 * std::cos(y * 0.17)};
+      im.data[static_cast<size_t>(y) * cols + x] = static_cast<uint8_t>(v);
+    }
+  }
+  return im;
+}
+
+/// The largest difference of two views of the same size, without the pixels closer than border to the edge.
+float MaxDifference(const img::ConstImgViewF& a, const img::ConstImgViewF& b, const int& border) {
+  float diff{0.0F};
+  for (int y = border; y < a.size.rows - border; y++) {
+    for (int x = border; x < a.size.cols - border; x++) {
+      diff = std::max(diff, std::abs(a.At(x, y) - b.At(x, y)));
+    }
+  }
+  return diff;
+}
+}// namespace
+
+TEST(TestAlgoImagePyramid, Octaves) {
+  const img::Pyramid pyr{WaveImg(100, 130), 10};
+  // 100, 50 and 25 rows, 12 is below kMinSide.
+  ASSERT_EQ(pyr.Octaves(), 3);
+  EXPECT_EQ(pyr.Levels(), 6);
+  EXPECT_EQ(pyr.Scales(), 3);
+  EXPECT_EQ(pyr.SizeOf(0), (img::Size{100, 130}));
+  EXPECT_EQ(pyr.SizeOf(1), (img::Size{50, 65}));
+  EXPECT_EQ(pyr.SizeOf(2), (img::Size{25, 32}));
+  EXPECT_EQ(pyr.Smoothed(2).size, (img::Size{25, 32}));
+  EXPECT_FLOAT_EQ(pyr.Sigma(0, 0), 1.6F);
+  EXPECT_FLOAT_EQ(pyr.Sigma(0, 3), 3.2F);
+  EXPECT_FLOAT_EQ(pyr.Sigma(1, 0), 3.2F);
+
+  EXPECT_TRUE(pyr.Gaussian(3, 0).Empty());
+  EXPECT_TRUE(pyr.Gaussian(0, 6).Empty());
+  EXPECT_TRUE(pyr.Laplacian(0, 5).Empty());
+  EXPECT_FALSE(pyr.Laplacian(2, 4).Empty());
+  EXPECT_TRUE(pyr.Smoothed(3).data.empty());
+}
+
+TEST(TestAlgoImagePyramid, Levels) {
+  const img::Img im{WaveImg(80, 90)};
+  const img::Pyramid pyr{im, 2};
+  ASSERT_EQ(pyr.Octaves(), 2);
+
+  // Octave 1 starts with every second pixel of the level with twice the sigma.
+  const img::ConstImgViewF first{pyr.Gaussian(1, 0)};
+  const img::ConstImgViewF prev{pyr.Gaussian(0, 3)};
+  for (int y = 0; y < first.size.rows; y++) {
+    for (int x = 0; x < first.size.cols; x++) {
+      ASSERT_EQ(first.At(x, y), prev.At(2 * x, 2 * y));
+    }
+  }
+  for (int o = 0; o < pyr.Octaves(); o++) {
+    for (int l = 0; l + 1 < pyr.Levels(); l++) {
+      const img::ConstImgViewF dog{pyr.Laplacian(o, l)};
+      for (int y = 0; y < dog.size.rows; y++) {
+        for (int x = 0; x < dog.size.cols; x++) {
+          ASSERT_EQ(dog.At(x, y), pyr.Gaussian(o, l + 1).At(x, y) - pyr.Gaussian(o, l).At(x, y));
+        }
+      }
+    }
+  }
+
+  // The levels blurred one from the other are close to blurring the input once, 3 sigma from the borders. The
+  // recursive filter is within a few percent of a Gaussian, and so is a chain of them.
+  const img::ImgF imf{img::Dataf(im.data.begin(), im.data.end()), im.size};
+  for (int l = 0; l < pyr.Levels(); l++) {
+    const float sigma{std::sqrt(pyr.Sigma(0, l) * pyr.Sigma(0, l) - 0.25F)};
+    const img::ImgF once{filt::RecursiveGaussianBlurF(imf, sigma)};
+    const int border{static_cast<int>(std::ceil(3.0F * sigma))};
+    EXPECT_LT(MaxDifference(pyr.Gaussian(0, l), img::ViewOf(once), border), 3.0F) << l;
+  }
+}
+
+TEST(TestAlgoImagePyramid, ConstantImage) {
+  const img::Img im{img::Data8(48 * 40, 77), img::Size{48, 40}};
+  const img::Pyramid pyr{im, 3, 2};
+  ASSERT_EQ(pyr.Octaves(), 2);
+  for (int o = 0; o < pyr.Octaves(); o++) {
+    for (int l = 0; l < pyr.Levels(); l++) {
+      const img::ConstImgViewF g{pyr.Gaussian(o, l)};
+      const img::ConstImgViewF dog{pyr.Laplacian(o, l)};
+      for (int y = 0; y < g.size.rows; y++) {
+        for (int x = 0; x < g.size.cols; x++) {
+          EXPECT_NEAR(g.At(x, y), 77.0F, 1e-2F);
+          if (!dog.Empty()) {
+            EXPECT_NEAR(dog.At(x, y), 0.0F, 1e-2F);
+          }
+        }
+      }
+    }
+    EXPECT_EQ(pyr.Smoothed(o).data, img::Data8(pyr.Smoothed(o).data.size(), 77));
+  }
+}
+
+TEST(TestAlgoImagePyramid, Errors) {
+  EXPECT_TRUE(img::Pyramid{}.Empty());
+  EXPECT_TRUE((img::Pyramid{img::Img{{}, img::Size{0, 0}}, 3}.Empty()));
+  EXPECT_TRUE((img::Pyramid{WaveImg(15, 40), 3}.Empty()));
+  EXPECT_TRUE((img::Pyramid{WaveImg(40, 40), 0}.Empty()));
+  EXPECT_TRUE((img::Pyramid{WaveImg(40, 40), 3, 0}.Empty()));
+  // Too many scales, the blur from one level to the next would be below what the filter can do.
+  EXPECT_TRUE((img::Pyramid{WaveImg(40, 40), 3, 20}.Empty()));
+  // sigma * sqrt(2^(2 / nbr_scales) - 1) is 0.516 for 14 scales and 0.498 for 15, with the default sigma.
+  EXPECT_FALSE((img::Pyramid{WaveImg(40, 40), 1, 14}.Empty()));
+  EXPECT_TRUE((img::Pyramid{WaveImg(40, 40), 1, 15}.Empty()));
+  EXPECT_FALSE((img::Pyramid{WaveImg(40, 40), 1, 15, 1.7F}.Empty()));
+  EXPECT_TRUE((img::Pyramid{img::Img{img::Data8(10), img::Size{40, 40}}, 3}.Empty()));
+  EXPECT_EQ(img::Pyramid{}.SizeOf(0), (img::Size{0, 0}));
+  EXPECT_TRUE(img::Pyramid{}.Gaussian(0, 0).Empty());
+}
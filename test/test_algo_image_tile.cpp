@@ -0,0 +1,77 @@
+///
+/// \brief Unit tests for running image operations on row bands.
+/// \author alex011235
+/// \date 2026-10-19
+/// \link <a href=https://github.com/alex011235/algo>Algo, Github</a>
+///
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/algo_image_filter.hpp"
+#include "include/algo_image_object.hpp"
+#include "include/algo_image_tile.hpp"
+#include "test_algo_image_helpers.hpp"
+
+namespace {
+namespace img = algo::image;
+namespace filt = algo::image::filter;
+namespace tile = algo::image::tile;
+using algo_test::RandomImg;
+
+/// Checks that op gives the same image on bands as on the whole image, for a few thread counts and band sizes.
+void ExpectSeamless(const img::Img& im, const tile::Operation& op, int halo) {
+  const img::Data8 expected{op(im).data};
+  for (const size_t threads : {1, 3, 8}) {
+    for (const int band_rows : {0, 1, 7, 40}) {
+      EXPECT_EQ(tile::Run(im, op, halo, threads, band_rows).data, expected);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TestAlgoImageTile, Convolve) {
+  const img::Img im{RandomImg(101, 37, 1)};
+  ExpectSeamless(im, [](const img::Img& band) { return filt::Convolve(band, filt::KernelType::SOBEL_X); }, 1);
+  ExpectSeamless(im, [](const img::Img& band) { return filt::Convolve(band, filt::KernelType::SMOOTHING); }, 1);
+}
+
+TEST(TestAlgoImageTile, GaussianAndMedian) {
+  const img::Img im{RandomImg(120, 45, 2)};
+  ExpectSeamless(im, [](const img::Img& band) { return filt::GaussianBlur(band, img::Size{7, 5}, 1.5F); }, 3);
+  ExpectSeamless(im, [](const img::Img& band) { return filt::MedianFilter(band, img::Size{5, 5}); }, 2);
+  ExpectSeamless(im, [](const img::Img& band) { return filt::MedianFilter(band, img::Size{4, 9}); }, 2);
+}
+
+TEST(TestAlgoImageTile, AdaptiveAndCanny) {
+  const img::Img im{RandomImg(90, 60, 3)};
+  ExpectSeamless(im, [](const img::Img& band) { return filt::threshold::Adaptive(band, 11, true); }, 5);
+  ExpectSeamless(im, [](const img::Img& band) { return algo::image::object::ExtractCannyEdges(band); }, 4);
+}
+
+TEST(TestAlgoImageTile, Float) {
+  img::ImgF im{img::Dataf(80 * 30), img::Size{80, 30}};
+  for (size_t i = 0; i < im.data.size(); i++) {
+    im.data[i] = static_cast<float>((i * 7919) % 101);
+  }
+  const tile::OperationF op{[](const img::ImgF& band) { return filt::GaussianBlurF(band, img::Size{5, 5}, 1.0F); }};
+  EXPECT_EQ(tile::RunF(im, op, 2, 4, 10).data, op(im).data);
+}
+
+TEST(TestAlgoImageTile, Errors) {
+  const img::Img im{RandomImg(64, 20, 4)};
+  const tile::Operation copy{[](const img::Img& band) { return band; }};
+  EXPECT_TRUE(tile::Run(img::Img{{}, img::Size{0, 0}}, copy, 1).data.empty());
+  EXPECT_TRUE(tile::Run(im, copy, -1).data.empty());
+  EXPECT_EQ(tile::Run(im, copy, 0, 4, 1).data, im.data);
+
+  // Another size is not stitched.
+  const tile::Operation crop{[](const img::Img&) { return img::Img{img::Data8(20, 0), img::Size{1, 20}}; }};
+  EXPECT_TRUE(tile::Run(im, crop, 0, 4, 8).data.empty());
+
+  const tile::Operation fail{[](const img::Img&) -> img::Img { throw std::runtime_error("band"); }};
+  EXPECT_THROW(tile::Run(im, fail, 0, 4, 8), std::runtime_error);
+}